@@ -0,0 +1,118 @@
+/*-------------------------------------------------------------------------
+ *
+ * bljsonb.c
+ *		Support functions of jsonb_bloom_ops.
+ *
+ * Copyright (c) 2016, PostgreSQL Global Development Group
+ * Portions Copyright (c) 2017, Bitnine Inc.
+ *
+ * IDENTIFICATION
+ *	  contrib/bloom/bljsonb.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "fmgr.h"
+#include "utils/jsonb.h"
+
+#include "bloom.h"
+
+/* stack of partial hashes of the keys on the path to the current value */
+typedef struct PathHashStack
+{
+	uint32		hash;
+	struct PathHashStack *parent;
+} PathHashStack;
+
+PG_FUNCTION_INFO_V1(jsonb_bloom_extract);
+
+/*
+ * Break a jsonb value into hashes of its key/value pairs.
+ *
+ * Each hash combines all the keys on the path to a scalar value with the
+ * value itself, the same way jsonb_path_ops does.  So, if `a @> b` then the
+ * hashes of `b` are a subset of the hashes of `a`, and a signature built from
+ * them can be used for both `@>` and `=`.  Property maps of vertices and edges
+ * usually have many keys, and they are compared on many keys at once; one bit
+ * set per pair keeps the index much smaller and cheaper to update than GIN.
+ */
+Datum
+jsonb_bloom_extract(PG_FUNCTION_ARGS)
+{
+	Jsonb	   *jb = PG_GETARG_JSONB(0);
+	int32	   *nentries = (int32 *) PG_GETARG_POINTER(1);
+	int			total = 2 * JB_ROOT_COUNT(jb);
+	JsonbIterator *it;
+	JsonbValue	v;
+	JsonbIteratorToken r;
+	PathHashStack tail;
+	PathHashStack *stack;
+	int			i = 0;
+	Datum	   *entries;
+
+	/* An empty root has no pairs, so it matches everything */
+	if (total == 0)
+	{
+		*nentries = 0;
+		PG_RETURN_POINTER(NULL);
+	}
+
+	entries = (Datum *) palloc(sizeof(Datum) * total);
+
+	tail.parent = NULL;
+	tail.hash = 0;
+	stack = &tail;
+
+	it = JsonbIteratorInit(&jb->root);
+
+	while ((r = JsonbIteratorNext(&it, &v, false)) != WJB_DONE)
+	{
+		PathHashStack *parent;
+
+		if (i >= total)
+		{
+			total *= 2;
+			entries = (Datum *) repalloc(entries, sizeof(Datum) * total);
+		}
+
+		switch (r)
+		{
+			case WJB_BEGIN_ARRAY:
+			case WJB_BEGIN_OBJECT:
+				parent = stack;
+				stack = (PathHashStack *) palloc(sizeof(PathHashStack));
+				stack->hash = parent->hash;
+				stack->parent = parent;
+				break;
+			case WJB_KEY:
+				JsonbHashScalarValue(&v, &stack->hash);
+				break;
+			case WJB_ELEM:
+			case WJB_VALUE:
+				JsonbHashScalarValue(&v, &stack->hash);
+				entries[i++] = UInt32GetDatum(stack->hash);
+				/* reset hash for the next pair */
+				stack->hash = stack->parent->hash;
+				break;
+			case WJB_END_ARRAY:
+			case WJB_END_OBJECT:
+				parent = stack->parent;
+				pfree(stack);
+				stack = parent;
+				if (stack->parent)
+					stack->hash = stack->parent->hash;
+				else
+					stack->hash = 0;
+				break;
+			default:
+				elog(ERROR, "invalid JsonbIteratorNext rc: %d", (int) r);
+		}
+	}
+
+	*nentries = i;
+
+	PG_FREE_IF_COPY(jb, 0);
+
+	PG_RETURN_POINTER(entries);
+}
@@ -0,0 +1,16 @@
+/* contrib/bloom/bloom--1.0--1.1.sql */
+
+-- complain if script is sourced in psql, rather than via ALTER EXTENSION
+\echo Use "ALTER EXTENSION bloom UPDATE TO '1.1'" to load this file. \quit
+
+CREATE FUNCTION jsonb_bloom_extract(jsonb, internal)
+RETURNS internal
+AS 'MODULE_PATHNAME'
+LANGUAGE C STRICT;
+
+CREATE OPERATOR CLASS jsonb_bloom_ops
+DEFAULT FOR TYPE jsonb USING bloom AS
+	OPERATOR	1	=(jsonb, jsonb),
+	OPERATOR	2	@>(jsonb, jsonb),
+	FUNCTION	1	jsonb_hash(jsonb),
+	FUNCTION	2	jsonb_bloom_extract(jsonb, internal);
@@ -1,4 +1,4 @@
-/* contrib/bloom/bloom--1.0.sql */
+/* contrib/bloom/bloom--1.1.sql */
 
 -- complain if script is sourced in psql, rather than via CREATE EXTENSION
 \echo Use "CREATE EXTENSION bloom" to load this file. \quit
@@ -23,3 +23,15 @@ CREATE OPERATOR CLASS text_ops
 DEFAULT FOR TYPE text USING bloom AS
 	OPERATOR	1	=(text, text),
 	FUNCTION	1	hashtext(text);
+
+CREATE FUNCTION jsonb_bloom_extract(jsonb, internal)
+RETURNS internal
+AS 'MODULE_PATHNAME'
+LANGUAGE C STRICT;
+
+CREATE OPERATOR CLASS jsonb_bloom_ops
+DEFAULT FOR TYPE jsonb USING bloom AS
+	OPERATOR	1	=(jsonb, jsonb),
+	OPERATOR	2	@>(jsonb, jsonb),
+	FUNCTION	1	jsonb_hash(jsonb),
+	FUNCTION	2	jsonb_bloom_extract(jsonb, internal);
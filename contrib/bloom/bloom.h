@@ -20,13 +20,19 @@
 #include "nodes/relation.h"
 #include "fmgr.h"
 
-/* Support procedures numbers */
+/*
+ * Support procedures numbers.  BLOOM_EXTRACT_PROC is optional; if given, it
+ * breaks a value into several hash values (e.g. key/value pairs of a jsonb
+ * object) and each of them is added to the signature.
+ */
 #define BLOOM_HASH_PROC			1
-#define BLOOM_NPROC				1
+#define BLOOM_EXTRACT_PROC		2
+#define BLOOM_NPROC				2
 
 /* Scan strategies */
 #define BLOOM_EQUAL_STRATEGY	1
-#define BLOOM_NSTRATEGIES		1
+#define BLOOM_CONTAINS_STRATEGY	2
+#define BLOOM_NSTRATEGIES		2
 
 /* Opaque for bloom pages */
 typedef struct BloomPageOpaqueData
@@ -137,6 +143,7 @@ typedef struct BloomMetaPageData
 typedef struct BloomState
 {
 	FmgrInfo	hashFn[INDEX_MAX_KEYS];
+	FmgrInfo	extractFn[INDEX_MAX_KEYS];	/* valid if fn_oid is valid */
 	BloomOptions opts;			/* copy of options on index's metapage */
 	int32		nColumns;
 
@@ -184,6 +191,9 @@ extern void signValue(BloomState *state, BloomSignatureWord *sign, Datum value,
 extern BloomTuple *BloomFormTuple(BloomState *state, ItemPointer iptr, Datum *values, bool *isnull);
 extern bool BloomPageAddItem(BloomState *state, Page page, BloomTuple *tuple);
 
+/* bljsonb.c */
+extern Datum jsonb_bloom_extract(PG_FUNCTION_ARGS);
+
 /* blvalidate.c */
 extern bool blvalidate(Oid opclassoid);
 
@@ -119,6 +119,7 @@ blhandler(PG_FUNCTION_ARGS)
 	amroutine->amstorage = false;
 	amroutine->amclusterable = false;
 	amroutine->ampredlocks = false;
+	amroutine->amcanparallel = false;
 	amroutine->amkeytype = InvalidOid;
 
 	amroutine->ambuild = blbuild;
@@ -138,6 +139,9 @@ blhandler(PG_FUNCTION_ARGS)
 	amroutine->amendscan = blendscan;
 	amroutine->ammarkpos = NULL;
 	amroutine->amrestrpos = NULL;
+	amroutine->amestimateparallelscan = NULL;
+	amroutine->aminitparallelscan = NULL;
+	amroutine->amparallelrescan = NULL;
 
 	PG_RETURN_POINTER(amroutine);
 }
@@ -158,6 +162,14 @@ initBloomState(BloomState *state, Relation index)
 		fmgr_info_copy(&(state->hashFn[i]),
 					   index_getprocinfo(index, i + 1, BLOOM_HASH_PROC),
 					   CurrentMemoryContext);
+
+		/* Extract function is optional */
+		if (OidIsValid(index_getprocid(index, i + 1, BLOOM_EXTRACT_PROC)))
+			fmgr_info_copy(&(state->extractFn[i]),
+						   index_getprocinfo(index, i + 1, BLOOM_EXTRACT_PROC),
+						   CurrentMemoryContext);
+		else
+			state->extractFn[i].fn_oid = InvalidOid;
 	}
 
 	/* Initialize amcache if needed with options from metapage */
@@ -241,12 +253,12 @@ mySrand(uint32 seed)
 }
 
 /*
- * Add bits of given value to the signature.
+ * Add bits of given hash value to the signature.
  */
-void
-signValue(BloomState *state, BloomSignatureWord *sign, Datum value, int attno)
+static void
+signHash(BloomState *state, BloomSignatureWord *sign, uint32 hashVal,
+		 int attno)
 {
-	uint32		hashVal;
 	int			nBit,
 				j;
 
@@ -262,7 +274,6 @@ signValue(BloomState *state, BloomSignatureWord *sign, Datum value, int attno)
 	 * different columns will be mapped into different bits because of step
 	 * above
 	 */
-	hashVal = DatumGetInt32(FunctionCall1(&state->hashFn[attno], value));
 	mySrand(hashVal ^ myRand());
 
 	for (j = 0; j < state->opts.bitSize[attno]; j++)
@@ -273,6 +284,42 @@ signValue(BloomState *state, BloomSignatureWord *sign, Datum value, int attno)
 	}
 }
 
+/*
+ * Add bits of given value to the signature.
+ *
+ * If the opclass has an extract function, every hash value it returns is
+ * added separately, so that a signature of a query value is a subset of the
+ * signature of any value containing it.
+ */
+void
+signValue(BloomState *state, BloomSignatureWord *sign, Datum value, int attno)
+{
+	if (OidIsValid(state->extractFn[attno].fn_oid))
+	{
+		Datum	   *entries;
+		int32		nentries = 0;
+		int32		i;
+
+		entries = (Datum *) DatumGetPointer(
+									FunctionCall2(&state->extractFn[attno],
+												  value,
+												  PointerGetDatum(&nentries)));
+
+		for (i = 0; i < nentries; i++)
+			signHash(state, sign, DatumGetUInt32(entries[i]), attno);
+
+		if (entries != NULL)
+			pfree(entries);
+	}
+	else
+	{
+		uint32		hashVal;
+
+		hashVal = DatumGetInt32(FunctionCall1(&state->hashFn[attno], value));
+		signHash(state, sign, hashVal, attno);
+	}
+}
+
 /*
  * Make bloom tuple from values.
  */
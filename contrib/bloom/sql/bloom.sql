@@ -72,6 +72,29 @@ SELECT count(*) FROM tstu WHERE i = 7;
 SELECT count(*) FROM tstu WHERE t = '5';
 SELECT count(*) FROM tstu WHERE i = 7 AND t = '5';
 
+-- jsonb property maps
+
+CREATE TABLE tstj (
+	j	jsonb
+);
+
+INSERT INTO tstj SELECT jsonb_build_object('i', i%10, 't', i%7) FROM generate_series(1,2000) i;
+CREATE INDEX bloomidxj ON tstj USING bloom (j) WITH (col1 = 3);
+
+SET enable_seqscan=off;
+SET enable_bitmapscan=on;
+SET enable_indexscan=on;
+
+EXPLAIN (COSTS OFF) SELECT count(*) FROM tstj WHERE j @> '{"i": 7}';
+EXPLAIN (COSTS OFF) SELECT count(*) FROM tstj WHERE j @> '{"t": 5}';
+EXPLAIN (COSTS OFF) SELECT count(*) FROM tstj WHERE j @> '{"i": 7, "t": 5}';
+EXPLAIN (COSTS OFF) SELECT count(*) FROM tstj WHERE j = '{"i": 7, "t": 5}';
+
+SELECT count(*) FROM tstj WHERE j @> '{"i": 7}';
+SELECT count(*) FROM tstj WHERE j @> '{"t": 5}';
+SELECT count(*) FROM tstj WHERE j @> '{"i": 7, "t": 5}';
+SELECT count(*) FROM tstj WHERE j = '{"i": 7, "t": 5}';
+
 RESET enable_seqscan;
 RESET enable_bitmapscan;
 RESET enable_indexscan;
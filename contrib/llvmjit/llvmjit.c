@@ -0,0 +1,332 @@
+/*-------------------------------------------------------------------------
+ *
+ * llvmjit.c
+ *	  Core part of the LLVM JIT provider.
+ *
+ * Code is generated with the LLVM C API and compiled to machine code with
+ * MCJIT.  Every compiled expression gets its own module and execution
+ * engine, because expressions are compiled one at a time when they are
+ * first evaluated.  The engines belong to a per-query LLVMJitContext, which
+ * is released together with the query's memory context, on success as well
+ * as on error.
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ *
+ * IDENTIFICATION
+ *	  contrib/llvmjit/llvmjit.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include <llvm-c/Analysis.h>
+#include <llvm-c/Target.h>
+#include <llvm-c/Transforms/PassManagerBuilder.h>
+
+#include "fmgr.h"
+#include "llvmjit.h"
+#include "portability/instr_time.h"
+
+PG_MODULE_MAGIC;
+
+
+LLVMTypeRef TypeSizeT;
+LLVMTypeRef TypeDatum;
+LLVMTypeRef TypeStorageBool;
+LLVMTypeRef TypeInt8Ptr;
+LLVMTypeRef TypePGFunction;
+LLVMTypeRef TypeSlotGetSomeAttrs;
+
+static bool llvm_session_initialized = false;
+
+
+static void llvm_session_initialize(void);
+static void llvm_release_context(void *arg);
+static void llvm_optimize_module(LLVMJitContext *context,
+					 LLVMModuleRef module);
+
+
+/*
+ * Initialize LLVM JIT provider.
+ */
+void
+_PG_jit_provider_init(JitProviderCallbacks *cb)
+{
+	cb->compile_expr = llvm_compile_expr;
+}
+
+/*
+ * Per session initialization.
+ */
+static void
+llvm_session_initialize(void)
+{
+	if (llvm_session_initialized)
+		return;
+
+	LLVMLinkInMCJIT();
+	if (LLVMInitializeNativeTarget() ||
+		LLVMInitializeNativeAsmPrinter() ||
+		LLVMInitializeNativeAsmParser())
+		elog(ERROR, "could not initialize LLVM native target");
+
+	TypeSizeT = LLVMIntType(sizeof(size_t) * 8);
+	TypeDatum = LLVMIntType(sizeof(Datum) * 8);
+	TypeStorageBool = LLVMIntType(sizeof(bool) * 8);
+	TypeInt8Ptr = LLVMPointerType(LLVMInt8Type(), 0);
+
+	/* Datum (*PGFunction) (FunctionCallInfo fcinfo) */
+	TypePGFunction = LLVMFunctionType(TypeDatum, &TypeInt8Ptr, 1, false);
+
+	/* void slot_getsomeattrs(TupleTableSlot *slot, int attnum) */
+	{
+		LLVMTypeRef params[2];
+
+		params[0] = TypeInt8Ptr;
+		params[1] = LLVMInt32Type();
+		TypeSlotGetSomeAttrs = LLVMFunctionType(LLVMVoidType(), params, 2,
+												false);
+	}
+
+	llvm_session_initialized = true;
+}
+
+/*
+ * Return the JIT context of the query, creating it on first use.
+ */
+LLVMJitContext *
+llvm_create_context(EState *estate)
+{
+	LLVMJitContext *context;
+
+	if (estate->es_jit != NULL)
+		return (LLVMJitContext *) estate->es_jit;
+
+	llvm_session_initialize();
+
+	context = MemoryContextAllocZero(estate->es_query_cxt,
+									 sizeof(LLVMJitContext));
+	context->base.flags = estate->es_jit_flags;
+	context->engines = NIL;
+
+	/* release the machine code when the query's memory goes away */
+	context->release_cb.func = llvm_release_context;
+	context->release_cb.arg = context;
+	MemoryContextRegisterResetCallback(estate->es_query_cxt,
+									   &context->release_cb);
+
+	estate->es_jit = &context->base;
+
+	return context;
+}
+
+static void
+llvm_release_context(void *arg)
+{
+	LLVMJitContext *context = (LLVMJitContext *) arg;
+	ListCell   *lc;
+
+	/* disposing of an engine disposes of its module as well */
+	foreach(lc, context->engines)
+		LLVMDisposeExecutionEngine((LLVMExecutionEngineRef) lfirst(lc));
+
+	/* the list itself lives in the memory being released */
+	context->engines = NIL;
+}
+
+/*
+ * Create a new module to emit code into.  A unique prefix for the names of
+ * the functions in it is returned in *name.
+ */
+LLVMModuleRef
+llvm_mutable_module(LLVMJitContext *context, char **name)
+{
+	LLVMModuleRef module;
+
+	*name = psprintf("pgjit%d", (int) context->module_generation++);
+	module = LLVMModuleCreateWithName(*name);
+
+	return module;
+}
+
+/*
+ * Compile the module to machine code and return the address of funcname in
+ * it.  The module must not be used any more afterwards.
+ */
+void *
+llvm_get_function(LLVMJitContext *context, LLVMModuleRef module,
+				  const char *funcname)
+{
+	struct LLVMMCJITCompilerOptions options;
+	LLVMExecutionEngineRef engine;
+	MemoryContext oldcxt;
+	char	   *error = NULL;
+	instr_time	starttime;
+	instr_time	endtime;
+	void	   *addr;
+
+#ifdef USE_ASSERT_CHECKING
+	if (LLVMVerifyModule(module, LLVMReturnStatusAction, &error))
+		elog(ERROR, "failed to verify JIT module: %s", error);
+	LLVMDisposeMessage(error);
+	error = NULL;
+#endif
+
+	/* optimize according to cost */
+	INSTR_TIME_SET_CURRENT(starttime);
+	llvm_optimize_module(context, module);
+	INSTR_TIME_SET_CURRENT(endtime);
+	INSTR_TIME_ACCUM_DIFF(context->base.optimization_counter,
+						  endtime, starttime);
+
+	/* and emit the code */
+	INSTR_TIME_SET_CURRENT(starttime);
+
+	LLVMInitializeMCJITCompilerOptions(&options, sizeof(options));
+	options.OptLevel = (context->base.flags & PGJIT_OPT3) ? 3 : 0;
+
+	if (LLVMCreateMCJITCompilerForModule(&engine, module, &options,
+										 sizeof(options), &error))
+	{
+		char	   *msg = pstrdup(error);
+
+		/* the module has been released by LLVM in this case, too */
+		LLVMDisposeMessage(error);
+		elog(ERROR, "failed to create JIT compiler: %s", msg);
+	}
+
+	/* the engine owns the module from now on */
+	oldcxt = MemoryContextSwitchTo(GetMemoryChunkContext(context));
+	context->engines = lappend(context->engines, engine);
+	MemoryContextSwitchTo(oldcxt);
+
+	addr = (void *) (uintptr_t) LLVMGetFunctionAddress(engine, funcname);
+
+	INSTR_TIME_SET_CURRENT(endtime);
+	INSTR_TIME_ACCUM_DIFF(context->base.emission_counter,
+						  endtime, starttime);
+
+	if (addr == NULL)
+		elog(ERROR, "failed to JIT: %s", funcname);
+
+	return addr;
+}
+
+/*
+ * Optimize the code in module.  Expensive queries get the full -O3
+ * pipeline, the others only get the cheap function simplification passes.
+ */
+static void
+llvm_optimize_module(LLVMJitContext *context, LLVMModuleRef module)
+{
+	LLVMPassManagerBuilderRef llvm_pmb;
+	LLVMPassManagerRef llvm_fpm;
+	LLVMPassManagerRef llvm_mpm;
+	LLVMValueRef func;
+	int			compile_optlevel;
+
+	if (context->base.flags & PGJIT_OPT3)
+		compile_optlevel = 3;
+	else
+		compile_optlevel = 0;
+
+	llvm_pmb = LLVMPassManagerBuilderCreate();
+	LLVMPassManagerBuilderSetOptLevel(llvm_pmb, compile_optlevel);
+
+	llvm_fpm = LLVMCreateFunctionPassManagerForModule(module);
+	LLVMPassManagerBuilderPopulateFunctionPassManager(llvm_pmb, llvm_fpm);
+
+	/* run function passes over each function */
+	LLVMInitializeFunctionPassManager(llvm_fpm);
+	for (func = LLVMGetFirstFunction(module);
+		 func != NULL;
+		 func = LLVMGetNextFunction(func))
+		LLVMRunFunctionPassManager(llvm_fpm, func);
+	LLVMFinalizeFunctionPassManager(llvm_fpm);
+	LLVMDisposePassManager(llvm_fpm);
+
+	/* and the module wide passes, which also inline the deform functions */
+	if (compile_optlevel > 0)
+	{
+		llvm_mpm = LLVMCreatePassManager();
+		LLVMPassManagerBuilderUseInlinerWithThreshold(llvm_pmb, 512);
+		LLVMPassManagerBuilderPopulateModulePassManager(llvm_pmb, llvm_mpm);
+		LLVMRunPassManager(llvm_mpm, module);
+		LLVMDisposePassManager(llvm_mpm);
+	}
+
+	LLVMPassManagerBuilderDispose(llvm_pmb);
+}
+
+LLVMValueRef
+l_ptr_const(void *ptr, LLVMTypeRef type)
+{
+	LLVMValueRef c = LLVMConstInt(TypeSizeT, (uintptr_t) ptr, false);
+
+	return LLVMConstIntToPtr(c, type);
+}
+
+LLVMValueRef
+l_int8_const(int8 i)
+{
+	return LLVMConstInt(LLVMInt8Type(), i, false);
+}
+
+LLVMValueRef
+l_int16_const(int16 i)
+{
+	return LLVMConstInt(LLVMInt16Type(), i, false);
+}
+
+LLVMValueRef
+l_int32_const(int32 i)
+{
+	return LLVMConstInt(LLVMInt32Type(), i, false);
+}
+
+LLVMValueRef
+l_int64_const(int64 i)
+{
+	return LLVMConstInt(LLVMInt64Type(), i, false);
+}
+
+LLVMValueRef
+l_sizet_const(size_t i)
+{
+	return LLVMConstInt(TypeSizeT, i, false);
+}
+
+/*
+ * Return a pointer of type fieldtype* to the field at byte offset `offset`
+ * of the struct `base` points to.
+ */
+LLVMValueRef
+l_field_ptr(LLVMBuilderRef b, LLVMValueRef base, size_t offset,
+			LLVMTypeRef fieldtype)
+{
+	LLVMValueRef v_base;
+	LLVMValueRef v_offset = l_sizet_const(offset);
+	LLVMValueRef v_ptr;
+
+	v_base = LLVMBuildPointerCast(b, base, TypeInt8Ptr, "");
+	v_ptr = LLVMBuildGEP2(b, LLVMInt8Type(), v_base, &v_offset, 1, "");
+
+	return LLVMBuildPointerCast(b, v_ptr, LLVMPointerType(fieldtype, 0), "");
+}
+
+/*
+ * Load the field at byte offset `offset` of the struct `base` points to.
+ */
+LLVMValueRef
+l_load_field(LLVMBuilderRef b, LLVMValueRef base, size_t offset,
+			 LLVMTypeRef fieldtype)
+{
+	return LLVMBuildLoad2(b, fieldtype,
+						  l_field_ptr(b, base, offset, fieldtype), "");
+}
+
+LLVMValueRef
+l_funcptr_const(void *fn, LLVMTypeRef fntype)
+{
+	return l_ptr_const(fn, LLVMPointerType(fntype, 0));
+}
@@ -0,0 +1,74 @@
+/*-------------------------------------------------------------------------
+ *
+ * llvmjit.h
+ *	  LLVM JIT provider.
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ *
+ * contrib/llvmjit/llvmjit.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef LLVMJIT_H
+#define LLVMJIT_H
+
+#include <llvm-c/Core.h>
+#include <llvm-c/ExecutionEngine.h>
+
+#include "jit/jit.h"
+#include "nodes/execnodes.h"
+#include "nodes/pg_list.h"
+#include "utils/memutils.h"
+
+
+typedef struct LLVMJitContext
+{
+	JitContext	base;
+
+	/* number of modules created */
+	size_t		module_generation;
+
+	/* execution engines, each owning one compiled module */
+	List	   *engines;
+
+	/* releases the engines together with the query's memory */
+	MemoryContextCallback release_cb;
+} LLVMJitContext;
+
+
+/* types used for generated code, set up by llvm_session_initialize() */
+extern LLVMTypeRef TypeSizeT;
+extern LLVMTypeRef TypeDatum;
+extern LLVMTypeRef TypeStorageBool;
+extern LLVMTypeRef TypeInt8Ptr;
+extern LLVMTypeRef TypePGFunction;
+extern LLVMTypeRef TypeSlotGetSomeAttrs;
+
+
+extern void _PG_jit_provider_init(JitProviderCallbacks *cb);
+
+extern LLVMJitContext *llvm_create_context(EState *estate);
+extern LLVMModuleRef llvm_mutable_module(LLVMJitContext *context,
+					char **name);
+extern void *llvm_get_function(LLVMJitContext *context, LLVMModuleRef module,
+				  const char *funcname);
+
+extern bool llvm_compile_expr(struct ExprProgram *program,
+				  struct EState *estate);
+extern LLVMValueRef slot_compile_deform(LLVMModuleRef module,
+					const char *funcname, TupleDesc desc, int natts);
+
+/* helpers for emitting code */
+extern LLVMValueRef l_ptr_const(void *ptr, LLVMTypeRef type);
+extern LLVMValueRef l_int8_const(int8 i);
+extern LLVMValueRef l_int16_const(int16 i);
+extern LLVMValueRef l_int32_const(int32 i);
+extern LLVMValueRef l_int64_const(int64 i);
+extern LLVMValueRef l_sizet_const(size_t i);
+extern LLVMValueRef l_field_ptr(LLVMBuilderRef b, LLVMValueRef base,
+			size_t offset, LLVMTypeRef fieldtype);
+extern LLVMValueRef l_load_field(LLVMBuilderRef b, LLVMValueRef base,
+			 size_t offset, LLVMTypeRef fieldtype);
+extern LLVMValueRef l_funcptr_const(void *fn, LLVMTypeRef fntype);
+
+#endif   /* LLVMJIT_H */
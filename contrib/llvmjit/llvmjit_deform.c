@@ -0,0 +1,432 @@
+/*-------------------------------------------------------------------------
+ *
+ * llvmjit_deform.c
+ *	  Generate code for deforming a heap tuple.
+ *
+ * This gains performance benefits over unJITed deforming from compile-time
+ * knowledge of the tuple descriptor.  Fixed column widths, NOT NULLness,
+ * alignment and byval-ness are known for every column, so only the offsets
+ * after variable length or nullable columns have to be computed at run time.
+ *
+ * The generated function deforms the first natts columns of a slot.  It
+ * falls back to slot_getsomeattrs() if the slot has already been partially
+ * deformed, has a different descriptor, or its tuple has fewer columns than
+ * requested, so it's always safe to call.
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ *
+ * IDENTIFICATION
+ *	  contrib/llvmjit/llvmjit_deform.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "access/htup_details.h"
+#include "access/tupdesc.h"
+#include "executor/tuptable.h"
+#include "llvmjit.h"
+
+
+static int	typalign_bytes(char attalign);
+static size_t varsize_any(void *attptr);
+
+
+/*
+ * Emit a function `void funcname(TupleTableSlot *slot)` into module that
+ * deforms the first natts columns of slots with descriptor desc.
+ */
+LLVMValueRef
+slot_compile_deform(LLVMModuleRef module, const char *funcname,
+					TupleDesc desc, int natts)
+{
+	LLVMBuilderRef b;
+	LLVMTypeRef deform_sig;
+	LLVMTypeRef size_sig;
+	LLVMTypeRef TypeLong = LLVMIntType(sizeof(long) * 8);
+	LLVMValueRef v_deform_fn;
+	LLVMBasicBlockRef b_entry;
+	LLVMBasicBlockRef b_check;
+	LLVMBasicBlockRef b_checknatts;
+	LLVMBasicBlockRef b_fallback;
+	LLVMBasicBlockRef b_deform;
+	LLVMBasicBlockRef b_finish;
+	LLVMBasicBlockRef b_done;
+	LLVMBasicBlockRef *attcheckblocks;
+	LLVMBasicBlockRef *attnullblocks;
+	LLVMBasicBlockRef *attfetchblocks;
+	LLVMValueRef v_slot;
+	LLVMValueRef v_offp;
+	LLVMValueRef v_nvalid;
+	LLVMValueRef v_desc;
+	LLVMValueRef v_tuplep;
+	LLVMValueRef v_tupdata;
+	LLVMValueRef v_infomask;
+	LLVMValueRef v_infomask2;
+	LLVMValueRef v_hasnulls;
+	LLVMValueRef v_hoff;
+	LLVMValueRef v_bits;
+	LLVMValueRef v_data;
+	LLVMValueRef v_values;
+	LLVMValueRef v_nulls;
+	LLVMValueRef v_cond;
+	LLVMValueRef v_args[2];
+	int			known_off = 0;
+	int			attnum;
+
+	Assert(natts > 0 && natts <= desc->natts);
+
+	b = LLVMCreateBuilder();
+
+	deform_sig = LLVMFunctionType(LLVMVoidType(), &TypeInt8Ptr, 1, false);
+	size_sig = LLVMFunctionType(TypeSizeT, &TypeInt8Ptr, 1, false);
+
+	v_deform_fn = LLVMAddFunction(module, funcname, deform_sig);
+	LLVMSetLinkage(v_deform_fn, LLVMInternalLinkage);
+
+	b_entry = LLVMAppendBasicBlock(v_deform_fn, "entry");
+	b_check = LLVMAppendBasicBlock(v_deform_fn, "check");
+	b_checknatts = LLVMAppendBasicBlock(v_deform_fn, "checknatts");
+	b_fallback = LLVMAppendBasicBlock(v_deform_fn, "fallback");
+	b_deform = LLVMAppendBasicBlock(v_deform_fn, "deform");
+
+	attcheckblocks = palloc(sizeof(LLVMBasicBlockRef) * natts);
+	attnullblocks = palloc(sizeof(LLVMBasicBlockRef) * natts);
+	attfetchblocks = palloc(sizeof(LLVMBasicBlockRef) * natts);
+	for (attnum = 0; attnum < natts; attnum++)
+	{
+		attcheckblocks[attnum] =
+			LLVMAppendBasicBlock(v_deform_fn, "block.attr.check");
+		attnullblocks[attnum] =
+			LLVMAppendBasicBlock(v_deform_fn, "block.attr.null");
+		attfetchblocks[attnum] =
+			LLVMAppendBasicBlock(v_deform_fn, "block.attr.fetch");
+	}
+
+	b_finish = LLVMAppendBasicBlock(v_deform_fn, "finish");
+	b_done = LLVMAppendBasicBlock(v_deform_fn, "done");
+
+	v_slot = LLVMGetParam(v_deform_fn, 0);
+
+	/* nothing to do if the columns have been deformed already */
+	LLVMPositionBuilderAtEnd(b, b_entry);
+	v_offp = LLVMBuildAlloca(b, TypeSizeT, "v_offp");
+	v_nvalid = l_load_field(b, v_slot, offsetof(TupleTableSlot, tts_nvalid),
+							LLVMInt32Type());
+	v_cond = LLVMBuildICmp(b, LLVMIntSGE, v_nvalid, l_int32_const(natts), "");
+	LLVMBuildCondBr(b, v_cond, b_done, b_check);
+
+	/* can we handle the tuple at all? */
+	LLVMPositionBuilderAtEnd(b, b_check);
+	v_desc = l_load_field(b, v_slot,
+						  offsetof(TupleTableSlot, tts_tupleDescriptor),
+						  TypeInt8Ptr);
+	v_tuplep = l_load_field(b, v_slot, offsetof(TupleTableSlot, tts_tuple),
+							TypeInt8Ptr);
+	v_cond = LLVMBuildOr(b,
+						 LLVMBuildICmp(b, LLVMIntNE, v_nvalid,
+									   l_int32_const(0), ""),
+						 LLVMBuildOr(b,
+									 LLVMBuildIsNull(b, v_tuplep, ""),
+									 LLVMBuildICmp(b, LLVMIntNE, v_desc,
+												   l_ptr_const(desc, TypeInt8Ptr),
+												   ""),
+									 ""),
+						 "");
+	LLVMBuildCondBr(b, v_cond, b_fallback, b_checknatts);
+
+	LLVMPositionBuilderAtEnd(b, b_checknatts);
+	v_tupdata = l_load_field(b, v_tuplep, offsetof(HeapTupleData, t_data),
+							 TypeInt8Ptr);
+	v_infomask2 = l_load_field(b, v_tupdata,
+							   offsetof(HeapTupleHeaderData, t_infomask2),
+							   LLVMInt16Type());
+	v_cond = LLVMBuildICmp(b, LLVMIntULT,
+						   LLVMBuildAnd(b, v_infomask2,
+										l_int16_const(HEAP_NATTS_MASK), ""),
+						   l_int16_const(natts), "");
+	LLVMBuildCondBr(b, v_cond, b_fallback, b_deform);
+
+	/* let the regular code deal with anything unusual */
+	LLVMPositionBuilderAtEnd(b, b_fallback);
+	v_args[0] = v_slot;
+	v_args[1] = l_int32_const(natts);
+	LLVMBuildCall2(b, TypeSlotGetSomeAttrs,
+				   l_funcptr_const(slot_getsomeattrs, TypeSlotGetSomeAttrs),
+				   v_args, 2, "");
+	LLVMBuildRetVoid(b);
+
+	/* set up the deforming of the columns */
+	LLVMPositionBuilderAtEnd(b, b_deform);
+	v_infomask = l_load_field(b, v_tupdata,
+							  offsetof(HeapTupleHeaderData, t_infomask),
+							  LLVMInt16Type());
+	v_hasnulls = LLVMBuildICmp(b, LLVMIntNE,
+							   LLVMBuildAnd(b, v_infomask,
+											l_int16_const(HEAP_HASNULL), ""),
+							   l_int16_const(0), "hasnulls");
+	v_hoff = LLVMBuildZExt(b,
+						   l_load_field(b, v_tupdata,
+										offsetof(HeapTupleHeaderData, t_hoff),
+										LLVMInt8Type()),
+						   TypeSizeT, "");
+	v_bits = l_field_ptr(b, v_tupdata, offsetof(HeapTupleHeaderData, t_bits),
+						 LLVMInt8Type());
+	v_data = LLVMBuildGEP2(b, LLVMInt8Type(),
+						   LLVMBuildPointerCast(b, v_tupdata, TypeInt8Ptr, ""),
+						   &v_hoff, 1, "v_data");
+	v_values = l_load_field(b, v_slot, offsetof(TupleTableSlot, tts_values),
+							LLVMPointerType(TypeDatum, 0));
+	v_nulls = l_load_field(b, v_slot, offsetof(TupleTableSlot, tts_isnull),
+						   LLVMPointerType(TypeStorageBool, 0));
+	LLVMBuildStore(b, l_sizet_const(0), v_offp);
+	LLVMBuildBr(b, attcheckblocks[0]);
+
+	for (attnum = 0; attnum < natts; attnum++)
+	{
+		Form_pg_attribute att = desc->attrs[attnum];
+		LLVMBasicBlockRef b_next;
+		LLVMValueRef v_attnum = l_int32_const(attnum);
+		LLVMValueRef v_off;
+		LLVMValueRef v_attp;
+		LLVMValueRef v_value;
+		LLVMValueRef v_newoff;
+		int			alignto = typalign_bytes(att->attalign);
+		int			aligned_off = -1;
+
+		b_next = (attnum + 1 < natts) ? attcheckblocks[attnum + 1] : b_finish;
+
+		/*
+		 * Check the null bitmap, unless the column can't be NULL.
+		 */
+		LLVMPositionBuilderAtEnd(b, attcheckblocks[attnum]);
+		if (known_off >= 0)
+			LLVMBuildStore(b, l_sizet_const(known_off), v_offp);
+		if (att->attnotnull)
+		{
+			LLVMBuildBr(b, attfetchblocks[attnum]);
+		}
+		else
+		{
+			LLVMValueRef v_byteno = l_int32_const(attnum >> 3);
+			LLVMValueRef v_byte;
+			LLVMValueRef v_bitnull;
+
+			v_byte = LLVMBuildLoad2(b, LLVMInt8Type(),
+									LLVMBuildGEP2(b, LLVMInt8Type(), v_bits,
+												  &v_byteno, 1, ""),
+									"");
+			v_bitnull = LLVMBuildICmp(b, LLVMIntEQ,
+									  LLVMBuildAnd(b, v_byte,
+												   l_int8_const(1 << (attnum & 0x07)),
+												   ""),
+									  l_int8_const(0), "");
+			v_cond = LLVMBuildAnd(b, v_hasnulls, v_bitnull, "attisnull");
+			LLVMBuildCondBr(b, v_cond, attnullblocks[attnum],
+							attfetchblocks[attnum]);
+		}
+
+		LLVMPositionBuilderAtEnd(b, attnullblocks[attnum]);
+		if (att->attnotnull)
+		{
+			LLVMBuildUnreachable(b);
+		}
+		else
+		{
+			LLVMBuildStore(b, LLVMConstInt(TypeDatum, 0, false),
+						   LLVMBuildGEP2(b, TypeDatum, v_values,
+										 &v_attnum, 1, ""));
+			LLVMBuildStore(b, LLVMConstInt(TypeStorageBool, 1, false),
+						   LLVMBuildGEP2(b, TypeStorageBool, v_nulls,
+										 &v_attnum, 1, ""));
+			LLVMBuildBr(b, b_next);
+		}
+
+		/*
+		 * Compute the offset of the column.  If all previous columns are
+		 * fixed width and NOT NULL, it's a compile time constant; a varlena
+		 * column may still start at a padding byte, though.
+		 */
+		LLVMPositionBuilderAtEnd(b, attfetchblocks[attnum]);
+		if (known_off >= 0)
+		{
+			aligned_off = TYPEALIGN(alignto, known_off);
+
+			if (att->attlen == -1 && aligned_off != known_off)
+			{
+				LLVMValueRef v_knownoff = l_sizet_const(known_off);
+				LLVMValueRef v_padbyte;
+
+				v_padbyte = LLVMBuildLoad2(b, LLVMInt8Type(),
+										   LLVMBuildGEP2(b, LLVMInt8Type(),
+														 v_data, &v_knownoff,
+														 1, ""),
+										   "");
+				v_off = LLVMBuildSelect(b,
+										LLVMBuildICmp(b, LLVMIntNE, v_padbyte,
+													  l_int8_const(0), ""),
+										v_knownoff,
+										l_sizet_const(aligned_off), "");
+				aligned_off = -1;
+			}
+			else
+			{
+				v_off = l_sizet_const(aligned_off);
+			}
+		}
+		else
+		{
+			v_off = LLVMBuildLoad2(b, TypeSizeT, v_offp, "");
+
+			if (alignto > 1)
+			{
+				LLVMValueRef v_aligned;
+
+				v_aligned = LLVMBuildAnd(b,
+										 LLVMBuildAdd(b, v_off,
+													  l_sizet_const(alignto - 1),
+													  ""),
+										 l_sizet_const(~((size_t) alignto - 1)),
+										 "");
+
+				if (att->attlen == -1)
+				{
+					LLVMValueRef v_padbyte;
+
+					/* no alignment if the column starts with a short header */
+					v_padbyte = LLVMBuildLoad2(b, LLVMInt8Type(),
+											   LLVMBuildGEP2(b, LLVMInt8Type(),
+															 v_data, &v_off,
+															 1, ""),
+											   "");
+					v_off = LLVMBuildSelect(b,
+											LLVMBuildICmp(b, LLVMIntNE,
+														  v_padbyte,
+														  l_int8_const(0), ""),
+											v_off, v_aligned, "");
+				}
+				else
+					v_off = v_aligned;
+			}
+		}
+
+		v_attp = LLVMBuildGEP2(b, LLVMInt8Type(), v_data, &v_off, 1, "");
+
+		/* fetch the value, the same way fetch_att() does */
+		if (att->attbyval)
+		{
+			LLVMTypeRef vartype = LLVMIntType(att->attlen * 8);
+			LLVMValueRef v_load;
+
+			v_load = LLVMBuildLoad2(b, vartype,
+									LLVMBuildPointerCast(b, v_attp,
+														 LLVMPointerType(vartype, 0),
+														 ""),
+									"");
+			LLVMSetAlignment(v_load, alignto);
+
+			if (att->attlen * 8 < sizeof(Datum) * 8)
+				v_value = LLVMBuildSExt(b, v_load, TypeDatum, "");
+			else
+				v_value = v_load;
+		}
+		else
+		{
+			v_value = LLVMBuildPtrToInt(b, v_attp, TypeDatum, "");
+		}
+
+		LLVMBuildStore(b, v_value,
+					   LLVMBuildGEP2(b, TypeDatum, v_values,
+									 &v_attnum, 1, ""));
+		LLVMBuildStore(b, LLVMConstInt(TypeStorageBool, 0, false),
+					   LLVMBuildGEP2(b, TypeStorageBool, v_nulls,
+									 &v_attnum, 1, ""));
+
+		/* and advance past it, the same way att_addlength_pointer() does */
+		if (att->attlen > 0)
+		{
+			v_newoff = LLVMBuildAdd(b, v_off, l_sizet_const(att->attlen), "");
+		}
+		else if (att->attlen == -1)
+		{
+			v_newoff = LLVMBuildAdd(b, v_off,
+									LLVMBuildCall2(b, size_sig,
+												   l_funcptr_const(varsize_any,
+																   size_sig),
+												   &v_attp, 1, ""),
+									"");
+		}
+		else
+		{
+			Assert(att->attlen == -2);
+			v_newoff = LLVMBuildAdd(b, v_off,
+									LLVMBuildAdd(b,
+												 LLVMBuildCall2(b, size_sig,
+																l_funcptr_const(strlen,
+																				size_sig),
+																&v_attp, 1, ""),
+												 l_sizet_const(1), ""),
+									"");
+		}
+		LLVMBuildStore(b, v_newoff, v_offp);
+
+		/*
+		 * The offset of the next column is known as long as this one has a
+		 * known offset, a fixed width, and can't be NULL.
+		 */
+		if (aligned_off >= 0 && att->attlen > 0 && att->attnotnull)
+			known_off = aligned_off + att->attlen;
+		else
+			known_off = -1;
+
+		LLVMBuildBr(b, b_next);
+	}
+
+	/* remember how far we got, like slot_deform_tuple() */
+	LLVMPositionBuilderAtEnd(b, b_finish);
+	LLVMBuildStore(b, l_int32_const(natts),
+				   l_field_ptr(b, v_slot, offsetof(TupleTableSlot, tts_nvalid),
+							   LLVMInt32Type()));
+	LLVMBuildStore(b,
+				   LLVMBuildZExt(b,
+								 LLVMBuildLoad2(b, TypeSizeT, v_offp, ""),
+								 TypeLong, ""),
+				   l_field_ptr(b, v_slot, offsetof(TupleTableSlot, tts_off),
+							   TypeLong));
+	LLVMBuildStore(b, LLVMConstInt(TypeStorageBool, 1, false),
+				   l_field_ptr(b, v_slot, offsetof(TupleTableSlot, tts_slow),
+							   TypeStorageBool));
+	LLVMBuildRetVoid(b);
+
+	LLVMPositionBuilderAtEnd(b, b_done);
+	LLVMBuildRetVoid(b);
+
+	LLVMDisposeBuilder(b);
+
+	return v_deform_fn;
+}
+
+static int
+typalign_bytes(char attalign)
+{
+	switch (attalign)
+	{
+		case 'c':
+			return 1;
+		case 's':
+			return ALIGNOF_SHORT;
+		case 'i':
+			return ALIGNOF_INT;
+		case 'd':
+			return ALIGNOF_DOUBLE;
+		default:
+			elog(ERROR, "unknown alignment: %c", attalign);
+			return 0;			/* keep compiler quiet */
+	}
+}
+
+static size_t
+varsize_any(void *attptr)
+{
+	return VARSIZE_ANY(attptr);
+}
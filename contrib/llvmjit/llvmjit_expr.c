@@ -0,0 +1,600 @@
+/*-------------------------------------------------------------------------
+ *
+ * llvmjit_expr.c
+ *	  JIT compile expression programs.
+ *
+ * Each step of an ExprProgram becomes a basic block of a native function.
+ * The addresses of the step's result, of its FunctionCallInfoData and of the
+ * called function are baked into the code as constants, so neither the
+ * steps nor the dispatch are looked at at run time.  The slots the program
+ * reads from are deformed with code generated for their tuple descriptor.
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ *
+ * IDENTIFICATION
+ *	  contrib/llvmjit/llvmjit_expr.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "executor/execProgram.h"
+#include "llvmjit.h"
+#include "pgstat.h"
+#include "portability/instr_time.h"
+
+
+/* where the slots an EEP_*_SLOT refers to are in the ExprContext */
+static const size_t slot_offsets[EEP_NUM_SLOTS] = {
+	offsetof(ExprContext, ecxt_scantuple),
+	offsetof(ExprContext, ecxt_innertuple),
+	offsetof(ExprContext, ecxt_outertuple)
+};
+
+static void build_store_result(LLVMBuilderRef b, ExprProgramStep *op,
+				   LLVMValueRef v_value, LLVMValueRef v_isnull);
+static void build_store_null(LLVMBuilderRef b, ExprProgramStep *op);
+static void build_func_call(LLVMBuilderRef b, ExprProgramStep *op,
+				LLVMValueRef v_fcusage);
+static void build_strict_checks(LLVMBuilderRef b, ExprProgramStep *op,
+					LLVMBasicBlockRef b_null);
+static LLVMValueRef build_datum_to_bool(LLVMBuilderRef b, LLVMValueRef v);
+static LLVMValueRef l_bool_ptr_const(bool *ptr);
+static LLVMValueRef l_datum_ptr_const(Datum *ptr);
+
+
+/*
+ * Compile `program` to native code and make it the program's evalfunc.
+ *
+ * Returns false if the program has to be interpreted.
+ */
+bool
+llvm_compile_expr(ExprProgram *program, EState *estate)
+{
+	LLVMJitContext *context;
+	LLVMModuleRef mod;
+	LLVMBuilderRef b;
+	LLVMTypeRef eval_sig;
+	LLVMTypeRef deform_sig;
+	LLVMTypeRef param_types[3];
+	LLVMValueRef eval_fn;
+	LLVMBasicBlockRef entry;
+	LLVMBasicBlockRef *opblocks;
+	LLVMValueRef v_econtext;
+	LLVMValueRef v_isnullp;
+	LLVMValueRef v_fcusage = NULL;
+	LLVMValueRef v_values[EEP_NUM_SLOTS];
+	LLVMValueRef v_nulls[EEP_NUM_SLOTS];
+	char	   *modname;
+	char	   *funcname;
+	void	   *code;
+	instr_time	starttime;
+	instr_time	endtime;
+	int			i;
+
+	context = llvm_create_context(estate);
+
+	INSTR_TIME_SET_CURRENT(starttime);
+
+	mod = llvm_mutable_module(context, &modname);
+	b = LLVMCreateBuilder();
+
+	/* Datum evalexpr(ExprProgram *program, ExprContext *econtext, bool *isNull) */
+	param_types[0] = TypeInt8Ptr;
+	param_types[1] = TypeInt8Ptr;
+	param_types[2] = TypeInt8Ptr;
+	eval_sig = LLVMFunctionType(TypeDatum, param_types, 3, false);
+	deform_sig = LLVMFunctionType(LLVMVoidType(), &TypeInt8Ptr, 1, false);
+
+	funcname = psprintf("%s_evalexpr", modname);
+	eval_fn = LLVMAddFunction(mod, funcname, eval_sig);
+	LLVMSetLinkage(eval_fn, LLVMExternalLinkage);
+
+	entry = LLVMAppendBasicBlock(eval_fn, "entry");
+
+	opblocks = palloc(sizeof(LLVMBasicBlockRef) * program->nsteps);
+	for (i = 0; i < program->nsteps; i++)
+		opblocks[i] = LLVMAppendBasicBlock(eval_fn, "b.op.start");
+
+	v_econtext = LLVMGetParam(eval_fn, 1);
+	v_isnullp = LLVMGetParam(eval_fn, 2);
+
+	LLVMPositionBuilderAtEnd(b, entry);
+
+	for (i = 0; i < program->nsteps; i++)
+	{
+		if (program->steps[i].opcode == EEOP_FUNCEXPR_FUSAGE)
+		{
+			v_fcusage = LLVMBuildAlloca(b,
+										LLVMArrayType(LLVMInt8Type(),
+													  sizeof(PgStat_FunctionCallUsage)),
+										"fcusage");
+			LLVMSetAlignment(v_fcusage, MAXIMUM_ALIGNOF);
+			v_fcusage = LLVMBuildPointerCast(b, v_fcusage, TypeInt8Ptr, "");
+			break;
+		}
+	}
+
+	/* deform everything the program needs at once */
+	for (i = 0; i < EEP_NUM_SLOTS; i++)
+	{
+		int			natts = program->last_attnum[i];
+		LLVMValueRef v_slot;
+
+		v_values[i] = NULL;
+		v_nulls[i] = NULL;
+
+		if (natts <= 0)
+			continue;
+
+		v_slot = l_load_field(b, v_econtext, slot_offsets[i], TypeInt8Ptr);
+
+		if ((context->base.flags & PGJIT_DEFORM) && program->last_desc[i])
+		{
+			LLVMValueRef v_deform;
+
+			v_deform = slot_compile_deform(mod,
+										   psprintf("%s_deform_%d",
+													modname, i),
+										   program->last_desc[i], natts);
+			LLVMBuildCall2(b, deform_sig, v_deform, &v_slot, 1, "");
+		}
+		else
+		{
+			LLVMValueRef v_args[2];
+
+			v_args[0] = v_slot;
+			v_args[1] = l_int32_const(natts);
+			LLVMBuildCall2(b, TypeSlotGetSomeAttrs,
+						   l_funcptr_const(slot_getsomeattrs,
+										   TypeSlotGetSomeAttrs),
+						   v_args, 2, "");
+		}
+
+		v_values[i] = l_load_field(b, v_slot,
+								   offsetof(TupleTableSlot, tts_values),
+								   LLVMPointerType(TypeDatum, 0));
+		v_nulls[i] = l_load_field(b, v_slot,
+								  offsetof(TupleTableSlot, tts_isnull),
+								  LLVMPointerType(TypeStorageBool, 0));
+	}
+
+	LLVMBuildBr(b, opblocks[0]);
+
+	for (i = 0; i < program->nsteps; i++)
+	{
+		ExprProgramStep *op = &program->steps[i];
+		LLVMBasicBlockRef b_next = (i + 1 < program->nsteps) ?
+		opblocks[i + 1] : NULL;
+
+		LLVMPositionBuilderAtEnd(b, opblocks[i]);
+
+		switch ((ExprProgramOpcode) op->opcode)
+		{
+			case EEOP_DONE:
+				{
+					LLVMValueRef v_value;
+					LLVMValueRef v_isnull;
+
+					v_value = LLVMBuildLoad2(b, TypeDatum,
+											 l_datum_ptr_const(&program->resvalue),
+											 "");
+					v_isnull = LLVMBuildLoad2(b, TypeStorageBool,
+											  l_bool_ptr_const(&program->resnull),
+											  "");
+					LLVMBuildStore(b, v_isnull,
+								   LLVMBuildPointerCast(b, v_isnullp,
+														LLVMPointerType(TypeStorageBool, 0),
+														""));
+					LLVMBuildRet(b, v_value);
+					break;
+				}
+
+			case EEOP_VAR:
+				{
+					int			slotno = op->d.var.slot;
+					LLVMValueRef v_attnum = l_int32_const(op->d.var.attnum);
+					LLVMValueRef v_value;
+					LLVMValueRef v_isnull;
+
+					Assert(v_values[slotno] != NULL);
+					v_value = LLVMBuildLoad2(b, TypeDatum,
+											 LLVMBuildGEP2(b, TypeDatum,
+														   v_values[slotno],
+														   &v_attnum, 1, ""),
+											 "");
+					v_isnull = LLVMBuildLoad2(b, TypeStorageBool,
+											  LLVMBuildGEP2(b, TypeStorageBool,
+															v_nulls[slotno],
+															&v_attnum, 1, ""),
+											  "");
+					build_store_result(b, op, v_value, v_isnull);
+					LLVMBuildBr(b, b_next);
+					break;
+				}
+
+			case EEOP_CONST:
+				build_store_result(b, op,
+								   LLVMConstInt(TypeDatum,
+												op->d.constval.value, false),
+								   LLVMConstInt(TypeStorageBool,
+												op->d.constval.isnull, false));
+				LLVMBuildBr(b, b_next);
+				break;
+
+			case EEOP_FUNCEXPR:
+				build_func_call(b, op, NULL);
+				LLVMBuildBr(b, b_next);
+				break;
+
+			case EEOP_FUNCEXPR_STRICT:
+			case EEOP_FUNCEXPR_FUSAGE:
+				{
+					LLVMBasicBlockRef b_null;
+
+					b_null = LLVMInsertBasicBlock(b_next, "b.op.argnull");
+					if (op->opcode == EEOP_FUNCEXPR_STRICT ||
+						op->d.func.finfo->fn_strict)
+						build_strict_checks(b, op, b_null);
+					build_func_call(b, op,
+									op->opcode == EEOP_FUNCEXPR_FUSAGE ?
+									v_fcusage : NULL);
+					LLVMBuildBr(b, b_next);
+
+					LLVMPositionBuilderAtEnd(b, b_null);
+					build_store_null(b, op);
+					LLVMBuildBr(b, b_next);
+					break;
+				}
+
+			case EEOP_FUNCEXPR_STRICT_VARS:
+				{
+					FunctionCallInfo fcinfo = op->d.func.fcinfo;
+					LLVMBasicBlockRef b_null;
+					int			n;
+
+					b_null = LLVMInsertBasicBlock(b_next, "b.op.argnull");
+
+					for (n = 0; n < op->d.func.nvars; n++)
+					{
+						ExprProgramVarArg *var = &op->d.func.vars[n];
+						LLVMValueRef v_attnum = l_int32_const(var->attnum);
+						LLVMValueRef v_isnull;
+						LLVMValueRef v_value;
+						LLVMBasicBlockRef b_notnull;
+
+						Assert(v_values[var->slot] != NULL);
+						b_notnull = LLVMInsertBasicBlock(b_null,
+														 "b.op.argnotnull");
+						v_isnull = LLVMBuildLoad2(b, TypeStorageBool,
+												  LLVMBuildGEP2(b, TypeStorageBool,
+																v_nulls[var->slot],
+																&v_attnum, 1, ""),
+												  "");
+						LLVMBuildCondBr(b,
+										LLVMBuildICmp(b, LLVMIntNE, v_isnull,
+													  l_int8_const(0), ""),
+										b_null, b_notnull);
+
+						LLVMPositionBuilderAtEnd(b, b_notnull);
+						v_value = LLVMBuildLoad2(b, TypeDatum,
+												 LLVMBuildGEP2(b, TypeDatum,
+															   v_values[var->slot],
+															   &v_attnum, 1, ""),
+												 "");
+						LLVMBuildStore(b, v_value,
+									   l_datum_ptr_const(&fcinfo->arg[var->argno]));
+					}
+					build_func_call(b, op, NULL);
+					LLVMBuildBr(b, b_next);
+
+					LLVMPositionBuilderAtEnd(b, b_null);
+					build_store_null(b, op);
+					LLVMBuildBr(b, b_next);
+					break;
+				}
+
+			case EEOP_BOOL_AND_STEP_FIRST:
+			case EEOP_BOOL_AND_STEP:
+			case EEOP_BOOL_OR_STEP_FIRST:
+			case EEOP_BOOL_OR_STEP:
+				{
+					bool		isand;
+					LLVMValueRef v_anynullp;
+					LLVMValueRef v_isnull;
+					LLVMValueRef v_value;
+					LLVMBasicBlockRef b_isnull;
+					LLVMBasicBlockRef b_notnull;
+
+					isand = (op->opcode == EEOP_BOOL_AND_STEP_FIRST ||
+							 op->opcode == EEOP_BOOL_AND_STEP);
+					v_anynullp = l_bool_ptr_const(op->d.boolexpr.anynull);
+
+					if (op->opcode == EEOP_BOOL_AND_STEP_FIRST ||
+						op->opcode == EEOP_BOOL_OR_STEP_FIRST)
+						LLVMBuildStore(b, l_int8_const(0), v_anynullp);
+
+					b_isnull = LLVMInsertBasicBlock(b_next, "b.op.isnull");
+					b_notnull = LLVMInsertBasicBlock(b_next, "b.op.notnull");
+
+					v_isnull = LLVMBuildLoad2(b, TypeStorageBool,
+											  l_bool_ptr_const(op->resnull), "");
+					LLVMBuildCondBr(b,
+									LLVMBuildICmp(b, LLVMIntNE, v_isnull,
+												  l_int8_const(0), ""),
+									b_isnull, b_notnull);
+
+					LLVMPositionBuilderAtEnd(b, b_isnull);
+					LLVMBuildStore(b, l_int8_const(1), v_anynullp);
+					LLVMBuildBr(b, b_next);
+
+					/* the result is known once an input is FALSE (TRUE) */
+					LLVMPositionBuilderAtEnd(b, b_notnull);
+					v_value = build_datum_to_bool(b,
+												  LLVMBuildLoad2(b, TypeDatum,
+																 l_datum_ptr_const(op->resvalue),
+																 ""));
+					if (isand)
+						LLVMBuildCondBr(b, v_value, b_next,
+										opblocks[op->d.boolexpr.jumpdone]);
+					else
+						LLVMBuildCondBr(b, v_value,
+										opblocks[op->d.boolexpr.jumpdone],
+										b_next);
+					break;
+				}
+
+			case EEOP_BOOL_AND_STEP_LAST:
+			case EEOP_BOOL_OR_STEP_LAST:
+				{
+					bool		isand = (op->opcode == EEOP_BOOL_AND_STEP_LAST);
+					LLVMValueRef v_isnull;
+					LLVMValueRef v_value;
+					LLVMValueRef v_anynull;
+					LLVMBasicBlockRef b_notnull;
+					LLVMBasicBlockRef b_checkanynull;
+					LLVMBasicBlockRef b_setnull;
+
+					b_notnull = LLVMInsertBasicBlock(b_next, "b.op.notnull");
+					b_checkanynull = LLVMInsertBasicBlock(b_next,
+														  "b.op.checkanynull");
+					b_setnull = LLVMInsertBasicBlock(b_next, "b.op.setnull");
+
+					/* a NULL input leaves the result NULL */
+					v_isnull = LLVMBuildLoad2(b, TypeStorageBool,
+											  l_bool_ptr_const(op->resnull), "");
+					LLVMBuildCondBr(b,
+									LLVMBuildICmp(b, LLVMIntNE, v_isnull,
+												  l_int8_const(0), ""),
+									b_next, b_notnull);
+
+					/* so does a FALSE (TRUE) input */
+					LLVMPositionBuilderAtEnd(b, b_notnull);
+					v_value = build_datum_to_bool(b,
+												  LLVMBuildLoad2(b, TypeDatum,
+																 l_datum_ptr_const(op->resvalue),
+																 ""));
+					if (isand)
+						LLVMBuildCondBr(b, v_value, b_checkanynull, b_next);
+					else
+						LLVMBuildCondBr(b, v_value, b_next, b_checkanynull);
+
+					/* otherwise, any NULL input makes the result NULL */
+					LLVMPositionBuilderAtEnd(b, b_checkanynull);
+					v_anynull = LLVMBuildLoad2(b, TypeStorageBool,
+											   l_bool_ptr_const(op->d.boolexpr.anynull),
+											   "");
+					LLVMBuildCondBr(b,
+									LLVMBuildICmp(b, LLVMIntNE, v_anynull,
+												  l_int8_const(0), ""),
+									b_setnull, b_next);
+
+					LLVMPositionBuilderAtEnd(b, b_setnull);
+					build_store_null(b, op);
+					LLVMBuildBr(b, b_next);
+					break;
+				}
+
+			case EEOP_BOOL_NOT:
+				{
+					LLVMValueRef v_isnull;
+					LLVMValueRef v_value;
+					LLVMBasicBlockRef b_notnull;
+
+					b_notnull = LLVMInsertBasicBlock(b_next, "b.op.notnull");
+
+					v_isnull = LLVMBuildLoad2(b, TypeStorageBool,
+											  l_bool_ptr_const(op->resnull), "");
+					LLVMBuildCondBr(b,
+									LLVMBuildICmp(b, LLVMIntNE, v_isnull,
+												  l_int8_const(0), ""),
+									b_next, b_notnull);
+
+					LLVMPositionBuilderAtEnd(b, b_notnull);
+					v_value = build_datum_to_bool(b,
+												  LLVMBuildLoad2(b, TypeDatum,
+																 l_datum_ptr_const(op->resvalue),
+																 ""));
+					v_value = LLVMBuildZExt(b, LLVMBuildNot(b, v_value, ""),
+											TypeDatum, "");
+					LLVMBuildStore(b, v_value, l_datum_ptr_const(op->resvalue));
+					LLVMBuildBr(b, b_next);
+					break;
+				}
+
+			case EEOP_EXPRSTATE:
+				{
+					LLVMTypeRef evalfunc_sig;
+					LLVMTypeRef evalfunc_params[4];
+					LLVMValueRef v_state;
+					LLVMValueRef v_evalfunc;
+					LLVMValueRef v_args[4];
+					LLVMValueRef v_value;
+
+					/* Datum evalfunc(ExprState *, ExprContext *, bool *, ExprDoneCond *) */
+					evalfunc_params[0] = TypeInt8Ptr;
+					evalfunc_params[1] = TypeInt8Ptr;
+					evalfunc_params[2] = TypeInt8Ptr;
+					evalfunc_params[3] = TypeInt8Ptr;
+					evalfunc_sig = LLVMFunctionType(TypeDatum, evalfunc_params,
+													4, false);
+
+					/* the evalfunc changes after the first call; load it */
+					v_state = l_ptr_const(op->d.exprstate.state, TypeInt8Ptr);
+					v_evalfunc = l_load_field(b, v_state,
+											  offsetof(ExprState, evalfunc),
+											  LLVMPointerType(evalfunc_sig, 0));
+
+					v_args[0] = v_state;
+					v_args[1] = v_econtext;
+					v_args[2] = l_ptr_const(op->resnull, TypeInt8Ptr);
+					v_args[3] = LLVMConstNull(TypeInt8Ptr);
+					v_value = LLVMBuildCall2(b, evalfunc_sig, v_evalfunc,
+											 v_args, 4, "");
+					LLVMBuildStore(b, v_value, l_datum_ptr_const(op->resvalue));
+					LLVMBuildBr(b, b_next);
+					break;
+				}
+
+			case EEOP_LAST:
+				elog(ERROR, "unrecognized expression program step: %d",
+					 (int) op->opcode);
+				break;
+		}
+	}
+
+	LLVMDisposeBuilder(b);
+
+	INSTR_TIME_SET_CURRENT(endtime);
+	INSTR_TIME_ACCUM_DIFF(context->base.generation_counter,
+						  endtime, starttime);
+
+	context->base.created_functions++;
+
+	code = llvm_get_function(context, mod, funcname);
+	program->evalfunc = (ExprProgramEvalFunc) code;
+
+	return true;
+}
+
+static void
+build_store_result(LLVMBuilderRef b, ExprProgramStep *op,
+				   LLVMValueRef v_value, LLVMValueRef v_isnull)
+{
+	LLVMBuildStore(b, v_value, l_datum_ptr_const(op->resvalue));
+	LLVMBuildStore(b, v_isnull, l_bool_ptr_const(op->resnull));
+}
+
+static void
+build_store_null(LLVMBuilderRef b, ExprProgramStep *op)
+{
+	build_store_result(b, op,
+					   LLVMConstInt(TypeDatum, 0, false),
+					   LLVMConstInt(TypeStorageBool, 1, false));
+}
+
+/*
+ * Call the step's function, tracking its usage in v_fcusage if not NULL.
+ */
+static void
+build_func_call(LLVMBuilderRef b, ExprProgramStep *op, LLVMValueRef v_fcusage)
+{
+	FunctionCallInfo fcinfo = op->d.func.fcinfo;
+	LLVMValueRef v_fcinfo = l_ptr_const(fcinfo, TypeInt8Ptr);
+	LLVMValueRef v_fcinfo_isnullp = l_bool_ptr_const(&fcinfo->isnull);
+	LLVMValueRef v_value;
+	LLVMValueRef v_isnull;
+
+	if (v_fcusage)
+	{
+		LLVMTypeRef init_sig;
+		LLVMTypeRef init_params[2];
+		LLVMValueRef v_args[2];
+
+		/* void pgstat_init_function_usage(FunctionCallInfoData *, PgStat_FunctionCallUsage *) */
+		init_params[0] = TypeInt8Ptr;
+		init_params[1] = TypeInt8Ptr;
+		init_sig = LLVMFunctionType(LLVMVoidType(), init_params, 2, false);
+
+		v_args[0] = v_fcinfo;
+		v_args[1] = v_fcusage;
+		LLVMBuildCall2(b, init_sig,
+					   l_funcptr_const(pgstat_init_function_usage, init_sig),
+					   v_args, 2, "");
+	}
+
+	LLVMBuildStore(b, l_int8_const(0), v_fcinfo_isnullp);
+	v_value = LLVMBuildCall2(b, TypePGFunction,
+							 l_funcptr_const(op->d.func.finfo->fn_addr,
+											 TypePGFunction),
+							 &v_fcinfo, 1, "");
+	v_isnull = LLVMBuildLoad2(b, TypeStorageBool, v_fcinfo_isnullp, "");
+	build_store_result(b, op, v_value, v_isnull);
+
+	if (v_fcusage)
+	{
+		LLVMTypeRef end_sig;
+		LLVMTypeRef end_params[2];
+		LLVMValueRef v_args[2];
+
+		/* void pgstat_end_function_usage(PgStat_FunctionCallUsage *, bool) */
+		end_params[0] = TypeInt8Ptr;
+		end_params[1] = TypeStorageBool;
+		end_sig = LLVMFunctionType(LLVMVoidType(), end_params, 2, false);
+
+		v_args[0] = v_fcusage;
+		v_args[1] = l_int8_const(1);
+		LLVMBuildCall2(b, end_sig,
+					   l_funcptr_const(pgstat_end_function_usage, end_sig),
+					   v_args, 2, "");
+	}
+}
+
+/*
+ * Branch to b_null if any argument of the step's function is NULL; leave the
+ * builder positioned where all of them have been found to be not NULL.
+ */
+static void
+build_strict_checks(LLVMBuilderRef b, ExprProgramStep *op,
+					LLVMBasicBlockRef b_null)
+{
+	FunctionCallInfo fcinfo = op->d.func.fcinfo;
+	int			argno;
+
+	for (argno = 0; argno < op->d.func.nargs; argno++)
+	{
+		LLVMBasicBlockRef b_notnull;
+		LLVMValueRef v_argnull;
+
+		b_notnull = LLVMInsertBasicBlock(b_null, "b.op.argnotnull");
+		v_argnull = LLVMBuildLoad2(b, TypeStorageBool,
+								   l_bool_ptr_const(&fcinfo->argnull[argno]),
+								   "");
+		LLVMBuildCondBr(b,
+						LLVMBuildICmp(b, LLVMIntNE, v_argnull,
+									  l_int8_const(0), ""),
+						b_null, b_notnull);
+		LLVMPositionBuilderAtEnd(b, b_notnull);
+	}
+}
+
+/* the equivalent of DatumGetBool(), as an i1 */
+static LLVMValueRef
+build_datum_to_bool(LLVMBuilderRef b, LLVMValueRef v)
+{
+	return LLVMBuildICmp(b, LLVMIntNE,
+						 LLVMBuildTrunc(b, v, TypeStorageBool, ""),
+						 l_int8_const(0), "");
+}
+
+static LLVMValueRef
+l_bool_ptr_const(bool *ptr)
+{
+	return l_ptr_const(ptr, LLVMPointerType(TypeStorageBool, 0));
+}
+
+static LLVMValueRef
+l_datum_ptr_const(Datum *ptr)
+{
+	return l_ptr_const(ptr, LLVMPointerType(TypeDatum, 0));
+}
@@ -62,10 +62,12 @@
 #include <unistd.h>
 
 #include "access/hash.h"
+#include "catalog/pg_type.h"
 #include "executor/instrument.h"
 #include "funcapi.h"
 #include "mb/pg_wchar.h"
 #include "miscadmin.h"
+#include "nodes/graphnodes.h"
 #include "parser/analyze.h"
 #include "parser/parsetree.h"
 #include "parser/scanner.h"
@@ -92,8 +94,13 @@ PG_MODULE_MAGIC;
  */
 #define PGSS_TEXT_FILE	PG_STAT_TMP_DIR "/pgss_query_texts.stat"
 
-/* Magic number identifying the stats file format */
-static const uint32 PGSS_FILE_HEADER = 0x20140125;
+/*
+ * Magic number identifying the stats file format.  It is a format version,
+ * bumped only when the layout of the saved entries changes (here, when the
+ * graph write counters were added to Counters); as upstream does, the new
+ * value is the date of that change.
+ */
+static const uint32 PGSS_FILE_HEADER = 0x20171019;
 
 /* PostgreSQL major version number, changes in which invalidate all entries */
 static const uint32 PGSS_PG_MAJOR_VERSION = PG_VERSION_NUM / 100;
@@ -117,7 +124,8 @@ typedef enum pgssVersion
 	PGSS_V1_0 = 0,
 	PGSS_V1_1,
 	PGSS_V1_2,
-	PGSS_V1_3
+	PGSS_V1_3,
+	PGSS_V1_5
 } pgssVersion;
 
 /*
@@ -155,6 +163,11 @@ typedef struct Counters
 	int64		temp_blks_written;		/* # of temp blocks written */
 	double		blk_read_time;	/* time spent reading, in msec */
 	double		blk_write_time; /* time spent writing, in msec */
+	int64		graph_insert_vertex;	/* # of vertices created */
+	int64		graph_insert_edge;		/* # of edges created */
+	int64		graph_delete_vertex;	/* # of vertices deleted */
+	int64		graph_delete_edge;		/* # of edges deleted */
+	int64		graph_update_property;	/* # of properties updated */
 	double		usage;			/* usage factor */
 } Counters;
 
@@ -279,6 +292,7 @@ void		_PG_init(void);
 void		_PG_fini(void);
 
 PG_FUNCTION_INFO_V1(pg_stat_statements_reset);
+PG_FUNCTION_INFO_V1(pg_stat_statements_1_5);
 PG_FUNCTION_INFO_V1(pg_stat_statements_1_2);
 PG_FUNCTION_INFO_V1(pg_stat_statements_1_3);
 PG_FUNCTION_INFO_V1(pg_stat_statements);
@@ -301,6 +315,7 @@ static uint32 pgss_hash_string(const char *str);
 static void pgss_store(const char *query, uint32 queryId,
 		   double total_time, uint64 rows,
 		   const BufferUsage *bufusage,
+		   const GraphWriteStats *graphwrstats,
 		   pgssJumbleState *jstate);
 static void pg_stat_statements_internal(FunctionCallInfo fcinfo,
 							pgssVersion api_version,
@@ -322,6 +337,8 @@ static void AppendJumble(pgssJumbleState *jstate,
 static void JumbleQuery(pgssJumbleState *jstate, Query *query);
 static void JumbleRangeTable(pgssJumbleState *jstate, List *rtable);
 static void JumbleExpr(pgssJumbleState *jstate, Node *node);
+static void JumbleGraphQuery(pgssJumbleState *jstate, Query *query);
+static void JumbleCypherKey(pgssJumbleState *jstate, Node *key);
 static void RecordConstLocation(pgssJumbleState *jstate, int location);
 static char *generate_normalized_query(pgssJumbleState *jstate, const char *query,
 						  int *query_len_p, int encoding);
@@ -825,6 +842,7 @@ pgss_post_parse_analyze(ParseState *pstate, Query *query)
 				   0,
 				   0,
 				   NULL,
+				   NULL,
 				   &jstate);
 }
 
@@ -929,6 +947,7 @@ pgss_ExecutorEnd(QueryDesc *queryDesc)
 				   queryDesc->totaltime->total * 1000.0,		/* convert to msec */
 				   queryDesc->estate->es_processed,
 				   &queryDesc->totaltime->bufusage,
+				   &queryDesc->estate->es_graphwrstats,
 				   NULL);
 	}
 
@@ -1039,6 +1058,7 @@ pgss_ProcessUtility(Node *parsetree, const char *queryString,
 				   INSTR_TIME_GET_MILLISEC(duration),
 				   rows,
 				   &bufusage,
+				   NULL,
 				   NULL);
 	}
 	else
@@ -1101,11 +1121,14 @@ pgss_hash_string(const char *str)
  * If jstate is not NULL then we're trying to create an entry for which
  * we have no statistics as yet; we just want to record the normalized
  * query string.  total_time, rows, bufusage are ignored in this case.
+ *
+ * graphwrstats may be NULL if the statement cannot write to a graph.
  */
 static void
 pgss_store(const char *query, uint32 queryId,
 		   double total_time, uint64 rows,
 		   const BufferUsage *bufusage,
+		   const GraphWriteStats *graphwrstats,
 		   pgssJumbleState *jstate)
 {
 	pgssHashKey key;
@@ -1250,6 +1273,21 @@ pgss_store(const char *query, uint32 queryId,
 		e->counters.temp_blks_written += bufusage->temp_blks_written;
 		e->counters.blk_read_time += INSTR_TIME_GET_MILLISEC(bufusage->blk_read_time);
 		e->counters.blk_write_time += INSTR_TIME_GET_MILLISEC(bufusage->blk_write_time);
+		if (graphwrstats)
+		{
+			/* UINT_MAX means that the statement does no such operation */
+			if (graphwrstats->insertVertex != UINT_MAX)
+				e->counters.graph_insert_vertex += graphwrstats->insertVertex;
+			if (graphwrstats->insertEdge != UINT_MAX)
+				e->counters.graph_insert_edge += graphwrstats->insertEdge;
+			if (graphwrstats->deleteVertex != UINT_MAX)
+				e->counters.graph_delete_vertex += graphwrstats->deleteVertex;
+			if (graphwrstats->deleteEdge != UINT_MAX)
+				e->counters.graph_delete_edge += graphwrstats->deleteEdge;
+			if (graphwrstats->updateProperty != UINT_MAX)
+				e->counters.graph_update_property +=
+					graphwrstats->updateProperty;
+		}
 		e->counters.usage += USAGE_EXEC(total_time);
 
 		SpinLockRelease(&e->mutex);
@@ -1282,7 +1320,8 @@ pg_stat_statements_reset(PG_FUNCTION_ARGS)
 #define PG_STAT_STATEMENTS_COLS_V1_1	18
 #define PG_STAT_STATEMENTS_COLS_V1_2	19
 #define PG_STAT_STATEMENTS_COLS_V1_3	23
-#define PG_STAT_STATEMENTS_COLS			23		/* maximum of above */
+#define PG_STAT_STATEMENTS_COLS_V1_5	28
+#define PG_STAT_STATEMENTS_COLS			28		/* maximum of above */
 
 /*
  * Retrieve statement statistics.
@@ -1294,6 +1333,16 @@ pg_stat_statements_reset(PG_FUNCTION_ARGS)
  * expected API version is identified by embedding it in the C name of the
  * function.  Unfortunately we weren't bright enough to do that for 1.1.
  */
+Datum
+pg_stat_statements_1_5(PG_FUNCTION_ARGS)
+{
+	bool		showtext = PG_GETARG_BOOL(0);
+
+	pg_stat_statements_internal(fcinfo, PGSS_V1_5, showtext);
+
+	return (Datum) 0;
+}
+
 Datum
 pg_stat_statements_1_3(PG_FUNCTION_ARGS)
 {
@@ -1397,6 +1446,10 @@ pg_stat_statements_internal(FunctionCallInfo fcinfo,
 			if (api_version != PGSS_V1_3)
 				elog(ERROR, "incorrect number of output arguments");
 			break;
+		case PG_STAT_STATEMENTS_COLS_V1_5:
+			if (api_version != PGSS_V1_5)
+				elog(ERROR, "incorrect number of output arguments");
+			break;
 		default:
 			elog(ERROR, "incorrect number of output arguments");
 	}
@@ -1593,11 +1646,20 @@ pg_stat_statements_internal(FunctionCallInfo fcinfo,
 			values[i++] = Float8GetDatumFast(tmp.blk_read_time);
 			values[i++] = Float8GetDatumFast(tmp.blk_write_time);
 		}
+		if (api_version >= PGSS_V1_5)
+		{
+			values[i++] = Int64GetDatumFast(tmp.graph_insert_vertex);
+			values[i++] = Int64GetDatumFast(tmp.graph_insert_edge);
+			values[i++] = Int64GetDatumFast(tmp.graph_delete_vertex);
+			values[i++] = Int64GetDatumFast(tmp.graph_delete_edge);
+			values[i++] = Int64GetDatumFast(tmp.graph_update_property);
+		}
 
 		Assert(i == (api_version == PGSS_V1_0 ? PG_STAT_STATEMENTS_COLS_V1_0 :
 					 api_version == PGSS_V1_1 ? PG_STAT_STATEMENTS_COLS_V1_1 :
 					 api_version == PGSS_V1_2 ? PG_STAT_STATEMENTS_COLS_V1_2 :
 					 api_version == PGSS_V1_3 ? PG_STAT_STATEMENTS_COLS_V1_3 :
+					 api_version == PGSS_V1_5 ? PG_STAT_STATEMENTS_COLS_V1_5 :
 					 -1 /* fail if you forget to update this assert */ ));
 
 		tuplestore_putvalues(tupstore, tupdesc, values, nulls);
@@ -2324,6 +2386,72 @@ JumbleQuery(pgssJumbleState *jstate, Query *query)
 	JumbleExpr(jstate, query->limitCount);
 	/* we ignore rowMarks */
 	JumbleExpr(jstate, query->setOperations);
+	JumbleGraphQuery(jstate, query);
+}
+
+/*
+ * Jumble the Cypher-specific parts of a query
+ *
+ * Only the shape of the graph pattern is significant.  Variable names are
+ * ignored because anonymous pattern elements get a fresh name from the
+ * parser on every parse analysis, which would otherwise make each execution
+ * of the same Cypher query look distinct.  Nothing is appended for plain SQL
+ * queries so that their query IDs are not affected.
+ */
+static void
+JumbleGraphQuery(pgssJumbleState *jstate, Query *query)
+{
+	if (query->dijkstraWeight > 0)
+	{
+		APP_JUMB(query->dijkstraWeight);
+		APP_JUMB(query->dijkstraWeightOut);
+		JumbleExpr(jstate, query->dijkstraEndId);
+		JumbleExpr(jstate, query->dijkstraEdgeId);
+		JumbleExpr(jstate, query->dijkstraSource);
+		JumbleExpr(jstate, query->dijkstraTarget);
+		JumbleExpr(jstate, query->dijkstraLimit);
+	}
+
+	if (query->graph.writeOp != GWROP_NONE)
+	{
+		APP_JUMB(query->graph.writeOp);
+		APP_JUMB(query->graph.last);
+		APP_JUMB(query->graph.detach);
+		APP_JUMB(query->graph.eager);
+		JumbleExpr(jstate, (Node *) query->graph.pattern);
+		JumbleExpr(jstate, (Node *) query->graph.targets);
+		JumbleExpr(jstate, (Node *) query->graph.exprs);
+		JumbleExpr(jstate, (Node *) query->graph.sets);
+		JumbleExpr(jstate, query->graph.mergepattern);
+	}
+}
+
+/*
+ * Jumble a property key of a Cypher map or access path
+ *
+ * The parser turns property names into text Consts without a location.
+ * Unlike user-supplied literals, they are part of the pattern structure
+ * (n.age and n.name must not be merged), so their values are jumbled.
+ */
+static void
+JumbleCypherKey(pgssJumbleState *jstate, Node *key)
+{
+	if (IsA(key, Const))
+	{
+		Const	   *c = (Const *) key;
+
+		if (c->consttype == TEXTOID && !c->constisnull && c->location < 0)
+		{
+			char	   *keystr = TextDatumGetCString(c->constvalue);
+
+			APP_JUMB(c->consttype);
+			APP_JUMB_STRING(keystr);
+			pfree(keystr);
+			return;
+		}
+	}
+
+	JumbleExpr(jstate, key);
 }
 
 /*
@@ -2760,6 +2888,12 @@ JumbleExpr(pgssJumbleState *jstate, Node *node)
 				APP_JUMB(lfirst_int(temp));
 			}
 			break;
+		case T_OidList:
+			foreach(temp, (List *) node)
+			{
+				APP_JUMB(lfirst_oid(temp));
+			}
+			break;
 		case T_SortGroupClause:
 			{
 				SortGroupClause *sgc = (SortGroupClause *) node;
@@ -2845,6 +2979,98 @@ JumbleExpr(pgssJumbleState *jstate, Node *node)
 				JumbleExpr(jstate, (Node *) err->arg);
 			}
 			break;
+		case T_CypherMapExpr:
+			{
+				CypherMapExpr *m = (CypherMapExpr *) node;
+				ListCell   *le;
+
+				/* keys and values alternate */
+				le = list_head(m->keyvals);
+				while (le != NULL)
+				{
+					JumbleCypherKey(jstate, (Node *) lfirst(le));
+					le = lnext(le);
+					JumbleExpr(jstate, (Node *) lfirst(le));
+					le = lnext(le);
+				}
+			}
+			break;
+		case T_CypherListExpr:
+			JumbleExpr(jstate, (Node *) ((CypherListExpr *) node)->elems);
+			break;
+		case T_CypherListCompExpr:
+			{
+				CypherListCompExpr *clc = (CypherListCompExpr *) node;
+
+				/* we ignore varname */
+				JumbleExpr(jstate, (Node *) clc->list);
+				JumbleExpr(jstate, (Node *) clc->cond);
+				JumbleExpr(jstate, (Node *) clc->elem);
+			}
+			break;
+		case T_CypherListCompVar:
+			/* only the NodeTag is significant */
+			break;
+		case T_CypherAccessExpr:
+			{
+				CypherAccessExpr *a = (CypherAccessExpr *) node;
+
+				JumbleExpr(jstate, (Node *) a->arg);
+				foreach(temp, a->path)
+				{
+					JumbleCypherKey(jstate, (Node *) lfirst(temp));
+				}
+			}
+			break;
+		case T_CypherIndices:
+			{
+				CypherIndices *cind = (CypherIndices *) node;
+
+				APP_JUMB(cind->is_slice);
+				JumbleExpr(jstate, cind->lidx);
+				JumbleExpr(jstate, cind->uidx);
+			}
+			break;
+		case T_GraphPath:
+			{
+				GraphPath  *gpath = (GraphPath *) node;
+
+				/* we ignore variable */
+				JumbleExpr(jstate, (Node *) gpath->chain);
+			}
+			break;
+		case T_GraphVertex:
+			{
+				GraphVertex *gvertex = (GraphVertex *) node;
+
+				APP_JUMB(gvertex->resno);
+				APP_JUMB(gvertex->create);
+				APP_JUMB(gvertex->relid);
+				JumbleExpr(jstate, gvertex->expr);
+				JumbleExpr(jstate, gvertex->qual);
+			}
+			break;
+		case T_GraphEdge:
+			{
+				GraphEdge  *gedge = (GraphEdge *) node;
+
+				APP_JUMB(gedge->direction);
+				APP_JUMB(gedge->resno);
+				APP_JUMB(gedge->relid);
+				JumbleExpr(jstate, gedge->expr);
+				JumbleExpr(jstate, gedge->qual);
+			}
+			break;
+		case T_GraphSetProp:
+			{
+				GraphSetProp *gsp = (GraphSetProp *) node;
+
+				/* we ignore variable */
+				APP_JUMB(gsp->kind);
+				JumbleExpr(jstate, gsp->elem);
+				JumbleExpr(jstate, gsp->expr);
+			}
+			break;
 		default:
 			/* Only a warning, since we can stumble along anyway */
 			elog(WARNING, "unrecognized node type: %d",
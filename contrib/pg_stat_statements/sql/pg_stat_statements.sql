@@ -0,0 +1,43 @@
+CREATE EXTENSION pg_stat_statements;
+
+CREATE GRAPH pgss;
+SET graph_path = pgss;
+CREATE VLABEL person;
+CREATE ELABEL knows;
+
+SELECT pg_stat_statements_reset();
+
+--
+-- graph writes
+--
+CREATE (:person {name: 'a', age: 1})-[:knows]->(:person {name: 'b', age: 2});
+CREATE (:person {name: 'c', age: 3});
+MATCH (n:person {name: 'c'}) SET n.age = 4;
+MATCH (:person {name: 'a'})-[r:knows]->() DELETE r;
+MATCH (n:person {name: 'c'}) DELETE n;
+
+--
+-- queries that differ only in constants share an entry
+--
+MATCH (n:person {name: 'a'}) RETURN n.age;
+MATCH (n:person {name: 'b'}) RETURN n.age;
+MATCH (n:person) WHERE n.age > 1 RETURN count(*);
+MATCH (n:person) WHERE n.age > 2 RETURN count(*);
+
+--
+-- queries with a different pattern shape don't
+--
+MATCH (a:person)-[:knows]->(b:person) RETURN count(*);
+MATCH (a:person)<-[:knows]-(b:person) RETURN count(*);
+MATCH (a:person)-[:knows]->(b:person)-[:knows]->(c:person) RETURN count(*);
+
+SELECT query, calls, rows,
+       graph_insert_vertex, graph_insert_edge,
+       graph_delete_vertex, graph_delete_edge, graph_update_property
+  FROM pg_stat_statements
+ WHERE query NOT LIKE '%pg_stat_statements%'
+ ORDER BY query COLLATE "C";
+
+DROP GRAPH pgss CASCADE;
+
+DROP EXTENSION pg_stat_statements;
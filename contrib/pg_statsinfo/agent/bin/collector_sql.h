@@ -510,6 +510,19 @@ SELECT * FROM statsinfo.memory()"
 /* profile */
 #define SQL_SELECT_PROFILE	"SELECT * FROM statsinfo.profile()"
 
+/* graph traversal latency */
+#define SQL_SELECT_GRAPH_TRAVERSAL "\
+SELECT \
+	dbid, \
+	kind, \
+	calls, \
+	total_time, \
+	min_time, \
+	max_time, \
+	rows \
+FROM \
+	statsinfo.graph_traversal()"
+
 /* repository size */
 #define SQL_SELECT_REPOSIZE "\
 SELECT \
@@ -709,4 +722,122 @@ FROM \
 WHERE \
 	n.nspname <> ALL (('{' || $1 || '}')::text[])"
 
+/* graph label */
+#define SQL_SELECT_GRAPH_LABEL "\
+SELECT \
+	g.graphname, \
+	l.labname, \
+	l.labid, \
+	l.labkind, \
+	l.relid, \
+	c.reltuples::bigint, \
+	pg_stat_get_live_tuples(l.relid) AS n_live_tup, \
+	pg_relation_size(l.relid) AS size \
+FROM \
+	ag_label l JOIN \
+	ag_graph g ON l.graphid = g.oid JOIN \
+	pg_class c ON l.relid = c.oid \
+WHERE \
+	g.graphname <> ALL (('{' || $1 || '}')::text[]) \
+ORDER BY \
+	l.relid"
+
+/*
+ * graph out-degree histogram
+ *
+ * Estimated per edge label from the statistics of its start column so that
+ * no edge is scanned.  Most common start vertices get their own degree, and
+ * the other start vertices share the rest of the edges evenly.  Degrees are
+ * grouped into buckets of powers of two.
+ */
+#define SQL_SELECT_GRAPH_DEGREE "\
+WITH e AS ( \
+	SELECT \
+		g.graphname, \
+		l.labname, \
+		greatest(c.reltuples, 0) AS nedges, \
+		CASE WHEN s.n_distinct < 0 \
+			THEN -s.n_distinct * c.reltuples \
+			ELSE s.n_distinct \
+		END AS nstarts, \
+		coalesce(s.most_common_freqs, '{}') AS freqs \
+	FROM \
+		ag_label l JOIN \
+		ag_graph g ON l.graphid = g.oid JOIN \
+		pg_class c ON l.relid = c.oid JOIN \
+		pg_stats s ON s.schemaname = g.graphname AND s.tablename = l.labname \
+	WHERE \
+		l.labkind = 'e' AND \
+		s.attname = 'start' AND \
+		NOT s.inherited AND \
+		g.graphname <> ALL (('{' || $1 || '}')::text[]) \
+), d AS ( \
+	SELECT \
+		graphname, \
+		labname, \
+		1::float8 AS nvertices, \
+		f * nedges AS degree \
+	FROM \
+		e, unnest(e.freqs) AS f \
+	UNION ALL \
+	SELECT \
+		graphname, \
+		labname, \
+		nstarts - cardinality(freqs), \
+		nedges * (1 - (SELECT coalesce(sum(f), 0) FROM unnest(freqs) AS f)) / \
+			(nstarts - cardinality(freqs)) \
+	FROM \
+		e \
+	WHERE \
+		nstarts - cardinality(freqs) >= 1 \
+) \
+SELECT \
+	graphname, \
+	labname, \
+	(2 ^ floor(log(2, greatest(degree, 1)::numeric)))::bigint AS degree_from, \
+	round(sum(nvertices))::bigint AS vertices, \
+	round(sum(nvertices * degree))::bigint AS edges \
+FROM \
+	d \
+GROUP BY \
+	1, 2, 3 \
+ORDER BY \
+	1, 2, 3"
+
+/*
+ * graph supernode
+ *
+ * Top vertices by degree, estimated from the most common values of start and
+ * end columns of edge labels.
+ */
+#define SQL_SELECT_GRAPH_SUPERNODE "\
+SELECT \
+	d.graphname, \
+	d.vid, \
+	round(sum(CASE WHEN d.attname = 'start' THEN d.degree ELSE 0 END))::bigint AS out_degree, \
+	round(sum(CASE WHEN d.attname = 'end' THEN d.degree ELSE 0 END))::bigint AS in_degree \
+FROM \
+	(SELECT \
+		g.graphname, \
+		s.attname, \
+		v.vid, \
+		v.freq * c.reltuples AS degree \
+	 FROM \
+		ag_label l JOIN \
+		ag_graph g ON l.graphid = g.oid JOIN \
+		pg_class c ON l.relid = c.oid JOIN \
+		pg_stats s ON s.schemaname = g.graphname AND s.tablename = l.labname, \
+		unnest(s.most_common_vals::text::text[], s.most_common_freqs) AS v(vid, freq) \
+	 WHERE \
+		l.labkind = 'e' AND \
+		s.attname IN ('start', 'end') AND \
+		NOT s.inherited AND \
+		g.graphname <> ALL (('{' || $1 || '}')::text[]) \
+	) d \
+GROUP BY \
+	d.graphname, d.vid \
+ORDER BY \
+	sum(d.degree) DESC \
+LIMIT $2"
+
 #endif
@@ -35,6 +35,7 @@ char		   *excluded_dbnames;
 char		   *excluded_schemas;
 char		   *stat_statements_max;
 char		   *stat_statements_exclude_users;
+char		   *graph_supernode_max;
 int				sampling_interval;
 int				snapshot_interval;
 int				enable_maintenance;
@@ -115,6 +116,7 @@ static void readopt(void);
 static bool decode_time(const char *field, int *hour, int *min, int *sec);
 static int strtoi(const char *nptr, char **endptr, int base);
 static bool execute_script(PGconn *conn, const char *script_file);
+static bool ensure_statsrepo_graph(PGconn *conn);
 static void create_lock_file(void);
 static void unlink_lock_file(void);
 static void load_control_file(ControlFile *ctrl);
@@ -139,6 +141,7 @@ static struct ParamMap PARAM_MAP[] =
 	{GUC_PREFIX ".excluded_schemas", assign_string, &excluded_schemas},
 	{GUC_PREFIX ".stat_statements_max", assign_string, &stat_statements_max},
 	{GUC_PREFIX ".stat_statements_exclude_users", assign_string, &stat_statements_exclude_users},
+	{GUC_PREFIX ".graph_supernode_max", assign_string, &graph_supernode_max},
 	{GUC_PREFIX ".repository_server", assign_string, &repository_server},
 	{GUC_PREFIX ".sampling_interval", assign_int, &sampling_interval},
 	{GUC_PREFIX ".snapshot_interval", assign_int, &snapshot_interval},
@@ -461,7 +464,12 @@ ensure_schema(PGconn *conn, const char *schema)
 	PQclear(res);
 	/* TODO: check installed schema version */
 	if (ok)
+	{
+		/* repository created before graph statistics needs their tables */
+		if (strcmp(schema, "statsrepo") == 0)
+			return ensure_statsrepo_graph(conn);
 		return true;	/* ok, installed */
+	}
 
 	/* iff schema is "statsrepo", create language 'PL/pgSQL' */
 	if (strcmp(schema, "statsrepo") == 0)
@@ -497,10 +505,45 @@ ensure_schema(PGconn *conn, const char *schema)
 		snprintf(path, MAXPGPATH, "%s/contrib/pg_statsrepo_alert.sql", share_path);
 		if (!execute_script(conn, path))
 			return false;
+
+		/* execute script $PGSHARE/contrib/pg_statsrepo_graph.sql */
+		snprintf(path, MAXPGPATH, "%s/contrib/pg_statsrepo_graph.sql", share_path);
+		if (!execute_script(conn, path))
+			return false;
 	}
 	return true;
 }
 
+/*
+ * create tables for graph statistics in statsrepo schema unless they exist.
+ * requires $PGDATA/contrib/pg_statsrepo_graph.sql
+ */
+static bool
+ensure_statsrepo_graph(PGconn *conn)
+{
+	PGresult	   *res;
+	bool			ok;
+	char			path[MAXPGPATH];
+
+	res = pgut_execute(conn,
+			"SELECT 1 FROM pg_class c JOIN pg_namespace n ON c.relnamespace = n.oid"
+			" WHERE n.nspname = 'statsrepo' AND c.relname = 'graph_traversal'",
+			0, NULL);
+	if (PQresultStatus(res) != PGRES_TUPLES_OK)
+	{
+		PQclear(res);
+		return false;
+	}
+	ok = (PQntuples(res) > 0);
+	PQclear(res);
+	if (ok)
+		return true;	/* ok, installed */
+
+	snprintf(path, MAXPGPATH, "%s/contrib/pg_statsrepo_graph.sql", share_path);
+	elog(LOG, "installing tables for graph statistics");
+	return execute_script(conn, path);
+}
+
 /*
  * set shutdown state
  */
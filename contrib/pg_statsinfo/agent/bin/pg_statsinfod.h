@@ -55,6 +55,7 @@ FROM \
 		('" GUC_PREFIX ".excluded_schemas'), \
 		('" GUC_PREFIX ".stat_statements_max'), \
 		('" GUC_PREFIX ".stat_statements_exclude_users'), \
+		('" GUC_PREFIX ".graph_supernode_max'), \
 		('" GUC_PREFIX ".sampling_interval'), \
 		('" GUC_PREFIX ".snapshot_interval'), \
 		('" GUC_PREFIX ".repository_server'), \
@@ -154,6 +155,7 @@ extern char		   *excluded_dbnames;
 extern char		   *excluded_schemas;
 extern char		   *stat_statements_max;
 extern char		   *stat_statements_exclude_users;
+extern char		   *graph_supernode_max;
 extern int			sampling_interval;
 extern int			snapshot_interval;
 extern int		    enable_maintenance;
@@ -0,0 +1,76 @@
+/*
+ * bin/pg_statsrepo_graph.sql
+ *
+ * Setup of tables for graph statistics.  This is also run on repositories
+ * created before these tables were added.
+ *
+ * Copyright (c) 2009-2017, NIPPON TELEGRAPH AND TELEPHONE CORPORATION
+ */
+
+-- Adjust this setting to control where the objects get created.
+SET search_path = public;
+
+BEGIN;
+
+SET LOCAL client_min_messages = WARNING;
+
+CREATE TABLE statsrepo.graph_label
+(
+	snapid			bigint,
+	dbid			oid,
+	graph			name,
+	label			name,
+	labid			integer,
+	labkind			"char",
+	relid			oid,
+	reltuples		bigint,
+	n_live_tup		bigint,
+	size			bigint,
+	PRIMARY KEY (snapid, dbid, relid),
+	FOREIGN KEY (snapid) REFERENCES statsrepo.snapshot (snapid) ON DELETE CASCADE,
+	FOREIGN KEY (snapid, dbid) REFERENCES statsrepo.database (snapid, dbid)
+);
+
+CREATE TABLE statsrepo.graph_degree
+(
+	snapid			bigint,
+	dbid			oid,
+	graph			name,
+	label			name,
+	degree_from		bigint,
+	vertices		bigint,
+	edges			bigint,
+	PRIMARY KEY (snapid, dbid, graph, label, degree_from),
+	FOREIGN KEY (snapid) REFERENCES statsrepo.snapshot (snapid) ON DELETE CASCADE,
+	FOREIGN KEY (snapid, dbid) REFERENCES statsrepo.database (snapid, dbid)
+);
+
+CREATE TABLE statsrepo.graph_supernode
+(
+	snapid			bigint,
+	dbid			oid,
+	graph			name,
+	vid				text,
+	out_degree		bigint,
+	in_degree		bigint,
+	FOREIGN KEY (snapid) REFERENCES statsrepo.snapshot (snapid) ON DELETE CASCADE,
+	FOREIGN KEY (snapid, dbid) REFERENCES statsrepo.database (snapid, dbid)
+);
+CREATE INDEX statsrepo_graph_supernode_idx ON statsrepo.graph_supernode(snapid, dbid);
+
+CREATE TABLE statsrepo.graph_traversal
+(
+	snapid			bigint,
+	dbid			oid,
+	kind			text,
+	calls			bigint,
+	total_time		double precision,
+	min_time		double precision,
+	max_time		double precision,
+	rows			bigint,
+	PRIMARY KEY (snapid, dbid, kind),
+	FOREIGN KEY (snapid) REFERENCES statsrepo.snapshot (snapid) ON DELETE CASCADE,
+	FOREIGN KEY (snapid, dbid) REFERENCES statsrepo.database (snapid, dbid)
+);
+
+COMMIT;
@@ -95,6 +95,7 @@ static const char *instance_puts[] =
 #endif
 	SQL_INSERT_STATEMENT,
 	SQL_INSERT_PLAN,
+	SQL_INSERT_GRAPH_TRAVERSAL,
 	NULL
 };
 
@@ -117,6 +118,9 @@ static const char *database_puts[] =
 	SQL_INSERT_INDEX,
 	SQL_INSERT_INHERITS,
 	SQL_INSERT_FUNCTION,
+	SQL_INSERT_GRAPH_LABEL,
+	SQL_INSERT_GRAPH_DEGREE,
+	SQL_INSERT_GRAPH_SUPERNODE,
 	NULL
 };
 
@@ -136,6 +140,9 @@ static bool has_pg_store_plans(PGconn *conn);
 static bool has_pg_store_plans_hash_query(PGconn *conn);
 #endif
 static bool has_statsrepo_alert(PGconn *conn);
+static bool has_graph(PGconn *conn);
+static bool has_graph_traversal(PGconn *conn);
+static List *get_graph_stats(PGconn *conn);
 
 QueueItem *
 get_snapshot(char *comment)
@@ -302,6 +309,15 @@ get_snapshot(char *comment)
 	else
 		snap->instance = lappend(snap->instance, NULL);
 
+	/* graph traversals are counted by the library, if it's new enough */
+	if (has_graph_traversal(conn))
+	{
+		snap->instance = lappend(snap->instance,
+			do_get(conn, SQL_SELECT_GRAPH_TRAVERSAL, 0, NULL));
+	}
+	else
+		snap->instance = lappend(snap->instance, NULL);
+
 	/* collect database statistics */
 	rows = PQntuples(snap->dbnames);
 	for (r = 0; r < rows; r++)
@@ -319,6 +335,8 @@ get_snapshot(char *comment)
 				(dbsnap = do_gets(conn, database_gets, 1, params)) == NIL)
 				continue;
 
+			/* graph statistics follow the other statistics of the database */
+			dbsnap = list_concat(dbsnap, get_graph_stats(conn));
 			break;	/* ok */
 		}
 
@@ -698,3 +716,60 @@ has_statsrepo_alert(PGconn *conn)
 
 	return result;
 }
+
+static bool
+has_graph(PGconn *conn)
+{
+	PGresult   *res;
+	bool		result;
+
+	/* check whether the database has any graph */
+	res = pgut_execute(conn, "SELECT 1 FROM ag_graph LIMIT 1", 0, NULL);
+	result = (PQresultStatus(res) == PGRES_TUPLES_OK && PQntuples(res) > 0);
+	PQclear(res);
+
+	return result;
+}
+
+static bool
+has_graph_traversal(PGconn *conn)
+{
+	PGresult   *res;
+	bool		result;
+
+	/*
+	 * check whether statsinfo.graph_traversal() exists; statsinfo schema
+	 * installed by an older version doesn't have it
+	 */
+	res = pgut_execute(conn,
+			"SELECT 1 FROM pg_proc p JOIN pg_namespace n ON p.pronamespace = n.oid"
+			" WHERE n.nspname = 'statsinfo' AND p.proname = 'graph_traversal'",
+			0, NULL);
+	result = (PQresultStatus(res) == PGRES_TUPLES_OK && PQntuples(res) > 0);
+	PQclear(res);
+
+	return result;
+}
+
+/*
+ * collect graph statistics of the database; label sizes, out-degree
+ * histogram and supernodes.  They are estimated from the catalogs and the
+ * planner statistics, so no label is scanned.  Returns NIL if the database
+ * has no graph.
+ */
+static List *
+get_graph_stats(PGconn *conn)
+{
+	List	   *result = NIL;
+	const char *params[] = {excluded_schemas, graph_supernode_max};
+
+	if (!has_graph(conn))
+		return NIL;
+
+	result = lappend(result, do_get(conn, SQL_SELECT_GRAPH_LABEL, 1, params));
+	result = lappend(result, do_get(conn, SQL_SELECT_GRAPH_DEGREE, 1, params));
+	result = lappend(result,
+					 do_get(conn, SQL_SELECT_GRAPH_SUPERNODE, 2, params));
+
+	return result;
+}
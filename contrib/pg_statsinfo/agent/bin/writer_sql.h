@@ -103,6 +103,21 @@ INSERT INTO statsrepo.inherits VALUES ($1, $2, $3, $4, $5)"
 #define SQL_INSERT_FUNCTION "\
 INSERT INTO statsrepo.function VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9)"
 
+#define SQL_INSERT_GRAPH_TRAVERSAL "\
+INSERT INTO statsrepo.graph_traversal \
+  SELECT (($1, $2, $3, $4, $5, $6, $7, $8)::statsrepo.graph_traversal).* \
+    FROM statsrepo.database d \
+   WHERE d.snapid = $1 AND d.dbid = $2"
+
+#define SQL_INSERT_GRAPH_LABEL "\
+INSERT INTO statsrepo.graph_label VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9, $10)"
+
+#define SQL_INSERT_GRAPH_DEGREE "\
+INSERT INTO statsrepo.graph_degree VALUES ($1, $2, $3, $4, $5, $6, $7)"
+
+#define SQL_INSERT_GRAPH_SUPERNODE "\
+INSERT INTO statsrepo.graph_supernode VALUES ($1, $2, $3, $4, $5, $6)"
+
 #define SQL_INSERT_ALERT "\
 INSERT INTO statsrepo.alert_message VALUES ($1, $2)"
 
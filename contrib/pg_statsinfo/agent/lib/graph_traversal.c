@@ -0,0 +1,360 @@
+/*
+ * lib/graph_traversal.c
+ *     Track executions of graph traversals (VLE and DIJKSTRA).
+ *
+ * Copyright (c) 2009-2017, NIPPON TELEGRAPH AND TELEPHONE CORPORATION
+ */
+
+#include "postgres.h"
+#include "executor/executor.h"
+#include "executor/instrument.h"
+#include "funcapi.h"
+#include "miscadmin.h"
+#include "nodes/nodeFuncs.h"
+#include "storage/ipc.h"
+#include "storage/shmem.h"
+#include "storage/spin.h"
+#include "utils/builtins.h"
+#include "utils/memutils.h"
+
+#include "../common.h"
+#include "pgut/pgut-be.h"
+
+/*
+ * Kinds of graph traversal.  A statement is counted once for every kind of
+ * traversal node found in its plan.
+ */
+#define GRAPH_TRAVERSAL_VLE			0x01	/* NestLoopVLE */
+#define GRAPH_TRAVERSAL_DIJKSTRA	0x02	/* Dijkstra */
+
+/* Max number of (database, kind) pairs tracked */
+#define GRAPH_TRAVERSAL_MAX_ENTRIES	256
+
+/*
+ * Statistics of the statements of one database having one kind of traversal.
+ * Times are in milliseconds, like pg_stat_statements.
+ */
+typedef struct traversalEntry
+{
+	Oid		dbid;			/* InvalidOid means unused entry */
+	int		kind;			/* GRAPH_TRAVERSAL_* */
+	int64	calls;			/* # of times executed */
+	double	total_time;		/* total execution time */
+	double	min_time;		/* minimum execution time */
+	double	max_time;		/* maximum execution time */
+	int64	rows;			/* total # of retrieved or affected rows */
+} traversalEntry;
+
+typedef struct traversalBuffer
+{
+	slock_t			mutex;		/* protects the entries */
+	traversalEntry	entries[GRAPH_TRAVERSAL_MAX_ENTRIES];
+} traversalBuffer;
+
+/* Hook storage */
+static shmem_startup_hook_type	prev_shmem_startup_hook = NULL;
+static ExecutorStart_hook_type	prev_ExecutorStart_hook = NULL;
+static ExecutorEnd_hook_type	prev_ExecutorEnd_hook = NULL;
+
+/* Backend local variables */
+static traversalBuffer *traversal_buffer = NULL;
+
+/* Module callbacks */
+void		init_graph_traversal(void);
+void		fini_graph_traversal(void);
+Datum		statsinfo_graph_traversal(PG_FUNCTION_ARGS);
+
+PG_FUNCTION_INFO_V1(statsinfo_graph_traversal);
+
+/* Internal functions */
+static void shmem_startup(void);
+static void myExecutorStart(QueryDesc *queryDesc, int eflags);
+static void myExecutorEnd(QueryDesc *queryDesc);
+static bool traversal_kinds_walker(PlanState *planstate, int *kinds);
+static int traversal_kinds(QueryDesc *queryDesc);
+static void store_traversal(int kind, double total_time, int64 rows);
+
+#define TAKE_HOOK2(func, replace) \
+	prev_##func##_hook = func##_hook; \
+	func##_hook = replace;
+
+#define TAKE_HOOK1(func) \
+	TAKE_HOOK2(func, func);
+
+#define RESTORE_HOOK(func) \
+	func##_hook = prev_##func##_hook;
+
+/*
+ * Module load callbacks
+ */
+void
+init_graph_traversal(void)
+{
+	RequestAddinShmemSpace(sizeof(traversalBuffer));
+
+	TAKE_HOOK1(shmem_startup);
+	TAKE_HOOK2(ExecutorStart, myExecutorStart);
+	TAKE_HOOK2(ExecutorEnd, myExecutorEnd);
+}
+
+/*
+ * Module unload callback
+ */
+void
+fini_graph_traversal(void)
+{
+	/* Uninstall hooks. */
+	RESTORE_HOOK(shmem_startup);
+	RESTORE_HOOK(ExecutorStart);
+	RESTORE_HOOK(ExecutorEnd);
+}
+
+/*
+ * shmem_startup() -
+ *
+ * Allocate or attach shared memory.
+ */
+static void
+shmem_startup(void)
+{
+	bool	found;
+
+	if (prev_shmem_startup_hook)
+		prev_shmem_startup_hook();
+
+	traversal_buffer = (traversalBuffer *) ShmemInitStruct("graph_traversal",
+												sizeof(traversalBuffer),
+												&found);
+	if (!found)
+	{
+		MemSet(traversal_buffer, 0, sizeof(traversalBuffer));
+		SpinLockInit(&traversal_buffer->mutex);
+	}
+}
+
+/*
+ * myExecutorStart() -
+ *
+ * Make sure statements having graph traversals are timed.
+ */
+static void
+myExecutorStart(QueryDesc *queryDesc, int eflags)
+{
+	if (prev_ExecutorStart_hook)
+		prev_ExecutorStart_hook(queryDesc, eflags);
+	else
+		standard_ExecutorStart(queryDesc, eflags);
+
+	/*
+	 * Set up to track total elapsed time in ExecutorRun, the same way as
+	 * pg_stat_statements does.  Allocate in per-query context so as to be
+	 * free at ExecutorEnd.
+	 */
+	if (traversal_buffer != NULL &&
+		queryDesc->totaltime == NULL &&
+		traversal_kinds(queryDesc) != 0)
+	{
+		MemoryContext oldcxt;
+
+		oldcxt = MemoryContextSwitchTo(queryDesc->estate->es_query_cxt);
+		queryDesc->totaltime = InstrAlloc(1, INSTRUMENT_ALL);
+		MemoryContextSwitchTo(oldcxt);
+	}
+}
+
+/*
+ * myExecutorEnd() -
+ *
+ * Count the statement for each kind of traversal in its plan.
+ */
+static void
+myExecutorEnd(QueryDesc *queryDesc)
+{
+	int		kinds;
+
+	if (traversal_buffer != NULL && queryDesc->totaltime != NULL &&
+		(kinds = traversal_kinds(queryDesc)) != 0)
+	{
+		double	total_time;
+		int64	rows = queryDesc->estate->es_processed;
+
+		/*
+		 * Make sure stats accumulation is done.  (Note: it's okay if several
+		 * levels of hook all do this.)
+		 */
+		InstrEndLoop(queryDesc->totaltime);
+		total_time = queryDesc->totaltime->total * 1000.0;	/* convert to msec */
+
+		if (kinds & GRAPH_TRAVERSAL_VLE)
+			store_traversal(GRAPH_TRAVERSAL_VLE, total_time, rows);
+		if (kinds & GRAPH_TRAVERSAL_DIJKSTRA)
+			store_traversal(GRAPH_TRAVERSAL_DIJKSTRA, total_time, rows);
+	}
+
+	if (prev_ExecutorEnd_hook)
+		prev_ExecutorEnd_hook(queryDesc);
+	else
+		standard_ExecutorEnd(queryDesc);
+}
+
+static bool
+traversal_kinds_walker(PlanState *planstate, int *kinds)
+{
+	if (planstate == NULL)
+		return false;
+
+	if (IsA(planstate, NestLoopVLEState))
+		*kinds |= GRAPH_TRAVERSAL_VLE;
+	else if (IsA(planstate, DijkstraState))
+		*kinds |= GRAPH_TRAVERSAL_DIJKSTRA;
+
+	return planstate_tree_walker(planstate, traversal_kinds_walker, kinds);
+}
+
+/*
+ * traversal_kinds() -
+ *
+ * Returns the kinds of graph traversal executed by the statement, as a
+ * bitmask of GRAPH_TRAVERSAL_*.
+ */
+static int
+traversal_kinds(QueryDesc *queryDesc)
+{
+	int		kinds = 0;
+
+	traversal_kinds_walker(queryDesc->planstate, &kinds);
+
+	return kinds;
+}
+
+/*
+ * store_traversal() -
+ *
+ * Add one execution to the entry of the current database.  If there's no
+ * room for a new entry, the execution is not counted.
+ */
+static void
+store_traversal(int kind, double total_time, int64 rows)
+{
+	traversalEntry *entry = NULL;
+	int				i;
+
+	SpinLockAcquire(&traversal_buffer->mutex);
+
+	for (i = 0; i < GRAPH_TRAVERSAL_MAX_ENTRIES; i++)
+	{
+		traversalEntry *e = &traversal_buffer->entries[i];
+
+		if (e->dbid == MyDatabaseId && e->kind == kind)
+		{
+			entry = e;
+			break;
+		}
+		if (e->dbid == InvalidOid)
+		{
+			/* entries are never removed, so the rest are unused too */
+			entry = e;
+			entry->dbid = MyDatabaseId;
+			entry->kind = kind;
+			entry->min_time = total_time;
+			entry->max_time = total_time;
+			break;
+		}
+	}
+
+	if (entry != NULL)
+	{
+		entry->calls++;
+		entry->total_time += total_time;
+		if (entry->min_time > total_time)
+			entry->min_time = total_time;
+		if (entry->max_time < total_time)
+			entry->max_time = total_time;
+		entry->rows += rows;
+	}
+
+	SpinLockRelease(&traversal_buffer->mutex);
+}
+
+/*
+ * statsinfo_graph_traversal - get statistics of graph traversals
+ */
+#define NUM_GRAPH_TRAVERSAL_COLS	7
+
+Datum
+statsinfo_graph_traversal(PG_FUNCTION_ARGS)
+{
+	ReturnSetInfo	*rsinfo = (ReturnSetInfo *) fcinfo->resultinfo;
+	TupleDesc		 tupdesc;
+	Tuplestorestate	*tupstore;
+	MemoryContext	 per_query_ctx;
+	MemoryContext	 oldcontext;
+	traversalEntry	 entries[GRAPH_TRAVERSAL_MAX_ENTRIES];
+	int				 i;
+
+	/* check to see if caller supports us returning a tuplestore */
+	if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("set-valued function called in context that cannot accept a set")));
+	if (!(rsinfo->allowedModes & SFRM_Materialize))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("materialize mode required, but it is not " \
+						"allowed in this context")));
+
+	/* Build a tuple descriptor for our result type */
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+	Assert(tupdesc->natts == NUM_GRAPH_TRAVERSAL_COLS);
+
+	per_query_ctx = rsinfo->econtext->ecxt_per_query_memory;
+	oldcontext = MemoryContextSwitchTo(per_query_ctx);
+
+	tupstore = tuplestore_begin_heap(true, false, work_mem);
+	rsinfo->returnMode = SFRM_Materialize;
+	rsinfo->setResult = tupstore;
+	rsinfo->setDesc = tupdesc;
+
+	MemoryContextSwitchTo(oldcontext);
+
+	/* Return zero rows if module has not been loaded properly. */
+	if (traversal_buffer == NULL)
+		PG_RETURN_VOID();
+
+	/* copy the entries not to hold the spinlock while building tuples */
+	SpinLockAcquire(&traversal_buffer->mutex);
+	memcpy(entries, traversal_buffer->entries, sizeof(entries));
+	SpinLockRelease(&traversal_buffer->mutex);
+
+	for (i = 0; i < GRAPH_TRAVERSAL_MAX_ENTRIES; i++)
+	{
+		traversalEntry *entry = &entries[i];
+		Datum			values[NUM_GRAPH_TRAVERSAL_COLS];
+		bool			nulls[NUM_GRAPH_TRAVERSAL_COLS];
+		int				j = 0;
+
+		if (entry->dbid == InvalidOid)
+			break;
+
+		MemSet(values, 0, sizeof(values));
+		MemSet(nulls, 0, sizeof(nulls));
+
+		values[j++] = ObjectIdGetDatum(entry->dbid);
+		values[j++] = CStringGetTextDatum(
+			entry->kind == GRAPH_TRAVERSAL_VLE ? "vle" : "dijkstra");
+		values[j++] = Int64GetDatum(entry->calls);
+		values[j++] = Float8GetDatum(entry->total_time);
+		values[j++] = Float8GetDatum(entry->min_time);
+		values[j++] = Float8GetDatum(entry->max_time);
+		values[j++] = Int64GetDatum(entry->rows);
+		Assert(j == NUM_GRAPH_TRAVERSAL_COLS);
+
+		tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+	}
+
+	/* clean up and return the tuplestore */
+	tuplestore_donestoring(tupstore);
+
+	PG_RETURN_VOID();
+}
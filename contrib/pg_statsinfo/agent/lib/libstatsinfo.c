@@ -211,6 +211,7 @@ default_log_maintenance_command(void)
 #define DEFAULT_LOG_MAINTENANCE_COMMAND		default_log_maintenance_command()
 #define DEFAULT_LONG_LOCK_THRESHOLD			30		/* sec */
 #define DEFAULT_STAT_STATEMENTS_MAX			30
+#define DEFAULT_GRAPH_SUPERNODE_MAX			10
 #define DEFAULT_CONTROLFILE_FSYNC_INTERVAL	60		/* sec */
 #define DEFAULT_LONG_TRANSACTION_MAX		10
 #define LONG_TRANSACTION_THRESHOLD			1.0		/* sec */
@@ -281,6 +282,7 @@ static char	   *log_maintenance_command = NULL;
 static int		long_lock_threshold = DEFAULT_LONG_LOCK_THRESHOLD;
 static int		stat_statements_max = DEFAULT_STAT_STATEMENTS_MAX;
 static char	   *stat_statements_exclude_users = NULL;
+static int		graph_supernode_max = DEFAULT_GRAPH_SUPERNODE_MAX;
 static int		long_transaction_max = DEFAULT_LONG_TRANSACTION_MAX;
 static int		controlfile_fsync_interval = DEFAULT_CONTROLFILE_FSYNC_INTERVAL;
 
@@ -322,6 +324,8 @@ extern PGUT_EXPORT void	_PG_init(void);
 extern PGUT_EXPORT void	_PG_fini(void);
 extern PGUT_EXPORT void	init_last_xact_activity(void);
 extern PGUT_EXPORT void	fini_last_xact_activity(void);
+extern PGUT_EXPORT void	init_graph_traversal(void);
+extern PGUT_EXPORT void	fini_graph_traversal(void);
 
 /*----  Internal declarations ----*/
 
@@ -1380,6 +1384,21 @@ _PG_init(void)
 							   NULL,
 							   NULL);
 
+	DefineCustomIntVariable(GUC_PREFIX ".graph_supernode_max",
+							"Sets the max number of supernodes recorded per database.",
+							NULL,
+							&graph_supernode_max,
+							DEFAULT_GRAPH_SUPERNODE_MAX,
+							0,
+							INT_MAX,
+							PGC_SIGHUP,
+							0,
+#if PG_VERSION_NUM >= 90100
+							NULL,
+#endif
+							NULL,
+							NULL);
+
 	DefineCustomIntVariable(GUC_PREFIX ".controlfile_fsync_interval",
 							"Sets the fsync interval of the control file.",
 							NULL,
@@ -1491,6 +1510,9 @@ _PG_init(void)
 	/* Install xact_last_activity */
 	init_last_xact_activity();
 
+	/* Install graph_traversal */
+	init_graph_traversal();
+
 	/*
 	 * spawn pg_statsinfo launcher process if the first call
 	 */
@@ -1506,6 +1528,9 @@ _PG_fini(void)
 {
 	/* Uninstall xact_last_activity */
 	fini_last_xact_activity();
+
+	/* Uninstall graph_traversal */
+	fini_graph_traversal();
 }
 
 /*
@@ -52,6 +52,7 @@ install -m 755 reporter/pg_statsinfo				%{buildroot}%{_bindir}/pg_statsinfo
 install -m 755 agent/bin/archive_pglog.sh			%{buildroot}%{_bindir}/archive_pglog.sh
 install -m 644 agent/bin/pg_statsrepo.sql			%{buildroot}%{_datadir}/contrib/pg_statsrepo.sql
 install -m 644 agent/bin/pg_statsrepo_alert.sql		%{buildroot}%{_datadir}/contrib/pg_statsrepo_alert.sql
+install -m 644 agent/bin/pg_statsrepo_graph.sql		%{buildroot}%{_datadir}/contrib/pg_statsrepo_graph.sql
 install -m 644 agent/bin/uninstall_pg_statsrepo.sql	%{buildroot}%{_datadir}/contrib/uninstall_pg_statsrepo.sql
 install -m 755 agent/lib/pg_statsinfo.so			%{buildroot}%{_libdir}/pg_statsinfo.so
 install -m 644 agent/lib/pg_statsinfo.sql			%{buildroot}%{_datadir}/contrib/pg_statsinfo.sql
@@ -69,6 +70,7 @@ rm -rf %{buildroot}
 %{_libdir}/pg_statsinfo.so
 %{_datadir}/contrib/pg_statsrepo.sql
 %{_datadir}/contrib/pg_statsrepo_alert.sql
+%{_datadir}/contrib/pg_statsrepo_graph.sql
 %{_datadir}/contrib/uninstall_pg_statsrepo.sql
 %{_datadir}/contrib/pg_statsinfo.sql
 %{_datadir}/contrib/uninstall_pg_statsinfo.sql
@@ -29,6 +29,12 @@
 
 #include <unistd.h>
 #include <fcntl.h>
+#ifdef USE_LZ4
+#include <lz4.h>
+#endif
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
 
 #include "access/genam.h"
 #include "access/heapam.h"
@@ -37,8 +43,10 @@
 #include "catalog/catalog.h"
 #include "common/pg_lzcompress.h"
 #include "miscadmin.h"
+#include "utils/attoptcache.h"
 #include "utils/expandeddatum.h"
 #include "utils/fmgroids.h"
+#include "utils/guc.h"
 #include "utils/rel.h"
 #include "utils/snapmgr.h"
 #include "utils/typcache.h"
@@ -53,7 +61,7 @@
 typedef struct toast_compress_header
 {
 	int32		vl_len_;		/* varlena header (do not touch directly!) */
-	int32		rawsize;
+	uint32		tcinfo;			/* raw size and compression method */
 } toast_compress_header;
 
 /*
@@ -61,11 +69,37 @@ typedef struct toast_compress_header
  * toast entries.
  */
 #define TOAST_COMPRESS_HDRSZ		((int32) sizeof(toast_compress_header))
-#define TOAST_COMPRESS_RAWSIZE(ptr) (((toast_compress_header *) (ptr))->rawsize)
+#define TOAST_COMPRESS_RAWSIZE(ptr) \
+	((int32) (((toast_compress_header *) (ptr))->tcinfo & VARLENA_RAWSIZE_MASK))
+#define TOAST_COMPRESS_METHOD(ptr) \
+	((int) (((toast_compress_header *) (ptr))->tcinfo >> VARLENA_RAWSIZE_BITS))
 #define TOAST_COMPRESS_RAWDATA(ptr) \
 	(((char *) (ptr)) + TOAST_COMPRESS_HDRSZ)
-#define TOAST_COMPRESS_SET_RAWSIZE(ptr, len) \
-	(((toast_compress_header *) (ptr))->rawsize = (len))
+#define TOAST_COMPRESS_SET_SIZE_AND_METHOD(ptr, len, cmethod) \
+	do { \
+		Assert((len) > 0 && (len) <= VARLENA_RAWSIZE_MASK); \
+		((toast_compress_header *) (ptr))->tcinfo = \
+			((uint32) (len)) | ((uint32) (cmethod) << VARLENA_RAWSIZE_BITS); \
+	} while (0)
+
+/* zstd's own default level, a good balance for values read many times */
+#define TOAST_ZSTD_LEVEL	3
+
+/*
+ * GUC support.  Methods that aren't built in are not accepted.
+ */
+const struct config_enum_entry toast_compression_options[] = {
+	{"pglz", TOAST_PGLZ_COMPRESSION_ID, false},
+#ifdef USE_LZ4
+	{"lz4", TOAST_LZ4_COMPRESSION_ID, false},
+#endif
+#ifdef USE_ZSTD
+	{"zstd", TOAST_ZSTD_COMPRESSION_ID, false},
+#endif
+	{NULL, 0, false}
+};
+
+int			default_toast_compression = TOAST_PGLZ_COMPRESSION_ID;
 
 static void toast_delete_datum(Relation rel, Datum value, bool is_speculative);
 static Datum toast_save_datum(Relation rel, Datum value,
@@ -76,6 +110,7 @@ static struct varlena *toast_fetch_datum(struct varlena * attr);
 static struct varlena *toast_fetch_datum_slice(struct varlena * attr,
 						int32 sliceoffset, int32 length);
 static struct varlena *toast_decompress_datum(struct varlena * attr);
+static int	toast_get_column_compression(Relation rel, int attnum);
 static int toast_open_indexes(Relation toastrel,
 				   LOCKMODE lock,
 				   Relation **toastidxs,
@@ -774,7 +809,8 @@ toast_insert_or_update(Relation rel, HeapTuple newtup, HeapTuple oldtup,
 		if (att[i]->attstorage == 'x')
 		{
 			old_value = toast_values[i];
-			new_value = toast_compress_datum(old_value);
+			new_value = toast_compress_datum(old_value,
+									toast_get_column_compression(rel, i + 1));
 
 			if (DatumGetPointer(new_value) != NULL)
 			{
@@ -913,7 +949,8 @@ toast_insert_or_update(Relation rel, HeapTuple newtup, HeapTuple oldtup,
 		 */
 		i = biggest_attno;
 		old_value = toast_values[i];
-		new_value = toast_compress_datum(old_value);
+		new_value = toast_compress_datum(old_value,
+									toast_get_column_compression(rel, i + 1));
 
 		if (DatumGetPointer(new_value) != NULL)
 		{
@@ -1291,7 +1328,8 @@ toast_flatten_tuple_to_datum(HeapTupleHeader tup,
 /* ----------
  * toast_compress_datum -
  *
- *	Create a compressed version of a varlena datum
+ *	Create a compressed version of a varlena datum, using compression
+ *	method cmethod
  *
  *	If we fail (ie, compressed result is actually bigger than original)
  *	then return NULL.  We must not use compressed data if it'd expand
@@ -1302,7 +1340,7 @@ toast_flatten_tuple_to_datum(HeapTupleHeader tup,
  * ----------
  */
 Datum
-toast_compress_datum(Datum value)
+toast_compress_datum(Datum value, int cmethod)
 {
 	struct varlena *tmp;
 	int32		valsize = VARSIZE_ANY_EXHDR(DatumGetPointer(value));
@@ -1313,17 +1351,79 @@ toast_compress_datum(Datum value)
 
 	/*
 	 * No point in wasting a palloc cycle if value size is out of the allowed
-	 * range for compression
+	 * range for compression.  pglz's limits are used for all methods.
 	 */
 	if (valsize < PGLZ_strategy_default->min_input_size ||
 		valsize > PGLZ_strategy_default->max_input_size)
 		return PointerGetDatum(NULL);
 
-	tmp = (struct varlena *) palloc(PGLZ_MAX_OUTPUT(valsize) +
-									TOAST_COMPRESS_HDRSZ);
+	switch (cmethod)
+	{
+		case TOAST_PGLZ_COMPRESSION_ID:
+			tmp = (struct varlena *) palloc(PGLZ_MAX_OUTPUT(valsize) +
+											TOAST_COMPRESS_HDRSZ);
+			len = pglz_compress(VARDATA_ANY(DatumGetPointer(value)),
+								valsize,
+								TOAST_COMPRESS_RAWDATA(tmp),
+								PGLZ_strategy_default);
+			break;
+
+		case TOAST_LZ4_COMPRESSION_ID:
+#ifdef USE_LZ4
+			{
+				int32		bound = LZ4_compressBound(valsize);
+
+				tmp = (struct varlena *) palloc(bound + TOAST_COMPRESS_HDRSZ);
+				len = LZ4_compress_default(VARDATA_ANY(DatumGetPointer(value)),
+										   TOAST_COMPRESS_RAWDATA(tmp),
+										   valsize, bound);
+				if (len <= 0)
+					len = -1;	/* failure */
+			}
+			break;
+#else
+			elog(ERROR, "LZ4 is not supported by this build");
+			return PointerGetDatum(NULL);		/* keep compiler quiet */
+#endif
+
+		case TOAST_ZSTD_COMPRESSION_ID:
+#ifdef USE_ZSTD
+			{
+				/* the context is reused for the life of the process */
+				static ZSTD_CCtx *zstd_cctx = NULL;
+				size_t		bound = ZSTD_compressBound(valsize);
+				size_t		zlen;
+
+				if (zstd_cctx == NULL)
+				{
+					zstd_cctx = ZSTD_createCCtx();
+					if (zstd_cctx == NULL)
+						ereport(ERROR,
+								(errcode(ERRCODE_OUT_OF_MEMORY),
+								 errmsg("out of memory")));
+				}
+
+				tmp = (struct varlena *) palloc(bound + TOAST_COMPRESS_HDRSZ);
+				zlen = ZSTD_compressCCtx(zstd_cctx,
+										 TOAST_COMPRESS_RAWDATA(tmp), bound,
+										 VARDATA_ANY(DatumGetPointer(value)),
+										 valsize, TOAST_ZSTD_LEVEL);
+				len = ZSTD_isError(zlen) ? -1 : (int32) zlen;
+			}
+			break;
+#else
+			elog(ERROR, "zstd is not supported by this build");
+			return PointerGetDatum(NULL);		/* keep compiler quiet */
+#endif
+
+		default:
+			elog(ERROR, "invalid compression method %d", cmethod);
+			return PointerGetDatum(NULL);		/* keep compiler quiet */
+	}
 
 	/*
-	 * We recheck the actual size even if pglz_compress() reports success,
+	 * We recheck the actual size even if the compression method reports
+	 * success,
 	 * because it might be satisfied with having saved as little as one byte
 	 * in the compressed data --- which could turn into a net loss once you
 	 * consider header and alignment padding.  Worst case, the compressed
@@ -1332,14 +1432,10 @@ toast_compress_datum(Datum value)
 	 * only one header byte and no padding if the value is short enough.  So
 	 * we insist on a savings of more than 2 bytes to ensure we have a gain.
 	 */
-	len = pglz_compress(VARDATA_ANY(DatumGetPointer(value)),
-						valsize,
-						TOAST_COMPRESS_RAWDATA(tmp),
-						PGLZ_strategy_default);
 	if (len >= 0 &&
 		len + TOAST_COMPRESS_HDRSZ < valsize - 2)
 	{
-		TOAST_COMPRESS_SET_RAWSIZE(tmp, valsize);
+		TOAST_COMPRESS_SET_SIZE_AND_METHOD(tmp, valsize, cmethod);
 		SET_VARSIZE_COMPRESSED(tmp, len + TOAST_COMPRESS_HDRSZ);
 		/* successful compression */
 		return PointerGetDatum(tmp);
@@ -2209,21 +2305,211 @@ toast_decompress_datum(struct varlena * attr)
 {
 	struct varlena *result;
 
+	int32		rawsize = TOAST_COMPRESS_RAWSIZE(attr);
+	int32		len;
+
 	Assert(VARATT_IS_COMPRESSED(attr));
 
-	result = (struct varlena *)
-		palloc(TOAST_COMPRESS_RAWSIZE(attr) + VARHDRSZ);
-	SET_VARSIZE(result, TOAST_COMPRESS_RAWSIZE(attr) + VARHDRSZ);
+	result = (struct varlena *) palloc(rawsize + VARHDRSZ);
+	SET_VARSIZE(result, rawsize + VARHDRSZ);
+
+	switch (TOAST_COMPRESS_METHOD(attr))
+	{
+		case TOAST_PGLZ_COMPRESSION_ID:
+			len = pglz_decompress(TOAST_COMPRESS_RAWDATA(attr),
+								  VARSIZE(attr) - TOAST_COMPRESS_HDRSZ,
+								  VARDATA(result),
+								  rawsize);
+			break;
+
+		case TOAST_LZ4_COMPRESSION_ID:
+#ifdef USE_LZ4
+			len = LZ4_decompress_safe(TOAST_COMPRESS_RAWDATA(attr),
+									  VARDATA(result),
+									  VARSIZE(attr) - TOAST_COMPRESS_HDRSZ,
+									  rawsize);
+#else
+			ereport(ERROR,
+					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+					 errmsg("value is compressed with lz4, which is not supported by this build")));
+			len = -1;			/* keep compiler quiet */
+#endif
+			break;
+
+		case TOAST_ZSTD_COMPRESSION_ID:
+#ifdef USE_ZSTD
+			{
+				size_t		zlen;
 
-	if (pglz_decompress(TOAST_COMPRESS_RAWDATA(attr),
-						VARSIZE(attr) - TOAST_COMPRESS_HDRSZ,
-						VARDATA(result),
-						TOAST_COMPRESS_RAWSIZE(attr)) < 0)
+				zlen = ZSTD_decompress(VARDATA(result), rawsize,
+									   TOAST_COMPRESS_RAWDATA(attr),
+									   VARSIZE(attr) - TOAST_COMPRESS_HDRSZ);
+				len = ZSTD_isError(zlen) ? -1 : (int32) zlen;
+			}
+#else
+			ereport(ERROR,
+					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+					 errmsg("value is compressed with zstd, which is not supported by this build")));
+			len = -1;			/* keep compiler quiet */
+#endif
+			break;
+
+		default:
+			len = -1;
+			break;
+	}
+
+	if (len != rawsize)
 		elog(ERROR, "compressed data is corrupted");
 
 	return result;
 }
 
+/* ----------
+ * toast_get_column_compression -
+ *
+ *	Get the compression method for a column of a relation: the column's
+ *	"compression" option if set, else default_toast_compression.
+ *	System catalogs always use the default, which saves a cache lookup
+ *	while inserting into them and keeps bootstrap working.
+ * ----------
+ */
+static int
+toast_get_column_compression(Relation rel, int attnum)
+{
+	AttributeOpts *aopts;
+	const struct config_enum_entry *entry;
+	char	   *name;
+	int			cmethod = default_toast_compression;
+
+	if (IsCatalogRelation(rel))
+		return default_toast_compression;
+
+	/* attoptcache keeps the options; we get a palloc'd copy of them */
+	aopts = get_attribute_options(RelationGetRelid(rel), attnum);
+	if (aopts == NULL)
+		return default_toast_compression;
+
+	/*
+	 * If the option names a method the server has since been built without,
+	 * stay with the default; the option was validated when it was set.
+	 */
+	if (aopts->compression_offset != 0)
+	{
+		name = (char *) aopts + aopts->compression_offset;
+		for (entry = toast_compression_options; entry->name; entry++)
+		{
+			if (strcmp(entry->name, name) == 0)
+			{
+				cmethod = entry->val;
+				break;
+			}
+		}
+	}
+
+	pfree(aopts);
+
+	return cmethod;
+}
+
+/* ----------
+ * toast_get_compression_id -
+ *
+ *	Return the compression method of a varlena datum, or
+ *	TOAST_INVALID_COMPRESSION_ID if it isn't compressed.  The method of an
+ *	externally stored value is in the header of the stored data, so the
+ *	value has to be fetched.
+ * ----------
+ */
+int
+toast_get_compression_id(struct varlena * attr)
+{
+	int			cmethod = TOAST_INVALID_COMPRESSION_ID;
+
+	if (VARATT_IS_EXTERNAL_ONDISK(attr))
+	{
+		struct varatt_external toast_pointer;
+
+		VARATT_EXTERNAL_GET_POINTER(toast_pointer, attr);
+
+		if (VARATT_EXTERNAL_IS_COMPRESSED(toast_pointer))
+		{
+			struct varlena *tmp = toast_fetch_datum(attr);
+
+			cmethod = TOAST_COMPRESS_METHOD(tmp);
+			pfree(tmp);
+		}
+	}
+	else if (VARATT_IS_EXTERNAL_INDIRECT(attr))
+	{
+		struct varatt_indirect toast_pointer;
+
+		VARATT_EXTERNAL_GET_POINTER(toast_pointer, attr);
+
+		/* nested indirect Datums aren't allowed */
+		Assert(!VARATT_IS_EXTERNAL_INDIRECT(toast_pointer.pointer));
+
+		return toast_get_compression_id(toast_pointer.pointer);
+	}
+	else if (VARATT_IS_COMPRESSED(attr))
+		cmethod = TOAST_COMPRESS_METHOD(attr);
+
+	return cmethod;
+}
+
+/* ----------
+ * toast_compression_name -
+ *
+ *	Return the name of a compression method
+ * ----------
+ */
+const char *
+toast_compression_name(int cmethod)
+{
+	switch (cmethod)
+	{
+		case TOAST_PGLZ_COMPRESSION_ID:
+			return "pglz";
+		case TOAST_LZ4_COMPRESSION_ID:
+			return "lz4";
+		case TOAST_ZSTD_COMPRESSION_ID:
+			return "zstd";
+	}
+	return "unknown";
+}
+
+/* ----------
+ * toastValidateCompressionOption -
+ *
+ *	Check the value of the "compression" attribute option
+ * ----------
+ */
+void
+toastValidateCompressionOption(char *value)
+{
+	const struct config_enum_entry *entry;
+
+	if (value != NULL)
+	{
+		for (entry = toast_compression_options; entry->name; entry++)
+		{
+			if (strcmp(entry->name, value) == 0)
+				return;
+		}
+
+		if (strcmp(value, "lz4") == 0 || strcmp(value, "zstd") == 0)
+			ereport(ERROR,
+					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+					 errmsg("compression method \"%s\" is not supported by this build",
+							value)));
+	}
+
+	ereport(ERROR,
+			(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+			 errmsg("invalid value for \"compression\" option"),
+			 errdetail("Valid values are \"pglz\", \"lz4\", and \"zstd\".")));
+}
+
 
 /* ----------
  * toast_open_indexes
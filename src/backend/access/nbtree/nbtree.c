@@ -23,10 +23,14 @@
 #include "access/xlog.h"
 #include "catalog/index.h"
 #include "commands/vacuum.h"
+#include "miscadmin.h"
 #include "storage/indexfsm.h"
 #include "storage/ipc.h"
+#include "storage/latch.h"
 #include "storage/lmgr.h"
+#include "storage/proc.h"
 #include "storage/smgr.h"
+#include "storage/spin.h"
 #include "tcop/tcopprot.h"		/* pgrminclude ignore */
 #include "utils/index_selfuncs.h"
 #include "utils/memutils.h"
@@ -62,6 +66,52 @@ typedef struct
 	MemoryContext pagedelcontext;
 } BTVacState;
 
+/*
+ * BTPARALLEL_NOT_INITIALIZED indicates that the scan has not started.
+ *
+ * BTPARALLEL_ADVANCING indicates that some process is advancing the scan to
+ * a new page; others must wait.
+ *
+ * BTPARALLEL_IDLE indicates that no backend is currently advancing the scan
+ * to a new page; some process can start doing that.
+ *
+ * BTPARALLEL_DONE indicates that the scan is complete (including error exit).
+ */
+typedef enum
+{
+	BTPARALLEL_NOT_INITIALIZED,
+	BTPARALLEL_ADVANCING,
+	BTPARALLEL_IDLE,
+	BTPARALLEL_DONE
+} BTPS_State;
+
+/*
+ * BTParallelScanDescData contains btree specific shared information required
+ * for parallel scan.
+ *
+ * Participants that find the scan being advanced by someone else record
+ * their pgprocno in btps_waiters and sleep on their latch.  Releasing the
+ * scan wakes the longest waiter; ending it wakes them all.  This tree has no
+ * condition variables, so latches stand in for them.  There is room for the
+ * leader and every possible worker.
+ */
+typedef struct BTParallelScanDescData
+{
+	BlockNumber btps_scanPage;	/* latest or next page to be scanned */
+	BTPS_State	btps_pageStatus;	/* indicates whether next page is
+									 * available for scan. see above for
+									 * possible states of parallel scan. */
+	slock_t		btps_mutex;		/* protects above and below variables */
+	int			btps_maxwaiters;	/* allocated length of btps_waiters */
+	int			btps_nwaiters;	/* # of participants waiting to seize */
+	int			btps_waiters[FLEXIBLE_ARRAY_MEMBER];	/* their pgprocnos */
+} BTParallelScanDescData;
+
+typedef struct BTParallelScanDescData *BTParallelScanDesc;
+
+#define BTParallelScanDescFromScan(pscan) \
+	((BTParallelScanDesc) ((char *) (pscan) + (pscan)->ps_offset))
+
 
 static void btbuildCallback(Relation index,
 				HeapTuple htup,
@@ -74,6 +124,10 @@ static void btvacuumscan(IndexVacuumInfo *info, IndexBulkDeleteResult *stats,
 			 BTCycleId cycleid);
 static void btvacuumpage(BTVacState *vstate, BlockNumber blkno,
 			 BlockNumber orig_blkno);
+static void _bt_parallel_add_waiter(BTParallelScanDesc btscan);
+static void _bt_parallel_remove_waiter(BTParallelScanDesc btscan);
+static int	_bt_parallel_pop_waiter(BTParallelScanDesc btscan);
+static void _bt_parallel_wait(void);
 
 
 /*
@@ -98,6 +152,7 @@ bthandler(PG_FUNCTION_ARGS)
 	amroutine->amstorage = false;
 	amroutine->amclusterable = true;
 	amroutine->ampredlocks = true;
+	amroutine->amcanparallel = true;
 	amroutine->amkeytype = InvalidOid;
 
 	amroutine->ambuild = btbuild;
@@ -117,6 +172,9 @@ bthandler(PG_FUNCTION_ARGS)
 	amroutine->amendscan = btendscan;
 	amroutine->ammarkpos = btmarkpos;
 	amroutine->amrestrpos = btrestrpos;
+	amroutine->amestimateparallelscan = btestimateparallelscan;
+	amroutine->aminitparallelscan = btinitparallelscan;
+	amroutine->amparallelrescan = btparallelrescan;
 
 	PG_RETURN_POINTER(amroutine);
 }
@@ -300,6 +358,14 @@ btgettuple(IndexScanDesc scan, ScanDirection dir)
 	/* btree indexes are never lossy */
 	scan->xs_recheck = false;
 
+	/*
+	 * The participants of a parallel scan share only their position in the
+	 * index, not their progress through the array keys, so the planner
+	 * never generates parallel scans with array keys.
+	 */
+	if (so->numArrayKeys && scan->parallel_scan != NULL)
+		elog(ERROR, "parallel btree scans cannot use array keys");
+
 	/*
 	 * If we have any array keys, initialize them during first call for a
 	 * scan.  We can't do this in btrescan because we don't know the scan
@@ -355,7 +421,10 @@ btgettuple(IndexScanDesc scan, ScanDirection dir)
 
 		/* If we have a tuple, return it ... */
 		if (res)
+		{
+			_bt_prefetch(scan, dir);
 			break;
+		}
 		/* ... otherwise see if we have more array keys to deal with */
 	} while (so->numArrayKeys && _bt_advance_array_keys(scan, dir));
 
@@ -647,6 +716,259 @@ btrestrpos(IndexScanDesc scan)
 	}
 }
 
+/*
+ * btestimateparallelscan -- estimate storage for BTParallelScanDescData
+ */
+Size
+btestimateparallelscan(void)
+{
+	return add_size(offsetof(BTParallelScanDescData, btps_waiters),
+					mul_size(sizeof(int), max_worker_processes + 1));
+}
+
+/*
+ * btinitparallelscan -- initialize BTParallelScanDesc for parallel btree scan
+ */
+void
+btinitparallelscan(void *target)
+{
+	BTParallelScanDesc bt_target = (BTParallelScanDesc) target;
+
+	SpinLockInit(&bt_target->btps_mutex);
+	bt_target->btps_scanPage = InvalidBlockNumber;
+	bt_target->btps_pageStatus = BTPARALLEL_NOT_INITIALIZED;
+	bt_target->btps_maxwaiters = max_worker_processes + 1;
+	bt_target->btps_nwaiters = 0;
+}
+
+/*
+ *	btparallelrescan() -- reset parallel scan
+ */
+void
+btparallelrescan(IndexScanDesc scan)
+{
+	BTParallelScanDesc btscan;
+	ParallelIndexScanDesc parallel_scan = scan->parallel_scan;
+
+	Assert(parallel_scan);
+
+	btscan = BTParallelScanDescFromScan(parallel_scan);
+
+	/*
+	 * In theory, we don't need to acquire the spinlock here, because there
+	 * shouldn't be any other workers running at this point, but we do so for
+	 * consistency.
+	 */
+	SpinLockAcquire(&btscan->btps_mutex);
+	btscan->btps_scanPage = InvalidBlockNumber;
+	btscan->btps_pageStatus = BTPARALLEL_NOT_INITIALIZED;
+	btscan->btps_nwaiters = 0;
+	SpinLockRelease(&btscan->btps_mutex);
+}
+
+/*
+ * _bt_parallel_seize() -- Begin the process of advancing the scan to a new
+ *		page.  Other scans must wait until we call _bt_parallel_release() or
+ *		_bt_parallel_done().
+ *
+ * The return value is true if we successfully seized the scan and false
+ * if we did not.  The latter case occurs if no pages remain.
+ *
+ * If the return value is true, *pageno returns the next page to read (for a
+ * forward scan) or the page to step left from (for a backward scan).  An
+ * invalid block number means the scan hasn't yet started, and P_NONE means
+ * we've reached the end.  The first time a participating process reaches the
+ * last page, it will return true and set *pageno to P_NONE; after that,
+ * further attempts to seize the scan will return false.
+ *
+ * Callers should ignore the value of pageno if the return value is false.
+ */
+bool
+_bt_parallel_seize(IndexScanDesc scan, BlockNumber *pageno)
+{
+	BTParallelScanDesc btscan;
+	bool		status = true;
+
+	btscan = BTParallelScanDescFromScan(scan->parallel_scan);
+
+	*pageno = P_NONE;
+
+	for (;;)
+	{
+		BTPS_State	pageStatus;
+		bool		exit_loop = false;
+
+		SpinLockAcquire(&btscan->btps_mutex);
+		pageStatus = btscan->btps_pageStatus;
+		if (pageStatus == BTPARALLEL_DONE)
+		{
+			/* We're done with this scan. */
+			status = false;
+			exit_loop = true;
+		}
+		else if (pageStatus != BTPARALLEL_ADVANCING)
+		{
+			/* We have successfully seized control of the scan. */
+			btscan->btps_pageStatus = BTPARALLEL_ADVANCING;
+			*pageno = btscan->btps_scanPage;
+			exit_loop = true;
+		}
+		if (exit_loop)
+			_bt_parallel_remove_waiter(btscan);
+		else
+			_bt_parallel_add_waiter(btscan);
+		SpinLockRelease(&btscan->btps_mutex);
+
+		if (exit_loop)
+			break;
+
+		/*
+		 * Somebody else is reading the page that tells where the scan goes
+		 * next.  Sleep until they release the scan and set our latch.
+		 */
+		_bt_parallel_wait();
+	}
+
+	return status;
+}
+
+/*
+ * _bt_parallel_release() -- Complete the process of advancing the scan to a
+ *		new page.  We now have the new value btps_scanPage; some other backend
+ *		can now begin advancing the scan.
+ */
+void
+_bt_parallel_release(IndexScanDesc scan, BlockNumber scan_page)
+{
+	BTParallelScanDesc btscan;
+	int			procno;
+
+	btscan = BTParallelScanDescFromScan(scan->parallel_scan);
+
+	SpinLockAcquire(&btscan->btps_mutex);
+	btscan->btps_scanPage = scan_page;
+	btscan->btps_pageStatus = BTPARALLEL_IDLE;
+	procno = _bt_parallel_pop_waiter(btscan);
+	SpinLockRelease(&btscan->btps_mutex);
+
+	/* Only one participant can seize the scan, so wake just one */
+	if (procno >= 0)
+		SetLatch(&ProcGlobal->allProcs[procno].procLatch);
+}
+
+/*
+ * _bt_parallel_done() -- Mark the parallel scan as complete.
+ *
+ * When there are no pages left to scan, this function should be called to
+ * notify other workers.  Otherwise, they might wait forever for the scan to
+ * advance to the next page.
+ */
+void
+_bt_parallel_done(IndexScanDesc scan)
+{
+	BTParallelScanDesc btscan;
+
+	/* Do nothing, for non-parallel scans */
+	if (scan->parallel_scan == NULL)
+		return;
+
+	btscan = BTParallelScanDescFromScan(scan->parallel_scan);
+
+	SpinLockAcquire(&btscan->btps_mutex);
+	btscan->btps_pageStatus = BTPARALLEL_DONE;
+	SpinLockRelease(&btscan->btps_mutex);
+
+	/* Wake all waiters; they will find the scan done */
+	for (;;)
+	{
+		int			procno;
+
+		SpinLockAcquire(&btscan->btps_mutex);
+		procno = _bt_parallel_pop_waiter(btscan);
+		SpinLockRelease(&btscan->btps_mutex);
+
+		if (procno < 0)
+			break;
+		SetLatch(&ProcGlobal->allProcs[procno].procLatch);
+	}
+}
+
+/*
+ * Add ourselves to the waiters of the parallel scan, unless we're already
+ * there.  The caller must hold btps_mutex.
+ */
+static void
+_bt_parallel_add_waiter(BTParallelScanDesc btscan)
+{
+	int			i;
+
+	for (i = 0; i < btscan->btps_nwaiters; i++)
+	{
+		if (btscan->btps_waiters[i] == MyProc->pgprocno)
+			return;
+	}
+
+	Assert(btscan->btps_nwaiters < btscan->btps_maxwaiters);
+	btscan->btps_waiters[btscan->btps_nwaiters++] = MyProc->pgprocno;
+}
+
+/*
+ * Remove ourselves from the waiters of the parallel scan, if we're there.
+ * The caller must hold btps_mutex.
+ */
+static void
+_bt_parallel_remove_waiter(BTParallelScanDesc btscan)
+{
+	int			i;
+
+	for (i = 0; i < btscan->btps_nwaiters; i++)
+	{
+		if (btscan->btps_waiters[i] == MyProc->pgprocno)
+		{
+			btscan->btps_nwaiters--;
+			memmove(&btscan->btps_waiters[i], &btscan->btps_waiters[i + 1],
+					sizeof(int) * (btscan->btps_nwaiters - i));
+			return;
+		}
+	}
+}
+
+/*
+ * Take the longest waiter off the parallel scan's list and return its
+ * pgprocno, or -1 if nobody is waiting.  The caller must hold btps_mutex,
+ * and set the waiter's latch after releasing it.
+ */
+static int
+_bt_parallel_pop_waiter(BTParallelScanDesc btscan)
+{
+	int			procno;
+
+	if (btscan->btps_nwaiters == 0)
+		return -1;
+
+	procno = btscan->btps_waiters[0];
+	btscan->btps_nwaiters--;
+	memmove(&btscan->btps_waiters[0], &btscan->btps_waiters[1],
+			sizeof(int) * btscan->btps_nwaiters);
+	return procno;
+}
+
+/*
+ * Sleep until the participant that is advancing the scan sets our latch.
+ */
+static void
+_bt_parallel_wait(void)
+{
+	int			rc;
+
+	rc = WaitLatch(MyLatch, WL_LATCH_SET | WL_POSTMASTER_DEATH, 0);
+	if (rc & WL_POSTMASTER_DEATH)
+		proc_exit(1);
+	ResetLatch(MyLatch);
+
+	CHECK_FOR_INTERRUPTS();
+}
+
 /*
  * Bulk deletion of all index entries pointing to a set of heap tuples.
  * The set of target tuples is specified via a callback routine that tells
@@ -30,6 +30,8 @@ static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir,
 static void _bt_saveitem(BTScanOpaque so, int itemIndex,
 			 OffsetNumber offnum, IndexTuple itup);
 static bool _bt_steppage(IndexScanDesc scan, ScanDirection dir);
+static bool _bt_parallel_readpage(IndexScanDesc scan, BlockNumber blkno,
+					  ScanDirection dir);
 static Buffer _bt_walk_left(Relation rel, Buffer buf, Snapshot snapshot);
 static bool _bt_endpoint(IndexScanDesc scan, ScanDirection dir);
 static void _bt_drop_lock_and_maybe_pin(IndexScanDesc scan, BTScanPos sp);
@@ -546,6 +548,7 @@ _bt_first(IndexScanDesc scan, ScanDirection dir)
 	int			i;
 	StrategyNumber strat_total;
 	BTScanPosItem *currItem;
+	BlockNumber blkno;
 
 	Assert(!BTScanPosIsValid(so->currPos));
 
@@ -562,7 +565,29 @@ _bt_first(IndexScanDesc scan, ScanDirection dir)
 	 * never be satisfied (eg, x == 1 AND x > 2).
 	 */
 	if (!so->qual_ok)
+	{
+		/* Notify any other participants that the scan is over. */
+		_bt_parallel_done(scan);
 		return false;
+	}
+
+	/*
+	 * For parallel scans, get the starting page from shared state.  If the
+	 * scan has not started, proceed to find out the first leaf page in the
+	 * usual way while keeping the other participants waiting.  If the scan
+	 * has already begun, continue from the page it has reached.
+	 */
+	if (scan->parallel_scan != NULL)
+	{
+		if (!_bt_parallel_seize(scan, &blkno))
+			return false;
+		else if (blkno != InvalidBlockNumber)
+		{
+			if (!_bt_parallel_readpage(scan, blkno, dir))
+				return false;
+			goto readcomplete;
+		}
+	}
 
 	/*----------
 	 * Examine the scan keys to discover where we need to start the scan.
@@ -773,7 +798,10 @@ _bt_first(IndexScanDesc scan, ScanDirection dir)
 
 			Assert(subkey->sk_flags & SK_ROW_MEMBER);
 			if (subkey->sk_flags & SK_ISNULL)
+			{
+				_bt_parallel_done(scan);
 				return false;
+			}
 			memcpy(scankeys + i, subkey, sizeof(ScanKeyData));
 
 			/*
@@ -993,6 +1021,12 @@ _bt_first(IndexScanDesc scan, ScanDirection dir)
 		 * because nothing finer to lock exists.
 		 */
 		PredicateLockRelation(rel, scan->xs_snapshot);
+
+		/*
+		 * mark parallel scan as done, so that all the workers can finish
+		 * their scan
+		 */
+		_bt_parallel_done(scan);
 		return false;
 	}
 	else
@@ -1060,6 +1094,7 @@ _bt_first(IndexScanDesc scan, ScanDirection dir)
 		_bt_drop_lock_and_maybe_pin(scan, &so->currPos);
 	}
 
+readcomplete:
 	/* OK, itemIndex says what to return */
 	currItem = &so->currPos.items[so->currPos.itemIndex];
 	scan->xs_ctup.t_self = currItem->heapTid;
@@ -1119,6 +1154,67 @@ _bt_next(IndexScanDesc scan, ScanDirection dir)
 	return true;
 }
 
+/*
+ *	_bt_prefetch() -- Prefetch heap pages of items ahead of the current one
+ *
+ * Called each time the scan returns an item.  All the matching items of a
+ * leaf page are known as soon as the page is read, so there is no need to
+ * fetch their heap tuples one synchronous read at a time: we keep prefetch
+ * requests in flight for the heap pages of the next items, up to
+ * effective_io_concurrency pages ahead.  That matters most for the edge
+ * lookups of graph traversals, which fetch the edges of a vertex through
+ * the start or end index of the edge label, and which are scattered all over
+ * the heap.
+ *
+ * Items of following leaf pages are not prefetched until we step onto them.
+ */
+void
+_bt_prefetch(IndexScanDesc scan, ScanDirection dir)
+{
+#ifdef USE_PREFETCH
+	BTScanOpaque so = (BTScanOpaque) scan->opaque;
+	ItemPointerData tids[MaxIndexTuplesPerPage];
+	int			ntids = 0;
+	int			item;
+
+	/* index-only scans mostly don't visit the heap */
+	if (target_prefetch_pages <= 0 || scan->xs_want_itup ||
+		scan->heapRelation == NULL)
+		return;
+
+	/*
+	 * Issue more requests once no more than half of the prefetched items
+	 * are left.  That's measured in items, not pages, for simplicity.
+	 */
+	if (ScanDirectionIsForward(dir))
+	{
+		if (so->prefetchItem <= so->currPos.itemIndex)
+			so->prefetchItem = so->currPos.itemIndex + 1;
+		if (so->prefetchItem - so->currPos.itemIndex - 1 >
+			target_prefetch_pages / 2)
+			return;
+
+		for (item = so->prefetchItem; item <= so->currPos.lastItem; item++)
+			tids[ntids++] = so->currPos.items[item].heapTid;
+		so->prefetchItem += PrefetchBufferTids(scan->heapRelation, tids, ntids,
+											   target_prefetch_pages);
+	}
+	else
+	{
+		if (so->prefetchItem >= so->currPos.itemIndex)
+			so->prefetchItem = so->currPos.itemIndex - 1;
+		if (so->currPos.itemIndex - so->prefetchItem - 1 >
+			target_prefetch_pages / 2)
+			return;
+
+		for (item = so->prefetchItem; item >= so->currPos.firstItem; item--)
+			tids[ntids++] = so->currPos.items[item].heapTid;
+		so->prefetchItem -= PrefetchBufferTids(scan->heapRelation, tids, ntids,
+											   target_prefetch_pages);
+	}
+#endif   /* USE_PREFETCH */
+}
+
 /*
  *	_bt_readpage() -- Load data from current index page into so->currPos
  *
@@ -1132,6 +1228,10 @@ _bt_next(IndexScanDesc scan, ScanDirection dir)
  * moreLeft or moreRight (as appropriate) is cleared if _bt_checkkeys reports
  * that there can be no more matching tuples in the current scan direction.
  *
+ * In the case of a parallel scan, caller must have called _bt_parallel_seize
+ * prior to calling this function; this function will invoke
+ * _bt_parallel_release before returning.
+ *
  * Returns true if any matching items found on the page, false if none.
  */
 static bool
@@ -1154,6 +1254,16 @@ _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber offnum)
 
 	page = BufferGetPage(so->currPos.buf);
 	opaque = (BTPageOpaque) PageGetSpecialPointer(page);
+
+	/* allow next page be processed by parallel worker */
+	if (scan->parallel_scan)
+	{
+		if (ScanDirectionIsForward(dir))
+			_bt_parallel_release(scan, opaque->btpo_next);
+		else
+			_bt_parallel_release(scan, BufferGetBlockNumber(so->currPos.buf));
+	}
+
 	minoff = P_FIRSTDATAKEY(opaque);
 	maxoff = PageGetMaxOffsetNumber(page);
 
@@ -1249,6 +1359,9 @@ _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber offnum)
 		so->currPos.itemIndex = MaxIndexTuplesPerPage - 1;
 	}
 
+	/* nothing on the new page has been prefetched yet */
+	so->prefetchItem = so->currPos.itemIndex;
+
 	return (so->currPos.firstItem <= so->currPos.lastItem);
 }
 
@@ -1321,6 +1434,32 @@ _bt_steppage(IndexScanDesc scan, ScanDirection dir)
 
 	rel = scan->indexRelation;
 
+	if (scan->parallel_scan != NULL)
+	{
+		BlockNumber blkno;
+
+		/* release the previous buffer, if pinned */
+		BTScanPosUnpinIfPinned(so->currPos);
+
+		/*
+		 * If our last page showed that nothing further can match, tell the
+		 * others; otherwise take the next page from the shared state.
+		 */
+		if (ScanDirectionIsForward(dir) ? !so->currPos.moreRight :
+			!so->currPos.moreLeft)
+		{
+			_bt_parallel_done(scan);
+			BTScanPosInvalidate(so->currPos);
+			return false;
+		}
+		if (!_bt_parallel_seize(scan, &blkno))
+		{
+			BTScanPosInvalidate(so->currPos);
+			return false;
+		}
+		return _bt_parallel_readpage(scan, blkno, dir);
+	}
+
 	if (ScanDirectionIsForward(dir))
 	{
 		/* Walk right to the next page with data */
@@ -1441,6 +1580,118 @@ _bt_steppage(IndexScanDesc scan, ScanDirection dir)
 	return true;
 }
 
+/*
+ *	_bt_parallel_readpage() -- Read the next page with matching data in a
+ *		parallel scan
+ *
+ * On entry, we have seized the parallel scan, and blkno is the block number
+ * it handed us: the page to read for a forward scan, or the page to step
+ * left from for a backward scan.  so->currPos holds no pin or lock.  Every
+ * page we read releases the scan again (in _bt_readpage), so if a page has
+ * no matching data, we have to seize the scan anew to get another one.
+ *
+ * Exit conditions are the same as for _bt_steppage().
+ */
+static bool
+_bt_parallel_readpage(IndexScanDesc scan, BlockNumber blkno,
+					  ScanDirection dir)
+{
+	BTScanOpaque so = (BTScanOpaque) scan->opaque;
+	Relation	rel = scan->indexRelation;
+	Page		page;
+	BTPageOpaque opaque;
+
+	for (;;)
+	{
+		/* if we're at end of scan, give up */
+		if (blkno == P_NONE)
+		{
+			_bt_parallel_done(scan);
+			BTScanPosInvalidate(so->currPos);
+			return false;
+		}
+
+		/* check for interrupts while we're not holding any buffer lock */
+		CHECK_FOR_INTERRUPTS();
+
+		so->currPos.moreLeft = true;
+		so->currPos.moreRight = true;
+
+		if (ScanDirectionIsForward(dir))
+		{
+			so->currPos.buf = _bt_getbuf(rel, blkno, BT_READ);
+			page = BufferGetPage(so->currPos.buf);
+			TestForOldSnapshot(scan->xs_snapshot, rel, page);
+			opaque = (BTPageOpaque) PageGetSpecialPointer(page);
+			if (!P_IGNORE(opaque))
+			{
+				PredicateLockPage(rel, blkno, scan->xs_snapshot);
+				/* see if there are any matches on this page */
+				/* note that this will clear moreRight if we can stop */
+				if (_bt_readpage(scan, dir, P_FIRSTDATAKEY(opaque)))
+					break;
+			}
+			else
+				_bt_parallel_release(scan, opaque->btpo_next);
+		}
+		else
+		{
+			/*
+			 * Step left from the page the previous participant read, the
+			 * same way _bt_steppage does when it holds no pin on it.
+			 */
+			so->currPos.buf = _bt_walk_left(rel,
+											_bt_getbuf(rel, blkno, BT_READ),
+											scan->xs_snapshot);
+
+			/* if we're physically at end of index, return failure */
+			if (so->currPos.buf == InvalidBuffer)
+			{
+				_bt_parallel_done(scan);
+				BTScanPosInvalidate(so->currPos);
+				return false;
+			}
+
+			page = BufferGetPage(so->currPos.buf);
+			TestForOldSnapshot(scan->xs_snapshot, rel, page);
+			opaque = (BTPageOpaque) PageGetSpecialPointer(page);
+			if (!P_IGNORE(opaque))
+			{
+				PredicateLockPage(rel, BufferGetBlockNumber(so->currPos.buf),
+								  scan->xs_snapshot);
+				/* see if there are any matches on this page */
+				/* note that this will clear moreLeft if we can stop */
+				if (_bt_readpage(scan, dir, PageGetMaxOffsetNumber(page)))
+					break;
+			}
+			else
+				_bt_parallel_release(scan,
+									 BufferGetBlockNumber(so->currPos.buf));
+		}
+
+		/* nope, release the page and ask for another one */
+		_bt_relbuf(rel, so->currPos.buf);
+
+		if (ScanDirectionIsForward(dir) ? !so->currPos.moreRight :
+			!so->currPos.moreLeft)
+		{
+			_bt_parallel_done(scan);
+			BTScanPosInvalidate(so->currPos);
+			return false;
+		}
+		if (!_bt_parallel_seize(scan, &blkno))
+		{
+			BTScanPosInvalidate(so->currPos);
+			return false;
+		}
+	}
+
+	/* Drop the lock, and maybe the pin, on the current page */
+	_bt_drop_lock_and_maybe_pin(scan, &so->currPos);
+
+	return true;
+}
+
 /*
  * _bt_walk_left() -- step left one page, if possible
  *
@@ -1682,6 +1933,7 @@ _bt_endpoint(IndexScanDesc scan, ScanDirection dir)
 		 */
 		PredicateLockRelation(rel, scan->xs_snapshot);
 		BTScanPosInvalidate(so->currPos);
+		_bt_parallel_done(scan);
 		return false;
 	}
 
@@ -0,0 +1,699 @@
+/*-------------------------------------------------------------------------
+ *
+ * redoworker.c
+ *	  Parallel WAL replay using background worker processes
+ *
+ * When recovery_workers is set, the startup process launches that many
+ * background workers when redo begins, and hands records that touch a
+ * single data block over to them instead of replaying them itself.  The
+ * worker is chosen by a hash of the block, so all changes to one block are
+ * replayed by the same worker, in WAL order.  Changes to different blocks
+ * are independent of each other, which is what lets them be replayed out of
+ * order.
+ *
+ * Every other record -- commits, CLOG, relation map and DDL records, and
+ * anything touching more than one block -- acts as a barrier: the startup
+ * process waits for the workers to finish everything dispatched so far, and
+ * then replays the record itself.  In particular, a transaction's commit
+ * record is only replayed after all of its changes, so hot standby queries
+ * never see its effects incompletely applied.
+ *
+ * Records are handed over in their raw form over a shm_mq per worker, and
+ * the worker decodes them again with xlogreader.c, to get its own copy of
+ * the decoded block references.
+ *
+ * Only record types whose redo routine looks at nothing but its own block
+ * (and the visibility map or FSM pages, which are locked anyway) are
+ * dispatched.  Records that need a cleanup lock are not, because waiting for
+ * a buffer pin in hot standby works only in the startup process.
+ *
+ * Before a consistent state is reached, which in crash recovery means until
+ * the end of WAL, a record may refer to a page or relation that a later
+ * record drops.  Such references are remembered in the startup process'
+ * private invalid-page table, so a worker sends them back over a second
+ * queue, and the startup process adds them to the table whenever it waits
+ * for the workers.  Every drop or truncation is a barrier, so they arrive
+ * before the record that would resolve them is replayed.
+ *
+ * The files of dropped and truncated relations are unlinked or shortened by
+ * the startup process, but the workers may still have them open.  After such
+ * a record, the workers are told to close all their files.
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ *
+ * IDENTIFICATION
+ *	  src/backend/access/transam/redoworker.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "access/heapam_xlog.h"
+#include "access/nbtree.h"
+#include "access/redoworker.h"
+#include "access/xact.h"
+#include "access/xlog.h"
+#include "access/xlog_internal.h"
+#include "access/xlogutils.h"
+#include "catalog/pg_control.h"
+#include "catalog/storage_xlog.h"
+#include "commands/dbcommands_xlog.h"
+#include "commands/tablespace.h"
+#include "miscadmin.h"
+#include "postmaster/bgworker.h"
+#include "postmaster/startup.h"
+#include "storage/ipc.h"
+#include "storage/latch.h"
+#include "storage/proc.h"
+#include "storage/shm_mq.h"
+#include "storage/shmem.h"
+#include "storage/smgr.h"
+#include "utils/hashutils.h"
+#include "utils/memutils.h"
+
+/* size of the queue of each worker, and of the queue back from it */
+#define REDO_QUEUE_SIZE		(256 * 1024)
+#define REDO_REPORT_QUEUE_SIZE	(16 * 1024)
+
+/*
+ * Header of a record handed over to a worker; the raw record follows.  A
+ * header with an invalid ReadRecPtr and no record tells the worker to close
+ * its files.
+ */
+typedef struct RedoRecordHeader
+{
+	XLogRecPtr	ReadRecPtr;
+	XLogRecPtr	EndRecPtr;
+} RedoRecordHeader;
+
+/* a reference to an invalid page, sent back by a worker */
+typedef struct RedoInvalidPageReport
+{
+	RelFileNode node;
+	ForkNumber	forkno;
+	BlockNumber blkno;
+	bool		present;
+} RedoInvalidPageReport;
+
+typedef struct RedoWorkerSlot
+{
+	pg_atomic_uint32 applied;	/* number of messages processed */
+	shm_mq	   *mq;				/* startup process -> worker */
+	shm_mq	   *reportmq;		/* worker -> startup process */
+} RedoWorkerSlot;
+
+typedef struct RedoWorkerCtlData
+{
+	PGPROC	   *startupProc;
+
+	/* set while the startup process waits for the workers to catch up */
+	pg_atomic_uint32 startupWaiting;
+
+	RedoWorkerSlot slots[FLEXIBLE_ARRAY_MEMBER];
+} RedoWorkerCtlData;
+
+static RedoWorkerCtlData *RedoWorkerCtl = NULL;
+
+int			recovery_workers = 0;
+
+bool		IsRedoWorker = false;
+
+/* startup process' state */
+static int	nRedoWorkers = 0;
+static shm_mq_handle *redoQueues[MAX_REDO_WORKERS];
+static shm_mq_handle *redoReportQueues[MAX_REDO_WORKERS];
+static BackgroundWorkerHandle *redoHandles[MAX_REDO_WORKERS];
+static uint32 redoDispatched[MAX_REDO_WORKERS];
+static bool redoFilesOpen[MAX_REDO_WORKERS];
+static bool redoOutstanding = false;
+static uint64 redoRecordsDispatched = 0;
+
+/* a redo worker's end of its report queue */
+static shm_mq_handle *redoReportQueue = NULL;
+
+static void SendToRedoWorker(int workerno, shm_mq_iovec *iov, int iovcnt);
+static void ReceiveRedoWorkerReports(void);
+static bool RedoRecordIsParallelSafe(XLogReaderState *record);
+static bool RedoRecordDropsFiles(XLogReaderState *record);
+static void redo_worker_error_callback(void *arg);
+
+
+/*
+ * Report shared memory space needed by RedoWorkerShmemInit
+ */
+Size
+RedoWorkerShmemSize(void)
+{
+	Size		size;
+
+	size = offsetof(RedoWorkerCtlData, slots);
+	size = add_size(size, mul_size(sizeof(RedoWorkerSlot), recovery_workers));
+	size = MAXALIGN(size);
+	size = add_size(size, mul_size(REDO_QUEUE_SIZE + REDO_REPORT_QUEUE_SIZE,
+								   recovery_workers));
+
+	return size;
+}
+
+/*
+ * Allocate and initialize shared memory for the redo workers
+ */
+void
+RedoWorkerShmemInit(void)
+{
+	bool		found;
+	char	   *queues;
+	int			i;
+
+	RedoWorkerCtl = (RedoWorkerCtlData *)
+		ShmemInitStruct("Redo Worker Data", RedoWorkerShmemSize(), &found);
+
+	if (found)
+		return;
+
+	RedoWorkerCtl->startupProc = NULL;
+	pg_atomic_init_u32(&RedoWorkerCtl->startupWaiting, 0);
+
+	queues = (char *) RedoWorkerCtl +
+		MAXALIGN(offsetof(RedoWorkerCtlData, slots) +
+				 sizeof(RedoWorkerSlot) * recovery_workers);
+	for (i = 0; i < recovery_workers; i++)
+	{
+		pg_atomic_init_u32(&RedoWorkerCtl->slots[i].applied, 0);
+		RedoWorkerCtl->slots[i].mq = (shm_mq *) queues;
+		queues += REDO_QUEUE_SIZE;
+		RedoWorkerCtl->slots[i].reportmq = (shm_mq *) queues;
+		queues += REDO_REPORT_QUEUE_SIZE;
+	}
+}
+
+/*
+ * Launch the redo workers.  Called by the startup process when redo begins.
+ *
+ * If fewer workers than requested can be registered, we make do with those;
+ * with none, all records are replayed by the startup process as usual.
+ */
+void
+StartRedoWorkers(void)
+{
+	BackgroundWorker worker;
+	int			i;
+
+	Assert(nRedoWorkers == 0);
+
+	/* a standalone backend has no postmaster to launch workers */
+	if (recovery_workers == 0 || !IsUnderPostmaster)
+		return;
+
+	RedoWorkerCtl->startupProc = MyProc;
+
+	memset(&worker, 0, sizeof(worker));
+	worker.bgw_flags = BGWORKER_SHMEM_ACCESS;
+	worker.bgw_start_time = BgWorkerStart_PostmasterStart;
+	worker.bgw_restart_time = BGW_NEVER_RESTART;
+	worker.bgw_main = RedoWorkerMain;
+	worker.bgw_notify_pid = MyProcPid;
+
+	for (i = 0; i < recovery_workers; i++)
+	{
+		RedoWorkerSlot *slot = &RedoWorkerCtl->slots[i];
+		shm_mq	   *mq;
+		shm_mq	   *reportmq;
+
+		snprintf(worker.bgw_name, BGW_MAXLEN, "redo worker %d", i);
+		worker.bgw_main_arg = Int32GetDatum(i);
+
+		mq = shm_mq_create(slot->mq, REDO_QUEUE_SIZE);
+		shm_mq_set_sender(mq, MyProc);
+		reportmq = shm_mq_create(slot->reportmq, REDO_REPORT_QUEUE_SIZE);
+		shm_mq_set_receiver(reportmq, MyProc);
+		pg_atomic_write_u32(&slot->applied, 0);
+
+		if (!RegisterDynamicBackgroundWorker(&worker, &redoHandles[i]))
+			break;
+
+		redoQueues[i] = shm_mq_attach(mq, NULL, redoHandles[i]);
+		redoReportQueues[i] = shm_mq_attach(reportmq, NULL, redoHandles[i]);
+		redoDispatched[i] = 0;
+		redoFilesOpen[i] = false;
+	}
+	nRedoWorkers = i;
+	redoRecordsDispatched = 0;
+
+	if (nRedoWorkers > 0)
+		ereport(LOG,
+				(errmsg("using %d redo workers", nRedoWorkers)));
+	if (nRedoWorkers < recovery_workers)
+		ereport(LOG,
+				(errmsg("could only register %d of %d redo workers",
+						nRedoWorkers, recovery_workers),
+				 errhint("Consider increasing max_worker_processes.")));
+}
+
+/*
+ * Hand a record over to a redo worker, if it can be replayed by one.
+ *
+ * Returns false if the caller must replay the record itself.  In that case,
+ * all the records dispatched earlier have been replayed by the time we
+ * return.
+ */
+bool
+DispatchRedoRecord(XLogReaderState *record)
+{
+	RedoRecordHeader hdr;
+	shm_mq_iovec iov[2];
+	RelFileNode rnode;
+	ForkNumber	forknum;
+	BlockNumber blkno;
+	int			workerno;
+
+	if (nRedoWorkers == 0)
+		return false;
+
+	if (!RedoRecordIsParallelSafe(record))
+	{
+		WaitForRedoWorkers();
+
+		/*
+		 * If the record is going to unlink or truncate relation files, make
+		 * the workers close theirs.  They are idle, and won't open any file
+		 * again before we have replayed the record.
+		 */
+		if (RedoRecordDropsFiles(record))
+		{
+			hdr.ReadRecPtr = InvalidXLogRecPtr;
+			hdr.EndRecPtr = InvalidXLogRecPtr;
+			iov[0].data = (char *) &hdr;
+			iov[0].len = sizeof(hdr);
+
+			for (workerno = 0; workerno < nRedoWorkers; workerno++)
+			{
+				if (!redoFilesOpen[workerno])
+					continue;
+				SendToRedoWorker(workerno, iov, 1);
+				redoFilesOpen[workerno] = false;
+			}
+		}
+		return false;
+	}
+
+	XLogRecGetBlockTag(record, 0, &rnode, &forknum, &blkno);
+	workerno = murmurhash64(((uint64) rnode.relNode << 32 | blkno) ^
+							((uint64) forknum << 30)) % nRedoWorkers;
+
+	hdr.ReadRecPtr = record->ReadRecPtr;
+	hdr.EndRecPtr = record->EndRecPtr;
+	iov[0].data = (char *) &hdr;
+	iov[0].len = sizeof(hdr);
+	iov[1].data = (char *) record->decoded_record;
+	iov[1].len = record->decoded_record->xl_tot_len;
+
+	SendToRedoWorker(workerno, iov, 2);
+	redoFilesOpen[workerno] = true;
+	redoRecordsDispatched++;
+
+	return true;
+}
+
+/*
+ * Send a message to a redo worker.
+ *
+ * If the worker's queue is full, it might itself be waiting for us to read
+ * its report queue, so we must not block on the send alone.
+ */
+static void
+SendToRedoWorker(int workerno, shm_mq_iovec *iov, int iovcnt)
+{
+	for (;;)
+	{
+		shm_mq_result res;
+
+		/* a partially sent message must be retried with the same data */
+		res = shm_mq_sendv(redoQueues[workerno], iov, iovcnt, true);
+		if (res == SHM_MQ_SUCCESS)
+			break;
+		if (res == SHM_MQ_DETACHED)
+			ereport(FATAL,
+					(errmsg("redo worker %d exited unexpectedly", workerno)));
+
+		ReceiveRedoWorkerReports();
+
+		WaitLatch(MyLatch, WL_LATCH_SET | WL_POSTMASTER_DEATH, 0);
+		ResetLatch(MyLatch);
+
+		/* Handle interrupt signals of startup process */
+		HandleStartupProcInterrupts();
+	}
+
+	redoDispatched[workerno]++;
+	redoOutstanding = true;
+}
+
+/*
+ * Add the invalid-page references reported by the workers so far to our
+ * invalid-page table.
+ */
+static void
+ReceiveRedoWorkerReports(void)
+{
+	int			i;
+
+	for (i = 0; i < nRedoWorkers; i++)
+	{
+		for (;;)
+		{
+			RedoInvalidPageReport report;
+			Size		nbytes;
+			void	   *data;
+
+			if (shm_mq_receive(redoReportQueues[i], &nbytes, &data,
+							   true) != SHM_MQ_SUCCESS)
+				break;
+
+			Assert(nbytes == sizeof(report));
+			memcpy(&report, data, sizeof(report));
+			XLogRememberInvalidPage(report.node, report.forkno,
+									report.blkno, report.present);
+		}
+	}
+}
+
+/*
+ * Wait until the redo workers have replayed all the records dispatched to
+ * them.
+ */
+void
+WaitForRedoWorkers(void)
+{
+	if (!redoOutstanding)
+		return;
+
+	pg_atomic_write_u32(&RedoWorkerCtl->startupWaiting, 1);
+
+	for (;;)
+	{
+		bool		done = true;
+		int			i;
+
+		/* pairs with the increment of "applied" in the workers */
+		pg_memory_barrier();
+
+		for (i = 0; i < nRedoWorkers; i++)
+		{
+			pid_t		pid;
+
+			if (pg_atomic_read_u32(&RedoWorkerCtl->slots[i].applied) ==
+				redoDispatched[i])
+				continue;
+
+			if (GetBackgroundWorkerPid(redoHandles[i], &pid) == BGWH_STOPPED)
+				ereport(FATAL,
+						(errmsg("redo worker %d exited unexpectedly", i)));
+			done = false;
+			break;
+		}
+
+		/*
+		 * A worker sends its reports before counting the record as applied,
+		 * so once we have seen everything applied, this gets all of them.
+		 * Until then, it also unblocks workers waiting for queue space.
+		 */
+		ReceiveRedoWorkerReports();
+
+		if (done)
+			break;
+
+		WaitLatch(MyLatch, WL_LATCH_SET | WL_TIMEOUT | WL_POSTMASTER_DEATH,
+				  1000L);
+		ResetLatch(MyLatch);
+
+		/* Handle interrupt signals of startup process */
+		HandleStartupProcInterrupts();
+	}
+
+	pg_atomic_write_u32(&RedoWorkerCtl->startupWaiting, 0);
+	redoOutstanding = false;
+}
+
+/*
+ * Wait for the redo workers to finish, and tell them to exit.  Called by the
+ * startup process at the end of redo.
+ */
+void
+StopRedoWorkers(void)
+{
+	int			i;
+
+	if (nRedoWorkers == 0)
+		return;
+
+	WaitForRedoWorkers();
+
+	ereport(LOG,
+			(errmsg("redo workers replayed " UINT64_FORMAT " records",
+					redoRecordsDispatched)));
+
+	/* detaching from the queues makes the workers exit */
+	for (i = 0; i < nRedoWorkers; i++)
+	{
+		shm_mq_detach(shm_mq_get_queue(redoQueues[i]));
+		shm_mq_detach(shm_mq_get_queue(redoReportQueues[i]));
+	}
+	nRedoWorkers = 0;
+}
+
+/*
+ * Can 'record' be replayed by a redo worker?
+ *
+ * It must reference exactly one block, and its redo routine must not need
+ * anything besides that block: no cleanup lock, no hot standby conflict
+ * resolution, no state kept in the startup process.
+ */
+static bool
+RedoRecordIsParallelSafe(XLogReaderState *record)
+{
+	uint8		info = XLogRecGetInfo(record) & ~XLR_INFO_MASK;
+
+	if (record->max_block_id != 0)
+		return false;
+
+	switch (XLogRecGetRmid(record))
+	{
+		case RM_XLOG_ID:
+			return info == XLOG_FPI || info == XLOG_FPI_FOR_HINT;
+
+		case RM_HEAP_ID:
+			switch (info & XLOG_HEAP_OPMASK)
+			{
+				case XLOG_HEAP_INSERT:
+				case XLOG_HEAP_DELETE:
+				case XLOG_HEAP_UPDATE:
+				case XLOG_HEAP_HOT_UPDATE:
+				case XLOG_HEAP_CONFIRM:
+				case XLOG_HEAP_LOCK:
+				case XLOG_HEAP_INPLACE:
+					return true;
+			}
+			return false;
+
+		case RM_HEAP2_ID:
+			info &= XLOG_HEAP_OPMASK;
+			return info == XLOG_HEAP2_MULTI_INSERT ||
+				info == XLOG_HEAP2_LOCK_UPDATED;
+
+		case RM_BTREE_ID:
+			return info == XLOG_BTREE_INSERT_LEAF;
+
+		default:
+			return false;
+	}
+}
+
+/*
+ * Does replaying 'record' unlink or truncate relation files?
+ */
+static bool
+RedoRecordDropsFiles(XLogReaderState *record)
+{
+	uint8		info = XLogRecGetInfo(record) & ~XLR_INFO_MASK;
+
+	switch (XLogRecGetRmid(record))
+	{
+		case RM_SMGR_ID:
+			return info == XLOG_SMGR_TRUNCATE;
+
+		case RM_DBASE_ID:
+			return info == XLOG_DBASE_DROP;
+
+		case RM_TBLSPC_ID:
+			return info == XLOG_TBLSPC_DROP;
+
+		case RM_XACT_ID:
+			switch (info & XLOG_XACT_OPMASK)
+			{
+				case XLOG_XACT_COMMIT:
+				case XLOG_XACT_COMMIT_PREPARED:
+					{
+						xl_xact_parsed_commit parsed;
+
+						ParseCommitRecord(XLogRecGetInfo(record),
+									 (xl_xact_commit *) XLogRecGetData(record),
+										  &parsed);
+						return parsed.nrels > 0;
+					}
+				case XLOG_XACT_ABORT:
+				case XLOG_XACT_ABORT_PREPARED:
+					{
+						xl_xact_parsed_abort parsed;
+
+						ParseAbortRecord(XLogRecGetInfo(record),
+									  (xl_xact_abort *) XLogRecGetData(record),
+										 &parsed);
+						return parsed.nrels > 0;
+					}
+			}
+			return false;
+
+		default:
+			return false;
+	}
+}
+
+/*
+ * Main entry point of a redo worker
+ */
+void
+RedoWorkerMain(Datum main_arg)
+{
+	int			workerno = DatumGetInt32(main_arg);
+	RedoWorkerSlot *slot = &RedoWorkerCtl->slots[workerno];
+	shm_mq_handle *mqh;
+	XLogReaderState *reader;
+	MemoryContext redoContext;
+	ErrorContextCallback errcallback;
+
+	BackgroundWorkerUnblockSignals();
+
+	/*
+	 * We replay records like the startup process does.  Invalid-page
+	 * references are passed on to it, see RedoWorkerReportInvalidPage.
+	 */
+	IsRedoWorker = true;
+	InRecovery = true;
+
+	shm_mq_set_receiver(slot->mq, MyProc);
+	mqh = shm_mq_attach(slot->mq, NULL, NULL);
+	shm_mq_set_sender(slot->reportmq, MyProc);
+	redoReportQueue = shm_mq_attach(slot->reportmq, NULL, NULL);
+
+	reader = XLogReaderAllocate(NULL, NULL);
+	if (!reader)
+		ereport(ERROR,
+				(errcode(ERRCODE_OUT_OF_MEMORY),
+				 errmsg("out of memory"),
+				 errdetail("Failed while allocating an XLog reading processor.")));
+
+	redoContext = AllocSetContextCreate(TopMemoryContext,
+										"Redo worker",
+										ALLOCSET_DEFAULT_SIZES);
+
+	errcallback.callback = redo_worker_error_callback;
+	errcallback.arg = (void *) reader;
+	errcallback.previous = NULL;
+
+	for (;;)
+	{
+		RedoRecordHeader hdr;
+		Size		nbytes;
+		void	   *data;
+		char	   *errormsg;
+		MemoryContext oldcontext;
+
+		CHECK_FOR_INTERRUPTS();
+
+		if (shm_mq_receive(mqh, &nbytes, &data, false) != SHM_MQ_SUCCESS)
+			break;				/* the startup process is done */
+
+		Assert(nbytes >= sizeof(hdr));
+		memcpy(&hdr, data, sizeof(hdr));
+
+		if (XLogRecPtrIsInvalid(hdr.ReadRecPtr))
+		{
+			/* the startup process is about to drop or truncate files */
+			smgrcloseall();
+		}
+		else
+		{
+			oldcontext = MemoryContextSwitchTo(redoContext);
+
+			reader->ReadRecPtr = hdr.ReadRecPtr;
+			reader->EndRecPtr = hdr.EndRecPtr;
+			if (!DecodeXLogRecord(reader,
+								(XLogRecord *) ((char *) data + sizeof(hdr)),
+								  &errormsg))
+				elog(PANIC, "could not decode WAL record at %X/%X: %s",
+					 (uint32) (hdr.ReadRecPtr >> 32), (uint32) hdr.ReadRecPtr,
+					 errormsg);
+
+			error_context_stack = &errcallback;
+			RmgrTable[XLogRecGetRmid(reader)].rm_redo(reader);
+			error_context_stack = NULL;
+
+			MemoryContextSwitchTo(oldcontext);
+			MemoryContextReset(redoContext);
+		}
+
+		/* the increment is a full barrier, so this can't miss a waiter */
+		pg_atomic_fetch_add_u32(&slot->applied, 1);
+		if (pg_atomic_read_u32(&RedoWorkerCtl->startupWaiting))
+			SetLatch(&RedoWorkerCtl->startupProc->procLatch);
+	}
+
+	proc_exit(0);
+}
+
+/*
+ * Pass a reference to an invalid page on to the startup process, which keeps
+ * the invalid-page table.  Called by log_invalid_page in a redo worker.
+ */
+void
+RedoWorkerReportInvalidPage(RelFileNode node, ForkNumber forkno,
+							BlockNumber blkno, bool present)
+{
+	RedoInvalidPageReport report;
+
+	Assert(IsRedoWorker);
+
+	report.node = node;
+	report.forkno = forkno;
+	report.blkno = blkno;
+	report.present = present;
+
+	/* the startup process reads the queue whenever it waits for us */
+	if (shm_mq_send(redoReportQueue, sizeof(report), &report,
+					false) != SHM_MQ_SUCCESS)
+		ereport(FATAL,
+				(errmsg("startup process exited unexpectedly")));
+}
+
+/*
+ * Error context callback for errors occurring in a redo worker
+ */
+static void
+redo_worker_error_callback(void *arg)
+{
+	XLogReaderState *record = (XLogReaderState *) arg;
+	RmgrId		rmid = XLogRecGetRmid(record);
+	const char *id;
+
+	id = RmgrTable[rmid].rm_identify(XLogRecGetInfo(record));
+	if (id == NULL)
+		id = psprintf("UNKNOWN (%X)", XLogRecGetInfo(record) & ~XLR_INFO_MASK);
+
+	errcontext("xlog redo at %X/%X for %s/%s",
+			   (uint32) (record->ReadRecPtr >> 32),
+			   (uint32) record->ReadRecPtr,
+			   RmgrTable[rmid].rm_name, id);
+}
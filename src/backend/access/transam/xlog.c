@@ -24,6 +24,7 @@
 #include "access/clog.h"
 #include "access/commit_ts.h"
 #include "access/multixact.h"
+#include "access/redoworker.h"
 #include "access/rewriteheap.h"
 #include "access/subtrans.h"
 #include "access/timeline.h"
@@ -33,6 +34,7 @@
 #include "access/xact.h"
 #include "access/xlog_internal.h"
 #include "access/xloginsert.h"
+#include "access/xlogprefetch.h"
 #include "access/xlogreader.h"
 #include "access/xlogutils.h"
 #include "catalog/catversion.h"
@@ -93,7 +95,7 @@ char	   *XLogArchiveCommand = NULL;
 bool		EnableHotStandby = false;
 bool		fullPageWrites = true;
 bool		wal_log_hints = false;
-bool		wal_compression = false;
+int			wal_compression = WAL_COMPRESSION_NONE;
 bool		log_checkpoints = false;
 int			sync_method = DEFAULT_SYNC_METHOD;
 int			wal_level = WAL_LEVEL_MINIMAL;
@@ -106,11 +108,13 @@ bool		XLOG_DEBUG = false;
 #endif
 
 /*
- * Number of WAL insertion locks to use. A higher value allows more insertions
- * to happen concurrently, but adds some CPU overhead to flushing the WAL,
- * which needs to iterate all the locks.
+ * Range of the number of WAL insertion locks to use. A higher value allows
+ * more insertions to happen concurrently, but adds some CPU overhead to
+ * flushing the WAL, which needs to iterate all the locks. The actual number
+ * is chosen at startup by XLOGChooseNumInsertLocks().
  */
-#define NUM_XLOGINSERT_LOCKS  8
+#define MIN_XLOGINSERT_LOCKS  8
+#define MAX_XLOGINSERT_LOCKS  64
 
 /*
  * Max distance from last checkpoint, before triggering a new xlog-based
@@ -160,6 +164,29 @@ const struct config_enum_entry archive_mode_options[] = {
 	{NULL, 0, false}
 };
 
+/*
+ * Methods that aren't built in are not accepted.  "on" means pglz, as it did
+ * before there was a choice.
+ */
+const struct config_enum_entry wal_compression_options[] = {
+	{"pglz", WAL_COMPRESSION_PGLZ, false},
+#ifdef USE_LZ4
+	{"lz4", WAL_COMPRESSION_LZ4, false},
+#endif
+#ifdef USE_ZSTD
+	{"zstd", WAL_COMPRESSION_ZSTD, false},
+#endif
+	{"on", WAL_COMPRESSION_PGLZ, false},
+	{"off", WAL_COMPRESSION_NONE, false},
+	{"true", WAL_COMPRESSION_PGLZ, true},
+	{"false", WAL_COMPRESSION_NONE, true},
+	{"yes", WAL_COMPRESSION_PGLZ, true},
+	{"no", WAL_COMPRESSION_NONE, true},
+	{"1", WAL_COMPRESSION_PGLZ, true},
+	{"0", WAL_COMPRESSION_NONE, true},
+	{NULL, 0, false}
+};
+
 /*
  * Statistics for current checkpoint are collected in this global struct.
  * Because only the checkpointer or a stand-alone backend can perform
@@ -539,7 +566,17 @@ typedef struct XLogCtlInsert
 	 * WAL insertion locks.
 	 */
 	WALInsertLockPadded *WALInsertLocks;
+	int			numInsertLocks;
 	LWLockTranche WALInsertLockTranche;
+
+#ifdef PG_HAVE_ATOMIC_U64_SUPPORT
+	/*
+	 * All insertions before this point are known to have finished.  It is
+	 * advanced by WaitXLogInsertionsToFinish(), and lets later calls return
+	 * without scanning the insertion locks.
+	 */
+	pg_atomic_uint64 finishedUpto;
+#endif
 } XLogCtlInsert;
 
 /*
@@ -679,8 +716,9 @@ typedef struct XLogCtlData
 
 static XLogCtlData *XLogCtl = NULL;
 
-/* a private copy of XLogCtl->Insert.WALInsertLocks, for convenience */
+/* private copies of XLogCtl->Insert.WALInsertLocks etc., for convenience */
 static WALInsertLockPadded *WALInsertLocks = NULL;
+static int	NumXLogInsertLocks = 0;
 
 /*
  * We maintain an image of pg_control in shared memory.
@@ -955,8 +993,8 @@ XLogInsertRecord(XLogRecData *rdata, XLogRecPtr fpw_lsn)
 	 * To keep track of which insertions are still in-progress, each concurrent
 	 * inserter acquires an insertion lock. In addition to just indicating that
 	 * an insertion is in progress, the lock tells others how far the inserter
-	 * has progressed. There is a small fixed number of insertion locks,
-	 * determined by NUM_XLOGINSERT_LOCKS. When an inserter crosses a page
+	 * has progressed. There is a fixed number of insertion locks, chosen at
+	 * startup by XLOGChooseNumInsertLocks(). When an inserter crosses a page
 	 * boundary, it updates the value stored in the lock to the how far it has
 	 * inserted, to allow the previous buffer to be flushed.
 	 *
@@ -1430,7 +1468,7 @@ WALInsertLockAcquire(void)
 	static int	lockToTry = -1;
 
 	if (lockToTry == -1)
-		lockToTry = MyProc->pgprocno % NUM_XLOGINSERT_LOCKS;
+		lockToTry = MyProc->pgprocno % NumXLogInsertLocks;
 	MyLockNo = lockToTry;
 
 	/*
@@ -1448,7 +1486,7 @@ WALInsertLockAcquire(void)
 		 * than locks, it still helps to distribute the inserters evenly
 		 * across the locks.
 		 */
-		lockToTry = (lockToTry + 1) % NUM_XLOGINSERT_LOCKS;
+		lockToTry = (lockToTry + 1) % NumXLogInsertLocks;
 	}
 }
 
@@ -1466,7 +1504,7 @@ WALInsertLockAcquireExclusive(void)
 	 * indicator is set to 0xFFFFFFFFFFFFFFFF, which is higher than any real
 	 * XLogRecPtr value, to make sure that no-one blocks waiting on those.
 	 */
-	for (i = 0; i < NUM_XLOGINSERT_LOCKS - 1; i++)
+	for (i = 0; i < NumXLogInsertLocks - 1; i++)
 	{
 		LWLockAcquire(&WALInsertLocks[i].l.lock, LW_EXCLUSIVE);
 		LWLockUpdateVar(&WALInsertLocks[i].l.lock,
@@ -1492,7 +1530,7 @@ WALInsertLockRelease(void)
 	{
 		int			i;
 
-		for (i = 0; i < NUM_XLOGINSERT_LOCKS; i++)
+		for (i = 0; i < NumXLogInsertLocks; i++)
 			LWLockReleaseClearVar(&WALInsertLocks[i].l.lock,
 								  &WALInsertLocks[i].l.insertingAt,
 								  0);
@@ -1520,8 +1558,8 @@ WALInsertLockUpdateInsertingAt(XLogRecPtr insertingAt)
 		 * We use the last lock to mark our actual position, see comments in
 		 * WALInsertLockAcquireExclusive.
 		 */
-		LWLockUpdateVar(&WALInsertLocks[NUM_XLOGINSERT_LOCKS - 1].l.lock,
-					 &WALInsertLocks[NUM_XLOGINSERT_LOCKS - 1].l.insertingAt,
+		LWLockUpdateVar(&WALInsertLocks[NumXLogInsertLocks - 1].l.lock,
+					 &WALInsertLocks[NumXLogInsertLocks - 1].l.insertingAt,
 						insertingAt);
 	}
 	else
@@ -1578,6 +1616,19 @@ WaitXLogInsertionsToFinish(XLogRecPtr upto)
 		upto = reservedUpto;
 	}
 
+#ifdef PG_HAVE_ATOMIC_U64_SUPPORT
+
+	/*
+	 * If an earlier call already saw all insertions up to 'upto' finish,
+	 * there's no need to look at the locks again.  Flushers often ask for
+	 * the same or a nearby position one after another, so this saves a lot
+	 * of lock scanning when there are many insertion locks.
+	 */
+	finishedUpto = pg_atomic_read_u64(&Insert->finishedUpto);
+	if (upto <= finishedUpto)
+		return finishedUpto;
+#endif
+
 	/*
 	 * Loop through all the locks, sleeping on any in-progress insert older
 	 * than 'upto'.
@@ -1588,7 +1639,7 @@ WaitXLogInsertionsToFinish(XLogRecPtr upto)
 	 * out for any insertion that's still in progress.
 	 */
 	finishedUpto = reservedUpto;
-	for (i = 0; i < NUM_XLOGINSERT_LOCKS; i++)
+	for (i = 0; i < NumXLogInsertLocks; i++)
 	{
 		XLogRecPtr	insertingat = InvalidXLogRecPtr;
 
@@ -1624,6 +1675,19 @@ WaitXLogInsertionsToFinish(XLogRecPtr upto)
 		if (insertingat != InvalidXLogRecPtr && insertingat < finishedUpto)
 			finishedUpto = insertingat;
 	}
+
+#ifdef PG_HAVE_ATOMIC_U64_SUPPORT
+	/* advance the shared hint, unless someone else got further already */
+	{
+		uint64		oldval = pg_atomic_read_u64(&Insert->finishedUpto);
+
+		while (oldval < finishedUpto &&
+			   !pg_atomic_compare_exchange_u64(&Insert->finishedUpto,
+											   &oldval, finishedUpto))
+			;
+	}
+#endif
+
 	return finishedUpto;
 }
 
@@ -4594,6 +4658,39 @@ XLOGChooseNumBuffers(void)
 	return xbuffers;
 }
 
+/*
+ * Choose the number of WAL insertion locks.
+ *
+ * Each concurrent inserter needs a lock of its own to avoid queuing, so we
+ * want about as many locks as there can be backends running on a CPU at the
+ * same time, rounded up to a power of two.  Fewer than MIN_XLOGINSERT_LOCKS
+ * is never useful, and more than MAX_XLOGINSERT_LOCKS makes the lock scan in
+ * WaitXLogInsertionsToFinish() too expensive.
+ *
+ * This must give the same answer every time it's called in the postmaster,
+ * since it determines the size of shared memory.
+ */
+static int
+XLOGChooseNumInsertLocks(void)
+{
+	int			target = MaxConnections;
+	int			nlocks;
+
+#ifdef _SC_NPROCESSORS_ONLN
+	{
+		long		ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+		if (ncpus > 0 && ncpus < target)
+			target = (int) ncpus;
+	}
+#endif
+
+	nlocks = MIN_XLOGINSERT_LOCKS;
+	while (nlocks < target && nlocks < MAX_XLOGINSERT_LOCKS)
+		nlocks *= 2;
+	return nlocks;
+}
+
 /*
  * GUC check_hook for wal_buffers
  */
@@ -4656,7 +4753,8 @@ XLOGShmemSize(void)
 	size = sizeof(XLogCtlData);
 
 	/* WAL insertion locks, plus alignment */
-	size = add_size(size, mul_size(sizeof(WALInsertLockPadded), NUM_XLOGINSERT_LOCKS + 1));
+	size = add_size(size, mul_size(sizeof(WALInsertLockPadded),
+								   XLOGChooseNumInsertLocks() + 1));
 	/* xlblocks array */
 	size = add_size(size, mul_size(sizeof(XLogRecPtr), XLOGbuffers));
 	/* extra alignment padding for XLOG I/O buffers */
@@ -4709,6 +4807,7 @@ XLOGShmemInit(void)
 
 		/* Initialize local copy of WALInsertLocks and register the tranche */
 		WALInsertLocks = XLogCtl->Insert.WALInsertLocks;
+		NumXLogInsertLocks = XLogCtl->Insert.numInsertLocks;
 		LWLockRegisterTranche(LWTRANCHE_WAL_INSERT,
 							  &XLogCtl->Insert.WALInsertLockTranche);
 		return;
@@ -4729,16 +4828,22 @@ XLOGShmemInit(void)
 	/* WAL insertion locks. Ensure they're aligned to the full padded size */
 	allocptr += sizeof(WALInsertLockPadded) -
 		((uintptr_t) allocptr) %sizeof(WALInsertLockPadded);
+	NumXLogInsertLocks = XLogCtl->Insert.numInsertLocks =
+		XLOGChooseNumInsertLocks();
 	WALInsertLocks = XLogCtl->Insert.WALInsertLocks =
 		(WALInsertLockPadded *) allocptr;
-	allocptr += sizeof(WALInsertLockPadded) * NUM_XLOGINSERT_LOCKS;
+	allocptr += sizeof(WALInsertLockPadded) * NumXLogInsertLocks;
+
+#ifdef PG_HAVE_ATOMIC_U64_SUPPORT
+	pg_atomic_init_u64(&XLogCtl->Insert.finishedUpto, 0);
+#endif
 
 	XLogCtl->Insert.WALInsertLockTranche.name = "wal_insert";
 	XLogCtl->Insert.WALInsertLockTranche.array_base = WALInsertLocks;
 	XLogCtl->Insert.WALInsertLockTranche.array_stride = sizeof(WALInsertLockPadded);
 
 	LWLockRegisterTranche(LWTRANCHE_WAL_INSERT, &XLogCtl->Insert.WALInsertLockTranche);
-	for (i = 0; i < NUM_XLOGINSERT_LOCKS; i++)
+	for (i = 0; i < NumXLogInsertLocks; i++)
 	{
 		LWLockInitialize(&WALInsertLocks[i].l.lock, LWTRANCHE_WAL_INSERT);
 		WALInsertLocks[i].l.insertingAt = InvalidXLogRecPtr;
@@ -5679,6 +5784,9 @@ recoveryPausesHere(void)
 	if (!LocalHotStandbyActive)
 		return;
 
+	/* Let the users see everything replayed so far */
+	WaitForRedoWorkers();
+
 	ereport(LOG,
 			(errmsg("recovery has paused"),
 			 errhint("Execute pg_xlog_replay_resume() to continue.")));
@@ -6746,6 +6854,7 @@ StartupXLOG(void)
 		{
 			ErrorContextCallback errcallback;
 			TimestampTz xtime;
+			XLogPrefetcher *prefetcher;
 
 			InRedo = true;
 
@@ -6753,6 +6862,11 @@ StartupXLOG(void)
 					(errmsg("redo starts at %X/%X",
 						 (uint32) (ReadRecPtr >> 32), (uint32) ReadRecPtr)));
 
+			/* Launch redo workers, if requested */
+			StartRedoWorkers();
+
+			prefetcher = XLogPrefetcherAllocate();
+
 			/*
 			 * main redo apply loop
 			 */
@@ -6906,8 +7020,16 @@ StartupXLOG(void)
 					TransactionIdIsValid(record->xl_xid))
 					RecordKnownAssignedTransactionIds(record->xl_xid);
 
-				/* Now apply the WAL record itself */
-				RmgrTable[record->xl_rmid].rm_redo(xlogreader);
+				/* Start reading the blocks of the upcoming records */
+				XLogPrefetcherReadAhead(prefetcher, xlogreader, ThisTimeLineID);
+
+				/*
+				 * Now apply the WAL record itself, or have a redo worker do
+				 * it.  If we apply it ourselves, DispatchRedoRecord has
+				 * waited for the workers to finish all earlier records.
+				 */
+				if (!DispatchRedoRecord(xlogreader))
+					RmgrTable[record->xl_rmid].rm_redo(xlogreader);
 
 				/* Pop the error context stack */
 				error_context_stack = errcallback.previous;
@@ -6971,6 +7093,10 @@ StartupXLOG(void)
 			 * end of main redo apply loop
 			 */
 
+			/* All records must be replayed before we do anything else */
+			StopRedoWorkers();
+			XLogPrefetcherFree(prefetcher);
+
 			if (reachedStopPoint)
 			{
 				if (!reachedConsistency)
@@ -7187,6 +7313,9 @@ StartupXLOG(void)
 	Insert = &XLogCtl->Insert;
 	Insert->PrevBytePos = XLogRecPtrToBytePos(LastRec);
 	Insert->CurrBytePos = XLogRecPtrToBytePos(EndOfLog);
+#ifdef PG_HAVE_ATOMIC_U64_SUPPORT
+	pg_atomic_write_u64(&Insert->finishedUpto, EndOfLog);
+#endif
 
 	/*
 	 * Tricky point here: readBuf contains the *last* block that the LastRec
@@ -7516,6 +7645,9 @@ CheckRecoveryConsistency(void)
 		 */
 		elog(DEBUG1, "end of backup reached");
 
+		/* Redo workers may still be replaying records before this point */
+		WaitForRedoWorkers();
+
 		LWLockAcquire(ControlFileLock, LW_EXCLUSIVE);
 
 		if (ControlFile->minRecoveryPoint < lastReplayedEndRecPtr)
@@ -7542,8 +7674,10 @@ CheckRecoveryConsistency(void)
 	{
 		/*
 		 * Check to see if the XLOG sequence contained any unresolved
-		 * references to uninitialized pages.
+		 * references to uninitialized pages.  Wait for the redo workers
+		 * first, to collect the references they came across.
 		 */
+		WaitForRedoWorkers();
 		XLogCheckInvalidPages();
 
 		reachedConsistency = true;
@@ -19,6 +19,13 @@
 
 #include "postgres.h"
 
+#ifdef USE_LZ4
+#include <lz4.h>
+#endif
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
 #include "access/xact.h"
 #include "access/xlog.h"
 #include "access/xlog_internal.h"
@@ -32,9 +39,33 @@
 #include "utils/memutils.h"
 #include "pg_trace.h"
 
-/* Buffer size required to store a compressed version of backup block image */
+/*
+ * Buffer size required to store a compressed version of backup block image,
+ * with any of the compression methods built in.
+ */
 #define PGLZ_MAX_BLCKSZ PGLZ_MAX_OUTPUT(BLCKSZ)
 
+#ifdef USE_LZ4
+#define LZ4_MAX_BLCKSZ	LZ4_COMPRESSBOUND(BLCKSZ)
+#else
+#define LZ4_MAX_BLCKSZ	0
+#endif
+
+#ifdef USE_ZSTD
+#define ZSTD_MAX_BLCKSZ ZSTD_COMPRESSBOUND(BLCKSZ)
+
+/*
+ * Full-page images are written in the foreground, so favor speed over
+ * compression ratio.
+ */
+#define WAL_ZSTD_LEVEL	1
+#else
+#define ZSTD_MAX_BLCKSZ 0
+#endif
+
+#define COMPRESS_BUFSIZE \
+	Max(Max(PGLZ_MAX_BLCKSZ, LZ4_MAX_BLCKSZ), ZSTD_MAX_BLCKSZ)
+
 /*
  * For each block reference registered with XLogRegisterBuffer, we fill in
  * a registered_buffer struct.
@@ -57,7 +88,7 @@ typedef struct
 								 * backup block data in XLogRecordAssemble() */
 
 	/* buffer to store a compressed version of backup block image */
-	char		compressed_page[PGLZ_MAX_BLCKSZ];
+	char		compressed_page[COMPRESS_BUFSIZE];
 } registered_buffer;
 
 static registered_buffer *registered_buffers;
@@ -595,7 +626,7 @@ XLogRecordAssemble(RmgrId rmid, uint8 info,
 			/*
 			 * Try to compress a block image if wal_compression is enabled
 			 */
-			if (wal_compression)
+			if (wal_compression != WAL_COMPRESSION_NONE)
 			{
 				is_compressed =
 					XLogCompressBackupBlock(page, bimg.hole_offset,
@@ -621,7 +652,22 @@ XLogRecordAssemble(RmgrId rmid, uint8 info,
 			if (is_compressed)
 			{
 				bimg.length = compressed_len;
-				bimg.bimg_info |= BKPIMAGE_IS_COMPRESSED;
+
+				switch ((WalCompression) wal_compression)
+				{
+					case WAL_COMPRESSION_PGLZ:
+						bimg.bimg_info |= BKPIMAGE_COMPRESS_PGLZ;
+						break;
+					case WAL_COMPRESSION_LZ4:
+						bimg.bimg_info |= BKPIMAGE_COMPRESS_LZ4;
+						break;
+					case WAL_COMPRESSION_ZSTD:
+						bimg.bimg_info |= BKPIMAGE_COMPRESS_ZSTD;
+						break;
+					case WAL_COMPRESSION_NONE:
+						Assert(false);	/* cannot happen */
+						break;
+				}
 
 				rdt_datas_last->data = regbuf->compressed_page;
 				rdt_datas_last->len = compressed_len;
@@ -760,11 +806,15 @@ XLogRecordAssemble(RmgrId rmid, uint8 info,
 }
 
 /*
- * Create a compressed version of a backup block image.
+ * Create a compressed version of a backup block image, using the method
+ * selected by wal_compression.
  *
  * Returns FALSE if compression fails (i.e., compressed result is actually
  * bigger than original). Otherwise, returns TRUE and sets 'dlen' to
  * the length of compressed block image.
+ *
+ * This is called in a critical section, so it must not throw errors; any
+ * failure just means the image is stored uncompressed.
  */
 static bool
 XLogCompressBackupBlock(char *page, uint16 hole_offset, uint16 hole_length,
@@ -794,12 +844,58 @@ XLogCompressBackupBlock(char *page, uint16 hole_offset, uint16 hole_length,
 	else
 		source = page;
 
+	switch ((WalCompression) wal_compression)
+	{
+		case WAL_COMPRESSION_PGLZ:
+			len = pglz_compress(source, orig_len, dest, PGLZ_strategy_default);
+			break;
+
+		case WAL_COMPRESSION_LZ4:
+#ifdef USE_LZ4
+			len = LZ4_compress_default(source, dest, orig_len,
+									   LZ4_MAX_BLCKSZ);
+			if (len <= 0)
+				len = -1;		/* failure */
+#else
+			elog(PANIC, "LZ4 is not supported by this build");
+#endif
+			break;
+
+		case WAL_COMPRESSION_ZSTD:
+#ifdef USE_ZSTD
+			{
+				/* the context is reused for the life of the process */
+				static ZSTD_CCtx *zstd_cctx = NULL;
+				size_t		zlen;
+
+				if (zstd_cctx == NULL)
+				{
+					zstd_cctx = ZSTD_createCCtx();
+					if (zstd_cctx == NULL)
+						return false;	/* out of memory */
+				}
+				zlen = ZSTD_compressCCtx(zstd_cctx, dest, ZSTD_MAX_BLCKSZ,
+										 source, orig_len, WAL_ZSTD_LEVEL);
+				len = ZSTD_isError(zlen) ? -1 : (int32) zlen;
+			}
+#else
+			elog(PANIC, "zstd is not supported by this build");
+#endif
+			break;
+
+		default:
+			elog(PANIC, "unrecognized wal_compression value: %d",
+				 wal_compression);
+			len = -1;			/* keep compiler quiet */
+			break;
+	}
+
 	/*
-	 * We recheck the actual size even if pglz_compress() reports success and
-	 * see if the number of bytes saved by compression is larger than the
-	 * length of extra data needed for the compressed version of block image.
+	 * We recheck the actual size even if the compression method reports
+	 * success and see if the number of bytes saved by compression is larger
+	 * than the length of extra data needed for the compressed version of
+	 * block image.
 	 */
-	len = pglz_compress(source, orig_len, dest, PGLZ_strategy_default);
 	if (len >= 0 &&
 		len + extra_bytes < orig_len)
 	{
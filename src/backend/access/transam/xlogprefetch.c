@@ -0,0 +1,379 @@
+/*-------------------------------------------------------------------------
+ *
+ * xlogprefetch.c
+ *	  Prefetching of blocks referenced by WAL records during recovery
+ *
+ * Redo routines read the blocks they modify synchronously, so a startup
+ * process replaying random writes spends most of its time waiting for I/O,
+ * one block at a time.  To avoid that, the prefetcher decodes the WAL ahead
+ * of replay with a second XLogReaderState, up to recovery_prefetch_distance
+ * bytes ahead, and initiates reads of the blocks the records reference, so
+ * that they are in the kernel's page cache by the time redo needs them.
+ *
+ * Blocks that redo will overwrite without reading them -- those restored
+ * from a full-page image or initialized from scratch -- and blocks already
+ * in shared buffers are skipped, as are blocks prefetched very recently.
+ *
+ * The prefetcher reads WAL only from the segment files in pg_xlog, and
+ * never waits for WAL to arrive: when it runs out of WAL, it just stops,
+ * and starts over from the replay position once replay has caught up.  So
+ * it works for crash recovery and streaming replication, but not for WAL
+ * restored from the archive one segment at a time.  A failure to read or
+ * decode WAL is never an error here; the prefetcher is only a hint, and
+ * replay will read the WAL again and report any real problem.
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ *
+ * IDENTIFICATION
+ *	  src/backend/access/transam/xlogprefetch.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include <unistd.h>
+
+#include "access/xlog_internal.h"
+#include "access/xlogprefetch.h"
+#include "replication/walreceiver.h"
+#include "storage/bufmgr.h"
+#include "storage/fd.h"
+#include "storage/shmem.h"
+#include "storage/spin.h"
+#include "utils/hashutils.h"
+
+/* number of recently prefetched blocks remembered */
+#define XLOGPREFETCH_RECENT_BLOCKS	64
+
+typedef struct XLogPrefetchBlock
+{
+	RelFileNode rnode;
+	ForkNumber	forknum;
+	BlockNumber blkno;
+} XLogPrefetchBlock;
+
+struct XLogPrefetcher
+{
+	XLogReaderState *reader;	/* decodes WAL ahead of replay */
+	TimeLineID	tli;			/* timeline whose WAL files we read */
+
+	/*
+	 * Is the reader positioned on a record?  If not, we start over at the
+	 * replay position once replay gets to retryAt.
+	 */
+	bool		active;
+	XLogRecPtr	retryAt;
+
+	/* currently open WAL segment file, or -1 */
+	int			readFile;
+	XLogSegNo	readSegNo;
+
+	/* direct-mapped cache of recently prefetched blocks */
+	XLogPrefetchBlock recent[XLOGPREFETCH_RECENT_BLOCKS];
+
+	XLogPrefetchStats stats;
+};
+
+typedef struct XLogPrefetchShared
+{
+	slock_t		mutex;			/* protects stats */
+	XLogPrefetchStats stats;
+} XLogPrefetchShared;
+
+static XLogPrefetchShared *XLogPrefetchShmem = NULL;
+
+int			recovery_prefetch_distance = 0;
+
+static int XLogPrefetcherReadPage(XLogReaderState *reader,
+					   XLogRecPtr targetPagePtr, int reqLen,
+					   XLogRecPtr targetRecPtr, char *readBuf,
+					   TimeLineID *pageTLI);
+static void XLogPrefetcherScanRecord(XLogPrefetcher *prefetcher);
+static void XLogPrefetcherStop(XLogPrefetcher *prefetcher,
+				   XLogRecPtr retryAt);
+
+
+/*
+ * Report shared memory space needed by XLogPrefetchShmemInit
+ */
+Size
+XLogPrefetchShmemSize(void)
+{
+	return sizeof(XLogPrefetchShared);
+}
+
+/*
+ * Allocate and initialize the shared prefetch statistics
+ */
+void
+XLogPrefetchShmemInit(void)
+{
+	bool		found;
+
+	XLogPrefetchShmem = (XLogPrefetchShared *)
+		ShmemInitStruct("XLog Prefetch Stats", XLogPrefetchShmemSize(),
+						&found);
+
+	if (!found)
+	{
+		SpinLockInit(&XLogPrefetchShmem->mutex);
+		memset(&XLogPrefetchShmem->stats, 0, sizeof(XLogPrefetchStats));
+	}
+}
+
+/*
+ * Create a prefetcher.  It does nothing while recovery_prefetch_distance is
+ * zero, but the setting can be changed during recovery.
+ */
+XLogPrefetcher *
+XLogPrefetcherAllocate(void)
+{
+	XLogPrefetcher *prefetcher;
+
+	prefetcher = palloc0(sizeof(XLogPrefetcher));
+	prefetcher->reader = XLogReaderAllocate(&XLogPrefetcherReadPage,
+											prefetcher);
+	if (!prefetcher->reader)
+		ereport(ERROR,
+				(errcode(ERRCODE_OUT_OF_MEMORY),
+				 errmsg("out of memory"),
+			errdetail("Failed while allocating an XLog reading processor.")));
+	prefetcher->readFile = -1;
+	prefetcher->active = false;
+	prefetcher->retryAt = InvalidXLogRecPtr;
+
+	/* the counters start over in each recovery */
+	SpinLockAcquire(&XLogPrefetchShmem->mutex);
+	memset(&XLogPrefetchShmem->stats, 0, sizeof(XLogPrefetchStats));
+	SpinLockRelease(&XLogPrefetchShmem->mutex);
+
+	return prefetcher;
+}
+
+/*
+ * Release a prefetcher.
+ */
+void
+XLogPrefetcherFree(XLogPrefetcher *prefetcher)
+{
+	if (prefetcher->readFile >= 0)
+		close(prefetcher->readFile);
+	XLogReaderFree(prefetcher->reader);
+	pfree(prefetcher);
+
+	SpinLockAcquire(&XLogPrefetchShmem->mutex);
+	XLogPrefetchShmem->stats.distance = 0;
+	SpinLockRelease(&XLogPrefetchShmem->mutex);
+}
+
+/*
+ * Read ahead of the record 'replay' is about to replay, on timeline 'tli',
+ * and prefetch the blocks referenced by the records up to
+ * recovery_prefetch_distance bytes further.
+ */
+void
+XLogPrefetcherReadAhead(XLogPrefetcher *prefetcher, XLogReaderState *replay,
+						TimeLineID tli)
+{
+	XLogReaderState *reader = prefetcher->reader;
+	XLogRecPtr	replayPtr = replay->ReadRecPtr;
+	XLogRecPtr	horizon;
+	char	   *errormsg;
+
+	if (recovery_prefetch_distance <= 0)
+	{
+		if (prefetcher->active)
+			XLogPrefetcherStop(prefetcher, InvalidXLogRecPtr);
+		return;
+	}
+
+	horizon = replayPtr + (XLogRecPtr) recovery_prefetch_distance * 1024;
+
+	/* After a timeline switch, we've been reading the wrong files. */
+	if (tli != prefetcher->tli)
+	{
+		XLogPrefetcherStop(prefetcher, InvalidXLogRecPtr);
+		prefetcher->tli = tli;
+	}
+
+	/* If replay overtook us, start over at its position. */
+	if (prefetcher->active && reader->ReadRecPtr < replayPtr)
+		XLogPrefetcherStop(prefetcher, InvalidXLogRecPtr);
+
+	if (!prefetcher->active)
+	{
+		if (replayPtr < prefetcher->retryAt)
+			return;
+
+		/*
+		 * Position the reader on the record being replayed.  Its blocks are
+		 * about to be read by redo anyway, so don't bother with them.
+		 */
+		if (XLogReadRecord(reader, replayPtr, &errormsg) == NULL)
+		{
+			XLogPrefetcherStop(prefetcher, replayPtr + XLOG_BLCKSZ);
+			return;
+		}
+		prefetcher->active = true;
+	}
+
+	while (reader->EndRecPtr < horizon)
+	{
+		XLogRecPtr	nextPtr = reader->EndRecPtr;
+
+		if (XLogReadRecord(reader, InvalidXLogRecPtr, &errormsg) == NULL)
+		{
+			/* out of WAL for now; retry once replay gets there */
+			XLogPrefetcherStop(prefetcher,
+							   Max(nextPtr, replayPtr + XLOG_BLCKSZ));
+			break;
+		}
+		XLogPrefetcherScanRecord(prefetcher);
+	}
+
+	prefetcher->stats.distance =
+		prefetcher->active ? reader->EndRecPtr - replayPtr : 0;
+
+	SpinLockAcquire(&XLogPrefetchShmem->mutex);
+	XLogPrefetchShmem->stats = prefetcher->stats;
+	SpinLockRelease(&XLogPrefetchShmem->mutex);
+}
+
+/*
+ * Copy the current statistics to *stats.
+ */
+void
+XLogPrefetchGetStats(XLogPrefetchStats *stats)
+{
+	SpinLockAcquire(&XLogPrefetchShmem->mutex);
+	*stats = XLogPrefetchShmem->stats;
+	SpinLockRelease(&XLogPrefetchShmem->mutex);
+}
+
+/*
+ * Prefetch the blocks referenced by the record the reader has just decoded.
+ */
+static void
+XLogPrefetcherScanRecord(XLogPrefetcher *prefetcher)
+{
+	XLogReaderState *reader = prefetcher->reader;
+	int			block_id;
+
+	for (block_id = 0; block_id <= reader->max_block_id; block_id++)
+	{
+		DecodedBkpBlock *blk = &reader->blocks[block_id];
+		XLogPrefetchBlock *recent;
+		uint64		hash;
+
+		if (!blk->in_use)
+			continue;
+
+		/* Redo will overwrite these blocks without reading them. */
+		if (blk->has_image)
+		{
+			prefetcher->stats.skip_fpw++;
+			continue;
+		}
+		if (blk->flags & BKPBLOCK_WILL_INIT)
+		{
+			prefetcher->stats.skip_new++;
+			continue;
+		}
+
+		/*
+		 * Consecutive records often touch the same block, for example the
+		 * same heap page or btree leaf when inserting in order.
+		 */
+		hash = murmurhash64(((uint64) blk->rnode.relNode << 32 | blk->blkno) ^
+							((uint64) blk->forknum << 30));
+		recent = &prefetcher->recent[hash % XLOGPREFETCH_RECENT_BLOCKS];
+		if (RelFileNodeEquals(recent->rnode, blk->rnode) &&
+			recent->forknum == blk->forknum &&
+			recent->blkno == blk->blkno)
+		{
+			prefetcher->stats.skip_rep++;
+			continue;
+		}
+		recent->rnode = blk->rnode;
+		recent->forknum = blk->forknum;
+		recent->blkno = blk->blkno;
+
+		if (PrefetchBufferWithoutRelcache(blk->rnode, blk->forknum,
+										  blk->blkno))
+			prefetcher->stats.prefetch++;
+		else
+			prefetcher->stats.skip_hit++;
+	}
+}
+
+/*
+ * Stop reading ahead, until replay reaches 'retryAt'.
+ */
+static void
+XLogPrefetcherStop(XLogPrefetcher *prefetcher, XLogRecPtr retryAt)
+{
+	prefetcher->active = false;
+	prefetcher->retryAt = retryAt;
+
+	/* the segment might be recycled by the time we come back */
+	if (prefetcher->readFile >= 0)
+	{
+		close(prefetcher->readFile);
+		prefetcher->readFile = -1;
+	}
+}
+
+/*
+ * XLogReaderState page read callback.  Reads a page from a WAL segment file
+ * of the prefetcher's timeline, if it's there; never waits.
+ */
+static int
+XLogPrefetcherReadPage(XLogReaderState *reader, XLogRecPtr targetPagePtr,
+					   int reqLen, XLogRecPtr targetRecPtr, char *readBuf,
+					   TimeLineID *pageTLI)
+{
+	XLogPrefetcher *prefetcher = (XLogPrefetcher *) reader->private_data;
+	XLogSegNo	segno;
+	uint32		offset;
+	int			count = XLOG_BLCKSZ;
+
+	/* Don't read past what the WAL receiver has flushed. */
+	if (WalRcvRunning())
+	{
+		XLogRecPtr	receivedUpto = GetWalRcvWriteRecPtr(NULL, NULL);
+
+		if (targetPagePtr + reqLen > receivedUpto)
+			return -1;
+		if (targetPagePtr + XLOG_BLCKSZ > receivedUpto)
+			count = (int) (receivedUpto - targetPagePtr);
+	}
+
+	XLByteToSeg(targetPagePtr, segno);
+	offset = targetPagePtr % XLogSegSize;
+
+	if (prefetcher->readFile >= 0 && segno != prefetcher->readSegNo)
+	{
+		close(prefetcher->readFile);
+		prefetcher->readFile = -1;
+	}
+	if (prefetcher->readFile < 0)
+	{
+		char		path[MAXPGPATH];
+
+		XLogFilePath(path, prefetcher->tli, segno);
+		prefetcher->readFile = BasicOpenFile(path, O_RDONLY | PG_BINARY, 0);
+		if (prefetcher->readFile < 0)
+			return -1;
+		prefetcher->readSegNo = segno;
+	}
+
+	if (lseek(prefetcher->readFile, (off_t) offset, SEEK_SET) < 0)
+		return -1;
+	if (read(prefetcher->readFile, readBuf, count) != count)
+		return -1;
+
+	*pageTLI = prefetcher->tli;
+	return count;
+}
@@ -19,11 +19,13 @@
 
 #include <unistd.h>
 
+#include "access/redoworker.h"
 #include "access/xlog.h"
 #include "access/xlog_internal.h"
 #include "access/xlogutils.h"
 #include "catalog/catalog.h"
 #include "miscadmin.h"
+#include "storage/lmgr.h"
 #include "storage/smgr.h"
 #include "utils/guc.h"
 #include "utils/hsearch.h"
@@ -81,6 +83,16 @@ log_invalid_page(RelFileNode node, ForkNumber forkno, BlockNumber blkno,
 	xl_invalid_page *hentry;
 	bool		found;
 
+	/*
+	 * The table is private to the startup process, so a redo worker hands
+	 * the reference over to it.  It comes back to this function there.
+	 */
+	if (IsRedoWorker)
+	{
+		RedoWorkerReportInvalidPage(node, forkno, blkno, present);
+		return;
+	}
+
 	/*
 	 * Once recovery has reached a consistent state, the invalid-page table
 	 * should be empty and remain so. If a reference to an invalid page is
@@ -136,6 +148,18 @@ log_invalid_page(RelFileNode node, ForkNumber forkno, BlockNumber blkno,
 	}
 }
 
+/*
+ * Log a reference to an invalid page that a redo worker came across.  Called
+ * by the startup process.
+ */
+void
+XLogRememberInvalidPage(RelFileNode node, ForkNumber forkno,
+						BlockNumber blkno, bool present)
+{
+	Assert(!IsRedoWorker);
+	log_invalid_page(node, forkno, blkno, present);
+}
+
 /* Forget any invalid pages >= minblkno, because they've been dropped */
 static void
 forget_invalid_pages(RelFileNode node, ForkNumber forkno, BlockNumber minblkno)
@@ -438,6 +462,7 @@ XLogReadBufferExtended(RelFileNode rnode, ForkNumber forknum,
 	BlockNumber lastblock;
 	Buffer		buffer;
 	SMgrRelation smgr;
+	Relation	fakerel = NULL;
 
 	Assert(blkno != P_NEW);
 
@@ -473,29 +498,54 @@ XLogReadBufferExtended(RelFileNode rnode, ForkNumber forknum,
 		if (mode == RBM_NORMAL_NO_LOG)
 			return InvalidBuffer;
 		/* OK to extend the file */
-		/* we do this in recovery only - no rel-extension lock needed */
 		Assert(InRecovery);
-		buffer = InvalidBuffer;
-		do
+
+		/*
+		 * The startup process replays alone, so it needs no rel-extension
+		 * lock, but redo workers can extend the same relation concurrently.
+		 * Once we have the lock, someone else might have extended the file
+		 * past our block already.
+		 */
+		if (IsRedoWorker)
+		{
+			fakerel = CreateFakeRelcacheEntry(rnode);
+			LockRelationForExtension(fakerel, ExclusiveLock);
+			lastblock = smgrnblocks(smgr, forknum);
+		}
+
+		if (blkno < lastblock)
+			buffer = ReadBufferWithoutRelcache(rnode, forknum, blkno,
+											   mode, NULL);
+		else
 		{
-			if (buffer != InvalidBuffer)
+			buffer = InvalidBuffer;
+			do
+			{
+				if (buffer != InvalidBuffer)
+				{
+					if (mode == RBM_ZERO_AND_LOCK || mode == RBM_ZERO_AND_CLEANUP_LOCK)
+						LockBuffer(buffer, BUFFER_LOCK_UNLOCK);
+					ReleaseBuffer(buffer);
+				}
+				buffer = ReadBufferWithoutRelcache(rnode, forknum,
+												   P_NEW, mode, NULL);
+			}
+			while (BufferGetBlockNumber(buffer) < blkno);
+			/* Handle the corner case that P_NEW returns non-consecutive pages */
+			if (BufferGetBlockNumber(buffer) != blkno)
 			{
 				if (mode == RBM_ZERO_AND_LOCK || mode == RBM_ZERO_AND_CLEANUP_LOCK)
 					LockBuffer(buffer, BUFFER_LOCK_UNLOCK);
 				ReleaseBuffer(buffer);
+				buffer = ReadBufferWithoutRelcache(rnode, forknum, blkno,
+												   mode, NULL);
 			}
-			buffer = ReadBufferWithoutRelcache(rnode, forknum,
-											   P_NEW, mode, NULL);
 		}
-		while (BufferGetBlockNumber(buffer) < blkno);
-		/* Handle the corner case that P_NEW returns non-consecutive pages */
-		if (BufferGetBlockNumber(buffer) != blkno)
+
+		if (fakerel)
 		{
-			if (mode == RBM_ZERO_AND_LOCK || mode == RBM_ZERO_AND_CLEANUP_LOCK)
-				LockBuffer(buffer, BUFFER_LOCK_UNLOCK);
-			ReleaseBuffer(buffer);
-			buffer = ReadBufferWithoutRelcache(rnode, forknum, blkno,
-											   mode, NULL);
+			UnlockRelationForExtension(fakerel, ExclusiveLock);
+			FreeFakeRelcacheEntry(fakerel);
 		}
 	}
 
@@ -20,7 +20,10 @@
 #include "commands/defrem.h"
 #include "commands/prepare.h"
 #include "executor/hashjoin.h"
+#include "executor/nodeDijkstra.h"
+#include "executor/nodeNestloopVle.h"
 #include "foreign/fdwapi.h"
+#include "jit/jit.h"
 #include "nodes/extensible.h"
 #include "nodes/nodeFuncs.h"
 #include "optimizer/clauses.h"
@@ -53,6 +56,10 @@ explain_get_index_name_hook_type explain_get_index_name_hook = NULL;
 #define X_CLOSE_IMMEDIATE 2
 #define X_NOWHITESPACE 4
 
+/* callbacks of show_traversal_info() to sum up and show instrumentation */
+typedef void (*traversal_accum_fn) (void *dst, void *src);
+typedef void (*traversal_show_fn) (void *instrument, ExplainState *es);
+
 static void ExplainOneQuery(Query *query, IntoClause *into, ExplainState *es,
 				const char *queryString, ParamListInfo params);
 static void report_triggers(ResultRelInfo *rInfo, bool show_relname,
@@ -78,6 +85,10 @@ static void show_upper_qual(List *qual, const char *qlabel,
 				ExplainState *es);
 static void show_sort_keys(SortState *sortstate, List *ancestors,
 			   ExplainState *es);
+static void show_incremental_sort_keys(IncrementalSortState *incrsortstate,
+						   List *ancestors, ExplainState *es);
+static void show_gather_merge_keys(GatherMergeState *gmstate, List *ancestors,
+					   ExplainState *es);
 static void show_merge_append_keys(MergeAppendState *mstate, List *ancestors,
 					   ExplainState *es);
 static void show_agg_keys(AggState *astate, List *ancestors,
@@ -99,7 +110,21 @@ static void show_sortorder_options(StringInfo buf, Node *sortexpr,
 static void show_tablesample(TableSampleClause *tsc, PlanState *planstate,
 				 List *ancestors, ExplainState *es);
 static void show_sort_info(SortState *sortstate, ExplainState *es);
+static void show_incremental_sort_info(IncrementalSortState *incrsortstate,
+						   ExplainState *es);
 static void show_hash_info(HashState *hashstate, ExplainState *es);
+static void show_hashagg_info(AggState *aggstate, ExplainState *es);
+static void show_vle_info(NestLoopVLEState *vlestate, ExplainState *es);
+static void accum_vle_instrumentation(void *dst, void *src);
+static void show_vle_instrumentation(void *instrument, ExplainState *es);
+static void show_dijkstra_info(DijkstraState *dstate, ExplainState *es);
+static void accum_dijkstra_instrumentation(void *dst, void *src);
+static void show_dijkstra_instrumentation(void *instrument, ExplainState *es);
+static void show_traversal_info(void *leader, void *workers, int num_workers,
+					Size size, traversal_accum_fn accum,
+					traversal_show_fn show, ExplainState *es);
+static void show_traversal_time(double rescanTime, double fetchTime,
+					ExplainState *es);
 static void show_tidbitmap_info(BitmapHeapScanState *planstate,
 					ExplainState *es);
 static void show_instrumentation_count(const char *qlabel, int which,
@@ -530,6 +555,10 @@ ExplainOnePlan(PlannedStmt *plannedstmt, IntoClause *into, ExplainState *es,
 	if (es->analyze)
 		ExplainPrintTriggers(es, queryDesc);
 
+	/* Print info about JIT compilation */
+	if (es->analyze)
+		ExplainPrintJIT(es, queryDesc);
+
 	/*
 	 * Close down the query and free resources.  Include time for this in the
 	 * total execution time (although it should be pretty minimal).
@@ -635,6 +664,63 @@ ExplainPrintTriggers(ExplainState *es, QueryDesc *queryDesc)
 	ExplainCloseGroup("Triggers", "Triggers", false, es);
 }
 
+/*
+ * ExplainPrintJIT -
+ *	  Append information about JITing to es->str.
+ *
+ * Nothing is printed if no function has been JIT compiled.
+ */
+void
+ExplainPrintJIT(ExplainState *es, QueryDesc *queryDesc)
+{
+	JitContext *jc = queryDesc->estate->es_jit;
+	double		generation;
+	double		optimization;
+	double		emission;
+	double		total;
+
+	if (jc == NULL || jc->created_functions == 0)
+		return;
+
+	generation = 1000.0 * INSTR_TIME_GET_DOUBLE(jc->generation_counter);
+	optimization = 1000.0 * INSTR_TIME_GET_DOUBLE(jc->optimization_counter);
+	emission = 1000.0 * INSTR_TIME_GET_DOUBLE(jc->emission_counter);
+	total = generation + optimization + emission;
+
+	if (es->format == EXPLAIN_FORMAT_TEXT)
+	{
+		appendStringInfoString(es->str, "JIT:\n");
+		appendStringInfo(es->str, "  Functions: %ld\n",
+						 (long) jc->created_functions);
+		appendStringInfo(es->str, "  Options: Optimization %s, Deforming %s\n",
+						 (jc->flags & PGJIT_OPT3) ? "true" : "false",
+						 (jc->flags & PGJIT_DEFORM) ? "true" : "false");
+		if (es->timing)
+			appendStringInfo(es->str,
+							 "  Timing: Generation %.3f ms, "
+							 "Optimization %.3f ms, Emission %.3f ms, "
+							 "Total %.3f ms\n",
+							 generation, optimization, emission, total);
+	}
+	else
+	{
+		ExplainOpenGroup("JIT", "JIT", true, es);
+		ExplainPropertyLong("Functions", (long) jc->created_functions, es);
+		ExplainPropertyText("Optimization",
+							(jc->flags & PGJIT_OPT3) ? "true" : "false", es);
+		ExplainPropertyText("Deforming",
+							(jc->flags & PGJIT_DEFORM) ? "true" : "false", es);
+		if (es->timing)
+		{
+			ExplainPropertyFloat("Generation Time", generation, 3, es);
+			ExplainPropertyFloat("Optimization Time", optimization, 3, es);
+			ExplainPropertyFloat("Emission Time", emission, 3, es);
+			ExplainPropertyFloat("Total Time", total, 3, es);
+		}
+		ExplainCloseGroup("JIT", "JIT", true, es);
+	}
+}
+
 /*
  * ExplainQueryText -
  *	  add a "Query Text" node that contains the actual text of the query
@@ -880,6 +966,9 @@ ExplainNode(PlanState *planstate, List *ancestors,
 		case T_Gather:
 			pname = sname = "Gather";
 			break;
+		case T_GatherMerge:
+			pname = sname = "Gather Merge";
+			break;
 		case T_IndexScan:
 			pname = sname = "Index Scan";
 			break;
@@ -949,6 +1038,9 @@ ExplainNode(PlanState *planstate, List *ancestors,
 		case T_Sort:
 			pname = sname = "Sort";
 			break;
+		case T_IncrementalSort:
+			pname = sname = "Incremental Sort";
+			break;
 		case T_Group:
 			pname = sname = "Group";
 			break;
@@ -1428,6 +1520,28 @@ ExplainNode(PlanState *planstate, List *ancestors,
 					ExplainPropertyBool("Single Copy", gather->single_copy, es);
 			}
 			break;
+		case T_GatherMerge:
+			{
+				GatherMerge *gm = (GatherMerge *) plan;
+
+				show_gather_merge_keys((GatherMergeState *) planstate,
+									   ancestors, es);
+				show_scan_qual(plan->qual, "Filter", planstate, ancestors, es);
+				if (plan->qual)
+					show_instrumentation_count("Rows Removed by Filter", 1,
+											   planstate, es);
+				ExplainPropertyInteger("Workers Planned",
+									   gm->num_workers, es);
+				if (es->analyze)
+				{
+					int			nworkers;
+
+					nworkers = ((GatherMergeState *) planstate)->nworkers_launched;
+					ExplainPropertyInteger("Workers Launched",
+										   nworkers, es);
+				}
+			}
+			break;
 		case T_FunctionScan:
 			if (es->verbose)
 			{
@@ -1507,6 +1621,10 @@ ExplainNode(PlanState *planstate, List *ancestors,
 			if (plan->qual)
 				show_instrumentation_count("Rows Removed by Filter", 2,
 										   planstate, es);
+			show_vle_info((NestLoopVLEState *) planstate, es);
+			break;
+		case T_Dijkstra:
+			show_dijkstra_info((DijkstraState *) planstate, es);
 			break;
 		case T_MergeJoin:
 			show_upper_qual(((MergeJoin *) plan)->mergeclauses,
@@ -1540,6 +1658,7 @@ ExplainNode(PlanState *planstate, List *ancestors,
 			if (plan->qual)
 				show_instrumentation_count("Rows Removed by Filter", 1,
 										   planstate, es);
+			show_hashagg_info((AggState *) planstate, es);
 			break;
 		case T_Group:
 			show_group_keys((GroupState *) planstate, ancestors, es);
@@ -1552,6 +1671,12 @@ ExplainNode(PlanState *planstate, List *ancestors,
 			show_sort_keys((SortState *) planstate, ancestors, es);
 			show_sort_info((SortState *) planstate, es);
 			break;
+		case T_IncrementalSort:
+			show_incremental_sort_keys((IncrementalSortState *) planstate,
+									   ancestors, es);
+			show_incremental_sort_info((IncrementalSortState *) planstate,
+									   es);
+			break;
 		case T_MergeAppend:
 			show_merge_append_keys((MergeAppendState *) planstate,
 								   ancestors, es);
@@ -1890,6 +2015,27 @@ show_sort_keys(SortState *sortstate, List *ancestors, ExplainState *es)
 						 ancestors, es);
 }
 
+/*
+ * Show the sort keys for an IncrementalSort node, and which of them the
+ * input is already sorted by.
+ */
+static void
+show_incremental_sort_keys(IncrementalSortState *incrsortstate,
+						   List *ancestors, ExplainState *es)
+{
+	IncrementalSort *plan = (IncrementalSort *) incrsortstate->ss.ps.plan;
+
+	show_sort_group_keys((PlanState *) incrsortstate, "Sort Key",
+						 plan->sort.numCols, plan->sort.sortColIdx,
+						 plan->sort.sortOperators, plan->sort.collations,
+						 plan->sort.nullsFirst,
+						 ancestors, es);
+	show_sort_group_keys((PlanState *) incrsortstate, "Presorted Key",
+						 plan->nPresortedCols, plan->sort.sortColIdx,
+						 NULL, NULL, NULL,
+						 ancestors, es);
+}
+
 /*
  * Likewise, for a MergeAppend node.
  */
@@ -1906,6 +2052,22 @@ show_merge_append_keys(MergeAppendState *mstate, List *ancestors,
 						 ancestors, es);
 }
 
+/*
+ * Likewise, for a GatherMerge node.
+ */
+static void
+show_gather_merge_keys(GatherMergeState *gmstate, List *ancestors,
+					   ExplainState *es)
+{
+	GatherMerge *plan = (GatherMerge *) gmstate->ps.plan;
+
+	show_sort_group_keys((PlanState *) gmstate, "Sort Key",
+						 plan->numCols, plan->sortColIdx,
+						 plan->sortOperators, plan->collations,
+						 plan->nullsFirst,
+						 ancestors, es);
+}
+
 /*
  * Show the grouping keys for an Agg node.
  */
@@ -2256,6 +2418,36 @@ show_sort_info(SortState *sortstate, ExplainState *es)
 	}
 }
 
+/*
+ * If it's EXPLAIN ANALYZE, show the number of batches an incremental sort
+ * node sorted and the space used by the largest of them
+ */
+static void
+show_incremental_sort_info(IncrementalSortState *incrsortstate,
+						   ExplainState *es)
+{
+	Assert(IsA(incrsortstate, IncrementalSortState));
+	if (es->analyze && incrsortstate->nbatches > 0)
+	{
+		if (es->format == EXPLAIN_FORMAT_TEXT)
+		{
+			appendStringInfoSpaces(es->str, es->indent * 2);
+			appendStringInfo(es->str, "Sort Batches: %ld  Peak %s: %ldkB\n",
+							 incrsortstate->nbatches,
+							 incrsortstate->maxSpaceType,
+							 incrsortstate->maxSpaceUsed);
+		}
+		else
+		{
+			ExplainPropertyLong("Sort Batches", incrsortstate->nbatches, es);
+			ExplainPropertyLong("Peak Sort Space Used",
+								incrsortstate->maxSpaceUsed, es);
+			ExplainPropertyText("Peak Sort Space Type",
+								incrsortstate->maxSpaceType, es);
+		}
+	}
+}
+
 /*
  * Show information on hash buckets/batches.
  */
@@ -2304,6 +2496,278 @@ show_hash_info(HashState *hashstate, ExplainState *es)
 	}
 }
 
+/*
+ * If it's EXPLAIN ANALYZE, show memory and disk usage of a hashed Agg node
+ */
+static void
+show_hashagg_info(AggState *aggstate, ExplainState *es)
+{
+	Agg		   *agg = (Agg *) aggstate->ss.ps.plan;
+	long		memPeakKb = (aggstate->hash_mem_peak + 1023) / 1024;
+	long		diskKb = (aggstate->hash_disk_used + 1023) / 1024;
+	int			nbatches = aggstate->hash_batches_used + 1;
+
+	if (!es->analyze || agg->aggstrategy != AGG_HASHED ||
+		!aggstate->table_filled)
+		return;
+
+	if (es->format != EXPLAIN_FORMAT_TEXT)
+	{
+		ExplainPropertyLong("HashAgg Batches", nbatches, es);
+		ExplainPropertyLong("Peak Memory Usage", memPeakKb, es);
+		ExplainPropertyLong("Disk Usage", diskKb, es);
+	}
+	else if (aggstate->hash_disk_used > 0)
+	{
+		appendStringInfoSpaces(es->str, es->indent * 2);
+		appendStringInfo(es->str,
+						 "Batches: %d  Memory Usage: %ldkB  Disk Usage: %ldkB\n",
+						 nbatches, memPeakKb, diskKb);
+	}
+	else
+	{
+		appendStringInfoSpaces(es->str, es->indent * 2);
+		appendStringInfo(es->str, "Memory Usage: %ldkB\n", memPeakKb);
+	}
+}
+
+/*
+ * If it's EXPLAIN ANALYZE, show traversal statistics for a NestLoopVLE node
+ */
+static void
+show_vle_info(NestLoopVLEState *vlestate, ExplainState *es)
+{
+	SharedNestLoopVLEInfo *si = vlestate->worker_info;
+
+	show_traversal_info(&vlestate->vinstrument,
+						si != NULL ? si->vinstrument : NULL,
+						si != NULL ? si->num_workers : 0,
+						sizeof(NestLoopVLEInstrumentation),
+						accum_vle_instrumentation, show_vle_instrumentation,
+						es);
+}
+
+static void
+accum_vle_instrumentation(void *dst, void *src)
+{
+	ExecNestLoopVLEAccumInstrumentation((NestLoopVLEInstrumentation *) dst,
+										(NestLoopVLEInstrumentation *) src);
+}
+
+static void
+show_vle_instrumentation(void *instrument, ExplainState *es)
+{
+	NestLoopVLEInstrumentation *vinstrument =
+		(NestLoopVLEInstrumentation *) instrument;
+	char		label[32];
+	int			i;
+
+	if (es->format == EXPLAIN_FORMAT_TEXT)
+	{
+		bool		first = true;
+
+		for (i = 0; i <= VLE_INSTR_MAX_HOPS; i++)
+		{
+			if (vinstrument->hopRows[i] == 0)
+				continue;
+
+			if (first)
+			{
+				appendStringInfoSpaces(es->str, es->indent * 2);
+				appendStringInfoString(es->str, "Rows per Hop:");
+				first = false;
+			}
+			appendStringInfo(es->str, " %d%s=" UINT64_FORMAT, i,
+							 (i == VLE_INSTR_MAX_HOPS) ? "+" : "",
+							 vinstrument->hopRows[i]);
+		}
+		if (!first)
+			appendStringInfoChar(es->str, '\n');
+
+		appendStringInfoSpaces(es->str, es->indent * 2);
+		appendStringInfo(es->str, "Inner Rescans: " UINT64_FORMAT
+						 "  Max Depth: %d",
+						 vinstrument->nrescans, vinstrument->maxDepth);
+		if (vinstrument->ncapped > 0)
+			appendStringInfo(es->str, "  Capped Vertices: " UINT64_FORMAT
+							 " (approximate result)",
+							 vinstrument->ncapped);
+		appendStringInfoChar(es->str, '\n');
+	}
+	else
+	{
+		ExplainOpenGroup("Rows per Hop", "Rows per Hop", true, es);
+		for (i = 0; i <= VLE_INSTR_MAX_HOPS; i++)
+		{
+			if (vinstrument->hopRows[i] == 0)
+				continue;
+
+			snprintf(label, sizeof(label), "%d%s", i,
+					 (i == VLE_INSTR_MAX_HOPS) ? "+" : "");
+			ExplainPropertyLong(label, (long) vinstrument->hopRows[i], es);
+		}
+		ExplainCloseGroup("Rows per Hop", "Rows per Hop", true, es);
+
+		ExplainPropertyLong("Inner Rescans", (long) vinstrument->nrescans, es);
+		ExplainPropertyInteger("Max Depth", vinstrument->maxDepth, es);
+		if (vinstrument->ncapped > 0)
+		{
+			ExplainPropertyLong("Capped Vertices",
+								(long) vinstrument->ncapped, es);
+			ExplainPropertyBool("Approximate Result", true, es);
+		}
+	}
+
+	show_traversal_time(vinstrument->rescanTime, vinstrument->fetchTime, es);
+}
+
+/*
+ * If it's EXPLAIN ANALYZE, show search statistics for a Dijkstra node
+ */
+static void
+show_dijkstra_info(DijkstraState *dstate, ExplainState *es)
+{
+	SharedDijkstraInfo *si = dstate->worker_info;
+
+	show_traversal_info(&dstate->dinstrument,
+						si != NULL ? si->dinstrument : NULL,
+						si != NULL ? si->num_workers : 0,
+						sizeof(DijkstraInstrumentation),
+						accum_dijkstra_instrumentation,
+						show_dijkstra_instrumentation, es);
+}
+
+static void
+accum_dijkstra_instrumentation(void *dst, void *src)
+{
+	ExecDijkstraAccumInstrumentation((DijkstraInstrumentation *) dst,
+									 (DijkstraInstrumentation *) src);
+}
+
+static void
+show_dijkstra_instrumentation(void *instrument, ExplainState *es)
+{
+	DijkstraInstrumentation *dinstrument =
+		(DijkstraInstrumentation *) instrument;
+	long		spacePeakKb = (dinstrument->peakQueueSpace + 1023) / 1024;
+
+	if (es->format == EXPLAIN_FORMAT_TEXT)
+	{
+		appendStringInfoSpaces(es->str, es->indent * 2);
+		appendStringInfo(es->str,
+						 "Heap Pushes: " UINT64_FORMAT "  Heap Pops: "
+						 UINT64_FORMAT "  Visited Nodes: %ld"
+						 "  Peak Queue Memory: %ldkB",
+						 dinstrument->heapPushes, dinstrument->heapPops,
+						 dinstrument->maxVisited, spacePeakKb);
+		if (dinstrument->ncapped > 0)
+			appendStringInfo(es->str, "  Capped Vertices: " UINT64_FORMAT
+							 " (approximate result)",
+							 dinstrument->ncapped);
+		appendStringInfoChar(es->str, '\n');
+	}
+	else
+	{
+		ExplainPropertyLong("Heap Pushes", (long) dinstrument->heapPushes, es);
+		ExplainPropertyLong("Heap Pops", (long) dinstrument->heapPops, es);
+		ExplainPropertyLong("Visited Nodes", dinstrument->maxVisited, es);
+		ExplainPropertyLong("Peak Queue Memory", spacePeakKb, es);
+		if (dinstrument->ncapped > 0)
+		{
+			ExplainPropertyLong("Capped Vertices",
+								(long) dinstrument->ncapped, es);
+			ExplainPropertyBool("Approximate Result", true, es);
+		}
+	}
+
+	show_traversal_time(dinstrument->rescanTime, dinstrument->fetchTime, es);
+}
+
+/*
+ * Show the statistics of a graph traversal node (NestLoopVLE or Dijkstra).
+ *
+ * "leader" is the instrumentation of the leader and "workers" is an array of
+ * "num_workers" instrumentations of "size" bytes each.  They are summed up by
+ * "accum" and the total is shown by "show".  Per-worker detail is shown in
+ * VERBOSE mode, skipping workers that did not take part in the traversal.
+ */
+static void
+show_traversal_info(void *leader, void *workers, int num_workers, Size size,
+					traversal_accum_fn accum, traversal_show_fn show,
+					ExplainState *es)
+{
+	void	   *total;
+	void	   *zero;
+	int			n;
+
+	if (!es->analyze)
+		return;
+
+	total = palloc(size);
+	memcpy(total, leader, size);
+	for (n = 0; n < num_workers; n++)
+		accum(total, (char *) workers + n * size);
+
+	show(total, es);
+	pfree(total);
+
+	if (!es->verbose || num_workers == 0)
+		return;
+
+	zero = palloc0(size);
+
+	ExplainOpenGroup("Workers", "Workers", false, es);
+	for (n = 0; n < num_workers; n++)
+	{
+		void	   *w = (char *) workers + n * size;
+
+		if (memcmp(w, zero, size) == 0)
+			continue;
+
+		ExplainOpenGroup("Worker", NULL, true, es);
+		if (es->format == EXPLAIN_FORMAT_TEXT)
+		{
+			appendStringInfoSpaces(es->str, es->indent * 2);
+			appendStringInfo(es->str, "Worker %d:\n", n);
+			es->indent++;
+		}
+		else
+			ExplainPropertyInteger("Worker Number", n, es);
+
+		show(w, es);
+
+		if (es->format == EXPLAIN_FORMAT_TEXT)
+			es->indent--;
+		ExplainCloseGroup("Worker", NULL, true, es);
+	}
+	ExplainCloseGroup("Workers", "Workers", false, es);
+
+	pfree(zero);
+}
+
+/*
+ * Show the time a traversal node spent in rescanning its edge scan and in
+ * fetching edges from it.
+ */
+static void
+show_traversal_time(double rescanTime, double fetchTime, ExplainState *es)
+{
+	if (!es->timing)
+		return;
+
+	if (es->format == EXPLAIN_FORMAT_TEXT)
+	{
+		appendStringInfoSpaces(es->str, es->indent * 2);
+		appendStringInfo(es->str, "Rescan Time: %.3f ms  Fetch Time: %.3f ms\n",
+						 1000.0 * rescanTime, 1000.0 * fetchTime);
+	}
+	else
+	{
+		ExplainPropertyFloat("Rescan Time", 1000.0 * rescanTime, 3, es);
+		ExplainPropertyFloat("Fetch Time", 1000.0 * fetchTime, 3, es);
+	}
+}
+
 /*
  * If it's EXPLAIN ANALYZE, show exact/lossy pages for a BitmapHeapScan node
  */
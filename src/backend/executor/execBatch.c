@@ -0,0 +1,838 @@
+/*-------------------------------------------------------------------------
+ *
+ * execBatch.c
+ *	  Batch-at-a-time tuple flow between executor nodes
+ *
+ * Normally a node gets the rows of its child one at a time, by calling
+ * ExecProcNode() which returns a TupleTableSlot.  For a scan feeding a
+ * simple aggregate that per-row call, the projection of the slot, the
+ * evaluation of the qual tree and the fmgr call of each transition function
+ * are most of the work.  With batches, the child fills a TupleBatch with up
+ * to TUPLE_BATCH_SIZE rows stored by column, a selection vector records the
+ * rows that pass the child's quals, and the parent consumes the whole batch
+ * with type specific loops ("kernels").
+ *
+ * Batches are opt-in (enable_batch_execution) and only used when every qual
+ * of the child and every aggregate of the parent has a kernel; otherwise the
+ * nodes fall back to ExecProcNode() transparently.  So far sequential scans
+ * produce batches and plain (ungrouped) aggregation consumes them.
+ *
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ *
+ * IDENTIFICATION
+ *	  src/backend/executor/execBatch.c
+ *
+ *-------------------------------------------------------------------------
+ */
+/*
+ * INTERFACE ROUTINES
+ *		ExecInitBatch		set up a node to produce batches
+ *		ExecProcNodeBatch	get the next batch from a node
+ *		ExecBatchQual		select the rows of a batch that pass its quals
+ *		ExecBatchTransFunc	look up the batch kernel of a transition function
+ */
+#include "postgres.h"
+
+#include <math.h>
+
+#include "catalog/pg_type.h"
+#include "executor/execBatch.h"
+#include "executor/executor.h"
+#include "executor/instrument.h"
+#include "executor/nodeSeqscan.h"
+#include "miscadmin.h"
+#include "nodes/nodeFuncs.h"
+#include "utils/array.h"
+#include "utils/fmgroids.h"
+#include "utils/graph.h"
+#include "utils/rel.h"
+
+
+/* GUC parameter */
+bool		enable_batch_execution = false;
+
+static int	batch_add_column(TupleBatch *batch, AttrNumber attnum,
+				 TupleDesc tupdesc);
+static bool batch_init_qual(TupleBatch *batch, BatchQual *bq, Expr *clause,
+				Index scanrelid, TupleDesc tupdesc);
+
+
+/* ----------------------------------------------------------------
+ *		Qual kernels
+ *
+ * Each kernel compacts the selection vector of the batch in place, keeping
+ * the rows whose column value compares true to the constant.  NULLs never
+ * pass, as the comparison operators are strict.  The loops are branch free
+ * so that the compiler can vectorize them.
+ * ----------------------------------------------------------------
+ */
+
+/* same ordering as float8_cmp_internal(): NaNs are equal and sort last */
+static inline int
+batch_float8_cmp(float8 a, float8 b)
+{
+	if (isnan(a))
+		return isnan(b) ? 0 : 1;
+	if (isnan(b))
+		return -1;
+	return (a > b) - (a < b);
+}
+
+#define BATCH_SCALAR_CMP(a, b)	(((a) > (b)) - ((a) < (b)))
+
+#define BATCH_FILTER(cond) \
+	for (i = 0; i < nsel; i++) \
+	{ \
+		int			row = sel[i]; \
+		\
+		sel[n] = row; \
+		n += !isnull[row] & (cond); \
+	}
+
+#define DEFINE_BATCH_COMPARE(name, ctype, DatumGetC, CMP) \
+static void \
+name(TupleBatch *batch, BatchQual *qual) \
+{ \
+	Datum	   *values = batch->values[qual->col]; \
+	bool	   *isnull = batch->isnull[qual->col]; \
+	uint16	   *sel = batch->sel; \
+	int			nsel = batch->nsel; \
+	ctype		c = DatumGetC(qual->constval); \
+	int			n = 0; \
+	int			i; \
+	\
+	switch (qual->op) \
+	{ \
+		case BATCH_OP_EQ: \
+			BATCH_FILTER(CMP(DatumGetC(values[row]), c) == 0); \
+			break; \
+		case BATCH_OP_NE: \
+			BATCH_FILTER(CMP(DatumGetC(values[row]), c) != 0); \
+			break; \
+		case BATCH_OP_LT: \
+			BATCH_FILTER(CMP(DatumGetC(values[row]), c) < 0); \
+			break; \
+		case BATCH_OP_LE: \
+			BATCH_FILTER(CMP(DatumGetC(values[row]), c) <= 0); \
+			break; \
+		case BATCH_OP_GT: \
+			BATCH_FILTER(CMP(DatumGetC(values[row]), c) > 0); \
+			break; \
+		case BATCH_OP_GE: \
+			BATCH_FILTER(CMP(DatumGetC(values[row]), c) >= 0); \
+			break; \
+	} \
+	batch->nsel = n; \
+}
+
+DEFINE_BATCH_COMPARE(batch_compare_int4, int32, DatumGetInt32, BATCH_SCALAR_CMP)
+DEFINE_BATCH_COMPARE(batch_compare_int8, int64, DatumGetInt64, BATCH_SCALAR_CMP)
+DEFINE_BATCH_COMPARE(batch_compare_float8, float8, DatumGetFloat8, batch_float8_cmp)
+DEFINE_BATCH_COMPARE(batch_compare_graphid, Graphid, DatumGetGraphid, BATCH_SCALAR_CMP)
+
+/*
+ * Comparison functions with kernels.  The kernel is chosen by the type of the
+ * column; an int4 constant compared to an int8 column is widened up front.
+ */
+static const struct
+{
+	Oid			funcid;
+	Oid			lefttype;
+	Oid			righttype;
+	BatchCompareOp op;
+}	batch_compare_funcs[] =
+{
+	{F_INT4EQ, INT4OID, INT4OID, BATCH_OP_EQ},
+	{F_INT4NE, INT4OID, INT4OID, BATCH_OP_NE},
+	{F_INT4LT, INT4OID, INT4OID, BATCH_OP_LT},
+	{F_INT4LE, INT4OID, INT4OID, BATCH_OP_LE},
+	{F_INT4GT, INT4OID, INT4OID, BATCH_OP_GT},
+	{F_INT4GE, INT4OID, INT4OID, BATCH_OP_GE},
+	{F_INT8EQ, INT8OID, INT8OID, BATCH_OP_EQ},
+	{F_INT8NE, INT8OID, INT8OID, BATCH_OP_NE},
+	{F_INT8LT, INT8OID, INT8OID, BATCH_OP_LT},
+	{F_INT8LE, INT8OID, INT8OID, BATCH_OP_LE},
+	{F_INT8GT, INT8OID, INT8OID, BATCH_OP_GT},
+	{F_INT8GE, INT8OID, INT8OID, BATCH_OP_GE},
+	{F_INT84EQ, INT8OID, INT4OID, BATCH_OP_EQ},
+	{F_INT84NE, INT8OID, INT4OID, BATCH_OP_NE},
+	{F_INT84LT, INT8OID, INT4OID, BATCH_OP_LT},
+	{F_INT84LE, INT8OID, INT4OID, BATCH_OP_LE},
+	{F_INT84GT, INT8OID, INT4OID, BATCH_OP_GT},
+	{F_INT84GE, INT8OID, INT4OID, BATCH_OP_GE},
+	{F_INT48EQ, INT4OID, INT8OID, BATCH_OP_EQ},
+	{F_INT48NE, INT4OID, INT8OID, BATCH_OP_NE},
+	{F_INT48LT, INT4OID, INT8OID, BATCH_OP_LT},
+	{F_INT48LE, INT4OID, INT8OID, BATCH_OP_LE},
+	{F_INT48GT, INT4OID, INT8OID, BATCH_OP_GT},
+	{F_INT48GE, INT4OID, INT8OID, BATCH_OP_GE},
+	{F_FLOAT8EQ, FLOAT8OID, FLOAT8OID, BATCH_OP_EQ},
+	{F_FLOAT8NE, FLOAT8OID, FLOAT8OID, BATCH_OP_NE},
+	{F_FLOAT8LT, FLOAT8OID, FLOAT8OID, BATCH_OP_LT},
+	{F_FLOAT8LE, FLOAT8OID, FLOAT8OID, BATCH_OP_LE},
+	{F_FLOAT8GT, FLOAT8OID, FLOAT8OID, BATCH_OP_GT},
+	{F_FLOAT8GE, FLOAT8OID, FLOAT8OID, BATCH_OP_GE},
+	{F_GRAPHID_EQ, GRAPHIDOID, GRAPHIDOID, BATCH_OP_EQ},
+	{F_GRAPHID_NE, GRAPHIDOID, GRAPHIDOID, BATCH_OP_NE},
+	{F_GRAPHID_LT, GRAPHIDOID, GRAPHIDOID, BATCH_OP_LT},
+	{F_GRAPHID_LE, GRAPHIDOID, GRAPHIDOID, BATCH_OP_LE},
+	{F_GRAPHID_GT, GRAPHIDOID, GRAPHIDOID, BATCH_OP_GT},
+	{F_GRAPHID_GE, GRAPHIDOID, GRAPHIDOID, BATCH_OP_GE}
+};
+
+/* ----------------------------------------------------------------
+ *		Transition kernels
+ *
+ * Each kernel has the effect of calling the transition function once for
+ * each selected row, in order, so results (including floating point
+ * rounding and overflow errors) are the same as without batches.
+ * ----------------------------------------------------------------
+ */
+
+static void
+float8_overflow_error(void)
+{
+	ereport(ERROR,
+			(errcode(ERRCODE_NUMERIC_VALUE_OUT_OF_RANGE),
+			 errmsg("value out of range: overflow")));
+}
+
+/* int8inc: count(*) */
+static void
+batch_trans_int8inc(TupleBatch *batch, int col, Datum *transValue,
+					bool *transValueIsNull, bool *noTransValue)
+{
+	int64		count;
+	int64		result;
+
+	if (*transValueIsNull)
+		return;
+
+	count = DatumGetInt64(*transValue);
+	result = count + batch->nsel;
+	if (result < count)
+		ereport(ERROR,
+				(errcode(ERRCODE_NUMERIC_VALUE_OUT_OF_RANGE),
+				 errmsg("bigint out of range")));
+
+	*transValue = Int64GetDatum(result);
+}
+
+/* int8inc_any: count(expr) */
+static void
+batch_trans_int8inc_any(TupleBatch *batch, int col, Datum *transValue,
+						bool *transValueIsNull, bool *noTransValue)
+{
+	bool	   *isnull = batch->isnull[col];
+	uint16	   *sel = batch->sel;
+	int			nsel = batch->nsel;
+	int64		count;
+	int64		result;
+	int64		n = 0;
+	int			i;
+
+	if (*transValueIsNull)
+		return;
+
+	for (i = 0; i < nsel; i++)
+		n += !isnull[sel[i]];
+
+	count = DatumGetInt64(*transValue);
+	result = count + n;
+	if (result < count)
+		ereport(ERROR,
+				(errcode(ERRCODE_NUMERIC_VALUE_OUT_OF_RANGE),
+				 errmsg("bigint out of range")));
+
+	*transValue = Int64GetDatum(result);
+}
+
+/* int4_sum: sum(int4); not strict, the state starts out NULL */
+static void
+batch_trans_int4_sum(TupleBatch *batch, int col, Datum *transValue,
+					 bool *transValueIsNull, bool *noTransValue)
+{
+	Datum	   *values = batch->values[col];
+	bool	   *isnull = batch->isnull[col];
+	uint16	   *sel = batch->sel;
+	int			nsel = batch->nsel;
+	int64		sum = 0;
+	int			n = 0;
+	int			i;
+
+	for (i = 0; i < nsel; i++)
+	{
+		int			row = sel[i];
+
+		sum += isnull[row] ? 0 : (int64) DatumGetInt32(values[row]);
+		n += !isnull[row];
+	}
+
+	if (n == 0)
+		return;
+
+	if (*transValueIsNull)
+	{
+		*transValue = Int64GetDatum(sum);
+		*transValueIsNull = false;
+	}
+	else
+		*transValue = Int64GetDatum(DatumGetInt64(*transValue) + sum);
+}
+
+/* int4_avg_accum: avg(int4); the state is an int8[2] of count and sum */
+static void
+batch_trans_int4_avg_accum(TupleBatch *batch, int col, Datum *transValue,
+						   bool *transValueIsNull, bool *noTransValue)
+{
+	Datum	   *values = batch->values[col];
+	bool	   *isnull = batch->isnull[col];
+	uint16	   *sel = batch->sel;
+	int			nsel = batch->nsel;
+	ArrayType  *transarray;
+	int64	   *transdata;
+	int64		sum = 0;
+	int64		n = 0;
+	int			i;
+
+	if (*transValueIsNull)
+		return;
+
+	transarray = DatumGetArrayTypeP(*transValue);
+	if (ARR_HASNULL(transarray) ||
+		ARR_SIZE(transarray) != ARR_OVERHEAD_NONULLS(1) + 2 * sizeof(int64))
+		elog(ERROR, "expected 2-element int8 array");
+
+	for (i = 0; i < nsel; i++)
+	{
+		int			row = sel[i];
+
+		sum += isnull[row] ? 0 : (int64) DatumGetInt32(values[row]);
+		n += !isnull[row];
+	}
+
+	transdata = (int64 *) ARR_DATA_PTR(transarray);
+	transdata[0] += n;
+	transdata[1] += sum;
+
+	*transValue = PointerGetDatum(transarray);
+}
+
+/* float8pl: sum(float8); strict, the first input becomes the state */
+static void
+batch_trans_float8pl(TupleBatch *batch, int col, Datum *transValue,
+					 bool *transValueIsNull, bool *noTransValue)
+{
+	Datum	   *values = batch->values[col];
+	bool	   *isnull = batch->isnull[col];
+	uint16	   *sel = batch->sel;
+	int			nsel = batch->nsel;
+	float8		state;
+	int			i = 0;
+
+	if (*noTransValue)
+	{
+		for (; i < nsel && isnull[sel[i]]; i++)
+			;
+		if (i == nsel)
+			return;
+		*transValue = values[sel[i++]];
+		*transValueIsNull = false;
+		*noTransValue = false;
+	}
+	if (*transValueIsNull)
+		return;
+
+	state = DatumGetFloat8(*transValue);
+	for (; i < nsel; i++)
+	{
+		int			row = sel[i];
+		float8		newval;
+		float8		result;
+
+		if (isnull[row])
+			continue;
+
+		newval = DatumGetFloat8(values[row]);
+		result = state + newval;
+		if (isinf(result) && !isinf(state) && !isinf(newval))
+			float8_overflow_error();
+		state = result;
+	}
+
+	*transValue = Float8GetDatum(state);
+}
+
+/* float8_accum: avg(float8) and friends; the state is a float8[3] */
+static void
+batch_trans_float8_accum(TupleBatch *batch, int col, Datum *transValue,
+						 bool *transValueIsNull, bool *noTransValue)
+{
+	Datum	   *values = batch->values[col];
+	bool	   *isnull = batch->isnull[col];
+	uint16	   *sel = batch->sel;
+	int			nsel = batch->nsel;
+	ArrayType  *transarray;
+	float8	   *transvalues;
+	float8		N,
+				sumX,
+				sumX2;
+	int			i;
+
+	if (*transValueIsNull)
+		return;
+
+	transarray = DatumGetArrayTypeP(*transValue);
+	if (ARR_NDIM(transarray) != 1 ||
+		ARR_DIMS(transarray)[0] != 3 ||
+		ARR_HASNULL(transarray) ||
+		ARR_ELEMTYPE(transarray) != FLOAT8OID)
+		elog(ERROR, "float8_accum: expected 3-element float8 array");
+
+	transvalues = (float8 *) ARR_DATA_PTR(transarray);
+	N = transvalues[0];
+	sumX = transvalues[1];
+	sumX2 = transvalues[2];
+
+	for (i = 0; i < nsel; i++)
+	{
+		int			row = sel[i];
+		float8		newval;
+		float8		oldsumX = sumX;
+		float8		oldsumX2 = sumX2;
+
+		if (isnull[row])
+			continue;
+
+		newval = DatumGetFloat8(values[row]);
+		N += 1.0;
+		sumX += newval;
+		if (isinf(sumX) && !isinf(oldsumX) && !isinf(newval))
+			float8_overflow_error();
+		sumX2 += newval * newval;
+		if (isinf(sumX2) && !isinf(oldsumX2) && !isinf(newval))
+			float8_overflow_error();
+	}
+
+	transvalues[0] = N;
+	transvalues[1] = sumX;
+	transvalues[2] = sumX2;
+
+	*transValue = PointerGetDatum(transarray);
+}
+
+/*
+ * min() and max(): strict, the first input becomes the state, and the state
+ * is replaced by every input that compares "better" than it.
+ */
+#define DEFINE_BATCH_MINMAX(name, ctype, DatumGetC, CGetDatum, CMP, better) \
+static void \
+name(TupleBatch *batch, int col, Datum *transValue, \
+	 bool *transValueIsNull, bool *noTransValue) \
+{ \
+	Datum	   *values = batch->values[col]; \
+	bool	   *isnull = batch->isnull[col]; \
+	uint16	   *sel = batch->sel; \
+	int			nsel = batch->nsel; \
+	ctype		state; \
+	int			i = 0; \
+	\
+	if (*noTransValue) \
+	{ \
+		for (; i < nsel && isnull[sel[i]]; i++) \
+			; \
+		if (i == nsel) \
+			return; \
+		*transValue = values[sel[i++]]; \
+		*transValueIsNull = false; \
+		*noTransValue = false; \
+	} \
+	if (*transValueIsNull) \
+		return; \
+	\
+	state = DatumGetC(*transValue); \
+	for (; i < nsel; i++) \
+	{ \
+		int			row = sel[i]; \
+		ctype		newval = DatumGetC(values[row]); \
+		\
+		if (!isnull[row] && !(CMP(state, newval) better 0)) \
+			state = newval; \
+	} \
+	*transValue = CGetDatum(state); \
+}
+
+DEFINE_BATCH_MINMAX(batch_trans_int4larger, int32, DatumGetInt32, Int32GetDatum, BATCH_SCALAR_CMP, >)
+DEFINE_BATCH_MINMAX(batch_trans_int4smaller, int32, DatumGetInt32, Int32GetDatum, BATCH_SCALAR_CMP, <)
+DEFINE_BATCH_MINMAX(batch_trans_int8larger, int64, DatumGetInt64, Int64GetDatum, BATCH_SCALAR_CMP, >)
+DEFINE_BATCH_MINMAX(batch_trans_int8smaller, int64, DatumGetInt64, Int64GetDatum, BATCH_SCALAR_CMP, <)
+DEFINE_BATCH_MINMAX(batch_trans_float8larger, float8, DatumGetFloat8, Float8GetDatum, batch_float8_cmp, >)
+DEFINE_BATCH_MINMAX(batch_trans_float8smaller, float8, DatumGetFloat8, Float8GetDatum, batch_float8_cmp, <)
+
+/*
+ * Transition functions with kernels.  "byval" kernels keep a pass-by-value
+ * state, which int8 and float8 are not on every platform; the others update
+ * an array state in place.  "needsvalue" is false for kernels that only look
+ * at the null flags of their column.
+ */
+static const struct
+{
+	Oid			funcid;
+	BatchTransFunc func;
+	bool		byval;
+	bool		needsvalue;
+}	batch_trans_funcs[] =
+{
+	{F_INT8INC, batch_trans_int8inc, true, false},
+	{F_INT8INC_ANY, batch_trans_int8inc_any, true, false},
+	{F_INT4_SUM, batch_trans_int4_sum, true, true},
+	{F_INT4_AVG_ACCUM, batch_trans_int4_avg_accum, false, true},
+	{F_FLOAT8PL, batch_trans_float8pl, true, true},
+	{F_FLOAT8_ACCUM, batch_trans_float8_accum, false, true},
+	{F_INT4LARGER, batch_trans_int4larger, true, true},
+	{F_INT4SMALLER, batch_trans_int4smaller, true, true},
+	{F_INT8LARGER, batch_trans_int8larger, true, true},
+	{F_INT8SMALLER, batch_trans_int8smaller, true, true},
+	{F_FLOAT8LARGER, batch_trans_float8larger, true, true},
+	{F_FLOAT8SMALLER, batch_trans_float8smaller, true, true}
+};
+
+
+/* ----------------------------------------------------------------
+ *		ExecInitBatch
+ *
+ *		Set up "node" to return its rows in batches.  outcols[0 .. ncols - 1]
+ *		are the output columns (target list resnos) of the node that the
+ *		caller needs; on success colmap[i] is set to the batch column that
+ *		holds outcols[i].  Returns NULL if the node cannot produce batches,
+ *		in which case the caller must use ExecProcNode() as usual.
+ *
+ *		Rows of a batch are not projected, so every output column needed
+ *		must be a plain column of the scanned relation, and every qual of
+ *		the node must have a kernel.
+ * ----------------------------------------------------------------
+ */
+TupleBatch *
+ExecInitBatch(PlanState *node, int ncols, AttrNumber *outcols, int *colmap)
+{
+	Plan	   *plan = node->plan;
+	ScanState  *scanstate;
+	Index		scanrelid;
+	TupleDesc	tupdesc;
+	TupleBatch *batch;
+	int			maxcols;
+	ListCell   *lc;
+	int			i;
+
+	if (!enable_batch_execution)
+		return NULL;
+
+	/* so far only sequential scans produce batches */
+	if (!IsA(node, SeqScanState))
+		return NULL;
+
+	/* EvalPlanQual rechecks replace the scanned rows with test tuples */
+	if (node->state->es_epqTuple != NULL)
+		return NULL;
+
+	scanstate = (ScanState *) node;
+	scanrelid = ((Scan *) plan)->scanrelid;
+	tupdesc = RelationGetDescr(scanstate->ss_currentRelation);
+
+	maxcols = ncols + list_length(plan->qual);
+
+	batch = (TupleBatch *) palloc0(sizeof(TupleBatch));
+	batch->attnums = (AttrNumber *) palloc(sizeof(AttrNumber) * maxcols);
+	batch->byval = (bool *) palloc(sizeof(bool) * maxcols);
+	batch->quals = (BatchQual *) palloc(sizeof(BatchQual) *
+										list_length(plan->qual));
+
+	for (i = 0; i < ncols; i++)
+	{
+		TargetEntry *tle;
+		Var		   *var;
+
+		if (outcols[i] <= 0 || outcols[i] > list_length(plan->targetlist))
+			return NULL;
+
+		tle = (TargetEntry *) list_nth(plan->targetlist, outcols[i] - 1);
+		Assert(tle->resno == outcols[i]);
+
+		var = (Var *) tle->expr;
+		if (!IsA(var, Var) ||
+			var->varno != scanrelid ||
+			var->varattno <= 0)
+			return NULL;
+
+		colmap[i] = batch_add_column(batch, var->varattno, tupdesc);
+	}
+
+	foreach(lc, plan->qual)
+	{
+		if (!batch_init_qual(batch, &batch->quals[batch->nquals],
+							 (Expr *) lfirst(lc), scanrelid, tupdesc))
+			return NULL;
+		batch->nquals++;
+	}
+
+	batch->values = (Datum **) palloc(sizeof(Datum *) * Max(batch->ncols, 1));
+	batch->isnull = (bool **) palloc(sizeof(bool *) * Max(batch->ncols, 1));
+	for (i = 0; i < batch->ncols; i++)
+	{
+		batch->values[i] = (Datum *) palloc(sizeof(Datum) * TUPLE_BATCH_SIZE);
+		batch->isnull[i] = (bool *) palloc(sizeof(bool) * TUPLE_BATCH_SIZE);
+	}
+	batch->sel = (uint16 *) palloc(sizeof(uint16) * TUPLE_BATCH_SIZE);
+
+	return batch;
+}
+
+/*
+ * Return the batch column for heap attribute "attnum", adding it if needed.
+ */
+static int
+batch_add_column(TupleBatch *batch, AttrNumber attnum, TupleDesc tupdesc)
+{
+	int			col;
+
+	for (col = 0; col < batch->ncols; col++)
+	{
+		if (batch->attnums[col] == attnum)
+			return col;
+	}
+
+	batch->attnums[col] = attnum;
+	batch->byval[col] = tupdesc->attrs[attnum - 1]->attbyval;
+	batch->maxattnum = Max(batch->maxattnum, attnum);
+	batch->ncols++;
+
+	return col;
+}
+
+/*
+ * Set up "bq" to evaluate "clause", if it is a comparison of a column of the
+ * scanned relation with a non-null constant that has a kernel.
+ */
+static bool
+batch_init_qual(TupleBatch *batch, BatchQual *bq, Expr *clause,
+				Index scanrelid, TupleDesc tupdesc)
+{
+	OpExpr	   *opexpr;
+	Node	   *leftop;
+	Node	   *rightop;
+	Var		   *var;
+	Const	   *con;
+	bool		commuted;
+	Oid			coltype;
+	Oid			consttype;
+	Datum		constval;
+	BatchQualFunc func;
+	int			col;
+	int			i;
+
+	if (!IsA(clause, OpExpr))
+		return false;
+
+	opexpr = (OpExpr *) clause;
+	if (list_length(opexpr->args) != 2)
+		return false;
+
+	leftop = (Node *) linitial(opexpr->args);
+	rightop = (Node *) lsecond(opexpr->args);
+
+	if (IsA(leftop, Var) && IsA(rightop, Const))
+	{
+		var = (Var *) leftop;
+		con = (Const *) rightop;
+		commuted = false;
+	}
+	else if (IsA(leftop, Const) && IsA(rightop, Var))
+	{
+		var = (Var *) rightop;
+		con = (Const *) leftop;
+		commuted = true;
+	}
+	else
+		return false;
+
+	if (var->varno != scanrelid || var->varattno <= 0 || con->constisnull)
+		return false;
+
+	set_opfuncid(opexpr);
+	for (i = 0; i < lengthof(batch_compare_funcs); i++)
+	{
+		if (batch_compare_funcs[i].funcid == opexpr->opfuncid)
+			break;
+	}
+	if (i == lengthof(batch_compare_funcs))
+		return false;
+
+	if (commuted)
+	{
+		coltype = batch_compare_funcs[i].righttype;
+		consttype = batch_compare_funcs[i].lefttype;
+	}
+	else
+	{
+		coltype = batch_compare_funcs[i].lefttype;
+		consttype = batch_compare_funcs[i].righttype;
+	}
+
+	constval = con->constvalue;
+	switch (coltype)
+	{
+		case INT4OID:
+			if (consttype != INT4OID)
+				return false;
+			func = batch_compare_int4;
+			break;
+		case INT8OID:
+			if (consttype == INT4OID)
+				constval = Int64GetDatum((int64) DatumGetInt32(constval));
+			func = batch_compare_int8;
+			break;
+		case FLOAT8OID:
+			func = batch_compare_float8;
+			break;
+		case GRAPHIDOID:
+			func = batch_compare_graphid;
+			break;
+		default:
+			elog(ERROR, "unexpected column type %u", coltype);
+			return false;		/* keep compiler quiet */
+	}
+
+	col = batch_add_column(batch, var->varattno, tupdesc);
+	if (!batch->byval[col])
+		return false;
+
+	bq->func = func;
+	bq->col = col;
+	bq->op = batch_compare_funcs[i].op;
+	bq->constval = constval;
+
+	/* "const op column" is evaluated as "column op' const" */
+	if (commuted)
+	{
+		switch (bq->op)
+		{
+			case BATCH_OP_LT:
+				bq->op = BATCH_OP_GT;
+				break;
+			case BATCH_OP_LE:
+				bq->op = BATCH_OP_GE;
+				break;
+			case BATCH_OP_GT:
+				bq->op = BATCH_OP_LT;
+				break;
+			case BATCH_OP_GE:
+				bq->op = BATCH_OP_LE;
+				break;
+			default:
+				break;
+		}
+	}
+
+	return true;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecProcNodeBatch
+ *
+ *		Fill "batch" with the next rows of the given node, which must have
+ *		been set up by ExecInitBatch().  A batch may have no selected rows
+ *		at all; false is returned only once the node is exhausted.
+ * ----------------------------------------------------------------
+ */
+bool
+ExecProcNodeBatch(PlanState *node, TupleBatch *batch)
+{
+	CHECK_FOR_INTERRUPTS();
+
+	if (node->chgParam != NULL) /* something changed */
+	{
+		ExecReScan(node);		/* let ReScan handle this */
+		batch->done = false;
+	}
+
+	if (batch->done)
+	{
+		batch->nrows = 0;
+		batch->nsel = 0;
+		return false;
+	}
+
+	if (node->instrument)
+		InstrStartNode(node->instrument);
+
+	switch (nodeTag(node))
+	{
+		case T_SeqScanState:
+			ExecSeqScanBatch((SeqScanState *) node, batch);
+			break;
+
+		default:
+			elog(ERROR, "unrecognized node type: %d", (int) nodeTag(node));
+			break;
+	}
+
+	if (node->instrument)
+		InstrStopNode(node->instrument, (double) batch->nsel);
+
+	return batch->nrows > 0;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecBatchQual
+ *
+ *		Set the selection vector of a freshly loaded batch to the rows that
+ *		pass all of its quals.
+ * ----------------------------------------------------------------
+ */
+void
+ExecBatchQual(TupleBatch *batch)
+{
+	int			i;
+
+	for (i = 0; i < batch->nrows; i++)
+		batch->sel[i] = i;
+	batch->nsel = batch->nrows;
+
+	for (i = 0; i < batch->nquals && batch->nsel > 0; i++)
+	{
+		BatchQual  *qual = &batch->quals[i];
+
+		qual->func(batch, qual);
+	}
+}
+
+/* ----------------------------------------------------------------
+ *		ExecBatchTransFunc
+ *
+ *		Return the batch kernel of the given transition function, or NULL
+ *		if there is none.  *needsvalue is set to whether the kernel reads
+ *		the values of its input column, not just the null flags.
+ * ----------------------------------------------------------------
+ */
+BatchTransFunc
+ExecBatchTransFunc(Oid transfn_oid, bool transtypeByVal, bool *needsvalue)
+{
+	int			i;
+
+	for (i = 0; i < lengthof(batch_trans_funcs); i++)
+	{
+		if (batch_trans_funcs[i].funcid != transfn_oid)
+			continue;
+
+		if (batch_trans_funcs[i].byval != transtypeByVal)
+			return NULL;
+
+		*needsvalue = batch_trans_funcs[i].needsvalue;
+		return batch_trans_funcs[i].func;
+	}
+
+	return NULL;
+}
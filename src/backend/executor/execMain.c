@@ -46,6 +46,7 @@
 #include "commands/trigger.h"
 #include "executor/execdebug.h"
 #include "foreign/fdwapi.h"
+#include "jit/jit.h"
 #include "mb/pg_wchar.h"
 #include "miscadmin.h"
 #include "optimizer/clauses.h"
@@ -232,6 +233,7 @@ standard_ExecutorStart(QueryDesc *queryDesc, int eflags)
 	estate->es_crosscheck_snapshot = RegisterSnapshot(queryDesc->crosscheck_snapshot);
 	estate->es_top_eflags = eflags;
 	estate->es_instrument = queryDesc->instrument_options;
+	estate->es_jit_flags = jit_flags_for_plan(queryDesc->plannedstmt);
 	estate->es_num_edgerefrels = queryDesc->plannedstmt->nVlePaths;
 	if (estate->es_num_edgerefrels > 0)
 		estate->es_edgerefrels = (Relation *)
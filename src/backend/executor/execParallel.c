@@ -25,8 +25,14 @@
 
 #include "executor/execParallel.h"
 #include "executor/executor.h"
+#include "executor/nodeBitmapHeapscan.h"
 #include "executor/nodeCustom.h"
+#include "executor/nodeDijkstra.h"
 #include "executor/nodeForeignscan.h"
+#include "executor/nodeHashjoin.h"
+#include "executor/nodeIndexonlyscan.h"
+#include "executor/nodeIndexscan.h"
+#include "executor/nodeNestloopVle.h"
 #include "executor/nodeSeqscan.h"
 #include "executor/tqueue.h"
 #include "nodes/nodeFuncs.h"
@@ -100,6 +106,8 @@ static bool ExecParallelEstimate(PlanState *node,
 					 ExecParallelEstimateContext *e);
 static bool ExecParallelInitializeDSM(PlanState *node,
 						  ExecParallelInitializeDSMContext *d);
+static bool ExecParallelReInitializeDSM(PlanState *planstate,
+							ParallelContext *pcxt);
 static shm_mq_handle **ExecParallelSetupTupleQueues(ParallelContext *pcxt,
 							 bool reinitialize);
 static bool ExecParallelRetrieveInstrumentation(PlanState *planstate,
@@ -193,6 +201,18 @@ ExecParallelEstimate(PlanState *planstate, ExecParallelEstimateContext *e)
 				ExecSeqScanEstimate((SeqScanState *) planstate,
 									e->pcxt);
 				break;
+			case T_IndexScanState:
+				ExecIndexScanEstimate((IndexScanState *) planstate,
+									  e->pcxt);
+				break;
+			case T_IndexOnlyScanState:
+				ExecIndexOnlyScanEstimate((IndexOnlyScanState *) planstate,
+										  e->pcxt);
+				break;
+			case T_BitmapHeapScanState:
+				ExecBitmapHeapEstimate((BitmapHeapScanState *) planstate,
+									   e->pcxt);
+				break;
 			case T_ForeignScanState:
 				ExecForeignScanEstimate((ForeignScanState *) planstate,
 										e->pcxt);
@@ -201,11 +221,28 @@ ExecParallelEstimate(PlanState *planstate, ExecParallelEstimateContext *e)
 				ExecCustomScanEstimate((CustomScanState *) planstate,
 									   e->pcxt);
 				break;
+			case T_HashJoinState:
+				ExecHashJoinEstimate((HashJoinState *) planstate,
+									 e->pcxt);
+				break;
 			default:
 				break;
 		}
 	}
 
+	/* Graph traversal nodes share their statistics even if not aware. */
+	switch (nodeTag(planstate))
+	{
+		case T_NestLoopVLEState:
+			ExecNestLoopVLEEstimate((NestLoopVLEState *) planstate, e->pcxt);
+			break;
+		case T_DijkstraState:
+			ExecDijkstraEstimate((DijkstraState *) planstate, e->pcxt);
+			break;
+		default:
+			break;
+	}
+
 	return planstate_tree_walker(planstate, ExecParallelEstimate, e);
 }
 
@@ -245,6 +282,18 @@ ExecParallelInitializeDSM(PlanState *planstate,
 				ExecSeqScanInitializeDSM((SeqScanState *) planstate,
 										 d->pcxt);
 				break;
+			case T_IndexScanState:
+				ExecIndexScanInitializeDSM((IndexScanState *) planstate,
+										   d->pcxt);
+				break;
+			case T_IndexOnlyScanState:
+				ExecIndexOnlyScanInitializeDSM((IndexOnlyScanState *) planstate,
+											   d->pcxt);
+				break;
+			case T_BitmapHeapScanState:
+				ExecBitmapHeapInitializeDSM((BitmapHeapScanState *) planstate,
+											d->pcxt);
+				break;
 			case T_ForeignScanState:
 				ExecForeignScanInitializeDSM((ForeignScanState *) planstate,
 											 d->pcxt);
@@ -253,11 +302,29 @@ ExecParallelInitializeDSM(PlanState *planstate,
 				ExecCustomScanInitializeDSM((CustomScanState *) planstate,
 											d->pcxt);
 				break;
+			case T_HashJoinState:
+				ExecHashJoinInitializeDSM((HashJoinState *) planstate,
+										  d->pcxt);
+				break;
 			default:
 				break;
 		}
 	}
 
+	/* Graph traversal nodes share their statistics even if not aware. */
+	switch (nodeTag(planstate))
+	{
+		case T_NestLoopVLEState:
+			ExecNestLoopVLEInitializeDSM((NestLoopVLEState *) planstate,
+										 d->pcxt);
+			break;
+		case T_DijkstraState:
+			ExecDijkstraInitializeDSM((DijkstraState *) planstate, d->pcxt);
+			break;
+		default:
+			break;
+	}
+
 	return planstate_tree_walker(planstate, ExecParallelInitializeDSM, d);
 }
 
@@ -323,6 +390,62 @@ ExecParallelReinitialize(ParallelExecutorInfo *pei)
 	ReinitializeParallelDSM(pei->pcxt);
 	pei->tqueue = ExecParallelSetupTupleQueues(pei->pcxt, true);
 	pei->finished = false;
+
+	/* Reset the shared state of parallel-aware nodes for the new scan. */
+	ExecParallelReInitializeDSM(pei->planstate, pei->pcxt);
+}
+
+/*
+ * Traverse the plan tree and let parallel-aware nodes reset the state they
+ * keep in the DSM.
+ *
+ * This is done here, while no worker is running, rather than in the nodes'
+ * own rescan routines, because a node's first rescan may happen in a worker
+ * or in the leader after the others have started to scan (for instance, to
+ * compute runtime index keys).
+ */
+static bool
+ExecParallelReInitializeDSM(PlanState *planstate, ParallelContext *pcxt)
+{
+	if (planstate == NULL)
+		return false;
+
+	if (planstate->plan->parallel_aware)
+	{
+		switch (nodeTag(planstate))
+		{
+			case T_IndexScanState:
+				ExecIndexScanReInitializeDSM((IndexScanState *) planstate,
+											 pcxt);
+				break;
+			case T_IndexOnlyScanState:
+				ExecIndexOnlyScanReInitializeDSM((IndexOnlyScanState *) planstate,
+												 pcxt);
+				break;
+			case T_BitmapHeapScanState:
+				ExecBitmapHeapReInitializeDSM((BitmapHeapScanState *) planstate,
+											  pcxt);
+				break;
+			default:
+				break;
+		}
+	}
+
+	/* Graph traversal nodes clear their statistics even if not aware. */
+	switch (nodeTag(planstate))
+	{
+		case T_NestLoopVLEState:
+			ExecNestLoopVLEReInitializeDSM((NestLoopVLEState *) planstate,
+										   pcxt);
+			break;
+		case T_DijkstraState:
+			ExecDijkstraReInitializeDSM((DijkstraState *) planstate, pcxt);
+			break;
+		default:
+			break;
+	}
+
+	return planstate_tree_walker(planstate, ExecParallelReInitializeDSM, pcxt);
 }
 
 /*
@@ -531,6 +654,20 @@ ExecParallelRetrieveInstrumentation(PlanState *planstate,
 	planstate->worker_instrument->num_workers = instrumentation->num_workers;
 	memcpy(&planstate->worker_instrument->instrument, instrument, ibytes);
 
+	/* Graph traversal nodes keep their own statistics; copy them too. */
+	switch (nodeTag(planstate))
+	{
+		case T_NestLoopVLEState:
+			ExecNestLoopVLERetrieveInstrumentation(
+											(NestLoopVLEState *) planstate);
+			break;
+		case T_DijkstraState:
+			ExecDijkstraRetrieveInstrumentation((DijkstraState *) planstate);
+			break;
+		default:
+			break;
+	}
+
 	return planstate_tree_walker(planstate, ExecParallelRetrieveInstrumentation,
 								 instrumentation);
 }
@@ -689,6 +826,18 @@ ExecParallelInitializeWorker(PlanState *planstate, shm_toc *toc)
 			case T_SeqScanState:
 				ExecSeqScanInitializeWorker((SeqScanState *) planstate, toc);
 				break;
+			case T_IndexScanState:
+				ExecIndexScanInitializeWorker((IndexScanState *) planstate,
+											  toc);
+				break;
+			case T_IndexOnlyScanState:
+				ExecIndexOnlyScanInitializeWorker((IndexOnlyScanState *) planstate,
+												  toc);
+				break;
+			case T_BitmapHeapScanState:
+				ExecBitmapHeapInitializeWorker((BitmapHeapScanState *) planstate,
+											   toc);
+				break;
 			case T_ForeignScanState:
 				ExecForeignScanInitializeWorker((ForeignScanState *) planstate,
 												toc);
@@ -697,11 +846,28 @@ ExecParallelInitializeWorker(PlanState *planstate, shm_toc *toc)
 				ExecCustomScanInitializeWorker((CustomScanState *) planstate,
 											   toc);
 				break;
+			case T_HashJoinState:
+				ExecHashJoinInitializeWorker((HashJoinState *) planstate, toc);
+				break;
 			default:
 				break;
 		}
 	}
 
+	/* Graph traversal nodes share their statistics even if not aware. */
+	switch (nodeTag(planstate))
+	{
+		case T_NestLoopVLEState:
+			ExecNestLoopVLEInitializeWorker((NestLoopVLEState *) planstate,
+											toc);
+			break;
+		case T_DijkstraState:
+			ExecDijkstraInitializeWorker((DijkstraState *) planstate, toc);
+			break;
+		default:
+			break;
+	}
+
 	return planstate_tree_walker(planstate, ExecParallelInitializeWorker, toc);
 }
 
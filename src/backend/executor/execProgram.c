@@ -0,0 +1,844 @@
+/*-------------------------------------------------------------------------
+ *
+ * execProgram.c
+ *	  Flat step programs for evaluation of scalar expressions
+ *
+ * ExecEvalExpr() walks the ExprState tree recursively, so every Var, Const
+ * and function argument costs an indirect call through the evalfunc pointer
+ * of its node.  For function and operator expressions, which make up almost
+ * all quals (Cypher property filters are nested function calls on jsonb),
+ * the tree is instead flattened into an array of steps the first time it is
+ * evaluated, and the steps are run in a single loop:
+ *
+ *	- each step stores its result directly where its consumer wants it,
+ *	  usually an argument slot of the FunctionCallInfo of the parent, so
+ *	  there is no intermediate result passing at all
+ *	- Consts given to functions are stored into the FunctionCallInfo once,
+ *	  when the program is built, and cost nothing per row
+ *	- a strict function whose arguments are only Vars and Consts is a single
+ *	  step that fetches and null-checks the Vars itself
+ *	- the highest attribute referenced in each slot is known in advance, so
+ *	  each slot is deformed with one slot_getsomeattrs() call per evaluation
+ *	  and Var steps read tts_values[] directly
+ *	- AND, OR and NOT are jumps within the program
+ *
+ * Nodes the program does not know are evaluated through their ExprState by
+ * an EEOP_EXPRSTATE step, so any expression without set-returning functions
+ * can be flattened.  With GCC-compatible compilers the steps are dispatched
+ * by computed gotos ("direct threading"); otherwise a switch is used.  If
+ * the query is expensive enough, a JIT provider (see jit/jit.c) may replace
+ * the interpreter by native code for the program.
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ *
+ * IDENTIFICATION
+ *	  src/backend/executor/execProgram.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "catalog/objectaccess.h"
+#include "executor/execProgram.h"
+#include "executor/executor.h"
+#include "jit/jit.h"
+#include "miscadmin.h"
+#include "pgstat.h"
+#include "utils/acl.h"
+#include "utils/builtins.h"
+#include "utils/lsyscache.h"
+
+
+/*
+ * Use computed gotos for dispatch if the compiler supports them.
+ */
+#if defined(__GNUC__)
+#define EEP_USE_COMPUTED_GOTO
+#endif
+
+/* working state while a program is being built */
+typedef struct ExprProgramBuild
+{
+	ExprProgram *program;
+	int			maxsteps;
+	ExprContext *econtext;
+	MemoryContext cxt;
+} ExprProgramBuild;
+
+static int	add_step(ExprProgramBuild *build, ExprProgramOpcode opcode,
+		 Datum *resvalue, bool *resnull);
+static void build_expr(ExprProgramBuild *build, ExprState *state,
+		   Datum *resvalue, bool *resnull);
+static void build_func(ExprProgramBuild *build, FuncExprState *fstate,
+		   Datum *resvalue, bool *resnull);
+static void build_bool(ExprProgramBuild *build, BoolExprState *bstate,
+		   Datum *resvalue, bool *resnull);
+static bool get_var_ref(ExprProgramBuild *build, ExprState *state,
+			int *slotno, int *attnum);
+static bool is_program_func(ExprState *state);
+static void ready_program(ExprProgram *program);
+static Datum ExecInterpExprProgram(ExprProgram *program,
+					  ExprContext *econtext, bool *isNull);
+
+
+/*
+ * ExecBuildExprProgram
+ *
+ * Flatten the function or operator expression `state` into a step program.
+ * This is done the first time the expression is evaluated, because like
+ * init_fcache() we check permissions and look at the input slots then.
+ *
+ * Returns NULL if `state` is not a plain function or operator call.  The
+ * caller must have made sure that no set-returning function is involved.
+ */
+ExprProgram *
+ExecBuildExprProgram(ExprState *state, ExprContext *econtext)
+{
+	ExprProgramBuild build;
+	ExprProgram *program;
+	MemoryContext oldcxt;
+
+	if (!is_program_func(state))
+		return NULL;
+
+	oldcxt = MemoryContextSwitchTo(econtext->ecxt_per_query_memory);
+
+	program = palloc0(sizeof(*program));
+
+	build.program = program;
+	build.maxsteps = 16;
+	build.econtext = econtext;
+	build.cxt = econtext->ecxt_per_query_memory;
+	program->steps = palloc(sizeof(ExprProgramStep) * build.maxsteps);
+	program->nsteps = 0;
+
+	build_expr(&build, state, &program->resvalue, &program->resnull);
+	add_step(&build, EEOP_DONE, NULL, NULL);
+
+	MemoryContextSwitchTo(oldcxt);
+
+	/*
+	 * Emit native code for the program if the query is worth it, else
+	 * prepare it for the interpreter.  JIT providers need the opcodes, so
+	 * this has to come first.
+	 */
+	if (!jit_compile_expr(program, econtext->ecxt_estate))
+	{
+		ready_program(program);
+		program->evalfunc = ExecInterpExprProgram;
+	}
+
+	return program;
+}
+
+/*
+ * ExecEvalExprProgram
+ *
+ * evalfunc of a FuncExprState whose expression has been flattened.
+ */
+Datum
+ExecEvalExprProgram(FuncExprState *fcache, ExprContext *econtext,
+					bool *isNull, ExprDoneCond *isDone)
+{
+	if (isDone)
+		*isDone = ExprSingleResult;
+
+	return fcache->program->evalfunc(fcache->program, econtext, isNull);
+}
+
+static int
+add_step(ExprProgramBuild *build, ExprProgramOpcode opcode,
+		 Datum *resvalue, bool *resnull)
+{
+	ExprProgram *program = build->program;
+	ExprProgramStep *step;
+
+	if (program->nsteps >= build->maxsteps)
+	{
+		build->maxsteps *= 2;
+		program->steps = repalloc(program->steps,
+								  sizeof(ExprProgramStep) * build->maxsteps);
+	}
+
+	step = &program->steps[program->nsteps];
+	MemSet(step, 0, sizeof(*step));
+	step->opcode = opcode;
+	step->resvalue = resvalue;
+	step->resnull = resnull;
+
+	return program->nsteps++;
+}
+
+/*
+ * Append steps that evaluate `state` into *resvalue and *resnull.
+ */
+static void
+build_expr(ExprProgramBuild *build, ExprState *state,
+		   Datum *resvalue, bool *resnull)
+{
+	ExprProgramStep *step;
+	int			slotno;
+	int			attnum;
+	int			stepno;
+
+	if (is_program_func(state))
+	{
+		build_func(build, (FuncExprState *) state, resvalue, resnull);
+		return;
+	}
+
+	if (IsA(state, BoolExprState))
+	{
+		build_bool(build, (BoolExprState *) state, resvalue, resnull);
+		return;
+	}
+
+	/* binary-compatible coercion does nothing at run time */
+	if (IsA(state, GenericExprState) && IsA(state->expr, RelabelType))
+	{
+		build_expr(build, ((GenericExprState *) state)->arg,
+				   resvalue, resnull);
+		return;
+	}
+
+	if (IsA(state, ExprState) && IsA(state->expr, Const))
+	{
+		Const	   *con = (Const *) state->expr;
+
+		stepno = add_step(build, EEOP_CONST, resvalue, resnull);
+		step = &build->program->steps[stepno];
+		step->d.constval.value = con->constvalue;
+		step->d.constval.isnull = con->constisnull;
+		return;
+	}
+
+	if (get_var_ref(build, state, &slotno, &attnum))
+	{
+		stepno = add_step(build, EEOP_VAR, resvalue, resnull);
+		step = &build->program->steps[stepno];
+		step->d.var.slot = slotno;
+		step->d.var.attnum = attnum;
+		return;
+	}
+
+	stepno = add_step(build, EEOP_EXPRSTATE, resvalue, resnull);
+	build->program->steps[stepno].d.exprstate.state = state;
+}
+
+static void
+build_func(ExprProgramBuild *build, FuncExprState *fstate,
+		   Datum *resvalue, bool *resnull)
+{
+	Expr	   *expr = fstate->xprstate.expr;
+	Oid			funcid;
+	Oid			inputcollid;
+	AclResult	aclresult;
+	FmgrInfo   *finfo;
+	FunctionCallInfo fcinfo;
+	int			nargs = list_length(fstate->args);
+	ExprProgramVarArg *vars;
+	int			nvars = 0;
+	bool		fusevars;
+	ExprProgramOpcode opcode;
+	ExprProgramStep *step;
+	int			stepno;
+	ListCell   *lc;
+	int			i;
+
+	if (IsA(expr, FuncExpr))
+	{
+		funcid = ((FuncExpr *) expr)->funcid;
+		inputcollid = ((FuncExpr *) expr)->inputcollid;
+	}
+	else
+	{
+		funcid = ((OpExpr *) expr)->opfuncid;
+		inputcollid = ((OpExpr *) expr)->inputcollid;
+	}
+
+	/* same checks as init_fcache() */
+	aclresult = pg_proc_aclcheck(funcid, GetUserId(), ACL_EXECUTE);
+	if (aclresult != ACLCHECK_OK)
+		aclcheck_error(aclresult, ACL_KIND_PROC, get_func_name(funcid));
+	InvokeFunctionExecuteHook(funcid);
+
+	if (nargs > FUNC_MAX_ARGS)
+		ereport(ERROR,
+				(errcode(ERRCODE_TOO_MANY_ARGUMENTS),
+			 errmsg_plural("cannot pass more than %d argument to a function",
+						   "cannot pass more than %d arguments to a function",
+						   FUNC_MAX_ARGS,
+						   FUNC_MAX_ARGS)));
+
+	finfo = palloc0(sizeof(FmgrInfo));
+	fcinfo = palloc0(sizeof(FunctionCallInfoData));
+	fmgr_info_cxt(funcid, finfo, build->cxt);
+	fmgr_info_set_expr((Node *) expr, finfo);
+	InitFunctionCallInfoData(*fcinfo, finfo, nargs, inputcollid, NULL, NULL);
+
+	/*
+	 * If the function is strict and takes only Vars and non-null Consts, the
+	 * call step can fetch the Vars by itself.
+	 */
+	fusevars = (finfo->fn_strict && nargs > 0 &&
+				pgstat_track_functions <= finfo->fn_stats);
+	vars = palloc(sizeof(ExprProgramVarArg) * Max(nargs, 1));
+	i = 0;
+	foreach(lc, fstate->args)
+	{
+		ExprState  *arg = lfirst(lc);
+		int			slotno;
+		int			attnum;
+
+		if (IsA(arg, ExprState) && IsA(arg->expr, Const))
+		{
+			Const	   *con = (Const *) arg->expr;
+
+			/* Consts are passed once and for all */
+			fcinfo->arg[i] = con->constvalue;
+			fcinfo->argnull[i] = con->constisnull;
+			if (con->constisnull)
+				fusevars = false;
+		}
+		else if (get_var_ref(build, arg, &slotno, &attnum))
+		{
+			vars[nvars].slot = slotno;
+			vars[nvars].attnum = attnum;
+			vars[nvars].argno = i;
+			nvars++;
+		}
+		else
+		{
+			fusevars = false;
+		}
+		i++;
+	}
+
+	if (fusevars && nvars > 0)
+	{
+		for (i = 0; i < nvars; i++)
+			fcinfo->argnull[vars[i].argno] = false;
+		opcode = EEOP_FUNCEXPR_STRICT_VARS;
+	}
+	else
+	{
+		/* evaluate the arguments that are not Consts into fcinfo */
+		i = 0;
+		foreach(lc, fstate->args)
+		{
+			ExprState  *arg = lfirst(lc);
+
+			if (!(IsA(arg, ExprState) && IsA(arg->expr, Const)))
+				build_expr(build, arg, &fcinfo->arg[i], &fcinfo->argnull[i]);
+			i++;
+		}
+
+		pfree(vars);
+		vars = NULL;
+		nvars = 0;
+
+		if (pgstat_track_functions > finfo->fn_stats)
+			opcode = EEOP_FUNCEXPR_FUSAGE;
+		else if (finfo->fn_strict && nargs > 0)
+			opcode = EEOP_FUNCEXPR_STRICT;
+		else
+			opcode = EEOP_FUNCEXPR;
+	}
+
+	stepno = add_step(build, opcode, resvalue, resnull);
+	step = &build->program->steps[stepno];
+	step->d.func.finfo = finfo;
+	step->d.func.fcinfo = fcinfo;
+	step->d.func.nargs = nargs;
+	step->d.func.nvars = nvars;
+	step->d.func.vars = vars;
+}
+
+static void
+build_bool(ExprProgramBuild *build, BoolExprState *bstate,
+		   Datum *resvalue, bool *resnull)
+{
+	BoolExpr   *boolexpr = (BoolExpr *) bstate->xprstate.expr;
+	ExprProgramOpcode first;
+	ExprProgramOpcode middle;
+	ExprProgramOpcode last;
+	bool	   *anynull;
+	List	   *jumps = NIL;
+	ListCell   *lc;
+	int			nargs = list_length(bstate->args);
+	int			i;
+
+	switch (boolexpr->boolop)
+	{
+		case NOT_EXPR:
+			build_expr(build, linitial(bstate->args), resvalue, resnull);
+			add_step(build, EEOP_BOOL_NOT, resvalue, resnull);
+			return;
+		case AND_EXPR:
+			first = EEOP_BOOL_AND_STEP_FIRST;
+			middle = EEOP_BOOL_AND_STEP;
+			last = EEOP_BOOL_AND_STEP_LAST;
+			break;
+		case OR_EXPR:
+			first = EEOP_BOOL_OR_STEP_FIRST;
+			middle = EEOP_BOOL_OR_STEP;
+			last = EEOP_BOOL_OR_STEP_LAST;
+			break;
+		default:
+			elog(ERROR, "unrecognized boolop: %d", (int) boolexpr->boolop);
+			return;				/* keep compiler quiet */
+	}
+
+	Assert(nargs >= 2);
+
+	anynull = palloc(sizeof(bool));
+
+	/*
+	 * Each argument is evaluated into the result of the whole expression,
+	 * then checked.  The first argument that decides the result jumps past
+	 * the remaining ones.
+	 */
+	i = 0;
+	foreach(lc, bstate->args)
+	{
+		ExprProgramOpcode opcode;
+		int			stepno;
+
+		build_expr(build, lfirst(lc), resvalue, resnull);
+
+		if (i == 0)
+			opcode = first;
+		else if (i == nargs - 1)
+			opcode = last;
+		else
+			opcode = middle;
+
+		stepno = add_step(build, opcode, resvalue, resnull);
+		build->program->steps[stepno].d.boolexpr.anynull = anynull;
+		jumps = lappend_int(jumps, stepno);
+		i++;
+	}
+
+	foreach(lc, jumps)
+	{
+		ExprProgramStep *step = &build->program->steps[lfirst_int(lc)];
+
+		step->d.boolexpr.jumpdone = build->program->nsteps;
+	}
+	list_free(jumps);
+}
+
+/*
+ * If `state` is a Var of a user attribute that can be read from its slot
+ * directly, return where it is and remember that the attribute has to be
+ * deformed.  The type check is the same as the one in ExecEvalScalarVar().
+ */
+static bool
+get_var_ref(ExprProgramBuild *build, ExprState *state,
+			int *slotno, int *attnum)
+{
+	ExprContext *econtext = build->econtext;
+	Var		   *variable;
+	TupleTableSlot *slot;
+	TupleDesc	slot_tupdesc;
+	Form_pg_attribute attr;
+
+	if (!IsA(state, ExprState) || !IsA(state->expr, Var))
+		return false;
+
+	variable = (Var *) state->expr;
+
+	/* system attributes and whole-row Vars need the tree */
+	if (variable->varattno <= 0)
+		return false;
+
+	switch (variable->varno)
+	{
+		case INNER_VAR:
+			slot = econtext->ecxt_innertuple;
+			*slotno = EEP_INNER_SLOT;
+			break;
+		case OUTER_VAR:
+			slot = econtext->ecxt_outertuple;
+			*slotno = EEP_OUTER_SLOT;
+			break;
+		default:
+			slot = econtext->ecxt_scantuple;
+			*slotno = EEP_SCAN_SLOT;
+			break;
+	}
+
+	if (slot == NULL)
+		return false;
+
+	slot_tupdesc = slot->tts_tupleDescriptor;
+	if (variable->varattno > slot_tupdesc->natts)	/* should never happen */
+		elog(ERROR, "attribute number %d exceeds number of columns %d",
+			 variable->varattno, slot_tupdesc->natts);
+
+	attr = slot_tupdesc->attrs[variable->varattno - 1];
+
+	/* can't check type if dropped, since atttypid is probably 0 */
+	if (!attr->attisdropped && variable->vartype != attr->atttypid)
+		ereport(ERROR,
+				(errcode(ERRCODE_DATATYPE_MISMATCH),
+				 errmsg("attribute %d has wrong type", variable->varattno),
+				 errdetail("Table has type %s, but query expects %s.",
+						   format_type_be(attr->atttypid),
+						   format_type_be(variable->vartype))));
+
+	*attnum = variable->varattno - 1;
+
+	if (variable->varattno > build->program->last_attnum[*slotno])
+		build->program->last_attnum[*slotno] = variable->varattno;
+	build->program->last_desc[*slotno] = slot_tupdesc;
+
+	return true;
+}
+
+static bool
+is_program_func(ExprState *state)
+{
+	return (IsA(state, FuncExprState) &&
+			(IsA(state->expr, FuncExpr) || IsA(state->expr, OpExpr)));
+}
+
+/*
+ * Replace opcodes by the addresses of their implementation if direct
+ * threading is used.
+ */
+static void
+ready_program(ExprProgram *program)
+{
+#ifdef EEP_USE_COMPUTED_GOTO
+	const void *const *dispatch_table;
+	int			i;
+
+	dispatch_table = (const void *const *)
+		DatumGetPointer(ExecInterpExprProgram(NULL, NULL, NULL));
+
+	for (i = 0; i < program->nsteps; i++)
+	{
+		ExprProgramStep *step = &program->steps[i];
+
+		step->opcode = (intptr_t) dispatch_table[step->opcode];
+	}
+#endif
+}
+
+#ifdef EEP_USE_COMPUTED_GOTO
+#define EEP_SWITCH()
+#define EEP_CASE(name)		CASE_##name:
+#define EEP_DISPATCH()		goto *((void *) op->opcode)
+#else
+#define EEP_SWITCH()		starteval: switch ((ExprProgramOpcode) op->opcode)
+#define EEP_CASE(name)		case name:
+#define EEP_DISPATCH()		goto starteval
+#endif
+
+#define EEP_NEXT() \
+	do { \
+		op++; \
+		EEP_DISPATCH(); \
+	} while (0)
+
+#define EEP_JUMP(stepno) \
+	do { \
+		op = &program->steps[stepno]; \
+		EEP_DISPATCH(); \
+	} while (0)
+
+/*
+ * Run a step program.
+ *
+ * If direct threading is used, calling this with a NULL program returns the
+ * dispatch table, for ready_program().
+ */
+static Datum
+ExecInterpExprProgram(ExprProgram *program, ExprContext *econtext,
+					  bool *isNull)
+{
+	TupleTableSlot *slots[EEP_NUM_SLOTS];
+	ExprProgramStep *op;
+	int			i;
+
+#ifdef EEP_USE_COMPUTED_GOTO
+	static const void *const dispatch_table[] = {
+		&&CASE_EEOP_DONE,
+		&&CASE_EEOP_VAR,
+		&&CASE_EEOP_CONST,
+		&&CASE_EEOP_FUNCEXPR,
+		&&CASE_EEOP_FUNCEXPR_STRICT,
+		&&CASE_EEOP_FUNCEXPR_FUSAGE,
+		&&CASE_EEOP_FUNCEXPR_STRICT_VARS,
+		&&CASE_EEOP_BOOL_AND_STEP_FIRST,
+		&&CASE_EEOP_BOOL_AND_STEP,
+		&&CASE_EEOP_BOOL_AND_STEP_LAST,
+		&&CASE_EEOP_BOOL_OR_STEP_FIRST,
+		&&CASE_EEOP_BOOL_OR_STEP,
+		&&CASE_EEOP_BOOL_OR_STEP_LAST,
+		&&CASE_EEOP_BOOL_NOT,
+		&&CASE_EEOP_EXPRSTATE,
+		&&CASE_EEOP_LAST
+	};
+
+	StaticAssertStmt(EEOP_LAST + 1 == lengthof(dispatch_table),
+					 "dispatch_table out of whack with ExprProgramOpcode");
+
+	if (program == NULL)
+		return PointerGetDatum(dispatch_table);
+#endif
+
+	slots[EEP_SCAN_SLOT] = econtext->ecxt_scantuple;
+	slots[EEP_INNER_SLOT] = econtext->ecxt_innertuple;
+	slots[EEP_OUTER_SLOT] = econtext->ecxt_outertuple;
+
+	/* deform everything the program needs at once */
+	for (i = 0; i < EEP_NUM_SLOTS; i++)
+	{
+		if (program->last_attnum[i] > 0)
+			slot_getsomeattrs(slots[i], program->last_attnum[i]);
+	}
+
+	op = program->steps;
+	EEP_DISPATCH();
+
+	EEP_SWITCH()
+	{
+		EEP_CASE(EEOP_DONE)
+		{
+			goto out;
+		}
+
+		EEP_CASE(EEOP_VAR)
+		{
+			TupleTableSlot *slot = slots[op->d.var.slot];
+			int			attnum = op->d.var.attnum;
+
+			*op->resvalue = slot->tts_values[attnum];
+			*op->resnull = slot->tts_isnull[attnum];
+
+			EEP_NEXT();
+		}
+
+		EEP_CASE(EEOP_CONST)
+		{
+			*op->resvalue = op->d.constval.value;
+			*op->resnull = op->d.constval.isnull;
+
+			EEP_NEXT();
+		}
+
+		EEP_CASE(EEOP_FUNCEXPR)
+		{
+			FunctionCallInfo fcinfo = op->d.func.fcinfo;
+
+			fcinfo->isnull = false;
+			*op->resvalue = (op->d.func.finfo->fn_addr) (fcinfo);
+			*op->resnull = fcinfo->isnull;
+
+			EEP_NEXT();
+		}
+
+		EEP_CASE(EEOP_FUNCEXPR_STRICT)
+		{
+			FunctionCallInfo fcinfo = op->d.func.fcinfo;
+			int			argno;
+
+			for (argno = 0; argno < op->d.func.nargs; argno++)
+			{
+				if (fcinfo->argnull[argno])
+					break;
+			}
+
+			if (argno < op->d.func.nargs)
+			{
+				*op->resvalue = (Datum) 0;
+				*op->resnull = true;
+			}
+			else
+			{
+				fcinfo->isnull = false;
+				*op->resvalue = (op->d.func.finfo->fn_addr) (fcinfo);
+				*op->resnull = fcinfo->isnull;
+			}
+
+			EEP_NEXT();
+		}
+
+		EEP_CASE(EEOP_FUNCEXPR_FUSAGE)
+		{
+			FunctionCallInfo fcinfo = op->d.func.fcinfo;
+			PgStat_FunctionCallUsage fcusage;
+			int			argno = op->d.func.nargs;
+
+			if (op->d.func.finfo->fn_strict)
+			{
+				for (argno = 0; argno < op->d.func.nargs; argno++)
+				{
+					if (fcinfo->argnull[argno])
+						break;
+				}
+			}
+
+			if (argno < op->d.func.nargs)
+			{
+				*op->resvalue = (Datum) 0;
+				*op->resnull = true;
+			}
+			else
+			{
+				pgstat_init_function_usage(fcinfo, &fcusage);
+
+				fcinfo->isnull = false;
+				*op->resvalue = (op->d.func.finfo->fn_addr) (fcinfo);
+				*op->resnull = fcinfo->isnull;
+
+				pgstat_end_function_usage(&fcusage, true);
+			}
+
+			EEP_NEXT();
+		}
+
+		EEP_CASE(EEOP_FUNCEXPR_STRICT_VARS)
+		{
+			FunctionCallInfo fcinfo = op->d.func.fcinfo;
+			int			n;
+
+			for (n = 0; n < op->d.func.nvars; n++)
+			{
+				ExprProgramVarArg *var = &op->d.func.vars[n];
+				TupleTableSlot *slot = slots[var->slot];
+
+				if (slot->tts_isnull[var->attnum])
+					break;
+				fcinfo->arg[var->argno] = slot->tts_values[var->attnum];
+			}
+
+			if (n < op->d.func.nvars)
+			{
+				*op->resvalue = (Datum) 0;
+				*op->resnull = true;
+			}
+			else
+			{
+				fcinfo->isnull = false;
+				*op->resvalue = (op->d.func.finfo->fn_addr) (fcinfo);
+				*op->resnull = fcinfo->isnull;
+			}
+
+			EEP_NEXT();
+		}
+
+		EEP_CASE(EEOP_BOOL_AND_STEP_FIRST)
+		{
+			*op->d.boolexpr.anynull = false;
+
+			/* FALL THROUGH to EEOP_BOOL_AND_STEP */
+		}
+
+		EEP_CASE(EEOP_BOOL_AND_STEP)
+		{
+			if (*op->resnull)
+			{
+				*op->d.boolexpr.anynull = true;
+			}
+			else if (!DatumGetBool(*op->resvalue))
+			{
+				/* result is already set to FALSE */
+				EEP_JUMP(op->d.boolexpr.jumpdone);
+			}
+
+			EEP_NEXT();
+		}
+
+		EEP_CASE(EEOP_BOOL_AND_STEP_LAST)
+		{
+			if (*op->resnull)
+			{
+				/* result is already set to NULL */
+			}
+			else if (!DatumGetBool(*op->resvalue))
+			{
+				/* result is already set to FALSE */
+			}
+			else if (*op->d.boolexpr.anynull)
+			{
+				*op->resvalue = (Datum) 0;
+				*op->resnull = true;
+			}
+
+			EEP_NEXT();
+		}
+
+		EEP_CASE(EEOP_BOOL_OR_STEP_FIRST)
+		{
+			*op->d.boolexpr.anynull = false;
+
+			/* FALL THROUGH to EEOP_BOOL_OR_STEP */
+		}
+
+		EEP_CASE(EEOP_BOOL_OR_STEP)
+		{
+			if (*op->resnull)
+			{
+				*op->d.boolexpr.anynull = true;
+			}
+			else if (DatumGetBool(*op->resvalue))
+			{
+				/* result is already set to TRUE */
+				EEP_JUMP(op->d.boolexpr.jumpdone);
+			}
+
+			EEP_NEXT();
+		}
+
+		EEP_CASE(EEOP_BOOL_OR_STEP_LAST)
+		{
+			if (*op->resnull)
+			{
+				/* result is already set to NULL */
+			}
+			else if (DatumGetBool(*op->resvalue))
+			{
+				/* result is already set to TRUE */
+			}
+			else if (*op->d.boolexpr.anynull)
+			{
+				*op->resvalue = (Datum) 0;
+				*op->resnull = true;
+			}
+
+			EEP_NEXT();
+		}
+
+		EEP_CASE(EEOP_BOOL_NOT)
+		{
+			if (!*op->resnull)
+				*op->resvalue = BoolGetDatum(!DatumGetBool(*op->resvalue));
+
+			EEP_NEXT();
+		}
+
+		EEP_CASE(EEOP_EXPRSTATE)
+		{
+			*op->resvalue = ExecEvalExpr(op->d.exprstate.state, econtext,
+										 op->resnull, NULL);
+
+			EEP_NEXT();
+		}
+
+		EEP_CASE(EEOP_LAST)
+		{
+			elog(ERROR, "unrecognized expression program step: %d",
+				 (int) op->opcode);
+			goto out;
+		}
+	}
+
+out:
+	*isNull = program->resnull;
+	return program->resvalue;
+}
@@ -41,6 +41,7 @@
 #include "access/tupconvert.h"
 #include "catalog/objectaccess.h"
 #include "catalog/pg_type.h"
+#include "executor/execProgram.h"
 #include "executor/execdebug.h"
 #include "executor/nodeSubplan.h"
 #include "funcapi.h"
@@ -2449,20 +2450,27 @@ ExecEvalFunc(FuncExprState *fcache,
 
 	/*
 	 * We need to invoke ExecMakeFunctionResult if either the function itself
-	 * or any of its input expressions can return a set.  Otherwise, invoke
-	 * ExecMakeFunctionResultNoSets.  In either case, change the evalfunc
-	 * pointer to go directly there on subsequent uses.
+	 * or any of its input expressions can return a set.  Otherwise, run the
+	 * expression as a step program, or invoke ExecMakeFunctionResultNoSets if
+	 * it can't be flattened.  In any case, change the evalfunc pointer to go
+	 * directly there on subsequent uses.
 	 */
 	if (fcache->func.fn_retset || expression_returns_set((Node *) func->args))
 	{
 		fcache->xprstate.evalfunc = (ExprStateEvalFunc) ExecMakeFunctionResult;
 		return ExecMakeFunctionResult(fcache, econtext, isNull, isDone);
 	}
-	else
+
+	/* flatten the expression if we can */
+	fcache->program = ExecBuildExprProgram(&fcache->xprstate, econtext);
+	if (fcache->program != NULL)
 	{
-		fcache->xprstate.evalfunc = (ExprStateEvalFunc) ExecMakeFunctionResultNoSets;
-		return ExecMakeFunctionResultNoSets(fcache, econtext, isNull, isDone);
+		fcache->xprstate.evalfunc = (ExprStateEvalFunc) ExecEvalExprProgram;
+		return ExecEvalExprProgram(fcache, econtext, isNull, isDone);
 	}
+
+	fcache->xprstate.evalfunc = (ExprStateEvalFunc) ExecMakeFunctionResultNoSets;
+	return ExecMakeFunctionResultNoSets(fcache, econtext, isNull, isDone);
 }
 
 /* ----------------------------------------------------------------
@@ -2484,20 +2492,27 @@ ExecEvalOper(FuncExprState *fcache,
 
 	/*
 	 * We need to invoke ExecMakeFunctionResult if either the function itself
-	 * or any of its input expressions can return a set.  Otherwise, invoke
-	 * ExecMakeFunctionResultNoSets.  In either case, change the evalfunc
-	 * pointer to go directly there on subsequent uses.
+	 * or any of its input expressions can return a set.  Otherwise, run the
+	 * expression as a step program, or invoke ExecMakeFunctionResultNoSets if
+	 * it can't be flattened.  In any case, change the evalfunc pointer to go
+	 * directly there on subsequent uses.
 	 */
 	if (fcache->func.fn_retset || expression_returns_set((Node *) op->args))
 	{
 		fcache->xprstate.evalfunc = (ExprStateEvalFunc) ExecMakeFunctionResult;
 		return ExecMakeFunctionResult(fcache, econtext, isNull, isDone);
 	}
-	else
+
+	/* flatten the expression if we can */
+	fcache->program = ExecBuildExprProgram(&fcache->xprstate, econtext);
+	if (fcache->program != NULL)
 	{
-		fcache->xprstate.evalfunc = (ExprStateEvalFunc) ExecMakeFunctionResultNoSets;
-		return ExecMakeFunctionResultNoSets(fcache, econtext, isNull, isDone);
+		fcache->xprstate.evalfunc = (ExprStateEvalFunc) ExecEvalExprProgram;
+		return ExecEvalExprProgram(fcache, econtext, isNull, isDone);
 	}
+
+	fcache->xprstate.evalfunc = (ExprStateEvalFunc) ExecMakeFunctionResultNoSets;
+	return ExecMakeFunctionResultNoSets(fcache, econtext, isNull, isDone);
 }
 
 /* ----------------------------------------------------------------
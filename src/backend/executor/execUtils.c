@@ -135,6 +135,9 @@ CreateExecutorState(void)
 	estate->es_instrument = 0;
 	estate->es_finished = false;
 
+	estate->es_jit_flags = 0;
+	estate->es_jit = NULL;
+
 	estate->es_exprcontexts = NIL;
 
 	estate->es_subplanstates = NIL;
@@ -187,6 +187,17 @@ InstrAccumParallelQuery(BufferUsage *result)
 	BufferUsageAdd(&pgBufferUsage, result);
 }
 
+/* add the time elapsed since *starttime to *total, in seconds */
+void
+InstrAccumTime(double *total, instr_time *starttime)
+{
+	instr_time	endtime;
+
+	INSTR_TIME_SET_CURRENT(endtime);
+	INSTR_TIME_SUBTRACT(endtime, *starttime);
+	*total += INSTR_TIME_GET_DOUBLE(endtime);
+}
+
 /* dst += add */
 static void
 BufferUsageAdd(BufferUsage *dst, const BufferUsage *add)
@@ -141,6 +141,36 @@
  *
  *	  TODO: AGG_HASHED doesn't support multiple grouping sets yet.
  *
+ *	  Spilling to disk:
+ *
+ *	  In AGG_HASHED mode, the planner only chooses hashing if it expects the
+ *	  hash table to fit in work_mem, but its estimate of the number of groups
+ *	  can be far off.  So we keep an eye on the memory used by the hash table
+ *	  and the transition values, and when it exceeds work_mem we stop creating
+ *	  new groups.  Tuples of groups that are already in the table are still
+ *	  aggregated as usual; any other tuple is written out to one of several
+ *	  temporary files ("partitions"), chosen by the bits of its hash value.
+ *	  Once the groups in memory have been returned, the table is emptied and
+ *	  each partition is read back in as a "batch" of input of its own.  Since
+ *	  all the tuples of a group go to the same partition, a group is never
+ *	  split across batches.  If a batch still has too many groups to fit in
+ *	  memory, it is spilled again, using the next bits of the hash value.
+ *
+ *	  We spill input tuples rather than transition values, since the latter
+ *	  can't be written out for aggregates whose transition type is "internal"
+ *	  unless they have serialization functions.  The memory used by a single
+ *	  group that grows without bound (say, a huge array_agg) is not limited.
+ *
+ *	  Batch input:
+ *
+ *	  When enable_batch_execution is on, AGG_PLAIN without grouping sets can
+ *	  read its input a batch of rows at a time (see execBatch.c), provided
+ *	  that the outer plan can produce batches, and every aggregate is a
+ *	  plain one over a single column (or count(*)) whose transition function
+ *	  has a batch kernel.  The kernels then replace advance_aggregates() for
+ *	  all the rows of a batch at once; they have the same results as calling
+ *	  the transition function row by row.
+ *
  * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
  * Portions Copyright (c) 1994, Regents of the University of California
  *
@@ -152,11 +182,14 @@
 
 #include "postgres.h"
 
+#include <limits.h>
+
 #include "access/htup_details.h"
 #include "catalog/objectaccess.h"
 #include "catalog/pg_aggregate.h"
 #include "catalog/pg_proc.h"
 #include "catalog/pg_type.h"
+#include "executor/execBatch.h"
 #include "executor/executor.h"
 #include "executor/nodeAgg.h"
 #include "miscadmin.h"
@@ -165,8 +198,10 @@
 #include "optimizer/tlist.h"
 #include "parser/parse_agg.h"
 #include "parser/parse_coerce.h"
+#include "storage/buffile.h"
 #include "utils/acl.h"
 #include "utils/builtins.h"
+#include "utils/dynahash.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/syscache.h"
@@ -334,6 +369,14 @@ typedef struct AggStatePerTransData
 	FunctionCallInfoData serialfn_fcinfo;
 
 	FunctionCallInfoData deserialfn_fcinfo;
+
+	/*
+	 * Kernel applying the transfn to a batch of input rows, and the batch
+	 * column it reads (-1 for count(*)).  Only set up if the aggregate reads
+	 * batches, see agg_init_batch().
+	 */
+	BatchTransFunc batch_transfn;
+	int			batch_col;
 }	AggStatePerTransData;
 
 /*
@@ -441,16 +484,47 @@ typedef struct AggStatePerPhaseData
  * To implement hashed aggregation, we need a hashtable that stores a
  * representative tuple and an array of AggStatePerGroup structs for each
  * distinct set of GROUP BY column values.  We compute the hash key from
- * the GROUP BY columns.
+ * the GROUP BY columns.  The array is allocated separately in the table's
+ * memory context and pointed to by the entry's "additional" field, since
+ * entries move around in the hash table.
+ */
+
+/*
+ * Bounds on the number of partitions the input of a hashing pass is divided
+ * into when it spills, as powers of 2.  Each open partition needs a buffer
+ * of BLCKSZ bytes, so we use more partitions only with more work_mem.
+ */
+#define HASHAGG_MIN_PARTITION_BITS	2
+#define HASHAGG_MAX_PARTITION_BITS	5
+
+/*
+ * Minimum number of new groups to create before the memory used by the hash
+ * table is measured again.  Measuring visits every block of the contexts
+ * involved, so we don't want to do it for every new group.
+ */
+#define HASHAGG_MIN_CHECK_INTERVAL	16
+
+/*
+ * HashAggSpillData - partitions the input of the current pass is spilled to
  */
-typedef struct AggHashEntryData *AggHashEntry;
+typedef struct HashAggSpillData
+{
+	int			input_bits;		/* hash bits already used to select input */
+	int			partition_bits; /* hash bits used to select a partition */
+	int			npartitions;	/* 1 << partition_bits */
+	BufFile   **partitions;		/* files, created on first use */
+	int64	   *ntuples;		/* number of tuples in each file */
+}	HashAggSpillData;
 
-typedef struct AggHashEntryData
+/*
+ * HashAggBatch - a spilled partition waiting to be aggregated
+ */
+typedef struct HashAggBatch
 {
-	TupleHashEntryData shared;	/* common header for hash table entries */
-	/* per-aggregate transition status array */
-	AggStatePerGroupData pergroup[FLEXIBLE_ARRAY_MEMBER];
-}	AggHashEntryData;
+	BufFile    *file;			/* spilled tuples */
+	int			used_bits;		/* hash bits shared by all of its tuples */
+	int64		ntuples;		/* number of tuples in the file */
+} HashAggBatch;
 
 static void initialize_phase(AggState *aggstate, int newphase);
 static TupleTableSlot *fetch_input_tuple(AggState *aggstate);
@@ -489,12 +563,23 @@ static void finalize_aggregates(AggState *aggstate,
 static TupleTableSlot *project_aggregates(AggState *aggstate);
 static Bitmapset *find_unaggregated_cols(AggState *aggstate);
 static bool find_unaggregated_cols_walker(Node *node, Bitmapset **colnos);
-static void build_hash_table(AggState *aggstate);
-static AggHashEntry lookup_hash_entry(AggState *aggstate,
+static void build_hash_table(AggState *aggstate, long nbuckets);
+static void hash_agg_set_limits(AggState *aggstate);
+static Size hash_agg_update_metrics(AggState *aggstate);
+static void hash_agg_check_limits(AggState *aggstate);
+static void hash_spill_init(AggState *aggstate);
+static void hash_spill_tuple(AggState *aggstate, TupleTableSlot *inputslot);
+static void hash_spill_finish(AggState *aggstate);
+static TupleTableSlot *hash_spill_read(AggState *aggstate, BufFile *file);
+static void hash_spill_reset(AggState *aggstate);
+static TupleHashEntryData *lookup_hash_entry(AggState *aggstate,
 				  TupleTableSlot *inputslot);
 static TupleTableSlot *agg_retrieve_direct(AggState *aggstate);
+static TupleTableSlot *agg_retrieve_batch(AggState *aggstate);
 static void agg_fill_hash_table(AggState *aggstate);
+static bool agg_refill_hash_table(AggState *aggstate);
 static TupleTableSlot *agg_retrieve_hash_table(AggState *aggstate);
+static void agg_init_batch(AggState *aggstate);
 static Datum GetAggInitVal(Datum textInitVal, Oid transtype);
 static void build_pertrans_for_aggref(AggStatePerTrans pertrans,
 						  AggState *aggsate, EState *estate,
@@ -1702,26 +1787,26 @@ find_unaggregated_cols_walker(Node *node, Bitmapset **colnos)
  * Initialize the hash table to empty.
  *
  * The hash table always lives in the aggcontext memory context.
+ * nbuckets is the expected number of groups.
  */
 static void
-build_hash_table(AggState *aggstate)
+build_hash_table(AggState *aggstate, long nbuckets)
 {
 	Agg		   *node = (Agg *) aggstate->ss.ps.plan;
 	MemoryContext tmpmem = aggstate->tmpcontext->ecxt_per_tuple_memory;
-	Size		entrysize;
+	Size		additionalsize;
 
 	Assert(node->aggstrategy == AGG_HASHED);
-	Assert(node->numGroups > 0);
+	Assert(nbuckets > 0);
 
-	entrysize = offsetof(AggHashEntryData, pergroup) +
-		aggstate->numaggs * sizeof(AggStatePerGroupData);
+	additionalsize = aggstate->numaggs * sizeof(AggStatePerGroupData);
 
 	aggstate->hashtable = BuildTupleHashTable(node->numCols,
 											  node->grpColIdx,
 											  aggstate->phase->eqfunctions,
 											  aggstate->hashfunctions,
-											  node->numGroups,
-											  entrysize,
+											  nbuckets,
+											  additionalsize,
 							 aggstate->aggcontexts[0]->ecxt_per_tuple_memory,
 											  tmpmem);
 }
@@ -1785,26 +1870,287 @@ hash_agg_entry_size(int numAggs)
 	Size		entrysize;
 
 	/* This must match build_hash_table */
-	entrysize = offsetof(AggHashEntryData, pergroup) +
+	entrysize = sizeof(TupleHashEntryData) +
 		numAggs * sizeof(AggStatePerGroupData);
 	entrysize = MAXALIGN(entrysize);
-	/* Account for hashtable overhead (assuming fill factor = 1) */
-	entrysize += 3 * sizeof(void *);
 	return entrysize;
 }
 
+/*
+ * Start counting the groups of a new hashing pass.
+ *
+ * The memory used by the table is first measured when it has as many groups
+ * as the planner's estimate of the entry size says will fit in work_mem.
+ */
+static void
+hash_agg_set_limits(AggState *aggstate)
+{
+	Plan	   *outerplan = outerPlan(aggstate->ss.ps.plan);
+	Size		entrysize;
+
+	entrysize = hash_agg_entry_size(aggstate->numaggs) +
+		MAXALIGN(SizeofMinimalTupleHeader) +
+		MAXALIGN(outerplan->plan_width);
+
+	aggstate->hash_spill_mode = false;
+	aggstate->hash_ngroups_current = 0;
+	aggstate->hash_ngroups_limit = Max(work_mem * 1024L / (long) entrysize, 1);
+}
+
+/*
+ * Measure the memory used by the hash table and the transition values of its
+ * groups, and remember the peak for EXPLAIN ANALYZE.
+ */
+static Size
+hash_agg_update_metrics(AggState *aggstate)
+{
+	MemoryContextCounters counters;
+	Size		mem_used;
+
+	MemoryContextMemConsumed(aggstate->aggcontexts[0]->ecxt_per_tuple_memory,
+							 &counters);
+	mem_used = counters.totalspace - counters.freespace;
+
+	if (mem_used > aggstate->hash_mem_peak)
+		aggstate->hash_mem_peak = mem_used;
+
+	return mem_used;
+}
+
+/*
+ * Called when the number of groups reaches hash_ngroups_limit.  If the hash
+ * table has outgrown work_mem, switch to spill mode; otherwise extrapolate
+ * from the average size of a group when to check again.
+ */
+static void
+hash_agg_check_limits(AggState *aggstate)
+{
+	HashAggSpill spill = aggstate->hash_spill;
+	long		ngroups = aggstate->hash_ngroups_current;
+	long		hash_mem = work_mem * 1024L;
+	Size		mem_used;
+
+	mem_used = hash_agg_update_metrics(aggstate);
+
+	if (mem_used < (Size) hash_mem)
+	{
+		long		groupsize = (long) (mem_used / ngroups) + 1;
+		long		remaining = (hash_mem - (long) mem_used) / groupsize;
+
+		/* check again about halfway to where we expect to run out */
+		aggstate->hash_ngroups_limit =
+			ngroups + Max(remaining / 2, HASHAGG_MIN_CHECK_INTERVAL);
+	}
+	else if (spill->input_bits + spill->partition_bits <= 32)
+	{
+		/* new groups go to disk from now on */
+		MemSet(spill->partitions, 0, sizeof(BufFile *) * spill->npartitions);
+		MemSet(spill->ntuples, 0, sizeof(int64) * spill->npartitions);
+		aggstate->hash_spill_mode = true;
+	}
+	else
+	{
+		/*
+		 * We've run out of hash bits to partition by, which means that this
+		 * batch consists of many tuples with the same hash value.  Spilling
+		 * them again wouldn't divide them any further, so just let the table
+		 * grow.
+		 */
+		aggstate->hash_ngroups_limit = LONG_MAX;
+	}
+}
+
+/*
+ * Set up the state needed to spill tuples, choosing the number of partitions
+ * from work_mem.
+ */
+static void
+hash_spill_init(AggState *aggstate)
+{
+	HashAggSpill spill;
+	long		npartitions;
+	int			bits;
+
+	/* allow the partitions' buffers a quarter of work_mem */
+	npartitions = work_mem * 1024L / 4 / BLCKSZ;
+	bits = my_log2(Max(npartitions, 1));
+	bits = Max(bits, HASHAGG_MIN_PARTITION_BITS);
+	bits = Min(bits, HASHAGG_MAX_PARTITION_BITS);
+
+	spill = (HashAggSpill) palloc0(sizeof(HashAggSpillData));
+	spill->input_bits = 0;
+	spill->partition_bits = bits;
+	spill->npartitions = 1 << bits;
+	spill->partitions = (BufFile **)
+		palloc0(sizeof(BufFile *) * spill->npartitions);
+	spill->ntuples = (int64 *) palloc0(sizeof(int64) * spill->npartitions);
+
+	aggstate->hash_spill = spill;
+}
+
+/*
+ * Write an input tuple whose group is not in the hash table to the partition
+ * selected by the next partition_bits bits of its hash value.
+ *
+ * The grouping columns must already have been loaded into hashslot.
+ */
+static void
+hash_spill_tuple(AggState *aggstate, TupleTableSlot *inputslot)
+{
+	HashAggSpill spill = aggstate->hash_spill;
+	MemoryContext oldcxt;
+	MinimalTuple tuple;
+	uint32		hashvalue;
+	int			partno;
+	size_t		written;
+
+	hashvalue = TupleHashTableHashValue(aggstate->hashtable,
+										aggstate->hashslot);
+	partno = (hashvalue << spill->input_bits) >> (32 - spill->partition_bits);
+
+	if (spill->partitions[partno] == NULL)
+	{
+		oldcxt = MemoryContextSwitchTo(aggstate->ss.ps.state->es_query_cxt);
+		spill->partitions[partno] = BufFileCreateTemp(false);
+		MemoryContextSwitchTo(oldcxt);
+	}
+
+	/* the copy goes away when the per-input-tuple context is reset */
+	oldcxt = MemoryContextSwitchTo(aggstate->tmpcontext->ecxt_per_tuple_memory);
+	tuple = ExecCopySlotMinimalTuple(inputslot);
+	MemoryContextSwitchTo(oldcxt);
+
+	written = BufFileWrite(spill->partitions[partno], (void *) tuple,
+						   tuple->t_len);
+	if (written != tuple->t_len)
+		ereport(ERROR,
+				(errcode_for_file_access(),
+			errmsg("could not write to hash-aggregate temporary file: %m")));
+
+	spill->ntuples[partno]++;
+	aggstate->hash_disk_used += tuple->t_len;
+}
+
+/*
+ * At the end of a hashing pass, turn the partitions written during the pass
+ * into batches to be aggregated later.
+ */
+static void
+hash_spill_finish(AggState *aggstate)
+{
+	HashAggSpill spill = aggstate->hash_spill;
+	MemoryContext oldcxt;
+	int			partno;
+
+	if (!aggstate->hash_spill_mode)
+		return;
+
+	oldcxt = MemoryContextSwitchTo(aggstate->ss.ps.state->es_query_cxt);
+
+	for (partno = 0; partno < spill->npartitions; partno++)
+	{
+		HashAggBatch *batch;
+
+		if (spill->partitions[partno] == NULL)
+			continue;
+
+		batch = (HashAggBatch *) palloc(sizeof(HashAggBatch));
+		batch->file = spill->partitions[partno];
+		batch->used_bits = spill->input_bits + spill->partition_bits;
+		batch->ntuples = spill->ntuples[partno];
+
+		/*
+		 * Put it in front, so that batches spilled again are processed before
+		 * their siblings and fewer files are open at a time.
+		 */
+		aggstate->hash_batches = lcons(batch, aggstate->hash_batches);
+
+		spill->partitions[partno] = NULL;
+	}
+
+	MemoryContextSwitchTo(oldcxt);
+
+	aggstate->hash_spill_mode = false;
+}
+
+/*
+ * Read the next tuple from a spilled batch into hash_spill_slot.  Returns
+ * NULL at the end of the file.
+ */
+static TupleTableSlot *
+hash_spill_read(AggState *aggstate, BufFile *file)
+{
+	uint32		t_len;
+	size_t		nread;
+	MinimalTuple tuple;
+
+	nread = BufFileRead(file, (void *) &t_len, sizeof(uint32));
+	if (nread == 0)				/* end of file */
+		return NULL;
+	if (nread != sizeof(uint32))
+		ereport(ERROR,
+				(errcode_for_file_access(),
+			 errmsg("could not read from hash-aggregate temporary file: %m")));
+	tuple = (MinimalTuple) palloc(t_len);
+	tuple->t_len = t_len;
+	nread = BufFileRead(file,
+						(void *) ((char *) tuple + sizeof(uint32)),
+						t_len - sizeof(uint32));
+	if (nread != t_len - sizeof(uint32))
+		ereport(ERROR,
+				(errcode_for_file_access(),
+			 errmsg("could not read from hash-aggregate temporary file: %m")));
+	return ExecStoreMinimalTuple(tuple, aggstate->hash_spill_slot, true);
+}
+
+/*
+ * Close all the temporary files of the current scan.
+ */
+static void
+hash_spill_reset(AggState *aggstate)
+{
+	HashAggSpill spill = aggstate->hash_spill;
+	ListCell   *lc;
+	int			partno;
+
+	if (aggstate->hash_spill_mode)
+	{
+		for (partno = 0; partno < spill->npartitions; partno++)
+		{
+			if (spill->partitions[partno] != NULL)
+				BufFileClose(spill->partitions[partno]);
+			spill->partitions[partno] = NULL;
+		}
+		aggstate->hash_spill_mode = false;
+	}
+
+	foreach(lc, aggstate->hash_batches)
+	{
+		HashAggBatch *batch = (HashAggBatch *) lfirst(lc);
+
+		BufFileClose(batch->file);
+	}
+	list_free_deep(aggstate->hash_batches);
+	aggstate->hash_batches = NIL;
+
+	spill->input_bits = 0;
+}
+
 /*
  * Find or create a hashtable entry for the tuple group containing the
  * given tuple.
  *
+ * In spill mode, no new entries are created; if the group is not in the
+ * table already, the tuple is written out to disk and NULL is returned.
+ *
  * When called, CurrentMemoryContext should be the per-query context.
  */
-static AggHashEntry
+static TupleHashEntryData *
 lookup_hash_entry(AggState *aggstate, TupleTableSlot *inputslot)
 {
 	TupleTableSlot *hashslot = aggstate->hashslot;
 	ListCell   *l;
-	AggHashEntry entry;
+	TupleHashEntryData *entry;
 	bool		isnew;
 
 	/* if first time through, initialize hashslot by cloning input slot */
@@ -1825,15 +2171,28 @@ lookup_hash_entry(AggState *aggstate, TupleTableSlot *inputslot)
 		hashslot->tts_isnull[varNumber] = inputslot->tts_isnull[varNumber];
 	}
 
+	if (aggstate->hash_spill_mode)
+	{
+		entry = LookupTupleHashEntry(aggstate->hashtable, hashslot, NULL);
+		if (entry == NULL)
+			hash_spill_tuple(aggstate, inputslot);
+		return entry;
+	}
+
 	/* find or create the hashtable entry using the filtered tuple */
-	entry = (AggHashEntry) LookupTupleHashEntry(aggstate->hashtable,
-												hashslot,
-												&isnew);
+	entry = LookupTupleHashEntry(aggstate->hashtable, hashslot, &isnew);
 
 	if (isnew)
 	{
+		entry->additional = (AggStatePerGroup)
+			MemoryContextAlloc(aggstate->hashtable->tablecxt,
+						  sizeof(AggStatePerGroupData) * aggstate->numtrans);
 		/* initialize aggregates for new tuple group */
-		initialize_aggregates(aggstate, entry->pergroup, 0);
+		initialize_aggregates(aggstate, (AggStatePerGroup) entry->additional,
+							  0);
+
+		if (++aggstate->hash_ngroups_current >= aggstate->hash_ngroups_limit)
+			hash_agg_check_limits(aggstate);
 	}
 
 	return entry;
@@ -1889,7 +2248,10 @@ ExecAgg(AggState *node)
 				result = agg_retrieve_hash_table(node);
 				break;
 			default:
-				result = agg_retrieve_direct(node);
+				if (node->batch)
+					result = agg_retrieve_batch(node);
+				else
+					result = agg_retrieve_direct(node);
 				break;
 		}
 
@@ -2224,6 +2586,66 @@ agg_retrieve_direct(AggState *aggstate)
 	return NULL;
 }
 
+/*
+ * ExecAgg for plain aggregation of batched input
+ *
+ * There is a single group and no grouping sets, so this returns at most one
+ * row, after the kernels have consumed all the input batches.
+ */
+static TupleTableSlot *
+agg_retrieve_batch(AggState *aggstate)
+{
+	ExprContext *econtext = aggstate->ss.ps.ps_ExprContext;
+	PlanState  *outerPlan = outerPlanState(aggstate);
+	TupleBatch *batch = aggstate->batch;
+	AggStatePerGroup pergroup = aggstate->pergroup;
+	int			numTrans = aggstate->numtrans;
+	MemoryContext oldContext;
+	int			transno;
+
+	ReScanExprContext(econtext);
+	ReScanExprContext(aggstate->aggcontexts[0]);
+
+	initialize_aggregates(aggstate, pergroup, 0);
+	aggstate->current_set = 0;
+
+	while (ExecProcNodeBatch(outerPlan, batch))
+	{
+		if (batch->nsel == 0)
+			continue;
+
+		/* array-typed states are updated in place, in the aggcontext */
+		oldContext = MemoryContextSwitchTo(aggstate->aggcontexts[0]->ecxt_per_tuple_memory);
+
+		for (transno = 0; transno < numTrans; transno++)
+		{
+			AggStatePerTrans pertrans = &aggstate->pertrans[transno];
+			AggStatePerGroup pergroupstate = &pergroup[transno];
+
+			pertrans->batch_transfn(batch, pertrans->batch_col,
+									&pergroupstate->transValue,
+									&pergroupstate->transValueIsNull,
+									&pergroupstate->noTransValue);
+		}
+
+		MemoryContextSwitchTo(oldContext);
+	}
+
+	aggstate->agg_done = true;
+
+	/*
+	 * agg_init_batch() made sure nothing refers to the non-aggregated input
+	 * columns, so the output can be projected from an empty input slot.
+	 */
+	econtext->ecxt_outertuple = aggstate->ss.ss_ScanTupleSlot;
+
+	prepare_projection_slot(aggstate, econtext->ecxt_outertuple, 0);
+
+	finalize_aggregates(aggstate, aggstate->peragg, pergroup, 0);
+
+	return project_aggregates(aggstate);
+}
+
 /*
  * ExecAgg for hashed case: phase 1, read input and build hash table
  */
@@ -2231,7 +2653,7 @@ static void
 agg_fill_hash_table(AggState *aggstate)
 {
 	ExprContext *tmpcontext;
-	AggHashEntry entry;
+	TupleHashEntryData *entry;
 	TupleTableSlot *outerslot;
 
 	/*
@@ -2256,21 +2678,98 @@ agg_fill_hash_table(AggState *aggstate)
 		/* Find or build hashtable entry for this tuple's group */
 		entry = lookup_hash_entry(aggstate, outerslot);
 
-		/* Advance the aggregates */
-		if (DO_AGGSPLIT_COMBINE(aggstate->aggsplit))
-			combine_aggregates(aggstate, entry->pergroup);
-		else
-			advance_aggregates(aggstate, entry->pergroup);
+		/* Advance the aggregates, unless the tuple was spilled */
+		if (entry != NULL)
+		{
+			if (DO_AGGSPLIT_COMBINE(aggstate->aggsplit))
+				combine_aggregates(aggstate,
+								   (AggStatePerGroup) entry->additional);
+			else
+				advance_aggregates(aggstate,
+								   (AggStatePerGroup) entry->additional);
+		}
 
 		/* Reset per-input-tuple context after each tuple */
 		ResetExprContext(tmpcontext);
 	}
 
+	hash_agg_update_metrics(aggstate);
+	hash_spill_finish(aggstate);
+
 	aggstate->table_filled = true;
 	/* Initialize to walk the hash table */
 	ResetTupleHashIterator(aggstate->hashtable, &aggstate->hashiter);
 }
 
+/*
+ * ExecAgg for hashed case: after all the groups in the hash table have been
+ * returned, empty it and fill it again from the next spilled batch.
+ *
+ * Returns false if there are no more batches.
+ */
+static bool
+agg_refill_hash_table(AggState *aggstate)
+{
+	Agg		   *node = (Agg *) aggstate->ss.ps.plan;
+	ExprContext *tmpcontext = aggstate->tmpcontext;
+	HashAggBatch *batch;
+	TupleHashEntryData *entry;
+	TupleTableSlot *slot;
+
+	if (aggstate->hash_batches == NIL)
+		return false;
+
+	batch = (HashAggBatch *) linitial(aggstate->hash_batches);
+	aggstate->hash_batches = list_delete_first(aggstate->hash_batches);
+
+	/*
+	 * Forget the groups of the previous pass.  The scan slot may still point
+	 * into the old table, so clear it first.  As in ExecReScanAgg, we rescan
+	 * rather than just reset the aggcontext so that shutdown callbacks run.
+	 */
+	ExecClearTuple(aggstate->ss.ss_ScanTupleSlot);
+	ReScanExprContext(aggstate->aggcontexts[0]);
+	build_hash_table(aggstate, (long) Min(batch->ntuples, node->numGroups));
+	hash_agg_set_limits(aggstate);
+	aggstate->hash_spill->input_bits = batch->used_bits;
+	aggstate->hash_batches_used++;
+
+	if (BufFileSeek(batch->file, 0, 0L, SEEK_SET))
+		ereport(ERROR,
+				(errcode_for_file_access(),
+			   errmsg("could not rewind hash-aggregate temporary file: %m")));
+
+	while ((slot = hash_spill_read(aggstate, batch->file)) != NULL)
+	{
+		/* set up for advance_aggregates call */
+		tmpcontext->ecxt_outertuple = slot;
+
+		entry = lookup_hash_entry(aggstate, slot);
+
+		if (entry != NULL)
+		{
+			if (DO_AGGSPLIT_COMBINE(aggstate->aggsplit))
+				combine_aggregates(aggstate,
+								   (AggStatePerGroup) entry->additional);
+			else
+				advance_aggregates(aggstate,
+								   (AggStatePerGroup) entry->additional);
+		}
+
+		ResetExprContext(tmpcontext);
+	}
+
+	BufFileClose(batch->file);
+	pfree(batch);
+
+	hash_agg_update_metrics(aggstate);
+	hash_spill_finish(aggstate);
+
+	ResetTupleHashIterator(aggstate->hashtable, &aggstate->hashiter);
+
+	return true;
+}
+
 /*
  * ExecAgg for hashed case: phase 2, retrieving groups from hash table
  */
@@ -2280,7 +2779,7 @@ agg_retrieve_hash_table(AggState *aggstate)
 	ExprContext *econtext;
 	AggStatePerAgg peragg;
 	AggStatePerGroup pergroup;
-	AggHashEntry entry;
+	TupleHashEntryData *entry;
 	TupleTableSlot *firstSlot;
 	TupleTableSlot *result;
 
@@ -2301,9 +2800,13 @@ agg_retrieve_hash_table(AggState *aggstate)
 		/*
 		 * Find the next entry in the hash table
 		 */
-		entry = (AggHashEntry) ScanTupleHashTable(&aggstate->hashiter);
+		entry = ScanTupleHashTable(aggstate->hashtable, &aggstate->hashiter);
 		if (entry == NULL)
 		{
+			/* Move on to the next spilled batch, if any */
+			if (agg_refill_hash_table(aggstate))
+				continue;
+
 			/* No more entries in hashtable, so done */
 			aggstate->agg_done = TRUE;
 			return NULL;
@@ -2322,11 +2825,11 @@ agg_retrieve_hash_table(AggState *aggstate)
 		 * Store the copied first input tuple in the tuple table slot reserved
 		 * for it, so that it can be used in ExecProject.
 		 */
-		ExecStoreMinimalTuple(entry->shared.firstTuple,
+		ExecStoreMinimalTuple(entry->firstTuple,
 							  firstSlot,
 							  false);
 
-		pergroup = entry->pergroup;
+		pergroup = (AggStatePerGroup) entry->additional;
 
 		finalize_aggregates(aggstate, peragg, pergroup, 0);
 
@@ -2456,6 +2959,8 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 	ExecInitResultTupleSlot(estate, &aggstate->ss.ps);
 	aggstate->hashslot = ExecInitExtraTupleSlot(estate);
 	aggstate->sort_slot = ExecInitExtraTupleSlot(estate);
+	if (node->aggstrategy == AGG_HASHED)
+		aggstate->hash_spill_slot = ExecInitExtraTupleSlot(estate);
 
 	/*
 	 * initialize child expressions
@@ -2491,6 +2996,9 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 	if (node->chain)
 		ExecSetSlotDescriptor(aggstate->sort_slot,
 						 aggstate->ss.ss_ScanTupleSlot->tts_tupleDescriptor);
+	if (node->aggstrategy == AGG_HASHED)
+		ExecSetSlotDescriptor(aggstate->hash_spill_slot,
+						 aggstate->ss.ss_ScanTupleSlot->tts_tupleDescriptor);
 
 	/*
 	 * Initialize result tuple type and projection info.
@@ -2632,10 +3140,13 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 
 	if (node->aggstrategy == AGG_HASHED)
 	{
-		build_hash_table(aggstate);
+		build_hash_table(aggstate, node->numGroups);
 		aggstate->table_filled = false;
 		/* Compute the columns we actually need to hash on */
 		aggstate->hash_needed = find_hash_columns(aggstate);
+		/* Prepare to spill to disk if the table outgrows work_mem */
+		hash_agg_set_limits(aggstate);
+		hash_spill_init(aggstate);
 	}
 	else
 	{
@@ -2949,9 +3460,95 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 	aggstate->numaggs = aggno + 1;
 	aggstate->numtrans = transno + 1;
 
+	agg_init_batch(aggstate);
+
 	return aggstate;
 }
 
+/*
+ * Set up the plain aggregation to read its input in batches, if the
+ * aggregates and the outer plan allow it.  Leaves aggstate->batch NULL
+ * otherwise.
+ */
+static void
+agg_init_batch(AggState *aggstate)
+{
+	Agg		   *node = (Agg *) aggstate->ss.ps.plan;
+	int			numTrans = aggstate->numtrans;
+	AttrNumber *outcols;
+	int		   *colmap;
+	bool	   *needsvalue;
+	TupleBatch *batch;
+	int			ncols = 0;
+	int			transno;
+
+	if (!enable_batch_execution ||
+		node->aggstrategy != AGG_PLAIN ||
+		node->groupingSets != NIL ||
+		node->chain != NIL ||
+		DO_AGGSPLIT_COMBINE(aggstate->aggsplit) ||
+		numTrans == 0)
+		return;
+
+	/* the output is projected without a representative input row */
+	if (!bms_is_empty(find_unaggregated_cols(aggstate)))
+		return;
+
+	outcols = (AttrNumber *) palloc(sizeof(AttrNumber) * numTrans);
+	colmap = (int *) palloc(sizeof(int) * numTrans);
+	needsvalue = (bool *) palloc(sizeof(bool) * numTrans);
+
+	for (transno = 0; transno < numTrans; transno++)
+	{
+		AggStatePerTrans pertrans = &aggstate->pertrans[transno];
+		Aggref	   *aggref = pertrans->aggref;
+
+		if (pertrans->aggfilter != NULL ||
+			pertrans->numSortCols > 0 ||
+			pertrans->numTransInputs > 1 ||
+			aggref->aggdirectargs != NIL)
+			return;
+
+		pertrans->batch_transfn = ExecBatchTransFunc(pertrans->transfn_oid,
+													 pertrans->transtypeByVal,
+													 &needsvalue[transno]);
+		if (pertrans->batch_transfn == NULL)
+			return;
+
+		if (pertrans->numTransInputs == 1)
+		{
+			TargetEntry *tle = (TargetEntry *) linitial(aggref->args);
+			Var		   *var = (Var *) tle->expr;
+
+			if (!IsA(var, Var) || var->varno != OUTER_VAR)
+				return;
+
+			outcols[ncols] = var->varattno;
+			pertrans->batch_col = ncols++;
+		}
+		else
+			pertrans->batch_col = -1;
+	}
+
+	batch = ExecInitBatch(outerPlanState(aggstate), ncols, outcols, colmap);
+	if (batch == NULL)
+		return;
+
+	for (transno = 0; transno < numTrans; transno++)
+	{
+		AggStatePerTrans pertrans = &aggstate->pertrans[transno];
+
+		if (pertrans->batch_col < 0)
+			continue;
+
+		pertrans->batch_col = colmap[pertrans->batch_col];
+		if (needsvalue[transno] && !batch->byval[pertrans->batch_col])
+			return;
+	}
+
+	aggstate->batch = batch;
+}
+
 /*
  * Build the state needed to calculate a state value for an aggregate.
  *
@@ -3436,6 +4033,10 @@ ExecEndAgg(AggState *node)
 		}
 	}
 
+	/* Close any temporary files of a hash table that spilled */
+	if (node->hash_spill)
+		hash_spill_reset(node);
+
 	/* And ensure any agg shutdown callbacks have been called */
 	for (setno = 0; setno < numGroupingSets; setno++)
 		ReScanExprContext(node->aggcontexts[setno]);
@@ -3483,10 +4084,13 @@ ExecReScanAgg(AggState *node)
 		 * If we do have the hash table, and the subplan does not have any
 		 * parameter changes, and none of our own parameter changes affect
 		 * input expressions of the aggregated functions, then we can just
-		 * rescan the existing hash table; no need to build it again.
+		 * rescan the existing hash table; no need to build it again.  That
+		 * doesn't work if the input was ever spilled to disk, since the table
+		 * then holds only the groups of the last batch.
 		 */
 		if (outerPlan->chgParam == NULL &&
-			!bms_overlap(node->ss.ps.chgParam, aggnode->aggParams))
+			!bms_overlap(node->ss.ps.chgParam, aggnode->aggParams) &&
+			node->hash_disk_used == 0)
 		{
 			ResetTupleHashIterator(node->hashtable, &node->hashiter);
 			return;
@@ -3539,8 +4143,10 @@ ExecReScanAgg(AggState *node)
 
 	if (aggnode->aggstrategy == AGG_HASHED)
 	{
-		/* Rebuild an empty hash table */
-		build_hash_table(node);
+		/* Discard any spilled batches and rebuild an empty hash table */
+		hash_spill_reset(node);
+		build_hash_table(node, aggnode->numGroups);
+		hash_agg_set_limits(node);
 		node->table_filled = false;
 	}
 	else
@@ -3556,6 +4162,10 @@ ExecReScanAgg(AggState *node)
 
 		node->input_done = false;
 		node->projected_set = -1;
+
+		/* the outer plan will be rescanned, so it has rows again */
+		if (node->batch)
+			node->batch->done = false;
 	}
 
 	if (outerPlan->chgParam == NULL)
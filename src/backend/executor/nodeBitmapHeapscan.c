@@ -32,6 +32,13 @@
  *		ExecInitBitmapHeapScan		creates and initializes state info.
  *		ExecReScanBitmapHeapScan	prepares to rescan the plan.
  *		ExecEndBitmapHeapScan		releases all storage.
+ *		ExecBitmapHeapEstimate		estimates DSM space needed for
+ *									parallel bitmap heap scan
+ *		ExecBitmapHeapInitializeDSM initialize DSM for parallel
+ *									bitmap heap scan
+ *		ExecBitmapHeapReInitializeDSM reset DSM for a new scan
+ *		ExecBitmapHeapInitializeWorker attach to DSM info in parallel
+ *									worker
  */
 #include "postgres.h"
 
@@ -42,6 +49,7 @@
 #include "pgstat.h"
 #include "storage/bufmgr.h"
 #include "storage/predicate.h"
+#include "storage/spin.h"
 #include "utils/memutils.h"
 #include "utils/rel.h"
 #include "utils/spccache.h"
@@ -49,8 +57,27 @@
 #include "utils/tqual.h"
 
 
+/*
+ * Shared state of a parallel bitmap heap scan.
+ *
+ * Every participant runs the bitmap index scans below the node itself and
+ * iterates over its own copy of the bitmap.  The bitmaps are built with the
+ * same snapshot, so any page holding a visible matching tuple is in all of
+ * them; the participants just have to agree on who fetches which heap page.
+ * The bitmap is iterated in block number order, so next_block is enough:
+ * a participant claims the page it's at by moving next_block past it, and
+ * skips every page below next_block because someone else has claimed it.
+ */
+struct ParallelBitmapHeapState
+{
+	slock_t		mutex;			/* protects next_block */
+	BlockNumber next_block;		/* first page not yet claimed */
+};
+
 static TupleTableSlot *BitmapHeapNext(BitmapHeapScanState *node);
 static void bitgetpage(HeapScanDesc scan, TBMIterateResult *tbmres);
+static bool BitmapClaimPage(ParallelBitmapHeapState *pstate,
+				BlockNumber blockno);
 
 
 /* ----------------------------------------------------------------
@@ -165,6 +192,17 @@ BitmapHeapNext(BitmapHeapScanState *node)
 				continue;
 			}
 
+			/*
+			 * In a parallel scan, skip pages that another participant has
+			 * already taken.
+			 */
+			if (node->pstate != NULL &&
+				!BitmapClaimPage(node->pstate, tbmres->blockno))
+			{
+				node->tbmres = tbmres = NULL;
+				continue;
+			}
+
 			/*
 			 * Fetch the current heap page and identify candidate tuples.
 			 */
@@ -409,6 +447,30 @@ bitgetpage(HeapScanDesc scan, TBMIterateResult *tbmres)
 	scan->rs_ntuples = ntup;
 }
 
+/*
+ * BitmapClaimPage - subroutine for BitmapHeapNext()
+ *
+ * Try to claim the given heap page for this participant of a parallel scan.
+ * Returns false if the page has been claimed by someone else already.
+ */
+static bool
+BitmapClaimPage(ParallelBitmapHeapState *pstate, BlockNumber blockno)
+{
+	bool		claimed;
+
+	SpinLockAcquire(&pstate->mutex);
+	if (blockno < pstate->next_block)
+		claimed = false;
+	else
+	{
+		pstate->next_block = blockno + 1;
+		claimed = true;
+	}
+	SpinLockRelease(&pstate->mutex);
+
+	return claimed;
+}
+
 /*
  * BitmapHeapRecheck -- access method routine to recheck a tuple in EvalPlanQual
  */
@@ -567,6 +629,7 @@ ExecInitBitmapHeapScan(BitmapHeapScan *node, EState *estate, int eflags)
 	scanstate->prefetch_target = 0;
 	/* may be updated below */
 	scanstate->prefetch_maximum = target_prefetch_pages;
+	scanstate->pstate = NULL;
 
 	/*
 	 * Miscellaneous initialization
@@ -653,3 +716,66 @@ ExecInitBitmapHeapScan(BitmapHeapScan *node, EState *estate, int eflags)
 	 */
 	return scanstate;
 }
+
+/* ----------------------------------------------------------------
+ *						Parallel Scan Support
+ * ----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------
+ *		ExecBitmapHeapEstimate
+ *
+ *		estimates the space required to serialize bitmap scan node.
+ * ----------------------------------------------------------------
+ */
+void
+ExecBitmapHeapEstimate(BitmapHeapScanState *node,
+					   ParallelContext *pcxt)
+{
+	shm_toc_estimate_chunk(&pcxt->estimator, sizeof(ParallelBitmapHeapState));
+	shm_toc_estimate_keys(&pcxt->estimator, 1);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecBitmapHeapInitializeDSM
+ *
+ *		Set up the shared state of a parallel bitmap heap scan.
+ * ----------------------------------------------------------------
+ */
+void
+ExecBitmapHeapInitializeDSM(BitmapHeapScanState *node,
+							ParallelContext *pcxt)
+{
+	ParallelBitmapHeapState *pstate;
+
+	pstate = shm_toc_allocate(pcxt->toc, sizeof(ParallelBitmapHeapState));
+	SpinLockInit(&pstate->mutex);
+	pstate->next_block = 0;
+	shm_toc_insert(pcxt->toc, node->ss.ps.plan->plan_node_id, pstate);
+	node->pstate = pstate;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecBitmapHeapReInitializeDSM
+ *
+ *		Reset the shared state before the workers are relaunched.
+ * ----------------------------------------------------------------
+ */
+void
+ExecBitmapHeapReInitializeDSM(BitmapHeapScanState *node,
+							  ParallelContext *pcxt)
+{
+	node->pstate->next_block = 0;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecBitmapHeapInitializeWorker
+ *
+ *		Copy relevant information from TOC into planstate.
+ * ----------------------------------------------------------------
+ */
+void
+ExecBitmapHeapInitializeWorker(BitmapHeapScanState *node, shm_toc *toc)
+{
+	node->pstate = shm_toc_lookup(toc, node->ss.ps.plan->plan_node_id);
+}
@@ -16,13 +16,22 @@
  *		ExecDijkstra	 	- execute dijkstra's algorithm
  *		ExecInitDijkstra 	- initialize
  *		ExecEndDijkstra 	- shut down
+ *
+ *		ExecDijkstraEstimate		- estimate DSM space for statistics
+ *		ExecDijkstraInitializeDSM	- initialize DSM for statistics
+ *		ExecDijkstraReInitializeDSM	- clear DSM for a new run
+ *		ExecDijkstraInitializeWorker - attach to DSM info in worker
+ *		ExecDijkstraRetrieveInstrumentation - get statistics of workers
+ *		ExecDijkstraAccumInstrumentation - add up statistics
  */
 
 #include "postgres.h"
 
 #include "access/htup_details.h"
+#include "access/parallel.h"
 #include "catalog/pg_type.h"
 #include "executor/executor.h"
+#include "executor/instrument.h"
 #include "executor/nodeDijkstra.h"
 #include "executor/tuptable.h"
 #include "lib/pairingheap.h"
@@ -30,17 +39,44 @@
 #include "nodes/memnodes.h"
 #include "utils/array.h"
 #include "utils/graph.h"
+#include "utils/hashutils.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 
 typedef struct vnode
 {
-	Graphid		id;					/* hash key */
+	Graphid		id;
 	double		weight;
 	List	   *incoming_enodes;
 	ListCell   *out_edge;
 } vnode;
 
+/*
+ * Entry of the visited_nodes table.  The vnodes are allocated separately,
+ * because they point to each other and entries move around in the table as
+ * it is modified.
+ */
+typedef struct visited_entry
+{
+	Graphid		id;				/* hash key */
+	uint32		status;			/* hash status */
+	vnode	   *vertex;
+} visited_entry;
+
+#define SH_PREFIX visitedhash
+#define SH_ELEMENT_TYPE visited_entry
+#define SH_KEY_TYPE Graphid
+#define SH_KEY id
+#define SH_HASH_KEY(tb, key) ((uint32) murmurhash64(key))
+#define SH_EQUAL(tb, a, b) ((a) == (b))
+#define SH_SCOPE static inline
+#define SH_DECLARE
+#define SH_DEFINE
+#include "lib/simplehash.h"
+
+/* initial size of visited_nodes */
+#define VISITED_NODES_INITIAL_SIZE	1024
+
 typedef struct enode
 {
 	Graphid		id;
@@ -114,6 +150,37 @@ vnode_next_path(vnode *vertex)
 	return false;
 }
 
+/*
+ * Find the vnode of the given vertex, or create one if it hasn't been
+ * visited yet.  *found tells which.
+ */
+static vnode *
+visit_vertex(DijkstraState *node, Graphid id, bool *found)
+{
+	visited_entry *entry;
+
+	entry = visitedhash_insert(node->visited_nodes, id, found);
+	if (!*found)
+	{
+		entry->vertex = (vnode *) MemoryContextAlloc(node->visited_mcxt,
+													 sizeof(vnode));
+		entry->vertex->id = id;
+	}
+
+	return entry->vertex;
+}
+
+/* return the vnode of a vertex that has been visited, or NULL */
+static vnode *
+find_vertex(DijkstraState *node, Graphid id)
+{
+	visited_entry *entry;
+
+	entry = visitedhash_lookup(node->visited_nodes, id);
+
+	return entry != NULL ? entry->vertex : NULL;
+}
+
 typedef struct dijkstra_pq_entry
 {
 	pairingheap_node ph_node;
@@ -135,20 +202,48 @@ pq_cmp(const pairingheap_node *a, const pairingheap_node *b, void *arg)
 }
 
 static dijkstra_pq_entry *
-pq_add(pairingheap *pq, MemoryContext pq_mcxt, Graphid to, double weight)
+pq_add(DijkstraState *node, Graphid to, double weight)
 {
 	dijkstra_pq_entry *n;
 
-	Assert(MemoryContextIsValid(pq_mcxt));
+	Assert(MemoryContextIsValid(node->pq_mcxt));
 
-	n = (dijkstra_pq_entry *) MemoryContextAlloc(pq_mcxt,
+	n = (dijkstra_pq_entry *) MemoryContextAlloc(node->pq_mcxt,
 												 sizeof(dijkstra_pq_entry));
 	n->to = to;
 	n->weight = weight;
-	pairingheap_add(pq, &n->ph_node);
+	pairingheap_add(node->pq, &n->ph_node);
+
+	node->dinstrument.heapPushes++;
+	node->queueSpace += GetMemoryChunkSpace(n);
+	if (node->queueSpace > node->dinstrument.peakQueueSpace)
+		node->dinstrument.peakQueueSpace = node->queueSpace;
+
+	return n;
+}
+
+static dijkstra_pq_entry *
+pq_remove_first(DijkstraState *node)
+{
+	dijkstra_pq_entry *n;
+
+	n = (dijkstra_pq_entry *) pairingheap_remove_first(node->pq);
+
+	node->dinstrument.heapPops++;
+	node->queueSpace -= GetMemoryChunkSpace(n);
+
 	return n;
 }
 
+static void
+count_visited(DijkstraState *node)
+{
+	long		nvisited = node->visited_nodes->members;
+
+	if (nvisited > node->dinstrument.maxVisited)
+		node->dinstrument.maxVisited = nvisited;
+}
+
 static Datum
 eval_array(List *elems, ExprContext *econtext)
 {
@@ -207,7 +302,6 @@ proj_path(DijkstraState *node)
 	vnode	   *end;
 	vnode	   *vertex;
 	enode	   *edge;
-	bool		found;
 	double		weight;
 	List	   *vertexes = NIL;
 	List	   *edges = NIL;
@@ -218,9 +312,8 @@ proj_path(DijkstraState *node)
 
 	plan = (Dijkstra *) node->ps.plan;
 
-	vertex = end = (vnode *) hash_search(node->visited_nodes, &node->target_id,
-										 HASH_FIND, &found);
-	Assert(found);
+	vertex = end = find_vertex(node, node->target_id);
+	Assert(vertex != NULL);
 
 	weight = vertex->weight;
 	while (vertex != NULL)
@@ -307,10 +400,14 @@ ExecDijkstra(DijkstraState *node)
 	dijkstra_pq_entry *start_node;
 	Datum		end_vid;
 	vnode	   *vertex;
+	bool		found;
+	bool		timing;
+	instr_time	starttime;
 
 	dijkstra = (Dijkstra *) node->ps.plan;
 	outerPlan = outerPlanState(node);
 	econtext = node->ps.ps_ExprContext;
+	timing = (node->ps.instrument != NULL && node->ps.instrument->need_timer);
 
 	/*
 	 * Reset per-tuple memory context to free any expression evaluation
@@ -331,43 +428,48 @@ ExecDijkstra(DijkstraState *node)
 	compute_limit(node);
 
 	start_vid = ExecEvalExpr(node->source, econtext, &is_null, &is_done);
-	start_node = pq_add(node->pq, node->pq_mcxt, DatumGetGraphid(start_vid),
-						0.0);
+	start_node = pq_add(node, DatumGetGraphid(start_vid), 0.0);
 
 	end_vid = ExecEvalExpr(node->target, econtext, &is_null, &is_done);
 	node->target_id = DatumGetGraphid(end_vid);
 
-	vertex = hash_search(node->visited_nodes, &start_node->to, HASH_ENTER,
-						 NULL);
+	vertex = visit_vertex(node, start_node->to, &found);
 	vertex->incoming_enodes = NIL;
 	vnode_add_enode(vertex, 0.0, -1, NULL);
 
 	while (!pairingheap_is_empty(node->pq))
 	{
-		bool		found;
 		dijkstra_pq_entry *min_pq_entry;
 		vnode	   *frontier;
 		int			paramno;
 		ParamExecData *prm;
+		int			ndegree;
 
-		min_pq_entry = (dijkstra_pq_entry *) pairingheap_remove_first(node->pq);
+		min_pq_entry = pq_remove_first(node);
 		if (min_pq_entry->to == node->target_id)
+		{
+			count_visited(node);
 			return proj_path(node);
+		}
 
-		frontier = (vnode *) hash_search(node->visited_nodes,
-										 &min_pq_entry->to, HASH_FIND, &found);
-		Assert(found);
+		frontier = find_vertex(node, min_pq_entry->to);
+		Assert(frontier != NULL);
 
 		paramno = ((Param *) node->source->expr)->paramid;
 
 		prm = &(econtext->ecxt_param_exec_vals[paramno]);
 		prm->value = UInt64GetDatum(min_pq_entry->to);
 		outerPlan->chgParam = bms_add_member(outerPlan->chgParam, paramno);
+
+		if (timing)
+			INSTR_TIME_SET_CURRENT(starttime);
 		ExecReScan(outerPlan);
+		if (timing)
+			InstrAccumTime(&node->dinstrument.rescanTime, &starttime);
 
 		pfree(min_pq_entry);
 
-		for (;;)
+		for (ndegree = 0;; ndegree++)
 		{
 			Datum		to;
 			Datum		eid;
@@ -378,10 +480,26 @@ ExecDijkstra(DijkstraState *node)
 			double		new_weight;
 			vnode	   *neighbor;
 
+			if (timing)
+				INSTR_TIME_SET_CURRENT(starttime);
 			outerTupleSlot = ExecProcNode(outerPlan);
+			if (timing)
+				InstrAccumTime(&node->dinstrument.fetchTime, &starttime);
 			if (TupIsNull(outerTupleSlot))
 				break;
 
+			/*
+			 * Do not look at more edges of a supernode than allowed.  The
+			 * vertex only counts as capped if it has more edges than that,
+			 * which we know once we have fetched one more.
+			 */
+			if (graph_traversal_max_degree > 0 &&
+				ndegree >= graph_traversal_max_degree)
+			{
+				node->dinstrument.ncapped++;
+				break;
+			}
+
 			to = slot_getattr(outerTupleSlot, dijkstra->end_id, &is_null);
 			to_val = DatumGetGraphid(to);
 
@@ -397,19 +515,18 @@ ExecDijkstra(DijkstraState *node)
 
 			new_weight = frontier->weight + weight_val;
 
-			neighbor = (vnode *) hash_search(node->visited_nodes, &to_val,
-											 HASH_ENTER, &found);
+			neighbor = visit_vertex(node, to_val, &found);
 
 			if (!found)
 			{
-				pq_add(node->pq, node->pq_mcxt, to_val, new_weight);
+				pq_add(node, to_val, new_weight);
 
 				neighbor->incoming_enodes = NIL;
 				vnode_add_enode(neighbor, new_weight, eid_val, frontier);
 			}
 			else if (new_weight < neighbor->weight)
 			{
-				pq_add(node->pq, node->pq_mcxt, to_val, new_weight);
+				pq_add(node, to_val, new_weight);
 
 				vnode_update_enode(neighbor, new_weight, eid_val, frontier);
 			}
@@ -421,6 +538,8 @@ ExecDijkstra(DijkstraState *node)
 		}
 	}
 
+	count_visited(node);
+
 	node->n = node->max_n;
 	return NULL;
 }
@@ -429,7 +548,6 @@ DijkstraState *
 ExecInitDijkstra(Dijkstra *node, EState *estate, int eflags)
 {
 	DijkstraState *dstate;
-	HASHCTL		hash_ctl;
 	PlanState  *outerPlan;
 
 	/* check for unsupported flags */
@@ -454,12 +572,16 @@ ExecInitDijkstra(Dijkstra *node, EState *estate, int eflags)
 	dstate->pq_mcxt = AllocSetContextCreate(CurrentMemoryContext,
 											"dijkstra's priority queue",
 											ALLOCSET_DEFAULT_SIZES);
-	hash_ctl.keysize = sizeof(Graphid);
-	hash_ctl.entrysize = sizeof(vnode);
-	hash_ctl.hcxt = CurrentMemoryContext;
-	dstate->visited_nodes = hash_create("dijkstra's visited nodes",
-										1024, &hash_ctl,
-										HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+	dstate->visited_mcxt = AllocSetContextCreate(CurrentMemoryContext,
+												 "dijkstra's visited nodes",
+												 ALLOCSET_DEFAULT_SIZES);
+	dstate->visited_nodes = visitedhash_create(dstate->visited_mcxt,
+											   VISITED_NODES_INITIAL_SIZE,
+											   NULL);
+	dstate->queueSpace = 0;
+	memset(&dstate->dinstrument, 0, sizeof(dstate->dinstrument));
+	dstate->shared_info = NULL;
+	dstate->worker_info = NULL;
 
 	dstate->source = ExecInitExpr((Expr *) node->source, (PlanState *) dstate);
 	dstate->target = ExecInitExpr((Expr *) node->target, (PlanState *) dstate);
@@ -523,7 +645,6 @@ void
 ExecReScanDijkstra(DijkstraState *node)
 {
 	PlanState  *outerPlan = outerPlanState(node);
-	HASHCTL		hash_ctl;
 
 	compute_limit(node);
 
@@ -538,15 +659,160 @@ ExecReScanDijkstra(DijkstraState *node)
 	node->is_executed = false;
 
 	/* reset hash table and priority queue */
-	hash_destroy(node->visited_nodes);
-	hash_ctl.keysize = sizeof(Graphid);
-	hash_ctl.entrysize = sizeof(vnode);
-	hash_ctl.hcxt = CurrentMemoryContext;
-	node->visited_nodes = hash_create("dijkstra's visited nodes",
-									  1024, &hash_ctl,
-									  HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+	MemoryContextReset(node->visited_mcxt);
+	node->visited_nodes = visitedhash_create(node->visited_mcxt,
+											 VISITED_NODES_INITIAL_SIZE,
+											 NULL);
 	MemoryContextReset(node->pq_mcxt);
 	pairingheap_reset(node->pq);
+	node->queueSpace = 0;
 
 	ExecClearTuple(node->selfTupleSlot);
 }
+
+/* ----------------------------------------------------------------
+ *		ExecShutdownDijkstra
+ *
+ *		Parallel workers report their statistics to the leader here.
+ * ----------------------------------------------------------------
+ */
+void
+ExecShutdownDijkstra(DijkstraState *node)
+{
+	DijkstraInstrumentation *dst;
+	DijkstraInstrumentation *src = &node->dinstrument;
+
+	if (node->shared_info == NULL || !IsParallelWorker())
+		return;
+
+	Assert(ParallelWorkerNumber < node->shared_info->num_workers);
+	dst = &node->shared_info->dinstrument[ParallelWorkerNumber];
+
+	ExecDijkstraAccumInstrumentation(dst, src);
+	memset(src, 0, sizeof(*src));
+}
+
+/* ----------------------------------------------------------------
+ *		ExecDijkstraEstimate
+ *
+ *		estimates the space required for the statistics of workers.
+ *		This is needed only if EXPLAIN ANALYZE is instrumenting the node.
+ * ----------------------------------------------------------------
+ */
+void
+ExecDijkstraEstimate(DijkstraState *node, ParallelContext *pcxt)
+{
+	Size		size;
+
+	if (node->ps.instrument == NULL || pcxt->nworkers == 0)
+		return;
+
+	size = mul_size(pcxt->nworkers, sizeof(DijkstraInstrumentation));
+	size = add_size(size, offsetof(SharedDijkstraInfo, dinstrument));
+	shm_toc_estimate_chunk(&pcxt->estimator, size);
+	shm_toc_estimate_keys(&pcxt->estimator, 1);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecDijkstraInitializeDSM
+ *
+ *		allocates zeroed slots for the statistics of workers.
+ * ----------------------------------------------------------------
+ */
+void
+ExecDijkstraInitializeDSM(DijkstraState *node, ParallelContext *pcxt)
+{
+	Size		size;
+
+	if (node->ps.instrument == NULL || pcxt->nworkers == 0)
+		return;
+
+	size = offsetof(SharedDijkstraInfo, dinstrument) +
+		pcxt->nworkers * sizeof(DijkstraInstrumentation);
+	node->shared_info = shm_toc_allocate(pcxt->toc, size);
+	memset(node->shared_info, 0, size);
+	node->shared_info->num_workers = pcxt->nworkers;
+	shm_toc_insert(pcxt->toc, node->ps.plan->plan_node_id, node->shared_info);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecDijkstraReInitializeDSM
+ *
+ *		clears the statistics slots before the workers are relaunched,
+ *		as the statistics of the last run have already been retrieved.
+ * ----------------------------------------------------------------
+ */
+void
+ExecDijkstraReInitializeDSM(DijkstraState *node, ParallelContext *pcxt)
+{
+	if (node->shared_info == NULL)
+		return;
+
+	memset(node->shared_info->dinstrument, 0,
+		   node->shared_info->num_workers * sizeof(DijkstraInstrumentation));
+}
+
+/* ----------------------------------------------------------------
+ *		ExecDijkstraInitializeWorker
+ *
+ *		attaches to the statistics slots in shared memory, if any.
+ * ----------------------------------------------------------------
+ */
+void
+ExecDijkstraInitializeWorker(DijkstraState *node, shm_toc *toc)
+{
+	node->shared_info = shm_toc_lookup(toc, node->ps.plan->plan_node_id);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecDijkstraRetrieveInstrumentation
+ *
+ *		adds the statistics of workers in shared memory to a local copy,
+ *		so that EXPLAIN can print them after the DSM segment is gone.
+ *		The copy sums up all the runs of the workers if Gather rescans.
+ * ----------------------------------------------------------------
+ */
+void
+ExecDijkstraRetrieveInstrumentation(DijkstraState *node)
+{
+	SharedDijkstraInfo *si = node->shared_info;
+	int			n;
+
+	if (si == NULL)
+		return;
+
+	if (node->worker_info == NULL)
+	{
+		Size		size;
+
+		size = offsetof(SharedDijkstraInfo, dinstrument) +
+			si->num_workers * sizeof(DijkstraInstrumentation);
+		node->worker_info =
+			MemoryContextAllocZero(node->ps.state->es_query_cxt, size);
+		node->worker_info->num_workers = si->num_workers;
+	}
+
+	Assert(node->worker_info->num_workers == si->num_workers);
+	for (n = 0; n < si->num_workers; n++)
+		ExecDijkstraAccumInstrumentation(&node->worker_info->dinstrument[n],
+										 &si->dinstrument[n]);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecDijkstraAccumInstrumentation
+ *
+ *		adds the statistics in src to dst.
+ * ----------------------------------------------------------------
+ */
+void
+ExecDijkstraAccumInstrumentation(DijkstraInstrumentation *dst,
+								 DijkstraInstrumentation *src)
+{
+	dst->heapPushes += src->heapPushes;
+	dst->heapPops += src->heapPops;
+	dst->ncapped += src->ncapped;
+	dst->maxVisited = Max(dst->maxVisited, src->maxVisited);
+	dst->peakQueueSpace = Max(dst->peakQueueSpace, src->peakQueueSpace);
+	dst->rescanTime += src->rescanTime;
+	dst->fetchTime += src->fetchTime;
+}
@@ -32,6 +32,9 @@
 #include "executor/nodeHash.h"
 #include "executor/nodeHashjoin.h"
 #include "miscadmin.h"
+#include "storage/ipc.h"
+#include "storage/latch.h"
+#include "storage/proc.h"
 #include "utils/dynahash.h"
 #include "utils/memutils.h"
 #include "utils/lsyscache.h"
@@ -50,6 +53,52 @@ static void ExecHashRemoveNextSkewBucket(HashJoinTable hashtable);
 
 static void *dense_alloc(HashJoinTable hashtable, Size size);
 
+static void MultiExecParallelHash(HashState *node);
+static void ExecParallelHashTableInsert(HashJoinTable hashtable,
+							TupleTableSlot *slot,
+							uint32 hashvalue);
+static void *parallel_dense_alloc(HashJoinTable hashtable, Size size,
+					 HashJoinSharedPtr *ptr);
+static void ExecParallelHashMapSegments(HashJoinTable hashtable);
+static void ExecParallelHashRelease(HashJoinTable hashtable);
+static void ExecParallelHashAttach(ParallelHashJoinState *pstate);
+static void ExecParallelHashWait(void);
+static void ExecParallelHashWakeup(ParallelHashJoinState *pstate);
+
+/*
+ * Return the tuple a HashJoinSharedPtr points to, in a parallel-aware
+ * hashjoin.  The segment holding it must be mapped by now.
+ */
+static inline HashJoinTuple
+ExecParallelHashTuple(HashJoinTable hashtable, HashJoinSharedPtr ptr)
+{
+	if (ptr == InvalidHashJoinSharedPtr)
+		return NULL;
+
+	Assert(hashtable->segment_bases[HashJoinSharedPtrSegno(ptr)] != NULL);
+	return (HashJoinTuple)
+		(hashtable->segment_bases[HashJoinSharedPtrSegno(ptr)] +
+		 HashJoinSharedPtrOffset(ptr));
+}
+
+static inline HashJoinTuple
+ExecParallelHashBucket(HashJoinTable hashtable, int bucketno)
+{
+	ParallelHashJoinState *pstate = hashtable->parallel_state;
+
+	return ExecParallelHashTuple(hashtable,
+								 pg_atomic_read_u64(&pstate->buckets[bucketno]));
+}
+
+static inline HashJoinTuple
+ExecHashNextTuple(HashJoinTable hashtable, HashJoinTuple hashTuple)
+{
+	if (hashtable->parallel_state != NULL)
+		return ExecParallelHashTuple(hashtable, hashTuple->next.shared);
+
+	return hashTuple->next.unshared;
+}
+
 /* ----------------------------------------------------------------
  *		ExecHash
  *
@@ -90,6 +139,16 @@ MultiExecHash(HashState *node)
 	outerNode = outerPlanState(node);
 	hashtable = node->hashtable;
 
+	if (hashtable->parallel_state != NULL)
+	{
+		MultiExecParallelHash(node);
+
+		if (node->ps.instrument)
+			InstrStopNode(node->ps.instrument, hashtable->totalTuples);
+
+		return NULL;
+	}
+
 	/*
 	 * set expression context
 	 */
@@ -240,10 +299,14 @@ ExecEndHash(HashState *node)
  *		ExecHashTableCreate
  *
  *		create an empty hashtable data structure for hashjoin.
+ *
+ *		If pstate is not NULL, the table is the shared one of a
+ *		parallel-aware hashjoin.  Its buckets are in pstate already.
  * ----------------------------------------------------------------
  */
 HashJoinTable
-ExecHashTableCreate(Hash *node, List *hashOperators, bool keepNulls)
+ExecHashTableCreate(Hash *node, List *hashOperators, bool keepNulls,
+					ParallelHashJoinState *pstate)
 {
 	HashJoinTable hashtable;
 	Plan	   *outerNode;
@@ -263,9 +326,16 @@ ExecHashTableCreate(Hash *node, List *hashOperators, bool keepNulls)
 	 */
 	outerNode = outerPlan(node);
 
-	ExecChooseHashTableSize(outerNode->plan_rows, outerNode->plan_width,
-							OidIsValid(node->skewTable),
-							&nbuckets, &nbatch, &num_skew_mcvs);
+	if (pstate != NULL)
+	{
+		nbuckets = pstate->nbuckets;
+		nbatch = 1;
+		num_skew_mcvs = 0;
+	}
+	else
+		ExecChooseHashTableSize(outerNode->plan_rows, outerNode->plan_width,
+								OidIsValid(node->skewTable),
+								&nbuckets, &nbatch, &num_skew_mcvs);
 
 	/* nbuckets must be a power of 2 */
 	log2_nbuckets = my_log2(nbuckets);
@@ -306,6 +376,14 @@ ExecHashTableCreate(Hash *node, List *hashOperators, bool keepNulls)
 	hashtable->spaceAllowedSkew =
 		hashtable->spaceAllowed * SKEW_WORK_MEM_PERCENT / 100;
 	hashtable->chunks = NULL;
+	hashtable->parallel_state = pstate;
+	hashtable->segments = NULL;
+	hashtable->segment_bases = NULL;
+	hashtable->nsegments_created = 0;
+	hashtable->cur_segno = -1;
+	hashtable->cur_segment_used = 0;
+	hashtable->cur_segment_size = 0;
+	hashtable->holding = false;
 
 #ifdef HJDEBUG
 	printf("Hashjoin %p: initial nbatch = %d, nbuckets = %d\n",
@@ -368,6 +446,19 @@ ExecHashTableCreate(Hash *node, List *hashOperators, bool keepNulls)
 		PrepareTempTablespaces();
 	}
 
+	/* The buckets of a shared table are in the DSM already */
+	if (pstate != NULL)
+	{
+		hashtable->segments = (dsm_segment **)
+			palloc0(PHJ_MAX_SEGMENTS * sizeof(dsm_segment *));
+		hashtable->segment_bases = (char **)
+			palloc0(PHJ_MAX_SEGMENTS * sizeof(char *));
+
+		MemoryContextSwitchTo(oldcxt);
+
+		return hashtable;
+	}
+
 	/*
 	 * Prepare context for the first-scan space allocations; allocate the
 	 * hashbucket array therein, and set each bucket "empty".
@@ -577,6 +668,9 @@ ExecHashTableDestroy(HashJoinTable hashtable)
 			BufFileClose(hashtable->outerBatchFile[i]);
 	}
 
+	/* Let go of the shared tuples, if any */
+	ExecHashTableDetach(hashtable);
+
 	/* Release working memory (batchCxt is a child, so it goes away too) */
 	MemoryContextDelete(hashtable->hashCxt);
 
@@ -584,6 +678,26 @@ ExecHashTableDestroy(HashJoinTable hashtable)
 	pfree(hashtable);
 }
 
+/* ----------------------------------------------------------------
+ *		ExecHashTableDetach
+ *
+ *		let go of the shared tuples of a parallel-aware hashjoin
+ *
+ * The shared state lives in the DSM of the parallel query, so this must
+ * be done before that goes away.  The rest of the table can still be
+ * looked at by EXPLAIN afterwards.
+ * ----------------------------------------------------------------
+ */
+void
+ExecHashTableDetach(HashJoinTable hashtable)
+{
+	if (hashtable->parallel_state != NULL)
+	{
+		ExecParallelHashRelease(hashtable);
+		hashtable->parallel_state = NULL;
+	}
+}
+
 /*
  * ExecHashIncreaseNumBatches
  *		increase the original number of batches in order to reduce
@@ -703,7 +817,7 @@ ExecHashIncreaseNumBatches(HashJoinTable hashtable)
 				memcpy(copyTuple, hashTuple, hashTupleSize);
 
 				/* and add it back to the appropriate bucket */
-				copyTuple->next = hashtable->buckets[bucketno];
+				copyTuple->next.unshared = hashtable->buckets[bucketno];
 				hashtable->buckets[bucketno] = copyTuple;
 			}
 			else
@@ -804,7 +918,7 @@ ExecHashIncreaseNumBuckets(HashJoinTable hashtable)
 									  &bucketno, &batchno);
 
 			/* add the tuple to the proper bucket */
-			hashTuple->next = hashtable->buckets[bucketno];
+			hashTuple->next.unshared = hashtable->buckets[bucketno];
 			hashtable->buckets[bucketno] = hashTuple;
 
 			/* advance index past the tuple */
@@ -866,7 +980,7 @@ ExecHashTableInsert(HashJoinTable hashtable,
 		HeapTupleHeaderClearMatch(HJTUPLE_MINTUPLE(hashTuple));
 
 		/* Push it onto the front of the bucket's list */
-		hashTuple->next = hashtable->buckets[bucketno];
+		hashTuple->next.unshared = hashtable->buckets[bucketno];
 		hashtable->buckets[bucketno] = hashTuple;
 
 		/*
@@ -1073,9 +1187,11 @@ ExecScanHashBucket(HashJoinState *hjstate,
 	 * otherwise scan the standard hashtable bucket.
 	 */
 	if (hashTuple != NULL)
-		hashTuple = hashTuple->next;
+		hashTuple = ExecHashNextTuple(hashtable, hashTuple);
 	else if (hjstate->hj_CurSkewBucketNo != INVALID_SKEW_BUCKET_NO)
 		hashTuple = hashtable->skewBucket[hjstate->hj_CurSkewBucketNo]->tuples;
+	else if (hashtable->parallel_state != NULL)
+		hashTuple = ExecParallelHashBucket(hashtable, hjstate->hj_CurBucketNo);
 	else
 		hashTuple = hashtable->buckets[hjstate->hj_CurBucketNo];
 
@@ -1101,7 +1217,7 @@ ExecScanHashBucket(HashJoinState *hjstate,
 			}
 		}
 
-		hashTuple = hashTuple->next;
+		hashTuple = ExecHashNextTuple(hashtable, hashTuple);
 	}
 
 	/*
@@ -1152,7 +1268,7 @@ ExecScanHashTableForUnmatched(HashJoinState *hjstate, ExprContext *econtext)
 		 * bucket.
 		 */
 		if (hashTuple != NULL)
-			hashTuple = hashTuple->next;
+			hashTuple = hashTuple->next.unshared;
 		else if (hjstate->hj_CurBucketNo < hashtable->nbuckets)
 		{
 			hashTuple = hashtable->buckets[hjstate->hj_CurBucketNo];
@@ -1191,7 +1307,7 @@ ExecScanHashTableForUnmatched(HashJoinState *hjstate, ExprContext *econtext)
 				return true;
 			}
 
-			hashTuple = hashTuple->next;
+			hashTuple = hashTuple->next.unshared;
 		}
 	}
 
@@ -1244,7 +1360,8 @@ ExecHashTableResetMatchFlags(HashJoinTable hashtable)
 	/* Reset all flags in the main table ... */
 	for (i = 0; i < hashtable->nbuckets; i++)
 	{
-		for (tuple = hashtable->buckets[i]; tuple != NULL; tuple = tuple->next)
+		for (tuple = hashtable->buckets[i]; tuple != NULL;
+			 tuple = tuple->next.unshared)
 			HeapTupleHeaderClearMatch(HJTUPLE_MINTUPLE(tuple));
 	}
 
@@ -1254,7 +1371,8 @@ ExecHashTableResetMatchFlags(HashJoinTable hashtable)
 		int			j = hashtable->skewBucketNums[i];
 		HashSkewBucket *skewBucket = hashtable->skewBucket[j];
 
-		for (tuple = skewBucket->tuples; tuple != NULL; tuple = tuple->next)
+		for (tuple = skewBucket->tuples; tuple != NULL;
+			 tuple = tuple->next.unshared)
 			HeapTupleHeaderClearMatch(HJTUPLE_MINTUPLE(tuple));
 	}
 }
@@ -1506,7 +1624,7 @@ ExecHashSkewTableInsert(HashJoinTable hashtable,
 	HeapTupleHeaderClearMatch(HJTUPLE_MINTUPLE(hashTuple));
 
 	/* Push it onto the front of the skew bucket's list */
-	hashTuple->next = hashtable->skewBucket[bucketNumber]->tuples;
+	hashTuple->next.unshared = hashtable->skewBucket[bucketNumber]->tuples;
 	hashtable->skewBucket[bucketNumber]->tuples = hashTuple;
 
 	/* Account for space used, and back off if we've used too much */
@@ -1555,7 +1673,7 @@ ExecHashRemoveNextSkewBucket(HashJoinTable hashtable)
 	hashTuple = bucket->tuples;
 	while (hashTuple != NULL)
 	{
-		HashJoinTuple nextHashTuple = hashTuple->next;
+		HashJoinTuple nextHashTuple = hashTuple->next.unshared;
 		MinimalTuple tuple;
 		Size		tupleSize;
 
@@ -1581,7 +1699,7 @@ ExecHashRemoveNextSkewBucket(HashJoinTable hashtable)
 			memcpy(copyTuple, hashTuple, tupleSize);
 			pfree(hashTuple);
 
-			copyTuple->next = hashtable->buckets[bucketno];
+			copyTuple->next.unshared = hashtable->buckets[bucketno];
 			hashtable->buckets[bucketno] = copyTuple;
 
 			/* We have reduced skew space, but overall space doesn't change */
@@ -1710,3 +1828,437 @@ dense_alloc(HashJoinTable hashtable, Size size)
 	/* return pointer to the start of the tuple memory */
 	return ptr;
 }
+
+/* ----------------------------------------------------------------
+ *		MultiExecParallelHash
+ *
+ *		build the shared hash table of a parallel-aware hashjoin,
+ *		together with the other participants
+ * ----------------------------------------------------------------
+ */
+static void
+MultiExecParallelHash(HashState *node)
+{
+	PlanState  *outerNode = outerPlanState(node);
+	HashJoinTable hashtable = node->hashtable;
+	ParallelHashJoinState *pstate = hashtable->parallel_state;
+	List	   *hashkeys = node->hashkeys;
+	ExprContext *econtext = node->ps.ps_ExprContext;
+	TupleTableSlot *slot;
+	uint32		hashvalue;
+	bool		late;
+	bool		done;
+	bool		wakeup = false;
+
+	/* join the build, unless it's over already */
+	SpinLockAcquire(&pstate->mutex);
+	late = pstate->build_done;
+	if (late)
+	{
+		/* the table can only be used if somebody still holds its segments */
+		if (pstate->nholders > 0)
+		{
+			ExecParallelHashAttach(pstate);
+			pstate->nmapping++;
+			hashtable->holding = true;
+		}
+	}
+	else
+	{
+		ExecParallelHashAttach(pstate);
+		pstate->nparticipants++;
+		hashtable->holding = true;
+	}
+	SpinLockRelease(&pstate->mutex);
+
+	if (!late)
+	{
+		/*
+		 * Insert the inner tuples we get.  The inner plan is partial, so the
+		 * other participants get the rest.
+		 */
+		for (;;)
+		{
+			slot = ExecProcNode(outerNode);
+			if (TupIsNull(slot))
+				break;
+			econtext->ecxt_innertuple = slot;
+			if (ExecHashGetHashValue(hashtable, econtext, hashkeys,
+									 false, hashtable->keepNulls,
+									 &hashvalue))
+			{
+				ExecParallelHashTableInsert(hashtable, slot, hashvalue);
+				hashtable->totalTuples += 1;
+			}
+		}
+
+		/* we'll map the others' segments as soon as they are done, too */
+		SpinLockAcquire(&pstate->mutex);
+		pstate->nbuilt++;
+		pstate->totalTuples += hashtable->totalTuples;
+		pstate->spaceUsed += hashtable->spaceUsed;
+		pstate->nmapping++;
+		if (pstate->nbuilt == pstate->nparticipants)
+		{
+			pstate->build_done = true;
+			wakeup = true;
+		}
+		done = pstate->build_done;
+		SpinLockRelease(&pstate->mutex);
+
+		/* we were the last ones, let the others map the segments */
+		if (wakeup)
+			ExecParallelHashWakeup(pstate);
+
+		while (!done)
+		{
+			ExecParallelHashWait();
+
+			SpinLockAcquire(&pstate->mutex);
+			done = pstate->build_done;
+			SpinLockRelease(&pstate->mutex);
+		}
+	}
+	else if (!hashtable->holding)
+	{
+		/* everybody else is done with the join, see ExecHashJoin() */
+		hashtable->totalTuples = 0;
+		return;
+	}
+
+	ExecParallelHashMapSegments(hashtable);
+
+	SpinLockAcquire(&pstate->mutex);
+	pstate->nmapping--;
+	wakeup = (pstate->nmapping == 0);
+	hashtable->totalTuples = pstate->totalTuples;
+	hashtable->spaceUsed = pstate->spaceUsed +
+		hashtable->nbuckets * sizeof(HashJoinSharedPtr);
+	SpinLockRelease(&pstate->mutex);
+
+	/* somebody may be waiting to let go of the segments */
+	if (wakeup)
+		ExecParallelHashWakeup(pstate);
+
+	hashtable->spacePeak = hashtable->spaceUsed;
+}
+
+/*
+ * ExecParallelHashTableInsert
+ *		insert a tuple into the shared hash table
+ *
+ * The tuple is copied into one of our own segments and pushed onto its
+ * bucket, which the other participants may be pushing onto concurrently.
+ */
+static void
+ExecParallelHashTableInsert(HashJoinTable hashtable,
+							TupleTableSlot *slot,
+							uint32 hashvalue)
+{
+	ParallelHashJoinState *pstate = hashtable->parallel_state;
+	MinimalTuple tuple = ExecFetchSlotMinimalTuple(slot);
+	HashJoinTuple hashTuple;
+	HashJoinSharedPtr ptr;
+	int			hashTupleSize;
+	int			bucketno;
+	int			batchno;
+	pg_atomic_uint64 *bucket;
+	uint64		head;
+
+	ExecHashGetBucketAndBatch(hashtable, hashvalue, &bucketno, &batchno);
+	Assert(batchno == 0);
+
+	hashTupleSize = HJTUPLE_OVERHEAD + tuple->t_len;
+	hashTuple = (HashJoinTuple) parallel_dense_alloc(hashtable, hashTupleSize,
+													 &ptr);
+	hashTuple->hashvalue = hashvalue;
+	memcpy(HJTUPLE_MINTUPLE(hashTuple), tuple, tuple->t_len);
+	HeapTupleHeaderClearMatch(HJTUPLE_MINTUPLE(hashTuple));
+
+	bucket = &pstate->buckets[bucketno];
+	head = pg_atomic_read_u64(bucket);
+	do
+	{
+		hashTuple->next.shared = head;
+	} while (!pg_atomic_compare_exchange_u64(bucket, &head, ptr));
+
+	hashtable->spaceUsed += hashTupleSize;
+}
+
+/*
+ * Allocate 'size' bytes from the DSM segment we are filling, creating a new
+ * one if it's full, and return both its address and its HashJoinSharedPtr.
+ *
+ * Every participant creates segments of its own, each one twice as large as
+ * its previous one, so that even large tables take few segments.  All of
+ * them together may not take more than work_mem: a shared table can't be
+ * split into batches, so we raise an error instead.
+ */
+static void *
+parallel_dense_alloc(HashJoinTable hashtable, Size size,
+					 HashJoinSharedPtr *ptr)
+{
+	ParallelHashJoinState *pstate = hashtable->parallel_state;
+	Size		offset;
+
+	size = MAXALIGN(size);
+
+	if (hashtable->cur_segno < 0 ||
+		hashtable->cur_segment_size - hashtable->cur_segment_used < size)
+	{
+		Size		segsize;
+		dsm_segment *seg;
+		int			segno;
+
+		segsize = PHJ_SEGMENT_SIZE << Min(hashtable->nsegments_created, 10);
+		segsize = Min(segsize, PHJ_MAX_SEGMENT_SIZE);
+		if (size > segsize)
+		{
+			if (size > PHJ_MAX_SEGMENT_SIZE)
+				ereport(ERROR,
+						(errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+						 errmsg("tuple is too large for a shared hash table")));
+			segsize = size;
+		}
+
+		/* reserve the space of the new segment, within work_mem */
+		SpinLockAcquire(&pstate->mutex);
+		if (pstate->spaceReserved + size > pstate->spaceAllowed)
+			segsize = 0;
+		else
+		{
+			segsize = Min(segsize,
+						  pstate->spaceAllowed - pstate->spaceReserved);
+			pstate->spaceReserved += segsize;
+		}
+		SpinLockRelease(&pstate->mutex);
+
+		if (segsize == 0)
+			ereport(ERROR,
+					(errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+					 errmsg("shared hash table exceeds work_mem"),
+					 errhint("Consider increasing work_mem or turning off enable_parallel_hash.")));
+
+		seg = dsm_create(segsize, 0);
+
+		SpinLockAcquire(&pstate->mutex);
+		segno = pstate->nsegments;
+		if (segno < PHJ_MAX_SEGMENTS)
+		{
+			pstate->segments[segno] = dsm_segment_handle(seg);
+			pstate->nsegments++;
+		}
+		SpinLockRelease(&pstate->mutex);
+
+		if (segno >= PHJ_MAX_SEGMENTS)
+		{
+			dsm_detach(seg);
+			ereport(ERROR,
+					(errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+					 errmsg("too many shared memory segments for a shared hash table")));
+		}
+
+		hashtable->segments[segno] = seg;
+		hashtable->segment_bases[segno] = dsm_segment_address(seg);
+		hashtable->nsegments_created++;
+		hashtable->cur_segno = segno;
+		hashtable->cur_segment_used = 0;
+		hashtable->cur_segment_size = segsize;
+	}
+
+	offset = hashtable->cur_segment_used;
+	hashtable->cur_segment_used += size;
+
+	*ptr = HashJoinSharedPtrMake(hashtable->cur_segno, offset);
+
+	return hashtable->segment_bases[hashtable->cur_segno] + offset;
+}
+
+/*
+ * Map the segments created by the other participants.  The caller has
+ * announced itself in pstate->nmapping, so none of them goes away meanwhile.
+ */
+static void
+ExecParallelHashMapSegments(HashJoinTable hashtable)
+{
+	ParallelHashJoinState *pstate = hashtable->parallel_state;
+	int			nsegments;
+	int			segno;
+
+	SpinLockAcquire(&pstate->mutex);
+	Assert(pstate->build_done);
+	nsegments = pstate->nsegments;
+	SpinLockRelease(&pstate->mutex);
+
+	for (segno = 0; segno < nsegments; segno++)
+	{
+		dsm_segment *seg;
+
+		if (hashtable->segments[segno] != NULL)
+			continue;
+
+		seg = dsm_attach(pstate->segments[segno]);
+		if (seg == NULL)
+			ereport(ERROR,
+					(errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+					 errmsg("could not map dynamic shared memory segment")));
+		hashtable->segments[segno] = seg;
+		hashtable->segment_bases[segno] = dsm_segment_address(seg);
+	}
+}
+
+/*
+ * Stop holding the segments of the shared table and unmap them.  We must
+ * not do so while another participant is mapping them, since we might be
+ * the last one to hold some of them.
+ */
+static void
+ExecParallelHashRelease(HashJoinTable hashtable)
+{
+	ParallelHashJoinState *pstate = hashtable->parallel_state;
+	int			segno;
+
+	if (hashtable->holding)
+	{
+		for (;;)
+		{
+			bool		released = false;
+
+			SpinLockAcquire(&pstate->mutex);
+			if (pstate->nmapping == 0)
+			{
+				pstate->nholders--;
+				released = true;
+			}
+			SpinLockRelease(&pstate->mutex);
+
+			if (released)
+				break;
+
+			ExecParallelHashWait();
+		}
+		hashtable->holding = false;
+	}
+
+	for (segno = 0; segno < PHJ_MAX_SEGMENTS; segno++)
+	{
+		if (hashtable->segments[segno] != NULL)
+		{
+			dsm_detach(hashtable->segments[segno]);
+			hashtable->segments[segno] = NULL;
+			hashtable->segment_bases[segno] = NULL;
+		}
+	}
+}
+
+/*
+ * Start holding the segments of the shared table, and record ourselves among
+ * its participants so that the others set our latch when we may have to
+ * stop waiting.  Called with the mutex held.  The leader and each worker
+ * attach at most once per scan, so there's room for all of them.
+ */
+static void
+ExecParallelHashAttach(ParallelHashJoinState *pstate)
+{
+	Assert(pstate->nprocs < pstate->maxprocs);
+	if (pstate->nprocs < pstate->maxprocs)
+		ParallelHashJoinProcnos(pstate)[pstate->nprocs++] = MyProc->pgprocno;
+	pstate->nholders++;
+}
+
+/*
+ * Wait until our latch is set by another participant, see
+ * ExecParallelHashWakeup.  The caller rechecks the shared state afterwards.
+ */
+static void
+ExecParallelHashWait(void)
+{
+	int			rc;
+
+	rc = WaitLatch(MyLatch, WL_LATCH_SET | WL_POSTMASTER_DEATH, 0);
+	if (rc & WL_POSTMASTER_DEATH)
+		proc_exit(1);
+	ResetLatch(MyLatch);
+
+	CHECK_FOR_INTERRUPTS();
+}
+
+/*
+ * Set the latches of the other participants, after ending the build or
+ * finishing the last mapping of the segments.
+ */
+static void
+ExecParallelHashWakeup(ParallelHashJoinState *pstate)
+{
+	int		   *procnos = ParallelHashJoinProcnos(pstate);
+	int			nprocs;
+	int			i;
+
+	SpinLockAcquire(&pstate->mutex);
+	nprocs = pstate->nprocs;
+	SpinLockRelease(&pstate->mutex);
+
+	for (i = 0; i < nprocs; i++)
+	{
+		if (procnos[i] != MyProc->pgprocno)
+			SetLatch(&ProcGlobal->allProcs[procnos[i]].procLatch);
+	}
+}
+
+/* ----------------------------------------------------------------
+ *		ExecParallelHashSize
+ *
+ *		size of the shared state of a parallel-aware hashjoin whose
+ *		whole inner relation is expected to have ntuples tuples, and
+ *		which at most maxprocs participants take part in
+ *
+ *		The number of buckets is limited by work_mem, like that of a
+ *		private table.
+ * ----------------------------------------------------------------
+ */
+Size
+ExecParallelHashSize(double ntuples, int tupwidth, int maxprocs,
+					 int *nbuckets)
+{
+	int			nbatch;
+	int			num_skew_mcvs;
+	Size		size;
+
+	ExecChooseHashTableSize(ntuples, tupwidth, false,
+							nbuckets, &nbatch, &num_skew_mcvs);
+
+	size = add_size(offsetof(ParallelHashJoinState, buckets),
+					mul_size(*nbuckets, sizeof(pg_atomic_uint64)));
+	return add_size(size, mul_size(maxprocs, sizeof(int)));
+}
+
+/* ----------------------------------------------------------------
+ *		ExecParallelHashInitialize
+ *
+ *		set up the shared state of a parallel-aware hashjoin, either
+ *		for the first time or for a rescan
+ * ----------------------------------------------------------------
+ */
+void
+ExecParallelHashInitialize(ParallelHashJoinState *pstate, int nbuckets,
+						   int maxprocs)
+{
+	int			i;
+
+	SpinLockInit(&pstate->mutex);
+	pstate->nbuckets = nbuckets;
+	pstate->nparticipants = 0;
+	pstate->nbuilt = 0;
+	pstate->build_done = false;
+	pstate->nholders = 0;
+	pstate->nmapping = 0;
+	pstate->totalTuples = 0;
+	pstate->spaceUsed = 0;
+	pstate->spaceAllowed = work_mem * 1024L;
+	pstate->spaceReserved = nbuckets * sizeof(pg_atomic_uint64);
+	pstate->nsegments = 0;
+	pstate->maxprocs = maxprocs;
+	pstate->nprocs = 0;
+	for (i = 0; i < nbuckets; i++)
+		pg_atomic_init_u64(&pstate->buckets[i], InvalidHashJoinSharedPtr);
+}
@@ -168,7 +168,8 @@ ExecHashJoin(HashJoinState *node)
 				 */
 				hashtable = ExecHashTableCreate((Hash *) hashNode->ps.plan,
 												node->hj_HashOperators,
-												HJ_FILL_INNER(node));
+												HJ_FILL_INNER(node),
+												node->hj_ParallelState);
 				node->hj_HashTable = hashtable;
 
 				/*
@@ -177,6 +178,14 @@ ExecHashJoin(HashJoinState *node)
 				hashNode->hashtable = hashtable;
 				(void) MultiExecProcNode((PlanState *) hashNode);
 
+				/*
+				 * If we arrived at a shared hash table after the other
+				 * participants were done with it, they have also consumed
+				 * the whole outer relation.
+				 */
+				if (hashtable->parallel_state != NULL && !hashtable->holding)
+					return NULL;
+
 				/*
 				 * If the inner relation is completely empty, and we're not
 				 * doing a left outer join, we can quit without scanning the
@@ -553,6 +562,8 @@ ExecInitHashJoin(HashJoin *node, EState *estate, int eflags)
 	 */
 	hjstate->hj_HashTable = NULL;
 	hjstate->hj_FirstOuterTupleSlot = NULL;
+	hjstate->hj_ParallelState = NULL;
+	hjstate->hj_ParallelNBuckets = 0;
 
 	hjstate->hj_CurHashValue = 0;
 	hjstate->hj_CurBucketNo = 0;
@@ -953,6 +964,7 @@ ExecReScanHashJoin(HashJoinState *node)
 	if (node->hj_HashTable != NULL)
 	{
 		if (node->hj_HashTable->nbatch == 1 &&
+			!node->js.ps.plan->parallel_aware &&
 			node->js.ps.righttree->chgParam == NULL)
 		{
 			/*
@@ -985,6 +997,15 @@ ExecReScanHashJoin(HashJoinState *node)
 			node->hj_HashTable = NULL;
 			node->hj_JoinState = HJ_BUILD_HASHTABLE;
 
+			/*
+			 * A shared hash table is rebuilt by the leader and the new
+			 * workers of the parallel rescan; the old ones are gone.
+			 */
+			if (node->hj_ParallelState != NULL)
+				ExecParallelHashInitialize(node->hj_ParallelState,
+										   node->hj_ParallelState->nbuckets,
+										   node->hj_ParallelState->maxprocs);
+
 			/*
 			 * if chgParam of subnode is not null then plan will be re-scanned
 			 * by first ExecProcNode.
@@ -1011,3 +1032,86 @@ ExecReScanHashJoin(HashJoinState *node)
 	if (node->js.ps.lefttree->chgParam == NULL)
 		ExecReScan(node->js.ps.lefttree);
 }
+
+/* ----------------------------------------------------------------
+ *		ExecShutdownHashJoin
+ *
+ *		Let go of the shared hash table before the parallel query
+ *		goes away.
+ * ----------------------------------------------------------------
+ */
+void
+ExecShutdownHashJoin(HashJoinState *node)
+{
+	if (node->hj_HashTable != NULL)
+		ExecHashTableDetach(node->hj_HashTable);
+
+	/* a rescan sets up a new one, if any */
+	node->hj_ParallelState = NULL;
+}
+
+/* ----------------------------------------------------------------
+ *						Parallel Hash Join Support
+ * ----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------
+ *		ExecHashJoinEstimate
+ *
+ *		estimates the space required to serialize the shared
+ *		hash table.
+ * ----------------------------------------------------------------
+ */
+void
+ExecHashJoinEstimate(HashJoinState *node, ParallelContext *pcxt)
+{
+	Hash	   *hash = (Hash *) innerPlanState(node)->plan;
+	Size		size;
+
+	/* the leader takes part too */
+	size = ExecParallelHashSize(hash->rows_total, hash->plan.plan_width,
+								pcxt->nworkers + 1,
+								&node->hj_ParallelNBuckets);
+	shm_toc_estimate_chunk(&pcxt->estimator, size);
+	shm_toc_estimate_keys(&pcxt->estimator, 1);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecHashJoinInitializeDSM
+ *
+ *		Set up the shared hash table, with all of its buckets empty.
+ * ----------------------------------------------------------------
+ */
+void
+ExecHashJoinInitializeDSM(HashJoinState *node, ParallelContext *pcxt)
+{
+	Hash	   *hash = (Hash *) innerPlanState(node)->plan;
+	ParallelHashJoinState *pstate;
+	int			nbuckets;
+	Size		size;
+
+	size = ExecParallelHashSize(hash->rows_total, hash->plan.plan_width,
+								pcxt->nworkers + 1, &nbuckets);
+	Assert(nbuckets == node->hj_ParallelNBuckets);
+
+	pstate = shm_toc_allocate(pcxt->toc, size);
+	ExecParallelHashInitialize(pstate, nbuckets, pcxt->nworkers + 1);
+	shm_toc_insert(pcxt->toc, node->js.ps.plan->plan_node_id, pstate);
+	node->hj_ParallelState = pstate;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecHashJoinInitializeWorker
+ *
+ *		Copy relevant information from TOC into planstate.
+ * ----------------------------------------------------------------
+ */
+void
+ExecHashJoinInitializeWorker(HashJoinState *node, shm_toc *toc)
+{
+	ParallelHashJoinState *pstate;
+
+	pstate = shm_toc_lookup(toc, node->js.ps.plan->plan_node_id);
+	node->hj_ParallelState = pstate;
+	node->hj_ParallelNBuckets = pstate->nbuckets;
+}
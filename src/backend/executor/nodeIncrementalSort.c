@@ -0,0 +1,407 @@
+/*-------------------------------------------------------------------------
+ *
+ * nodeIncrementalSort.c
+ *	  Routines to handle incremental sorting of relations.
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ *
+ * IDENTIFICATION
+ *	  src/backend/executor/nodeIncrementalSort.c
+ *
+ * DESCRIPTION
+ *
+ *	Incremental sort is a Sort whose input is already sorted on a prefix of
+ *	the sort keys.  Given the sort keys (a, b) and input sorted by (a), the
+ *	input consists of groups of tuples with equal "a", and only the tuples
+ *	within each group need to be sorted by "b":
+ *
+ *		(1, 5)  (1, 2)  (2, 9)  (2, 1)  (2, 5)  (3, 3)
+ *		^-----------^   ^-------------------^   ^----^
+ *
+ *	Sorting each group on its own keeps memory use bounded by the size of the
+ *	largest group instead of the whole input, and the first tuples can be
+ *	returned as soon as the first group has been read, which matters a lot
+ *	under a LIMIT.
+ *
+ *	Sorting tiny groups one at a time would waste most of the time setting
+ *	up and tearing down sorts, so the tuples are sorted in batches of at
+ *	least INCREMENTAL_SORT_MIN_BATCH tuples instead.  When a batch has its
+ *	minimum size it is extended to the end of the presorted group that its
+ *	last tuple belongs to, so a group is never split across two batches.
+ *	Each batch is sorted on all the sort keys; the first tuple that does not
+ *	belong to the batch is kept in transfer_tuple to start the next one.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "executor/execdebug.h"
+#include "executor/nodeIncrementalSort.h"
+#include "miscadmin.h"
+#include "utils/lsyscache.h"
+#include "utils/tuplesort.h"
+
+/* minimum number of tuples sorted at once */
+#define INCREMENTAL_SORT_MIN_BATCH	32
+
+static void incsort_put_tuple(IncrementalSortState *node,
+				  Tuplesortstate *tuplesortstate, TupleTableSlot *slot,
+				  int64 *nTuples, int64 minTuples);
+static void incsort_record_stats(IncrementalSortState *node,
+					 Tuplesortstate *tuplesortstate);
+
+
+/* ----------------------------------------------------------------
+ *		ExecIncrementalSort
+ *
+ *		Reads the next batch of tuples from the outer subtree whenever the
+ *		current one has been returned, sorts it using tuplesort and returns
+ *		its tuples one per call.
+ *
+ *		Conditions:
+ *		  -- the outer subtree returns tuples sorted on the first
+ *			 nPresortedCols sort keys.
+ *
+ *		Initial States:
+ *		  -- the outer child is prepared to return the first tuple.
+ * ----------------------------------------------------------------
+ */
+TupleTableSlot *
+ExecIncrementalSort(IncrementalSortState *node)
+{
+	IncrementalSort *plannode = (IncrementalSort *) node->ss.ps.plan;
+	EState	   *estate = node->ss.ps.state;
+	ScanDirection dir;
+	PlanState  *outerNode;
+	Tuplesortstate *tuplesortstate;
+	TupleTableSlot *slot;
+	int64		nTuples;
+	int64		minTuples;
+
+	SO1_printf("ExecIncrementalSort: %s\n",
+			   "entering routine");
+
+	/* incremental sort only supports forward scans */
+	Assert(ScanDirectionIsForward(estate->es_direction));
+
+	/*
+	 * Return the next tuple of the current batch, if any.  Once a batch is
+	 * exhausted, release it.
+	 */
+	tuplesortstate = (Tuplesortstate *) node->tuplesortstate;
+	if (tuplesortstate != NULL)
+	{
+		slot = node->ss.ps.ps_ResultTupleSlot;
+		if (tuplesort_gettupleslot(tuplesortstate, true, slot, NULL))
+		{
+			node->bound_Done++;
+			return slot;
+		}
+
+		tuplesort_end(tuplesortstate);
+		node->tuplesortstate = NULL;
+	}
+
+	/*
+	 * Stop if the outer plan is exhausted and no tuple is left over from the
+	 * previous batch, or if we have returned all the tuples a bound asks for.
+	 */
+	if ((node->outerNodeDone && TupIsNull(node->transfer_tuple)) ||
+		(node->bounded && node->bound_Done >= node->bound))
+		return ExecClearTuple(node->ss.ps.ps_ResultTupleSlot);
+
+	SO1_printf("ExecIncrementalSort: %s\n",
+			   "sorting next batch");
+
+	dir = estate->es_direction;
+	estate->es_direction = ForwardScanDirection;
+
+	outerNode = outerPlanState(node);
+	tuplesortstate = tuplesort_begin_heap(ExecGetResultType(outerNode),
+										  plannode->sort.numCols,
+										  plannode->sort.sortColIdx,
+										  plannode->sort.sortOperators,
+										  plannode->sort.collations,
+										  plannode->sort.nullsFirst,
+										  work_mem,
+										  false);
+	node->tuplesortstate = (void *) tuplesortstate;
+
+	/*
+	 * If we are bounded, this batch needs to produce at most the remaining
+	 * number of tuples, and it need not be any longer than that up to the
+	 * end of the group it stops in.
+	 */
+	minTuples = INCREMENTAL_SORT_MIN_BATCH;
+	if (node->bounded)
+	{
+		int64		remaining = node->bound - node->bound_Done;
+
+		tuplesort_set_bound(tuplesortstate, remaining);
+		minTuples = Min(minTuples, remaining);
+	}
+
+	nTuples = 0;
+	if (!TupIsNull(node->transfer_tuple))
+	{
+		incsort_put_tuple(node, tuplesortstate, node->transfer_tuple,
+						  &nTuples, minTuples);
+		ExecClearTuple(node->transfer_tuple);
+	}
+
+	while (!node->outerNodeDone)
+	{
+		slot = ExecProcNode(outerNode);
+
+		if (TupIsNull(slot))
+		{
+			node->outerNodeDone = true;
+			break;
+		}
+
+		/*
+		 * Once the batch has its minimum size, it only takes tuples of the
+		 * group of its last tuple.  The first tuple of the next group starts
+		 * the next batch.
+		 */
+		if (nTuples >= minTuples &&
+			!execTuplesMatch(node->group_pivot, slot,
+							 node->nPresortedCols,
+							 plannode->sort.sortColIdx,
+							 node->presortedEqfns,
+							 node->ss.ps.ps_ExprContext->ecxt_per_tuple_memory))
+		{
+			ExecCopySlot(node->transfer_tuple, slot);
+			break;
+		}
+
+		incsort_put_tuple(node, tuplesortstate, slot, &nTuples, minTuples);
+	}
+
+	tuplesort_performsort(tuplesortstate);
+	incsort_record_stats(node, tuplesortstate);
+	node->nbatches++;
+
+	estate->es_direction = dir;
+
+	SO1_printf("ExecIncrementalSort: %s\n", "sorting done");
+
+	slot = node->ss.ps.ps_ResultTupleSlot;
+	if (tuplesort_gettupleslot(tuplesortstate, true, slot, NULL))
+		node->bound_Done++;
+	return slot;
+}
+
+/*
+ * Add a tuple to the batch being built.  The tuple that brings the batch to
+ * its minimum size becomes the pivot the following tuples are compared with.
+ */
+static void
+incsort_put_tuple(IncrementalSortState *node, Tuplesortstate *tuplesortstate,
+				  TupleTableSlot *slot, int64 *nTuples, int64 minTuples)
+{
+	tuplesort_puttupleslot(tuplesortstate, slot);
+	if (++(*nTuples) == minTuples)
+		ExecCopySlot(node->group_pivot, slot);
+}
+
+/*
+ * Remember the space used by the largest batch, for EXPLAIN ANALYZE.  A batch
+ * that went to disk is reported over any that was sorted in memory.
+ */
+static void
+incsort_record_stats(IncrementalSortState *node,
+					 Tuplesortstate *tuplesortstate)
+{
+	const char *sortMethod;
+	const char *spaceType;
+	long		spaceUsed;
+	bool		isDisk;
+	bool		maxIsDisk;
+
+	tuplesort_get_stats(tuplesortstate, &sortMethod, &spaceType, &spaceUsed);
+
+	isDisk = strcmp(spaceType, "Disk") == 0;
+	maxIsDisk = node->maxSpaceType != NULL &&
+		strcmp(node->maxSpaceType, "Disk") == 0;
+
+	if (node->maxSpaceType == NULL ||
+		(isDisk && !maxIsDisk) ||
+		(isDisk == maxIsDisk && spaceUsed > node->maxSpaceUsed))
+	{
+		node->maxSpaceUsed = spaceUsed;
+		node->maxSpaceType = spaceType;
+	}
+}
+
+/* ----------------------------------------------------------------
+ *		ExecInitIncrementalSort
+ *
+ *		Creates the run-time state information for the incremental sort
+ *		node produced by the planner and initializes its outer subtree.
+ * ----------------------------------------------------------------
+ */
+IncrementalSortState *
+ExecInitIncrementalSort(IncrementalSort *node, EState *estate, int eflags)
+{
+	IncrementalSortState *incrsortstate;
+	Oid		   *eqOperators;
+	int			i;
+
+	SO1_printf("ExecInitIncrementalSort: %s\n",
+			   "initializing incremental sort node");
+
+	/* check for unsupported flags */
+	Assert(!(eflags & (EXEC_FLAG_BACKWARD | EXEC_FLAG_MARK)));
+
+	/*
+	 * create state structure
+	 */
+	incrsortstate = makeNode(IncrementalSortState);
+	incrsortstate->ss.ps.plan = (Plan *) node;
+	incrsortstate->ss.ps.state = estate;
+
+	incrsortstate->bounded = false;
+	incrsortstate->bound_Done = 0;
+	incrsortstate->nPresortedCols = node->nPresortedCols;
+	incrsortstate->outerNodeDone = false;
+	incrsortstate->tuplesortstate = NULL;
+	incrsortstate->nbatches = 0;
+	incrsortstate->maxSpaceUsed = 0;
+	incrsortstate->maxSpaceType = NULL;
+
+	/*
+	 * Miscellaneous initialization
+	 *
+	 * The ExprContext only provides the memory the presorted columns are
+	 * compared in.
+	 */
+	ExecAssignExprContext(estate, &incrsortstate->ss.ps);
+
+	/*
+	 * tuple table initialization
+	 */
+	ExecInitResultTupleSlot(estate, &incrsortstate->ss.ps);
+	ExecInitScanTupleSlot(estate, &incrsortstate->ss);
+	incrsortstate->group_pivot = ExecInitExtraTupleSlot(estate);
+	incrsortstate->transfer_tuple = ExecInitExtraTupleSlot(estate);
+
+	/*
+	 * initialize child nodes
+	 *
+	 * We shield the child node from the need to support REWIND, BACKWARD, or
+	 * MARK/RESTORE.
+	 */
+	eflags &= ~(EXEC_FLAG_REWIND | EXEC_FLAG_BACKWARD | EXEC_FLAG_MARK);
+
+	outerPlanState(incrsortstate) = ExecInitNode(outerPlan(node), estate, eflags);
+
+	/*
+	 * initialize tuple type.  no need to initialize projection info because
+	 * this node doesn't do projections.
+	 */
+	ExecAssignResultTypeFromTL(&incrsortstate->ss.ps);
+	ExecAssignScanTypeFromOuterPlan(&incrsortstate->ss);
+	incrsortstate->ss.ps.ps_ProjInfo = NULL;
+
+	ExecSetSlotDescriptor(incrsortstate->group_pivot,
+						  ExecGetResultType(outerPlanState(incrsortstate)));
+	ExecSetSlotDescriptor(incrsortstate->transfer_tuple,
+						  ExecGetResultType(outerPlanState(incrsortstate)));
+
+	/*
+	 * Look up the equality functions of the presorted columns, which tell
+	 * where the groups of the input end.
+	 */
+	eqOperators = (Oid *) palloc(node->nPresortedCols * sizeof(Oid));
+	for (i = 0; i < node->nPresortedCols; i++)
+	{
+		Oid			eqop;
+
+		eqop = get_equality_op_for_ordering_op(node->sort.sortOperators[i],
+											   NULL);
+		if (!OidIsValid(eqop))
+			elog(ERROR, "could not find equality operator for ordering operator %u",
+				 node->sort.sortOperators[i]);
+		eqOperators[i] = eqop;
+	}
+	incrsortstate->presortedEqfns = execTuplesMatchPrepare(node->nPresortedCols,
+														   eqOperators);
+	pfree(eqOperators);
+
+	SO1_printf("ExecInitIncrementalSort: %s\n",
+			   "incremental sort node initialized");
+
+	return incrsortstate;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecEndIncrementalSort(node)
+ * ----------------------------------------------------------------
+ */
+void
+ExecEndIncrementalSort(IncrementalSortState *node)
+{
+	SO1_printf("ExecEndIncrementalSort: %s\n",
+			   "shutting down incremental sort node");
+
+	/*
+	 * Free the exprcontext
+	 */
+	ExecFreeExprContext(&node->ss.ps);
+
+	/*
+	 * clean out the tuple table
+	 */
+	ExecClearTuple(node->ss.ss_ScanTupleSlot);
+	/* must drop pointer to sort result tuple */
+	ExecClearTuple(node->ss.ps.ps_ResultTupleSlot);
+	ExecClearTuple(node->group_pivot);
+	ExecClearTuple(node->transfer_tuple);
+
+	/*
+	 * Release tuplesort resources
+	 */
+	if (node->tuplesortstate != NULL)
+		tuplesort_end((Tuplesortstate *) node->tuplesortstate);
+	node->tuplesortstate = NULL;
+
+	/*
+	 * shut down the subplan
+	 */
+	ExecEndNode(outerPlanState(node));
+
+	SO1_printf("ExecEndIncrementalSort: %s\n",
+			   "incremental sort node shutdown");
+}
+
+void
+ExecReScanIncrementalSort(IncrementalSortState *node)
+{
+	PlanState  *outerPlan = outerPlanState(node);
+
+	/*
+	 * Batches are not kept after they have been returned, so we always have
+	 * to re-read the subplan.
+	 */
+	ExecClearTuple(node->ss.ps.ps_ResultTupleSlot);
+	ExecClearTuple(node->group_pivot);
+	ExecClearTuple(node->transfer_tuple);
+
+	if (node->tuplesortstate != NULL)
+		tuplesort_end((Tuplesortstate *) node->tuplesortstate);
+	node->tuplesortstate = NULL;
+
+	node->outerNodeDone = false;
+	node->bound_Done = 0;
+
+	/*
+	 * if chgParam of subnode is not null then plan will be re-scanned by
+	 * first ExecProcNode.
+	 */
+	if (outerPlan->chgParam == NULL)
+		ExecReScan(outerPlan);
+}
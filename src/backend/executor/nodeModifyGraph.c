@@ -27,6 +27,7 @@
 #include "utils/builtins.h"
 #include "utils/datum.h"
 #include "utils/graph.h"
+#include "utils/hashutils.h"
 #include "utils/jsonb.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
@@ -99,6 +100,7 @@ typedef struct SqlcmdEntry
 typedef struct ModifiedPropEntry
 {
 	Graphid		key;
+	uint32		status;			/* hash status */
 	union
 	{
 		Datum		properties;
@@ -106,6 +108,18 @@ typedef struct ModifiedPropEntry
 	}			val;
 } ModifiedPropEntry;
 
+/* the table of modified graph elements, looked up for every result row */
+#define SH_PREFIX proptable
+#define SH_ELEMENT_TYPE ModifiedPropEntry
+#define SH_KEY_TYPE Graphid
+#define SH_KEY key
+#define SH_HASH_KEY(tb, key) ((uint32) murmurhash64(key))
+#define SH_EQUAL(tb, a, b) ((a) == (b))
+#define SH_SCOPE static inline
+#define SH_DECLARE
+#define SH_DEFINE
+#include "lib/simplehash.h"
+
 static HTAB *sqlcmd_cache = NULL;
 
 static void initGraphWRStats(ModifyGraphState *mgstate, GraphWriteOp op);
@@ -260,17 +274,7 @@ ExecInitModifyGraph(ModifyGraph *mgplan, EState *estate, int eflags)
 	InitSqlcmdHashTable(estate->es_query_cxt);
 
 	if (mgstate->eagerness && (mgstate->sets != NIL || mgstate->exprs != NIL))
-	{
-		HASHCTL ctl;
-
-		memset(&ctl, 0, sizeof(ctl));
-		ctl.keysize = sizeof(Graphid);
-		ctl.entrysize = sizeof(ModifiedPropEntry);
-		ctl.hcxt = CurrentMemoryContext;
-
-		mgstate->propTable = hash_create("modified object table", 128, &ctl,
-										HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
-	}
+		mgstate->propTable = proptable_create(CurrentMemoryContext, 128, NULL);
 	else
 	{
 		mgstate->propTable = NULL;
@@ -350,7 +354,7 @@ ExecModifyGraph(ModifyGraphState *mgstate)
 		mgstate->child_done = true;
 
 		if (mgstate->propTable != NULL &&
-			hash_get_num_entries(mgstate->propTable) > 0)
+			mgstate->propTable->members > 0)
 			reflectModifiedProp(mgstate);
 	}
 
@@ -370,7 +374,7 @@ ExecModifyGraph(ModifyGraphState *mgstate)
 		slot_getallattrs(result);
 
 		if (mgstate->propTable == NULL ||
-			hash_get_num_entries(mgstate->propTable) < 1)
+			mgstate->propTable->members < 1)
 			return result;
 
 		natts = result->tts_tupleDescriptor->natts;
@@ -430,7 +434,7 @@ ExecEndModifyGraph(ModifyGraphState *mgstate)
 	mgstate->tuplestorestate = NULL;
 
 	if (mgstate->propTable != NULL)
-		hash_destroy(mgstate->propTable);
+		proptable_destroy(mgstate->propTable);
 
 	if (sqlcmd_cache != NULL)
 		EndSqlcmdHashTable();
@@ -1820,7 +1824,7 @@ enterSetPropTable(ModifyGraphState *mgstate, Datum gid, Datum prop)
 	bool		found;
 	ModifiedPropEntry *entry;
 
-	entry = hash_search(mgstate->propTable, (void *) &gid, HASH_ENTER, &found);
+	entry = proptable_insert(mgstate->propTable, DatumGetGraphid(gid), &found);
 	if (found)
 		pfree((void *) entry->val.properties);
 	entry->val.properties = datumCopy(prop, false, -1);
@@ -1831,21 +1835,22 @@ enterDelPropTable(ModifyGraphState *mgstate, Datum elem, Oid type)
 {
 	Datum gid;
 	ModifiedPropEntry *entry;
+	bool		found;
 
 	if (type == VERTEXOID)
 	{
 		gid = getVertexIdDatum(elem);
 
-		entry = hash_search(mgstate->propTable, (void *) &gid, HASH_ENTER,
-							NULL);
+		entry = proptable_insert(mgstate->propTable, DatumGetGraphid(gid),
+								 &found);
 		entry->val.kind = DEL_ELEM_VERTEX;
 	}
 	else if (type == EDGEOID)
 	{
 		gid = getEdgeIdDatum(elem);
 
-		entry = hash_search(mgstate->propTable, (void *) &gid, HASH_ENTER,
-							NULL);
+		entry = proptable_insert(mgstate->propTable, DatumGetGraphid(gid),
+								 &found);
 		entry->val.kind = DEL_ELEM_EDGE;
 	}
 	else
@@ -1862,8 +1867,8 @@ enterDelPropTable(ModifyGraphState *mgstate, Datum elem, Oid type)
 		{
 			gid = (Datum) lfirst(lc);
 
-			entry = hash_search(mgstate->propTable,
-								(void *) &gid, HASH_ENTER, NULL);
+			entry = proptable_insert(mgstate->propTable,
+									 DatumGetGraphid(gid), &found);
 			entry->val.kind = DEL_ELEM_VERTEX;
 		}
 
@@ -1871,8 +1876,8 @@ enterDelPropTable(ModifyGraphState *mgstate, Datum elem, Oid type)
 		{
 			gid = (Datum) lfirst(lc);
 
-			entry = hash_search(mgstate->propTable,
-								(void *) &gid, HASH_ENTER, NULL);
+			entry = proptable_insert(mgstate->propTable,
+									 DatumGetGraphid(gid), &found);
 			entry->val.kind = DEL_ELEM_EDGE;
 		}
 	}
@@ -1944,7 +1949,7 @@ getVertexFinalPropMap(ModifyGraphState *mgstate, Datum origin, Graphid gid)
 	ModifyGraph *plan = (ModifyGraph *) mgstate->ps.plan;
 	ModifiedPropEntry *entry;
 
-	entry = hash_search(mgstate->propTable, (void *) &gid, HASH_FIND, NULL);
+	entry = proptable_lookup(mgstate->propTable, gid);
 
 	/* un-modified vertex */
 	if (entry == NULL)
@@ -1962,7 +1967,7 @@ getEdgeFinalPropMap(ModifyGraphState *mgstate, Datum origin, Graphid gid)
 	ModifyGraph *plan = (ModifyGraph *) mgstate->ps.plan;
 	ModifiedPropEntry *entry;
 
-	entry = hash_search(mgstate->propTable, (void *) &gid, HASH_FIND, NULL);
+	entry = proptable_lookup(mgstate->propTable, gid);
 
 	/* un-modified edge */
 	if (entry == NULL)
@@ -2078,7 +2083,7 @@ static void
 reflectModifiedProp(ModifyGraphState *mgstate)
 {
 	ModifyGraph *plan = (ModifyGraph *) mgstate->ps.plan;
-	HASH_SEQ_STATUS seq;
+	proptable_iterator it;
 	ModifiedPropEntry *entry;
 
 	Assert(mgstate->propTable != NULL);
@@ -2088,8 +2093,8 @@ reflectModifiedProp(ModifyGraphState *mgstate)
 
 	DisableGraphDML = false;
 
-	hash_seq_init(&seq, mgstate->propTable);
-	while ((entry = hash_seq_search(&seq)) != NULL)
+	proptable_start_iterate(mgstate->propTable, &it);
+	while ((entry = proptable_iterate(mgstate->propTable, &it)) != NULL)
 	{
 		Datum gid = GraphidGetDatum(entry->key);
 
@@ -15,12 +15,21 @@
  *		ExecNestLoopVLE	 	- process a nestloop join of two plans
  *		ExecInitNestLoopVLE - initialize the join
  *		ExecEndNestLoopVLE 	- shut down the join
+ *
+ *		ExecNestLoopVLEEstimate		 - estimate DSM space for statistics
+ *		ExecNestLoopVLEInitializeDSM - initialize DSM for statistics
+ *		ExecNestLoopVLEReInitializeDSM - clear DSM for a new run
+ *		ExecNestLoopVLEInitializeWorker - attach to DSM info in worker
+ *		ExecNestLoopVLERetrieveInstrumentation - get statistics of workers
+ *		ExecNestLoopVLEAccumInstrumentation - add up statistics
  */
 
 #include "postgres.h"
 
+#include "access/parallel.h"
 #include "catalog/pg_type.h"
 #include "executor/execdebug.h"
+#include "executor/instrument.h"
 #include "executor/nodeNestloopVle.h"
 #include "fmgr.h"
 #include "nodes/pg_list.h"
@@ -43,6 +52,10 @@
 static bool incrDepth(NestLoopVLEState *node);
 static bool decrDepth(NestLoopVLEState *node);
 static bool isMaxDepth(NestLoopVLEState *node);
+static void resetDegree(NestLoopVLEState *node);
+static bool isDegreeCapped(NestLoopVLEState *node);
+static bool isOuterDegreeCapped(NestLoopVLEState *node,
+								TupleTableSlot *outerTupleSlot);
 static void bindNestParam(NestLoopVLE *nlv,
 						  ExprContext *econtext,
 						  TupleTableSlot *outerTupleSlot,
@@ -63,6 +76,7 @@ static void addOuterRowidAndGid(NestLoopVLEState *node, TupleTableSlot *slot);
 static void addInnerRowidAndGid(NestLoopVLEState *node, TupleTableSlot *slot);
 static void addRowidAndGid(NestLoopVLEState *node, Datum rowid, Datum gid);
 static void popRowidAndGid(NestLoopVLEState *node);
+static void countHopRow(NestLoopVLEState *node);
 
 
 TupleTableSlot *
@@ -78,6 +92,8 @@ ExecNestLoopVLE(NestLoopVLEState *node)
 	ExprContext *econtext;
 	TupleTableSlot *result;
 	ExprDoneCond isDone;
+	bool		timing;
+	instr_time	starttime;
 
 	/*
 	 * get information from the node
@@ -90,6 +106,8 @@ ExecNestLoopVLE(NestLoopVLEState *node)
 	innerPlan = innerPlanState(node);
 	econtext = node->nls.js.ps.ps_ExprContext;
 	selfTupleSlot = node->selfTupleSlot;
+	timing = (node->nls.js.ps.instrument != NULL &&
+			  node->nls.js.ps.instrument->need_timer);
 
 	/*
 	 * Reset per-tuple memory context to free any expression evaluation
@@ -130,6 +148,9 @@ ExecNestLoopVLE(NestLoopVLEState *node)
 					return NULL;
 				}
 
+				if (isOuterDegreeCapped(node, outerTupleSlot))
+					continue;
+
 				addOuterRowidAndGid(node, outerTupleSlot);
 			}
 
@@ -140,7 +161,10 @@ ExecNestLoopVLE(NestLoopVLEState *node)
 
 			/* in the case that minHops is 0 or 1 (starting point) */
 			if (!node->selfLoop && (node->curhops >= nlv->minHops))
+			{
+				countHopRow(node);
 				result = outerTupleSlot;
+			}
 
 			if (incrDepth(node))
 			{
@@ -148,6 +172,9 @@ ExecNestLoopVLE(NestLoopVLEState *node)
 
 				bindNestParam(nlv, econtext, outerTupleSlot, innerPlan);
 
+				if (timing)
+					INSTR_TIME_SET_CURRENT(starttime);
+
 				/*
 				 * now rescan the inner plan
 				 */
@@ -160,6 +187,12 @@ ExecNestLoopVLE(NestLoopVLEState *node)
 				node->nls.js.ps.state->es_forceReScan = true;
 				ExecReScan(innerPlan);
 				node->nls.js.ps.state->es_forceReScan = false;
+
+				node->vinstrument.nrescans++;
+				if (timing)
+					InstrAccumTime(&node->vinstrument.rescanTime, &starttime);
+
+				resetDegree(node);
 			}
 
 			if (result != NULL)
@@ -171,8 +204,29 @@ ExecNestLoopVLE(NestLoopVLEState *node)
 		 */
 		ENLV1_printf("getting new inner tuple");
 
+		if (timing)
+			INSTR_TIME_SET_CURRENT(starttime);
+
 		innerTupleSlot = ExecProcNode(innerPlan);
 
+		if (timing)
+			InstrAccumTime(&node->vinstrument.fetchTime, &starttime);
+
+		if (!TupIsNull(innerTupleSlot))
+		{
+			if (isDegreeCapped(node))
+			{
+				/*
+				 * The vertex has more edges than allowed; treat the rest of
+				 * them as exhausted.
+				 */
+				node->vinstrument.ncapped++;
+				innerTupleSlot = NULL;
+			}
+			else if (node->curhops < node->maxdegrees)
+				node->degrees[node->curhops]++;
+		}
+
 		if (TupIsNull(innerTupleSlot))
 		{
 			decrDepth(node);
@@ -186,7 +240,11 @@ ExecNestLoopVLE(NestLoopVLEState *node)
 			else
 			{
 				ENLV1_printf("no inner tuple, upscanning inner plan, looping");
+				if (timing)
+					INSTR_TIME_SET_CURRENT(starttime);
 				ExecUpScan(innerPlan);
+				if (timing)
+					InstrAccumTime(&node->vinstrument.rescanTime, &starttime);
 				econtext->ecxt_outertuple = restoreStartAndBindVar(node);
 				bindNestParam(nlv, econtext, econtext->ecxt_outertuple, NULL);
 			}
@@ -250,7 +308,10 @@ ExecNestLoopVLE(NestLoopVLEState *node)
 				}
 
 				if (node->curhops >= nlv->minHops)
+				{
+					countHopRow(node);
 					return result;
+				}
 			}
 			else
 			{
@@ -349,6 +410,14 @@ ExecInitNestLoopVLE(NestLoopVLE *node, EState *estate, int eflags)
 	nlvstate->selfLoop = false;
 	nlvstate->curhops = (node->minHops == 0) ? 0 : 1;
 
+	nlvstate->degrees = NULL;
+	nlvstate->maxdegrees = 0;
+	nlvstate->outerDegree = 0;
+
+	memset(&nlvstate->vinstrument, 0, sizeof(nlvstate->vinstrument));
+	nlvstate->shared_info = NULL;
+	nlvstate->worker_info = NULL;
+
 	innerTupleDesc =
 			innerPlanState(nlvstate)->ps_ResultTupleSlot->tts_tupleDescriptor;
 	initArray(&nlvstate->rowids,
@@ -449,6 +518,157 @@ ExecReScanNestLoopVLE(NestLoopVLEState *node)
 	clearArray(&node->rowids);
 	if (node->hasPath)
 		clearArray(&node->path);
+
+	node->outerDegree = 0;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecShutdownNestLoopVLE
+ *
+ *		Parallel workers report their statistics to the leader here.
+ * ----------------------------------------------------------------
+ */
+void
+ExecShutdownNestLoopVLE(NestLoopVLEState *node)
+{
+	if (node->shared_info != NULL && IsParallelWorker())
+	{
+		Assert(ParallelWorkerNumber < node->shared_info->num_workers);
+		ExecNestLoopVLEAccumInstrumentation(
+				&node->shared_info->vinstrument[ParallelWorkerNumber],
+				&node->vinstrument);
+		memset(&node->vinstrument, 0, sizeof(node->vinstrument));
+	}
+}
+
+/* ----------------------------------------------------------------
+ *		ExecNestLoopVLEEstimate
+ *
+ *		estimates the space required for the statistics of workers.
+ *		This is needed only if EXPLAIN ANALYZE is instrumenting the node.
+ * ----------------------------------------------------------------
+ */
+void
+ExecNestLoopVLEEstimate(NestLoopVLEState *node, ParallelContext *pcxt)
+{
+	Size		size;
+
+	if (node->nls.js.ps.instrument == NULL || pcxt->nworkers == 0)
+		return;
+
+	size = mul_size(pcxt->nworkers, sizeof(NestLoopVLEInstrumentation));
+	size = add_size(size, offsetof(SharedNestLoopVLEInfo, vinstrument));
+	shm_toc_estimate_chunk(&pcxt->estimator, size);
+	shm_toc_estimate_keys(&pcxt->estimator, 1);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecNestLoopVLEInitializeDSM
+ *
+ *		allocates zeroed slots for the statistics of workers.
+ * ----------------------------------------------------------------
+ */
+void
+ExecNestLoopVLEInitializeDSM(NestLoopVLEState *node, ParallelContext *pcxt)
+{
+	Size		size;
+
+	if (node->nls.js.ps.instrument == NULL || pcxt->nworkers == 0)
+		return;
+
+	size = offsetof(SharedNestLoopVLEInfo, vinstrument) +
+		pcxt->nworkers * sizeof(NestLoopVLEInstrumentation);
+	node->shared_info = shm_toc_allocate(pcxt->toc, size);
+	memset(node->shared_info, 0, size);
+	node->shared_info->num_workers = pcxt->nworkers;
+	shm_toc_insert(pcxt->toc, node->nls.js.ps.plan->plan_node_id,
+				   node->shared_info);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecNestLoopVLEReInitializeDSM
+ *
+ *		clears the statistics slots before the workers are relaunched,
+ *		as the statistics of the last run have already been retrieved.
+ * ----------------------------------------------------------------
+ */
+void
+ExecNestLoopVLEReInitializeDSM(NestLoopVLEState *node, ParallelContext *pcxt)
+{
+	if (node->shared_info == NULL)
+		return;
+
+	memset(node->shared_info->vinstrument, 0,
+		   node->shared_info->num_workers *
+		   sizeof(NestLoopVLEInstrumentation));
+}
+
+/* ----------------------------------------------------------------
+ *		ExecNestLoopVLEInitializeWorker
+ *
+ *		attaches to the statistics slots in shared memory, if any.
+ * ----------------------------------------------------------------
+ */
+void
+ExecNestLoopVLEInitializeWorker(NestLoopVLEState *node, shm_toc *toc)
+{
+	node->shared_info = shm_toc_lookup(toc,
+									   node->nls.js.ps.plan->plan_node_id);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecNestLoopVLERetrieveInstrumentation
+ *
+ *		adds the statistics of workers in shared memory to a local copy,
+ *		so that EXPLAIN can print them after the DSM segment is gone.
+ *		The copy sums up all the runs of the workers if Gather rescans.
+ * ----------------------------------------------------------------
+ */
+void
+ExecNestLoopVLERetrieveInstrumentation(NestLoopVLEState *node)
+{
+	SharedNestLoopVLEInfo *si = node->shared_info;
+	int			n;
+
+	if (si == NULL)
+		return;
+
+	if (node->worker_info == NULL)
+	{
+		Size		size;
+
+		size = offsetof(SharedNestLoopVLEInfo, vinstrument) +
+			si->num_workers * sizeof(NestLoopVLEInstrumentation);
+		node->worker_info =
+			MemoryContextAllocZero(node->nls.js.ps.state->es_query_cxt, size);
+		node->worker_info->num_workers = si->num_workers;
+	}
+
+	Assert(node->worker_info->num_workers == si->num_workers);
+	for (n = 0; n < si->num_workers; n++)
+		ExecNestLoopVLEAccumInstrumentation(&node->worker_info->vinstrument[n],
+											&si->vinstrument[n]);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecNestLoopVLEAccumInstrumentation
+ *
+ *		adds the statistics in src to dst.
+ * ----------------------------------------------------------------
+ */
+void
+ExecNestLoopVLEAccumInstrumentation(NestLoopVLEInstrumentation *dst,
+									NestLoopVLEInstrumentation *src)
+{
+	int			i;
+
+	for (i = 0; i <= VLE_INSTR_MAX_HOPS; i++)
+		dst->hopRows[i] += src->hopRows[i];
+	dst->nrescans += src->nrescans;
+	dst->ncapped += src->ncapped;
+	dst->maxDepth = Max(dst->maxDepth, src->maxDepth);
+	dst->rescanTime += src->rescanTime;
+	dst->fetchTime += src->fetchTime;
 }
 
 static bool
@@ -482,6 +702,94 @@ isMaxDepth(NestLoopVLEState *node)
 	return (node->curhops == nlv->maxHops);
 }
 
+/*
+ * Start counting the edges of the vertex being expanded at the current depth.
+ *
+ * The count of each depth survives while deeper levels are visited, so the
+ * expansion of a vertex can resume after upscanning. Nothing is counted if
+ * graph_traversal_max_degree is not set.
+ */
+static void
+resetDegree(NestLoopVLEState *node)
+{
+	int			depth = node->curhops;
+
+	if (graph_traversal_max_degree <= 0)
+		return;
+
+	if (depth >= node->maxdegrees)
+	{
+		int			newsize = Max(depth + 1, Max(node->maxdegrees * 2, 8));
+		MemoryContext oldctx;
+
+		oldctx = MemoryContextSwitchTo(node->nls.js.ps.state->es_query_cxt);
+		if (node->degrees == NULL)
+			node->degrees = palloc0(sizeof(int64) * newsize);
+		else
+		{
+			node->degrees = repalloc(node->degrees, sizeof(int64) * newsize);
+			memset(node->degrees + node->maxdegrees, 0,
+				   sizeof(int64) * (newsize - node->maxdegrees));
+		}
+		MemoryContextSwitchTo(oldctx);
+
+		node->maxdegrees = newsize;
+	}
+
+	node->degrees[depth] = 0;
+}
+
+/*
+ * Have we already fetched graph_traversal_max_degree edges of the vertex
+ * being expanded at the current depth?
+ */
+static bool
+isDegreeCapped(NestLoopVLEState *node)
+{
+	if (graph_traversal_max_degree <= 0 || node->degrees == NULL ||
+		node->curhops >= node->maxdegrees)
+		return false;
+
+	return (node->degrees[node->curhops] >= graph_traversal_max_degree);
+}
+
+/*
+ * Count an outer row against graph_traversal_max_degree, and tell whether it
+ * is past the cap and must be skipped.
+ *
+ * Unless minHops is 0, the outer rows are the first hop, so the cap applies
+ * to them too.  They are counted per start vertex while the rows of one
+ * vertex arrive together, as they do from the usual index scan on the start
+ * column; rows of a vertex that come back later start a new count.
+ */
+static bool
+isOuterDegreeCapped(NestLoopVLEState *node, TupleTableSlot *outerTupleSlot)
+{
+	NestLoopVLE *nlv = (NestLoopVLE *) node->nls.js.ps.plan;
+	Graphid		start;
+
+	if (graph_traversal_max_degree <= 0 || nlv->minHops == 0 ||
+		outerTupleSlot->tts_isnull[OUTER_START_VARNO])
+		return false;
+
+	start = DatumGetGraphid(outerTupleSlot->tts_values[OUTER_START_VARNO]);
+	if (node->outerDegree == 0 || start != node->outerStart)
+	{
+		node->outerStart = start;
+		node->outerDegree = 0;
+	}
+
+	node->outerDegree++;
+	if (node->outerDegree <= graph_traversal_max_degree)
+		return false;
+
+	/* count each vertex once, at its first edge past the cap */
+	if (node->outerDegree == (int64) graph_traversal_max_degree + 1)
+		node->vinstrument.ncapped++;
+
+	return true;
+}
+
 /*
  * fetch the values of any outer Vars that must be passed to the
  * inner scan, and store them in the appropriate PARAM_EXEC slots.
@@ -766,6 +1074,9 @@ addRowidAndGid(NestLoopVLEState *node, Datum rowid, Datum gid)
 	if (gid != (Datum) 0)
 		addElem(&node->path, datumCopy(gid, node->path.elembyval,
 									   node->path.elemlength));
+
+	if (node->rowids.nelems > node->vinstrument.maxDepth)
+		node->vinstrument.maxDepth = node->rowids.nelems;
 }
 
 static void
@@ -775,3 +1086,11 @@ popRowidAndGid(NestLoopVLEState *node)
 	if (node->hasPath)
 		popElem(&node->path);
 }
+
+static void
+countHopRow(NestLoopVLEState *node)
+{
+	int			hops = Min(node->curhops, VLE_INSTR_MAX_HOPS);
+
+	node->vinstrument.hopRows[hops]++;
+}
@@ -15,6 +15,7 @@
 /*
  * INTERFACE ROUTINES
  *		ExecSeqScan				sequentially scans a relation.
+ *		ExecSeqScanBatch		loads the next batch of tuples.
  *		ExecSeqNext				retrieve next tuple in sequential order.
  *		ExecInitSeqScan			creates and initializes a seqscan node.
  *		ExecEndSeqScan			releases any storage allocated.
@@ -28,6 +29,7 @@
 
 #include "access/relscan.h"
 #include "catalog/pg_operator.h"
+#include "executor/execBatch.h"
 #include "executor/execdebug.h"
 #include "executor/nodeSeqscan.h"
 #include "optimizer/clauses.h"
@@ -143,6 +145,88 @@ ExecSeqScan(SeqScanState *node)
 					(ExecScanRecheckMtd) SeqRecheck);
 }
 
+/* ----------------------------------------------------------------
+ *		ExecSeqScanBatch(node, batch)
+ *
+ *		Loads the next TUPLE_BATCH_SIZE tuples of the relation into the
+ *		columns of the batch and selects the ones that pass the quals.
+ *		ExecInitBatch() has checked that the quals can all be evaluated
+ *		by the batch kernels, and that the columns the parent reads need
+ *		no projection.
+ * ----------------------------------------------------------------
+ */
+void
+ExecSeqScanBatch(SeqScanState *node, TupleBatch *batch)
+{
+	HeapScanDesc scandesc;
+	EState	   *estate;
+	ScanDirection direction;
+	TupleTableSlot *slot;
+	int			nrows = 0;
+
+	batch->nrows = 0;
+	batch->nsel = 0;
+
+	if (node->ss.ss_skipLabelScan)
+	{
+		node->ss.ss_skipLabelScan = false;
+		batch->done = true;
+		return;
+	}
+
+	scandesc = node->ss.ss_currentScanDesc;
+	estate = node->ss.ps.state;
+	direction = estate->es_direction;
+	slot = node->ss.ss_ScanTupleSlot;
+
+	if (scandesc == NULL)
+	{
+		scandesc = heap_beginscan(node->ss.ss_currentRelation,
+								  estate->es_snapshot,
+								  0, NULL);
+		node->ss.ss_currentScanDesc = scandesc;
+	}
+
+	while (nrows < TUPLE_BATCH_SIZE)
+	{
+		HeapTuple	tuple;
+		int			col;
+
+		tuple = heap_getnext(scandesc, direction);
+		if (tuple == NULL)
+		{
+			/* don't call heap_getnext() again, it would restart the scan */
+			batch->done = true;
+			break;
+		}
+
+		/* count(*) alone needs no columns at all */
+		if (batch->ncols > 0)
+		{
+			ExecStoreTuple(tuple, slot, scandesc->rs_cbuf, false);
+			slot_getsomeattrs(slot, batch->maxattnum);
+
+			for (col = 0; col < batch->ncols; col++)
+			{
+				int			attno = batch->attnums[col] - 1;
+
+				batch->values[col][nrows] = slot->tts_values[attno];
+				batch->isnull[col][nrows] = slot->tts_isnull[attno];
+			}
+		}
+
+		nrows++;
+	}
+
+	/* release the pin of the last page; only by-value datums were kept */
+	ExecClearTuple(slot);
+
+	batch->nrows = nrows;
+	ExecBatchQual(batch);
+
+	InstrCountFiltered1(node, batch->nrows - batch->nsel);
+}
+
 /* ----------------------------------------------------------------
  *		InitScanRelation
  *
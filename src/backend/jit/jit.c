@@ -0,0 +1,179 @@
+/*-------------------------------------------------------------------------
+ *
+ * jit.c
+ *	  Provider independent JIT infrastructure.
+ *
+ * Code related to loading JIT providers, redirecting calls into JIT providers
+ * and error handling.  No code specific to a specific JIT implementation
+ * should end up here, so that the core server never depends on a JIT
+ * library such as LLVM.  A provider is a shared library in $libdir, named
+ * by jit_provider, that exports _PG_jit_provider_init().
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ *
+ *
+ * IDENTIFICATION
+ *	  src/backend/jit/jit.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "executor/execProgram.h"
+#include "fmgr.h"
+#include "jit/jit.h"
+#include "miscadmin.h"
+
+
+/* GUCs */
+bool		jit_enabled = false;
+char	   *jit_provider = NULL;
+double		jit_above_cost = 100000;
+double		jit_optimize_above_cost = 500000;
+bool		jit_expressions = true;
+bool		jit_tuple_deforming = true;
+
+static JitProviderCallbacks provider;
+static bool provider_successfully_loaded = false;
+static bool provider_failed_loading = false;
+
+
+static bool provider_init(void);
+static bool file_exists(const char *name);
+
+
+/*
+ * Return true if a JIT provider has successfully been loaded, false
+ * otherwise.  Only the first call actually tries to load it.
+ */
+static bool
+provider_init(void)
+{
+	char		path[MAXPGPATH];
+	JitProviderInit init;
+
+	/* don't even try to load if not enabled */
+	if (!jit_enabled)
+		return false;
+
+	/*
+	 * Don't retry loading after failing - attempting to load JIT provider
+	 * isn't cheap.
+	 */
+	if (provider_failed_loading)
+		return false;
+	if (provider_successfully_loaded)
+		return true;
+
+	/*
+	 * Check whether the shared library exists.  We do that check before
+	 * actually attempting to load the shared library (via load_external_function()),
+	 * because that'd error out in case the shlib isn't available.
+	 */
+	snprintf(path, MAXPGPATH, "%s/%s%s", pkglib_path, jit_provider, DLSUFFIX);
+	elog(DEBUG1, "probing availability of JIT provider at %s", path);
+	if (!file_exists(path))
+	{
+		elog(DEBUG1,
+			 "provider not available, disabling JIT for current session");
+		provider_failed_loading = true;
+		return false;
+	}
+
+	/*
+	 * If loading functions fails, signal failure.  We do so because
+	 * load_external_function() might error out despite the above check if
+	 * e.g. the library's dependencies aren't installed.  We want to signal
+	 * ERROR in that case, so the user is notified, but we don't want to
+	 * continually retry.
+	 */
+	provider_failed_loading = true;
+
+	/* and initialize */
+	init = (JitProviderInit)
+		load_external_function(path, "_PG_jit_provider_init", true, NULL);
+	init(&provider);
+
+	provider_successfully_loaded = true;
+	provider_failed_loading = false;
+
+	elog(DEBUG1, "successfully loaded JIT provider in current session");
+
+	return true;
+}
+
+/*
+ * Decide which JIT operations are worthwhile for a plan, based on its
+ * estimated total cost.  Returns a mask of PGJIT_* flags.
+ */
+int
+jit_flags_for_plan(PlannedStmt *stmt)
+{
+	int			flags = PGJIT_NONE;
+
+	if (!jit_enabled || jit_above_cost < 0 || stmt->planTree == NULL)
+		return PGJIT_NONE;
+
+	if (stmt->planTree->total_cost <= jit_above_cost)
+		return PGJIT_NONE;
+
+	flags |= PGJIT_PERFORM;
+	if (jit_optimize_above_cost >= 0 &&
+		stmt->planTree->total_cost > jit_optimize_above_cost)
+		flags |= PGJIT_OPT3;
+	if (jit_expressions)
+		flags |= PGJIT_EXPR;
+	if (jit_tuple_deforming)
+		flags |= PGJIT_DEFORM;
+
+	return flags;
+}
+
+/*
+ * Ask the provider to JIT compile an expression program.
+ *
+ * Returns true if successful, false if not.  On success the provider has
+ * replaced program->evalfunc.
+ */
+bool
+jit_compile_expr(ExprProgram *program, EState *estate)
+{
+	/* standalone expression contexts have no EState */
+	if (estate == NULL)
+		return false;
+
+	/* if no jitting should be performed at all */
+	if (!(estate->es_jit_flags & PGJIT_PERFORM))
+		return false;
+
+	/* or if expressions aren't JITed */
+	if (!(estate->es_jit_flags & PGJIT_EXPR))
+		return false;
+
+	/* this also takes !jit_enabled into account */
+	if (provider_init())
+		return provider.compile_expr(program, estate);
+
+	return false;
+}
+
+static bool
+file_exists(const char *name)
+{
+	struct stat st;
+
+	AssertArg(name != NULL);
+
+	if (stat(name, &st) == 0)
+		return S_ISDIR(st.st_mode) ? false : true;
+	else if (!(errno == ENOENT || errno == ENOTDIR))
+		ereport(ERROR,
+				(errcode_for_file_access(),
+				 errmsg("could not access file \"%s\": %m", name)));
+
+	return false;
+}
@@ -603,7 +603,7 @@ try_hashjoin_path(PlannerInfo *root,
 	 */
 	initial_cost_hashjoin(root, &workspace, jointype, hashclauses,
 						  outer_path, inner_path,
-						  extra->sjinfo, &extra->semifactors);
+						  extra->sjinfo, &extra->semifactors, false);
 
 	if (add_path_precheck(joinrel,
 						  workspace.startup_cost, workspace.total_cost,
@@ -620,7 +620,8 @@ try_hashjoin_path(PlannerInfo *root,
 									  inner_path,
 									  extra->restrictlist,
 									  required_outer,
-									  hashclauses));
+									  hashclauses,
+									  false));
 	}
 	else
 	{
@@ -633,6 +634,10 @@ try_hashjoin_path(PlannerInfo *root,
  * try_partial_hashjoin_path
  *	  Consider a partial hashjoin join path; if it appears useful, push it into
  *	  the joinrel's partial_pathlist via add_partial_path().
+ *
+ * If parallel_hash is true, inner_path is partial too, and the participants
+ * are to build a single hash table together out of it.  We only do that if
+ * the whole table fits in memory.
  */
 static void
 try_partial_hashjoin_path(PlannerInfo *root,
@@ -641,7 +646,8 @@ try_partial_hashjoin_path(PlannerInfo *root,
 						  Path *inner_path,
 						  List *hashclauses,
 						  JoinType jointype,
-						  JoinPathExtraData *extra)
+						  JoinPathExtraData *extra,
+						  bool parallel_hash)
 {
 	JoinCostWorkspace workspace;
 
@@ -666,7 +672,9 @@ try_partial_hashjoin_path(PlannerInfo *root,
 	 */
 	initial_cost_hashjoin(root, &workspace, jointype, hashclauses,
 						  outer_path, inner_path,
-						  extra->sjinfo, &extra->semifactors);
+						  extra->sjinfo, &extra->semifactors, parallel_hash);
+	if (parallel_hash && workspace.numbatches > 1)
+		return;
 	if (!add_partial_path_precheck(joinrel, workspace.total_cost, NIL))
 		return;
 
@@ -682,7 +690,8 @@ try_partial_hashjoin_path(PlannerInfo *root,
 										  inner_path,
 										  extra->restrictlist,
 										  NULL,
-										  hashclauses));
+										  hashclauses,
+										  parallel_hash));
 }
 
 /*
@@ -1642,7 +1651,22 @@ hash_inner_and_outer(PlannerInfo *root,
 				try_partial_hashjoin_path(root, joinrel,
 										  cheapest_partial_outer,
 										  cheapest_safe_inner,
-										  hashclauses, jointype, extra);
+										  hashclauses, jointype, extra,
+										  false);
+
+			/*
+			 * Also consider splitting the scan of the inner relation among
+			 * the participants, which then share a single hash table,
+			 * instead of having each one of them hash the whole relation.
+			 */
+			if (enable_parallel_hash &&
+				save_jointype != JOIN_UNIQUE_INNER &&
+				innerrel->partial_pathlist != NIL)
+				try_partial_hashjoin_path(root, joinrel,
+										  cheapest_partial_outer,
+								  (Path *) linitial(innerrel->partial_pathlist),
+										  hashclauses, jointype, extra,
+										  true);
 		}
 	}
 }
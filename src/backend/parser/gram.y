@@ -668,7 +668,7 @@ static List *preserve_downcasing_type_func_namelist(List *namelist);
 	CACHE CALLED CASCADE CASCADED CASE CAST CATALOG_P CHAIN CHAR_P
 	CHARACTER CHARACTERISTICS CHECK CHECKPOINT CLASS CLOSE
 	CLUSTER COALESCE COLLATE COLLATION COLUMN COMMENT COMMENTS COMMIT
-	COMMITTED CONCURRENTLY CONFIGURATION CONFLICT CONNECTION CONSTRAINT
+	COMMITTED COMPRESSION CONCURRENTLY CONFIGURATION CONFLICT CONNECTION CONSTRAINT
 	CONSTRAINTS CONTENT_P CONTINUE_P CONVERSION_P COPY COST CREATE
 	CROSS CSV CUBE CURRENT_P
 	CURRENT_CATALOG CURRENT_DATE CURRENT_ROLE CURRENT_SCHEMA
@@ -14029,6 +14029,7 @@ unreserved_keyword:
 			| COMMENTS
 			| COMMIT
 			| COMMITTED
+			| COMPRESSION
 			| CONFIGURATION
 			| CONFLICT
 			| CONNECTION
@@ -14622,6 +14623,16 @@ alter_label_cmd:
 					n->def = (Node *) makeString($3);
 					$$ = (Node *)n;
 				}
+			/* ALTER VLABEL <name> SET COMPRESSION <method> */
+			| SET COMPRESSION ColId
+				{
+					AlterTableCmd *n = makeNode(AlterTableCmd);
+					n->subtype = AT_SetOptions;
+					n->name = NULL;
+					n->def = (Node *) list_make1(makeDefElem("compression",
+												(Node *) makeString($3)));
+					$$ = (Node *)n;
+				}
 			/* ALTER VLABEL <name> OWNER TO RoleSpec */
 			| OWNER TO RoleSpec
 				{
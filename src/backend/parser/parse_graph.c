@@ -15,7 +15,6 @@
 #include "access/sysattr.h"
 #include "catalog/ag_graph_fn.h"
 #include "catalog/ag_label.h"
-#include "catalog/pg_am.h"
 #include "catalog/pg_class.h"
 #include "catalog/pg_collation.h"
 #include "catalog/pg_inherits_fn.h"
@@ -194,9 +193,10 @@ static Node *transformElemQuals(ParseState *pstate, Node *qual);
 static Node *transform_prop_constr(ParseState *pstate, Node *qual,
 								   Node *prop_map, Node *prop_constr);
 static void transform_prop_constr_worker(Node *node, prop_constr_context *ctx);
-static bool ginAvail(ParseState *pstate, Index varno, AttrNumber varattno);
+static bool containsIndexAvail(ParseState *pstate, Index varno,
+				   AttrNumber varattno);
 static Oid getSourceRelid(ParseState *pstate, Index varno, AttrNumber varattno);
-static bool hasGinOnProp(Oid relid);
+static bool hasContainsIndexOnProp(Oid relid);
 /* MATCH - future vertex */
 static void addFutureVertex(ParseState *pstate, AttrNumber varattno,
 							char *labname);
@@ -2924,7 +2924,8 @@ transformElemQuals(ParseState *pstate, Node *qual)
 			qual = transform_prop_constr(pstate, qual, prop_map,
 										 eq->prop_constr);
 
-		if ((is_cyphermap && ginAvail(pstate, eq->varno, eq->varattno)) ||
+		if ((is_cyphermap &&
+			 containsIndexAvail(pstate, eq->varno, eq->varattno)) ||
 			!is_cyphermap)
 		{
 			Node	   *prop_constr;
@@ -3028,8 +3029,14 @@ transform_prop_constr_worker(Node *node, prop_constr_context *ctx)
 	}
 }
 
+/*
+ * Returns true if the property map of the source relation (or any of its
+ * children) has an index that can answer `@>`.  Such an index is typically a
+ * GIN index with jsonb_ops or jsonb_path_ops, or a bloom index with
+ * jsonb_bloom_ops which is cheaper to maintain when many keys are compared.
+ */
 static bool
-ginAvail(ParseState *pstate, Index varno, AttrNumber varattno)
+containsIndexAvail(ParseState *pstate, Index varno, AttrNumber varattno)
 {
 	Oid			relid;
 	List	   *inhoids;
@@ -3040,14 +3047,14 @@ ginAvail(ParseState *pstate, Index varno, AttrNumber varattno)
 		return false;
 
 	if (!has_subclass(relid))
-		return hasGinOnProp(relid);
+		return hasContainsIndexOnProp(relid);
 
 	inhoids = find_all_inheritors(relid, AccessShareLock, NULL);
 	foreach(li, inhoids)
 	{
 		Oid inhoid = lfirst_oid(li);
 
-		if (hasGinOnProp(inhoid))
+		if (hasContainsIndexOnProp(inhoid))
 			return true;
 	}
 
@@ -3135,7 +3142,7 @@ getSourceRelid(ParseState *pstate, Index varno, AttrNumber varattno)
 
 /* See get_relation_info() */
 static bool
-hasGinOnProp(Oid relid)
+hasContainsIndexOnProp(Oid relid)
 {
 	Relation	rel;
 	List	   *indexoidlist;
@@ -3178,12 +3185,6 @@ hasGinOnProp(Oid relid)
 			continue;
 		}
 
-		if (indexRel->rd_rel->relam != GIN_AM_OID)
-		{
-			index_close(indexRel, NoLock);
-			continue;
-		}
-
 		attnum = attnameAttNum(rel, AG_ELEM_PROP_MAP, false);
 		if (attnum == InvalidAttrNumber)
 		{
@@ -3191,7 +3192,9 @@ hasGinOnProp(Oid relid)
 			continue;
 		}
 
-		if (index->indkey.values[0] == attnum)
+		/* the opclass of the first key decides whether `@>` can be used */
+		if (index->indkey.values[0] == attnum &&
+			op_in_opfamily(OID_JSONB_CONTAINS_OP, indexRel->rd_opfamily[0]))
 		{
 			index_close(indexRel, NoLock);
 			ret = true;
@@ -3596,9 +3596,10 @@ transformAlterLabelStmt(AlterTableStmt *stmt)
 		switch (cmd->subtype)
 		{
 			case AT_SetStorage:
+			case AT_SetOptions:
 				{
-					/* storage option is meaningless for graph id
-					 * so forced to graph property */
+					/* storage and compression options are meaningless for
+					 * graph id so forced to graph property */
 					cmd->name = AG_ELEM_PROP_MAP;
 
 					newcmds = lappend(newcmds, cmd);
@@ -30,6 +30,10 @@
 #ifdef HAVE_SYS_SHM_H
 #include <sys/shm.h>
 #endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#endif
 
 #include "miscadmin.h"
 #include "portability/mem.h"
@@ -77,6 +81,7 @@ void	   *UsedShmemSegAddr = NULL;
 #ifdef USE_ANONYMOUS_SHMEM
 static Size AnonymousShmemSize;
 static void *AnonymousShmem = NULL;
+static Size AnonymousShmemPageSize = 0;	/* huge page size, if used */
 #endif
 
 static void *InternalIpcMemoryCreate(IpcMemoryKey memKey, Size size);
@@ -461,6 +466,8 @@ CreateAnonymousSegment(Size *size)
 		if (huge_pages == HUGE_PAGES_TRY && ptr == MAP_FAILED)
 			elog(DEBUG1, "mmap(%zu) with MAP_HUGETLB failed, huge pages disabled: %m",
 				 allocsize);
+		if (ptr != MAP_FAILED)
+			AnonymousShmemPageSize = hugepagesize;
 	}
 #endif
 
@@ -817,3 +824,71 @@ PGSharedMemoryAttach(IpcMemoryKey key, IpcMemoryId *shmid)
 
 	return hdr;
 }
+
+/*
+ * PGSharedMemoryBindToNode
+ *
+ * Ask the kernel to back the given part of the main shared memory segment
+ * with memory of the given NUMA node.  Only whole pages within the range are
+ * affected; they are huge pages if the segment got them.  The pages at the
+ * edges are left to the default policy, which places a page on the node of
+ * the process that touches it first.
+ *
+ * This must be done before the memory is first touched.  Returns false if
+ * it's not supported on this platform, or if the kernel refuses, e.g.
+ * because there is no such node.  It's only an optimization, so callers can
+ * just carry on.
+ */
+bool
+PGSharedMemoryBindToNode(void *addr, Size size, int node)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+	unsigned long nodemask;
+	Size		pagesize;
+	uintptr_t	start;
+	uintptr_t	end;
+
+	if (node < 0 || node >= sizeof(nodemask) * BITS_PER_BYTE)
+		return false;
+
+	pagesize = AnonymousShmemPageSize;
+	if (pagesize == 0)
+		pagesize = sysconf(_SC_PAGESIZE);
+
+	start = TYPEALIGN(pagesize, addr);
+	end = TYPEALIGN_DOWN(pagesize, (uintptr_t) addr + size);
+	if (start >= end)
+		return true;
+
+	nodemask = 1UL << node;
+	if (syscall(SYS_mbind, (void *) start, (unsigned long) (end - start),
+				MPOL_PREFERRED, &nodemask,
+				(unsigned long) (sizeof(nodemask) * BITS_PER_BYTE), 0) != 0)
+		return false;
+
+	return true;
+#else
+	errno = ENOSYS;
+	return false;
+#endif
+}
+
+/*
+ * PGSharedMemoryCurrentNode
+ *
+ * Return the NUMA node of the CPU we're running on, or -1 if unknown.  The
+ * scheduler may move us to another node at any time, so this is just a hint
+ * about which part of shared memory is cheapest to use.
+ */
+int
+PGSharedMemoryCurrentNode(void)
+{
+#if defined(__linux__) && defined(SYS_getcpu)
+	unsigned	cpu;
+	unsigned	node;
+
+	if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0)
+		return (int) node;
+#endif
+	return -1;
+}
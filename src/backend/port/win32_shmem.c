@@ -431,3 +431,26 @@ pgwin32_ReserveSharedMemoryRegion(HANDLE hChild)
 
 	return true;
 }
+
+/*
+ * PGSharedMemoryBindToNode
+ *
+ * Placing shared memory on NUMA nodes isn't supported on Windows.
+ */
+bool
+PGSharedMemoryBindToNode(void *addr, Size size, int node)
+{
+	errno = ENOSYS;
+	return false;
+}
+
+/*
+ * PGSharedMemoryCurrentNode
+ *
+ * The NUMA node we're running on is unknown on Windows.
+ */
+int
+PGSharedMemoryCurrentNode(void)
+{
+	return -1;
+}
@@ -16,6 +16,7 @@
 
 #include "storage/bufmgr.h"
 #include "storage/buf_internals.h"
+#include "storage/pg_shmem.h"
 
 
 BufferDescPadded *BufferDescriptors;
@@ -60,6 +61,9 @@ CkptSortItem *CkptBufferIds;
  */
 
 
+static void BindBuffersToNodes(void);
+
+
 /*
  * Initialize shared buffer pool
  *
@@ -124,6 +128,13 @@ InitBufferPool(void)
 	{
 		int			i;
 
+		/*
+		 * Ask for each node's buffers to be placed in its own memory.  This
+		 * has to happen before anything touches them.
+		 */
+		if (numa_nodes > 1)
+			BindBuffersToNodes();
+
 		/*
 		 * Initialize all the buffer headers.
 		 */
@@ -163,6 +174,35 @@ InitBufferPool(void)
 						 &backend_flush_after);
 }
 
+/*
+ * BindBuffersToNodes
+ *
+ * Place the buffers and buffer descriptors of each NUMA node's range in
+ * memory of that node, as far as the kernel lets us.
+ */
+static void
+BindBuffersToNodes(void)
+{
+	int			node;
+
+	for (node = 0; node < numa_nodes; node++)
+	{
+		int			first = GetNodeFirstBuffer(node);
+		int			nbuffers = GetNodeFirstBuffer(node + 1) - first;
+
+		if (!PGSharedMemoryBindToNode(BufferBlocks + first * (Size) BLCKSZ,
+									  nbuffers * (Size) BLCKSZ, node) ||
+			!PGSharedMemoryBindToNode(GetBufferDescriptor(first),
+								 nbuffers * sizeof(BufferDescPadded), node))
+		{
+			ereport(LOG,
+				(errmsg("could not place shared buffers on NUMA node %d: %m",
+						node)));
+			break;
+		}
+	}
+}
+
 /*
  * BufferShmemSize
  *
@@ -9,6 +9,9 @@
  * in most cases the caller needs to adjust the buffer header contents
  * before the lock is released (see notes in README).
  *
+ * The exception is the lookup hint array, which can be read without any lock
+ * (see BufTableLookupHint).
+ *
  *
  * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
  * Portions Copyright (c) 1994, Regents of the University of California
@@ -34,6 +37,18 @@ typedef struct
 
 static HTAB *SharedBufHash;
 
+/*
+ * Lookup hints: for each slot, the ID plus one of the buffer most recently
+ * entered into or found in the hashtable with a hash code mapping to that
+ * slot, or zero.  Hints are only suggestions, so they are read and written
+ * without locking, and never cleared.
+ */
+static pg_atomic_uint32 *BufHints;
+static int	NumBufHints;
+
+/* number of lookup hint slots per hashtable entry */
+#define BUF_HINTS_PER_ENTRY		2
+
 
 /*
  * Estimate space needed for mapping hashtable
@@ -42,7 +57,12 @@ static HTAB *SharedBufHash;
 Size
 BufTableShmemSize(int size)
 {
-	return hash_estimate_size(size, sizeof(BufferLookupEnt));
+	Size		sz;
+
+	sz = hash_estimate_size(size, sizeof(BufferLookupEnt));
+	sz = add_size(sz, mul_size(mul_size(size, BUF_HINTS_PER_ENTRY),
+							   sizeof(pg_atomic_uint32)));
+	return sz;
 }
 
 /*
@@ -53,6 +73,7 @@ void
 InitBufTable(int size)
 {
 	HASHCTL		info;
+	bool		found;
 
 	/* assume no locking is needed yet */
 
@@ -65,6 +86,19 @@ InitBufTable(int size)
 								  size, size,
 								  &info,
 								  HASH_ELEM | HASH_BLOBS | HASH_PARTITION);
+
+	NumBufHints = size * BUF_HINTS_PER_ENTRY;
+	BufHints = (pg_atomic_uint32 *)
+		ShmemInitStruct("Shared Buffer Lookup Hints",
+						NumBufHints * sizeof(pg_atomic_uint32),
+						&found);
+	if (!found)
+	{
+		int			i;
+
+		for (i = 0; i < NumBufHints; i++)
+			pg_atomic_init_u32(&BufHints[i], 0);
+	}
 }
 
 /*
@@ -103,9 +137,25 @@ BufTableLookup(BufferTag *tagPtr, uint32 hashcode)
 	if (!result)
 		return -1;
 
+	BufTableSetHint(hashcode, result->id);
+
 	return result->id;
 }
 
+/*
+ * BufTableLookupHint
+ *		Return the ID of a buffer that may hold the page with the given hash
+ *		code, or -1
+ *
+ * No lock is needed.  The buffer may hold any page, or none; the caller must
+ * pin it and then check its tag.
+ */
+int
+BufTableLookupHint(uint32 hashcode)
+{
+	return (int) pg_atomic_read_u32(&BufHints[hashcode % NumBufHints]) - 1;
+}
+
 /*
  * BufTableInsert
  *		Insert a hashtable entry for given tag and buffer ID,
@@ -137,9 +187,27 @@ BufTableInsert(BufferTag *tagPtr, uint32 hashcode, int buf_id)
 
 	result->id = buf_id;
 
+	BufTableSetHint(hashcode, buf_id);
+
 	return -1;
 }
 
+/*
+ * BufTableSetHint
+ *		Make buf_id the lookup hint for the given hash code
+ *
+ * The hint is only stored if it changes, to avoid dirtying a cache line that
+ * other backends are reading.
+ */
+void
+BufTableSetHint(uint32 hashcode, int buf_id)
+{
+	pg_atomic_uint32 *hint = &BufHints[hashcode % NumBufHints];
+
+	if (pg_atomic_read_u32(hint) != (uint32) buf_id + 1)
+		pg_atomic_write_u32(hint, (uint32) buf_id + 1);
+}
+
 /*
  * BufTableDelete
  *		Delete the hashtable entry for given tag (which must exist)
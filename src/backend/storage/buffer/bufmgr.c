@@ -48,6 +48,7 @@
 #include "storage/proc.h"
 #include "storage/smgr.h"
 #include "storage/standby.h"
+#include "utils/memutils.h"
 #include "utils/rel.h"
 #include "utils/resowner_private.h"
 #include "utils/timestamp.h"
@@ -104,6 +105,24 @@ typedef struct CkptTsStatus
 	int			index;
 } CkptTsStatus;
 
+/*
+ * Information saved between calls of BgBufferSyncNode for one node, so we can
+ * determine the strategy point's advance rate and avoid scanning
+ * already-cleaned buffers.
+ */
+typedef struct BgBufferSyncState
+{
+	bool		saved_info_valid;
+	int			prev_strategy_buf_id;
+	uint32		prev_strategy_passes;
+	int			next_to_clean;
+	uint32		next_passes;
+
+	/* Moving averages of allocation rate and clean-buffer density */
+	float		smoothed_alloc;
+	float		smoothed_density;
+} BgBufferSyncState;
+
 /* GUC variables */
 bool		zero_damaged_pages = false;
 int			bgwriter_lru_maxpages = 100;
@@ -432,10 +451,14 @@ static Buffer ReadBuffer_common(SMgrRelation reln, char relpersistence,
 				  ForkNumber forkNum, BlockNumber blockNum,
 				  ReadBufferMode mode, BufferAccessStrategy strategy,
 				  bool *hit);
+static bool PrefetchSharedBuffer(SMgrRelation smgr_reln, ForkNumber forkNum,
+					 BlockNumber blockNum);
 static bool PinBuffer(BufferDesc *buf, BufferAccessStrategy strategy);
 static void PinBuffer_Locked(BufferDesc *buf);
 static void UnpinBuffer(BufferDesc *buf, bool fixOwner);
 static void BufferSync(int flags);
+static bool BgBufferSyncNode(BgBufferSyncState *state, int nodeno,
+				 int maxpages, WritebackContext *wb_context);
 static uint32 WaitBufHdrUnlocked(BufferDesc *buf);
 static int	SyncOneBuffer(int buf_id, bool skip_recently_used, WritebackContext *flush_context);
 static void WaitIO(BufferDesc *buf);
@@ -450,6 +473,8 @@ static BufferDesc *BufferAlloc(SMgrRelation smgr,
 			BlockNumber blockNum,
 			BufferAccessStrategy strategy,
 			bool *foundPtr);
+static BufferDesc *BufferLookupNoLock(BufferTag *tag, uint32 hashcode,
+				   BufferAccessStrategy strategy, bool *valid);
 static void FlushBuffer(BufferDesc *buf, SMgrRelation reln);
 static void AtProcExit_Buffers(int code, Datum arg);
 static void CheckForBufferLeaks(void);
@@ -547,41 +572,127 @@ PrefetchBuffer(Relation reln, ForkNumber forkNum, BlockNumber blockNum)
 		LocalPrefetchBuffer(reln->rd_smgr, forkNum, blockNum);
 	}
 	else
+		(void) PrefetchSharedBuffer(reln->rd_smgr, forkNum, blockNum);
+#endif   /* USE_PREFETCH */
+}
+
+/*
+ * PrefetchBufferWithoutRelcache -- like PrefetchBuffer, for WAL replay
+ *
+ * The block need not exist: the recovery prefetcher can ask for blocks of
+ * relations that are only created or extended later in the WAL.
+ *
+ * Returns true if a read was initiated, false if the block is in shared
+ * buffers already.
+ */
+bool
+PrefetchBufferWithoutRelcache(RelFileNode rnode, ForkNumber forkNum,
+							  BlockNumber blockNum)
+{
+	SMgrRelation smgr = smgropen(rnode, InvalidBackendId);
+
+	Assert(BlockNumberIsValid(blockNum));
+
+	return PrefetchSharedBuffer(smgr, forkNum, blockNum);
+}
+
+/*
+ * PrefetchSharedBuffer -- initiate a read of a shared buffer's block, unless
+ * it's in the buffer pool already.  Returns true if a read was initiated.
+ */
+static bool
+PrefetchSharedBuffer(SMgrRelation smgr_reln, ForkNumber forkNum,
+					 BlockNumber blockNum)
+{
+	BufferTag	newTag;			/* identity of requested block */
+	uint32		newHash;		/* hash value for newTag */
+	LWLock	   *newPartitionLock;		/* buffer partition lock for it */
+	int			buf_id;
+
+	/* create a tag so we can lookup the buffer */
+	INIT_BUFFERTAG(newTag, smgr_reln->smgr_rnode.node, forkNum, blockNum);
+
+	/* determine its hash code and partition lock ID */
+	newHash = BufTableHashCode(&newTag);
+	newPartitionLock = BufMappingPartitionLock(newHash);
+
+	/* see if the block is in the buffer pool already */
+	LWLockAcquire(newPartitionLock, LW_SHARED);
+	buf_id = BufTableLookup(&newTag, newHash);
+	LWLockRelease(newPartitionLock);
+
+	/*
+	 * If the block *is* in buffers, we do nothing.  This is not really ideal:
+	 * the block might be just about to be evicted, which would be stupid
+	 * since we know we are going to need it soon.  But the only easy answer
+	 * is to bump the usage_count, which does not seem like a great solution:
+	 * when the caller does ultimately touch the block, usage_count would get
+	 * bumped again, resulting in too much favoritism for blocks that are
+	 * involved in a prefetch sequence. A real fix would involve some
+	 * additional per-buffer state, and it's not clear that there's enough of
+	 * a problem to justify that.
+	 */
+	if (buf_id >= 0)
+		return false;
+
+	/* If not in buffers, initiate prefetch */
+#ifdef USE_PREFETCH
+	smgrprefetch(smgr_reln, forkNum, blockNum);
+#endif
+	return true;
+}
+
+/*
+ * PrefetchBufferTids -- initiate asynchronous reads of the blocks a batch
+ *		of TIDs point to
+ *
+ * The TIDs are taken in the order given, which should be the order the
+ * caller is going to fetch them in, until max_blocks distinct blocks have
+ * been prefetched.  A block that appears among the last few blocks
+ * prefetched is not prefetched again, which takes care of runs of TIDs on
+ * the same block.  Returns the number of TIDs covered; when the caller wants
+ * to stay further ahead, it should continue with the next one.
+ *
+ * Covers all the TIDs without doing anything if prefetching isn't compiled
+ * in.
+ */
+int
+PrefetchBufferTids(Relation reln, ItemPointer tids, int ntids, int max_blocks)
+{
+#ifdef USE_PREFETCH
+#define PREFETCH_RECENT_BLOCKS	8
+	BlockNumber recent[PREFETCH_RECENT_BLOCKS];
+	int			nblocks = 0;
+	int			i;
+
+	for (i = 0; i < ntids; i++)
 	{
-		BufferTag	newTag;		/* identity of requested block */
-		uint32		newHash;	/* hash value for newTag */
-		LWLock	   *newPartitionLock;	/* buffer partition lock for it */
-		int			buf_id;
-
-		/* create a tag so we can lookup the buffer */
-		INIT_BUFFERTAG(newTag, reln->rd_smgr->smgr_rnode.node,
-					   forkNum, blockNum);
-
-		/* determine its hash code and partition lock ID */
-		newHash = BufTableHashCode(&newTag);
-		newPartitionLock = BufMappingPartitionLock(newHash);
-
-		/* see if the block is in the buffer pool already */
-		LWLockAcquire(newPartitionLock, LW_SHARED);
-		buf_id = BufTableLookup(&newTag, newHash);
-		LWLockRelease(newPartitionLock);
+		BlockNumber blkno = ItemPointerGetBlockNumber(&tids[i]);
+		bool		seen = false;
+		int			j;
 
-		/* If not in buffers, initiate prefetch */
-		if (buf_id < 0)
-			smgrprefetch(reln->rd_smgr, forkNum, blockNum);
+		for (j = 0; j < Min(nblocks, PREFETCH_RECENT_BLOCKS); j++)
+		{
+			if (recent[j] == blkno)
+			{
+				seen = true;
+				break;
+			}
+		}
+		if (seen)
+			continue;
 
-		/*
-		 * If the block *is* in buffers, we do nothing.  This is not really
-		 * ideal: the block might be just about to be evicted, which would be
-		 * stupid since we know we are going to need it soon.  But the only
-		 * easy answer is to bump the usage_count, which does not seem like a
-		 * great solution: when the caller does ultimately touch the block,
-		 * usage_count would get bumped again, resulting in too much
-		 * favoritism for blocks that are involved in a prefetch sequence. A
-		 * real fix would involve some additional per-buffer state, and it's
-		 * not clear that there's enough of a problem to justify that.
-		 */
+		if (nblocks >= max_blocks)
+			break;
+
+		PrefetchBuffer(reln, MAIN_FORKNUM, blkno);
+		recent[nblocks % PREFETCH_RECENT_BLOCKS] = blkno;
+		nblocks++;
 	}
+
+	return i;
+#else
+	return ntids;
 #endif   /* USE_PREFETCH */
 }
 
@@ -1008,7 +1119,24 @@ BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 	newHash = BufTableHashCode(&newTag);
 	newPartitionLock = BufMappingPartitionLock(newHash);
 
-	/* see if the block is in the buffer pool already */
+	/*
+	 * See if the block is in the buffer pool already.  Most of the time the
+	 * lookup hints find it without taking the mapping lock.
+	 */
+	buf = BufferLookupNoLock(&newTag, newHash, strategy, &valid);
+	if (buf != NULL)
+	{
+		*foundPtr = TRUE;
+		StrategyCountHit(buf);
+
+		/* see comments in the found case below */
+		if (!valid && StartBufferIO(buf, true))
+			*foundPtr = FALSE;
+
+		return buf;
+	}
+
+	/* no luck, search the mapping table */
 	LWLockAcquire(newPartitionLock, LW_SHARED);
 	buf_id = BufTableLookup(&newTag, newHash);
 	if (buf_id >= 0)
@@ -1026,6 +1154,7 @@ BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 		LWLockRelease(newPartitionLock);
 
 		*foundPtr = TRUE;
+		StrategyCountHit(buf);
 
 		if (!valid)
 		{
@@ -1238,6 +1367,7 @@ BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 			LWLockRelease(newPartitionLock);
 
 			*foundPtr = TRUE;
+			StrategyCountHit(buf);
 
 			if (!valid)
 			{
@@ -1291,8 +1421,10 @@ BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 	 * Clearing BM_VALID here is necessary, clearing the dirtybits is just
 	 * paranoia.  We also reset the usage_count since any recency of use of
 	 * the old content is no longer relevant.  (The usage_count starts out at
-	 * 1 so that the buffer can survive one clock-sweep pass.)
+	 * 1 so that the buffer can survive one clock-sweep pass.)  The
+	 * replacement strategy gets to look at the old tag first.
 	 */
+	StrategyAdmitBuffer(buf, buf_state, newHash);
 	buf->tag = newTag;
 	buf_state &= ~(BM_VALID | BM_DIRTY | BM_JUST_DIRTIED |
 				   BM_CHECKPOINT_NEEDED | BM_IO_ERROR | BM_PERMANENT |
@@ -1326,6 +1458,57 @@ BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 	return buf;
 }
 
+/*
+ * BufferLookupNoLock -- subroutine for BufferAlloc.  Looks up a shared
+ *		buffer without taking the buffer mapping lock.
+ *
+ * Buffer headers are never freed, and a buffer's tag only changes while its
+ * header spinlock is held and nobody but the process changing it has it
+ * pinned.  So we can pin whatever buffer the lookup hint suggests and then
+ * check whether it holds the requested page: while we hold the pin, the tag
+ * can't change under us.  That makes the common case of a buffer hit free of
+ * LWLocks.  If the hint is stale, we unpin the buffer again and return NULL;
+ * the caller must then search the mapping table the hard way.
+ *
+ * On success the buffer is pinned as by PinBuffer, and *valid is set to
+ * PinBuffer's result.
+ */
+static BufferDesc *
+BufferLookupNoLock(BufferTag *tag, uint32 hashcode,
+				   BufferAccessStrategy strategy, bool *valid)
+{
+	int			buf_id;
+	BufferDesc *buf;
+
+	buf_id = BufTableLookupHint(hashcode);
+	if (buf_id < 0)
+		return NULL;
+	buf = GetBufferDescriptor(buf_id);
+
+	/*
+	 * Check the tag before pinning the buffer too, so that we seldom pin a
+	 * buffer that holds some other page.  That would bump its usage count,
+	 * and could make a backend that is about to recycle it look for another
+	 * victim.  This unlocked read can see a torn tag, but it's only a filter.
+	 */
+	if (!BUFFERTAGS_EQUAL(buf->tag, *tag))
+		return NULL;
+
+	/*
+	 * Pin it.  PinBuffer waits for the header spinlock to be released, and
+	 * its atomic operation acts as a memory barrier, so the tag we read next
+	 * is at least as new as the pin.
+	 */
+	*valid = PinBuffer(buf, strategy);
+
+	if (BUFFERTAGS_EQUAL(buf->tag, *tag) &&
+		(pg_atomic_read_u32(&buf->state) & BM_TAG_VALID))
+		return buf;
+
+	UnpinBuffer(buf, true);
+	return NULL;
+}
+
 /*
  * InvalidateBuffer -- mark a shared buffer invalid and return it to the
  * freelist.
@@ -1411,6 +1594,7 @@ retry:
 	 * linear scans of the buffer array don't think the buffer is valid.
 	 */
 	oldFlags = buf_state & BUF_FLAG_MASK;
+	StrategyForgetBuffer(buf);
 	CLEAR_BUFFERTAG(buf->tag);
 	buf_state &= ~(BUF_FLAG_MASK | BUF_USAGECOUNT_MASK);
 	UnlockBufHdr(buf, buf_state);
@@ -2018,33 +2202,71 @@ BufferSync(int flags)
  *
  * This is called periodically by the background writer process.
  *
+ * Every NUMA node's range of buffers has its own clock sweep, so the LRU scan
+ * is done separately for each of them, see BgBufferSyncNode.  The
+ * bgwriter_lru_maxpages limit is divided evenly between the nodes.
+ *
  * Returns true if it's appropriate for the bgwriter process to go into
- * low-power hibernation mode.  (This happens if the strategy clock sweep
- * has been "lapped" and no buffer allocations have occurred recently,
+ * low-power hibernation mode.  (This happens if every node's strategy clock
+ * sweep has been "lapped" and no buffer allocations have occurred recently,
  * or if the bgwriter has been effectively disabled by setting
  * bgwriter_lru_maxpages to 0.)
  */
 bool
 BgBufferSync(WritebackContext *wb_context)
+{
+	/* Information saved between calls, for each node */
+	static BgBufferSyncState *states = NULL;
+
+	int			maxpages;
+	bool		hibernate = true;
+	int			i;
+
+	if (states == NULL)
+	{
+		states = (BgBufferSyncState *)
+			MemoryContextAllocZero(TopMemoryContext,
+								   numa_nodes * sizeof(BgBufferSyncState));
+		for (i = 0; i < numa_nodes; i++)
+			states[i].smoothed_density = 10.0;
+	}
+
+	maxpages = (bgwriter_lru_maxpages + numa_nodes - 1) / numa_nodes;
+
+	/* Make sure we can handle the pin inside SyncOneBuffer */
+	ResourceOwnerEnlargeBuffers(CurrentResourceOwner);
+
+	for (i = 0; i < numa_nodes; i++)
+	{
+		if (!BgBufferSyncNode(&states[i], i, maxpages, wb_context))
+			hibernate = false;
+	}
+
+	return hibernate;
+}
+
+/*
+ * BgBufferSyncNode -- Write out some dirty buffers of one node.
+ *
+ * The buffers of node 'nodeno' are those from GetNodeFirstBuffer(nodeno) up
+ * to the next node's first buffer.  Buffer numbers below are relative to the
+ * first one.  We write at most 'maxpages' buffers.
+ *
+ * Returns true if the node's clock sweep has been "lapped" and no buffer
+ * allocations have occurred recently, or if the LRU scan is disabled.
+ */
+static bool
+BgBufferSyncNode(BgBufferSyncState *state, int nodeno, int maxpages,
+				 WritebackContext *wb_context)
 {
 	/* info obtained from freelist.c */
 	int			strategy_buf_id;
 	uint32		strategy_passes;
 	uint32		recent_alloc;
 
-	/*
-	 * Information saved between calls so we can determine the strategy
-	 * point's advance rate and avoid scanning already-cleaned buffers.
-	 */
-	static bool saved_info_valid = false;
-	static int	prev_strategy_buf_id;
-	static uint32 prev_strategy_passes;
-	static int	next_to_clean;
-	static uint32 next_passes;
-
-	/* Moving averages of allocation rate and clean-buffer density */
-	static float smoothed_alloc = 0;
-	static float smoothed_density = 10.0;
+	/* The node's range of buffers */
+	int			first_buffer = GetNodeFirstBuffer(nodeno);
+	int			num_buffers = GetNodeFirstBuffer(nodeno + 1) - first_buffer;
 
 	/* Potentially these could be tunables, but for now, not */
 	float		smoothing_samples = 16;
@@ -2072,7 +2294,8 @@ BgBufferSync(WritebackContext *wb_context)
 	 * Find out where the freelist clock sweep currently is, and how many
 	 * buffer allocations have happened since our last call.
 	 */
-	strategy_buf_id = StrategySyncStart(&strategy_passes, &recent_alloc);
+	strategy_buf_id = StrategySyncStart(nodeno, &strategy_passes,
+										&recent_alloc) - first_buffer;
 
 	/* Report buffer alloc counts to pgstat */
 	BgWriterStats.m_buf_alloc += recent_alloc;
@@ -2082,9 +2305,9 @@ BgBufferSync(WritebackContext *wb_context)
 	 * stuff.  We mark the saved state invalid so that we can recover sanely
 	 * if LRU scan is turned back on later.
 	 */
-	if (bgwriter_lru_maxpages <= 0)
+	if (maxpages <= 0)
 	{
-		saved_info_valid = false;
+		state->saved_info_valid = false;
 		return true;
 	}
 
@@ -2096,34 +2319,34 @@ BgBufferSync(WritebackContext *wb_context)
 	 * weird-looking coding of xxx_passes comparisons are to avoid bogus
 	 * behavior when the passes counts wrap around.
 	 */
-	if (saved_info_valid)
+	if (state->saved_info_valid)
 	{
-		int32		passes_delta = strategy_passes - prev_strategy_passes;
+		int32		passes_delta = strategy_passes - state->prev_strategy_passes;
 
-		strategy_delta = strategy_buf_id - prev_strategy_buf_id;
-		strategy_delta += (long) passes_delta *NBuffers;
+		strategy_delta = strategy_buf_id - state->prev_strategy_buf_id;
+		strategy_delta += (long) passes_delta *num_buffers;
 
 		Assert(strategy_delta >= 0);
 
-		if ((int32) (next_passes - strategy_passes) > 0)
+		if ((int32) (state->next_passes - strategy_passes) > 0)
 		{
 			/* we're one pass ahead of the strategy point */
-			bufs_to_lap = strategy_buf_id - next_to_clean;
+			bufs_to_lap = strategy_buf_id - state->next_to_clean;
 #ifdef BGW_DEBUG
 			elog(DEBUG2, "bgwriter ahead: bgw %u-%u strategy %u-%u delta=%ld lap=%d",
-				 next_passes, next_to_clean,
+				 state->next_passes, state->next_to_clean,
 				 strategy_passes, strategy_buf_id,
 				 strategy_delta, bufs_to_lap);
 #endif
 		}
-		else if (next_passes == strategy_passes &&
-				 next_to_clean >= strategy_buf_id)
+		else if (state->next_passes == strategy_passes &&
+				 state->next_to_clean >= strategy_buf_id)
 		{
 			/* on same pass, but ahead or at least not behind */
-			bufs_to_lap = NBuffers - (next_to_clean - strategy_buf_id);
+			bufs_to_lap = num_buffers - (state->next_to_clean - strategy_buf_id);
 #ifdef BGW_DEBUG
 			elog(DEBUG2, "bgwriter ahead: bgw %u-%u strategy %u-%u delta=%ld lap=%d",
-				 next_passes, next_to_clean,
+				 state->next_passes, state->next_to_clean,
 				 strategy_passes, strategy_buf_id,
 				 strategy_delta, bufs_to_lap);
 #endif
@@ -2136,13 +2359,13 @@ BgBufferSync(WritebackContext *wb_context)
 			 */
 #ifdef BGW_DEBUG
 			elog(DEBUG2, "bgwriter behind: bgw %u-%u strategy %u-%u delta=%ld",
-				 next_passes, next_to_clean,
+				 state->next_passes, state->next_to_clean,
 				 strategy_passes, strategy_buf_id,
 				 strategy_delta);
 #endif
-			next_to_clean = strategy_buf_id;
-			next_passes = strategy_passes;
-			bufs_to_lap = NBuffers;
+			state->next_to_clean = strategy_buf_id;
+			state->next_passes = strategy_passes;
+			bufs_to_lap = num_buffers;
 		}
 	}
 	else
@@ -2156,15 +2379,15 @@ BgBufferSync(WritebackContext *wb_context)
 			 strategy_passes, strategy_buf_id);
 #endif
 		strategy_delta = 0;
-		next_to_clean = strategy_buf_id;
-		next_passes = strategy_passes;
-		bufs_to_lap = NBuffers;
+		state->next_to_clean = strategy_buf_id;
+		state->next_passes = strategy_passes;
+		bufs_to_lap = num_buffers;
 	}
 
 	/* Update saved info for next time */
-	prev_strategy_buf_id = strategy_buf_id;
-	prev_strategy_passes = strategy_passes;
-	saved_info_valid = true;
+	state->prev_strategy_buf_id = strategy_buf_id;
+	state->prev_strategy_passes = strategy_passes;
+	state->saved_info_valid = true;
 
 	/*
 	 * Compute how many buffers had to be scanned for each new allocation, ie,
@@ -2175,7 +2398,7 @@ BgBufferSync(WritebackContext *wb_context)
 	if (strategy_delta > 0 && recent_alloc > 0)
 	{
 		scans_per_alloc = (float) strategy_delta / (float) recent_alloc;
-		smoothed_density += (scans_per_alloc - smoothed_density) /
+		state->smoothed_density += (scans_per_alloc - state->smoothed_density) /
 			smoothing_samples;
 	}
 
@@ -2184,22 +2407,22 @@ BgBufferSync(WritebackContext *wb_context)
 	 * strategy point and where we've scanned ahead to, based on the smoothed
 	 * density estimate.
 	 */
-	bufs_ahead = NBuffers - bufs_to_lap;
-	reusable_buffers_est = (float) bufs_ahead / smoothed_density;
+	bufs_ahead = num_buffers - bufs_to_lap;
+	reusable_buffers_est = (float) bufs_ahead / state->smoothed_density;
 
 	/*
 	 * Track a moving average of recent buffer allocations.  Here, rather than
 	 * a true average we want a fast-attack, slow-decline behavior: we
 	 * immediately follow any increase.
 	 */
-	if (smoothed_alloc <= (float) recent_alloc)
-		smoothed_alloc = recent_alloc;
+	if (state->smoothed_alloc <= (float) recent_alloc)
+		state->smoothed_alloc = recent_alloc;
 	else
-		smoothed_alloc += ((float) recent_alloc - smoothed_alloc) /
+		state->smoothed_alloc += ((float) recent_alloc - state->smoothed_alloc) /
 			smoothing_samples;
 
 	/* Scale the estimate by a GUC to allow more aggressive tuning. */
-	upcoming_alloc_est = (int) (smoothed_alloc * bgwriter_lru_multiplier);
+	upcoming_alloc_est = (int) (state->smoothed_alloc * bgwriter_lru_multiplier);
 
 	/*
 	 * If recent_alloc remains at zero for many cycles, smoothed_alloc will
@@ -2210,7 +2433,7 @@ BgBufferSync(WritebackContext *wb_context)
 	 * syndrome.  It will pop back up as soon as recent_alloc increases.
 	 */
 	if (upcoming_alloc_est == 0)
-		smoothed_alloc = 0;
+		state->smoothed_alloc = 0;
 
 	/*
 	 * Even in cases where there's been little or no buffer allocation
@@ -2222,7 +2445,7 @@ BgBufferSync(WritebackContext *wb_context)
 	 * the BGW will be called during the scan_whole_pool time; slice the
 	 * buffer pool into that many sections.
 	 */
-	min_scan_buffers = (int) (NBuffers / (scan_whole_pool_milliseconds / BgWriterDelay));
+	min_scan_buffers = (int) (num_buffers / (scan_whole_pool_milliseconds / BgWriterDelay));
 
 	if (upcoming_alloc_est < (min_scan_buffers + reusable_buffers_est))
 	{
@@ -2240,9 +2463,6 @@ BgBufferSync(WritebackContext *wb_context)
 	 * requirements, or hit the bgwriter_lru_maxpages limit.
 	 */
 
-	/* Make sure we can handle the pin inside SyncOneBuffer */
-	ResourceOwnerEnlargeBuffers(CurrentResourceOwner);
-
 	num_to_scan = bufs_to_lap;
 	num_written = 0;
 	reusable_buffers = reusable_buffers_est;
@@ -2250,20 +2470,20 @@ BgBufferSync(WritebackContext *wb_context)
 	/* Execute the LRU scan */
 	while (num_to_scan > 0 && reusable_buffers < upcoming_alloc_est)
 	{
-		int			sync_state = SyncOneBuffer(next_to_clean, true,
-											   wb_context);
+		int			sync_state = SyncOneBuffer(first_buffer + state->next_to_clean,
+											   true, wb_context);
 
-		if (++next_to_clean >= NBuffers)
+		if (++state->next_to_clean >= num_buffers)
 		{
-			next_to_clean = 0;
-			next_passes++;
+			state->next_to_clean = 0;
+			state->next_passes++;
 		}
 		num_to_scan--;
 
 		if (sync_state & BUF_WRITTEN)
 		{
 			reusable_buffers++;
-			if (++num_written >= bgwriter_lru_maxpages)
+			if (++num_written >= maxpages)
 			{
 				BgWriterStats.m_maxwritten_clean++;
 				break;
@@ -2277,8 +2497,8 @@ BgBufferSync(WritebackContext *wb_context)
 
 #ifdef BGW_DEBUG
 	elog(DEBUG1, "bgwriter: recent_alloc=%u smoothed=%.2f delta=%ld ahead=%d density=%.2f reusable_est=%d upcoming_est=%d scanned=%d wrote=%d reusable=%d",
-		 recent_alloc, smoothed_alloc, strategy_delta, bufs_ahead,
-		 smoothed_density, reusable_buffers_est, upcoming_alloc_est,
+		 recent_alloc, state->smoothed_alloc, strategy_delta, bufs_ahead,
+		 state->smoothed_density, reusable_buffers_est, upcoming_alloc_est,
 		 bufs_to_lap - num_to_scan,
 		 num_written,
 		 reusable_buffers - reusable_buffers_est);
@@ -2297,13 +2517,13 @@ BgBufferSync(WritebackContext *wb_context)
 	if (new_strategy_delta > 0 && new_recent_alloc > 0)
 	{
 		scans_per_alloc = (float) new_strategy_delta / (float) new_recent_alloc;
-		smoothed_density += (scans_per_alloc - smoothed_density) /
+		state->smoothed_density += (scans_per_alloc - state->smoothed_density) /
 			smoothing_samples;
 
 #ifdef BGW_DEBUG
 		elog(DEBUG2, "bgwriter: cleaner density alloc=%u scan=%ld density=%.2f new smoothed=%.2f",
 			 new_recent_alloc, new_strategy_delta,
-			 scans_per_alloc, smoothed_density);
+			 scans_per_alloc, state->smoothed_density);
 #endif
 	}
 
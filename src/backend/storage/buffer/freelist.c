@@ -15,53 +15,169 @@
  */
 #include "postgres.h"
 
+#include "miscadmin.h"
 #include "port/atomics.h"
 #include "storage/buf_internals.h"
 #include "storage/bufmgr.h"
+#include "storage/pg_shmem.h"
 #include "storage/proc.h"
+#include "storage/shmem.h"
 
 #define INT_ACCESS_ONCE(var)	((int)(*((volatile int *)&(var))))
 
+/* GUC variables */
+int			buffer_replacement_policy = BUFFER_REPLACEMENT_CLOCK;
+int			numa_nodes = 1;
 
 /*
- * The shared freelist control information.
+ * 2Q replacement
+ *
+ * The plain clock sweep is not scan resistant: a page touched once by a large
+ * scan starts out with the same usage count as a page that is used over and
+ * over, so a scan bigger than shared_buffers can push the whole working set
+ * out (ring strategies protect against bulk reads, but not against index
+ * scans or many mid-sized scans).  The "2q" policy keeps the clock hand but
+ * sorts resident pages into two queues, as in Johnson and Shasha's 2Q:
+ *
+ * - a page read in for the first time joins the probationary queue (A1in);
+ * - a page read in again soon after it was evicted from the probationary
+ *	 queue joins the protected queue (Am).
+ *
+ * "Soon after" is decided by the ghost table, which remembers the buffer
+ * mapping hash codes of the pages most recently evicted from the
+ * probationary queue (A1out).  It is a direct-mapped array of hash codes, so
+ * an entry is forgotten once another evicted page maps to its slot; that
+ * makes it lossy, but it needs no locking and its size bounds how long a
+ * page is remembered.
+ *
+ * While the probationary queue holds more than its share of the buffers, the
+ * clock hand evicts probationary pages regardless of their usage count and
+ * passes over protected pages without aging them, so pages that were only
+ * read once are evicted before the working set.  Otherwise the ordinary
+ * clock sweep runs over all buffers.
+ *
+ * A buffer's queue is protected by its header spinlock.
+ */
+#define BUF_QUEUE_NONE			0	/* no page, or policy is clock */
+#define BUF_QUEUE_PROBATION		1	/* A1in */
+#define BUF_QUEUE_PROTECTED		2	/* Am */
+
+/* probationary queue target size (Kin), as a fraction of NBuffers */
+#define PROBATION_TARGET		(NBuffers / 4)
+
+/* number of ghost entries (Kout) */
+#define NUM_GHOST_ENTRIES		Max(NBuffers / 2, 16)
+
+/*
+ * NUMA nodes
+ *
+ * With numa_nodes > 1, the buffers are divided into that many contiguous
+ * ranges (see GetBufferNode), buf_init.c asks the kernel to place each range
+ * on its own node, and each range has its own clock hand.  A backend sweeps
+ * the range of the node it was running on when it first needed a buffer, so
+ * pages it reads in land in memory local to it, and backends on different
+ * nodes don't contend for the same hand.
+ */
+
+/*
+ * Hit and miss counters for pg_stat_get_buffer_replacement() and
+ * pg_stat_get_buffer_nodes().  Every process has its own slot, indexed by
+ * pgprocno, so that they can be updated without locking or cache line
+ * contention.
  */
 typedef struct
 {
-	/* Spinlock: protects the values below */
-	slock_t		buffer_strategy_lock;
+	uint64		hits;			/* lookups found in shared buffers */
+	uint64		misses;			/* lookups that had to allocate a buffer */
+	uint64		ghost_hits;		/* misses admitted to the protected queue */
+	uint64		evictions;		/* valid pages replaced */
+	uint64		probation_evictions;	/* of those, from the probationary
+										 * queue */
 
 	/*
-	 * Clock sweep hand: index of next buffer to consider grabbing. Note that
-	 * this isn't a concrete buffer - we only ever increase the value. So, to
-	 * get an actual buffer, it needs to be used modulo NBuffers.
+	 * Hits and misses by the node this process runs on, split by whether the
+	 * buffer belongs to the same node.
 	 */
-	pg_atomic_uint32 nextVictimBuffer;
+	uint64		local_hits[NUMA_MAX_NODES];
+	uint64		remote_hits[NUMA_MAX_NODES];
+	uint64		local_reads[NUMA_MAX_NODES];
+	uint64		remote_reads[NUMA_MAX_NODES];
+} BufferStrategyCounters;
 
-	int			firstFreeBuffer;	/* Head of list of unused buffers */
-	int			lastFreeBuffer; /* Tail of list of unused buffers */
+#define NUM_STRATEGY_COUNTERS	(MaxBackends + NUM_AUXILIARY_PROCS)
+
+/* slots are padded to whole cache lines */
+#define STRATEGY_COUNTERS_STRIDE	CACHELINEALIGN(sizeof(BufferStrategyCounters))
 
+/*
+ * Clock sweep state of one node's range of buffers.  Each is padded to a
+ * cache line, so that sweeping one node doesn't slow down the others.
+ */
+typedef struct
+{
 	/*
-	 * NOTE: lastFreeBuffer is undefined when firstFreeBuffer is -1 (that is,
-	 * when the list is empty)
+	 * Clock sweep hand: index of next buffer to consider grabbing, relative
+	 * to firstBuffer. Note that this isn't a concrete buffer - we only ever
+	 * increase the value. So, to get an actual buffer, it needs to be used
+	 * modulo numBuffers.
 	 */
+	pg_atomic_uint32 nextVictimBuffer;
 
 	/*
-	 * Statistics.  These counters should be wide enough that they can't
-	 * overflow during a single bgwriter cycle.
+	 * Statistics.  This counter should be wide enough that it can't overflow
+	 * during a single bgwriter cycle.
 	 */
 	uint32		completePasses; /* Complete cycles of the clock sweep */
 	pg_atomic_uint32 numBufferAllocs;	/* Buffers allocated since last reset */
 
+	int			firstBuffer;	/* first buffer of the node */
+	int			numBuffers;		/* number of buffers of the node */
+} BufferStrategyNode;
+
+typedef union BufferStrategyNodePadded
+{
+	BufferStrategyNode node;
+	char		pad[PG_CACHE_LINE_SIZE];
+} BufferStrategyNodePadded;
+
+
+/*
+ * The shared freelist control information.
+ */
+typedef struct
+{
+	/* Spinlock: protects the values below, and the nodes' completePasses */
+	slock_t		buffer_strategy_lock;
+
+	int			firstFreeBuffer;	/* Head of list of unused buffers */
+	int			lastFreeBuffer; /* Tail of list of unused buffers */
+
+	/*
+	 * NOTE: lastFreeBuffer is undefined when firstFreeBuffer is -1 (that is,
+	 * when the list is empty)
+	 */
+
 	/*
 	 * Bgworker process to be notified upon activity or -1 if none. See
 	 * StrategyNotifyBgWriter.
 	 */
 	int			bgwprocno;
+
+	/* Number of buffers in the probationary queue, with the 2q policy */
+	pg_atomic_uint32 numProbation;
+
+	/* Clock sweep state of each node; only numa_nodes are used */
+	BufferStrategyNodePadded nodes[NUMA_MAX_NODES];
 } BufferStrategyControl;
 
 /* Pointers to shared state */
 static BufferStrategyControl *StrategyControl = NULL;
+static uint8 *BufferQueues = NULL;
+static pg_atomic_uint32 *GhostEntries = NULL;
+static char *StrategyCounters = NULL;
+
+/* Node this process prefers, or -1 if not determined yet */
+static int	MyBufferNode = -1;
 
 /*
  * Private (non-shared) state for managing a ring of shared buffers to re-use.
@@ -102,15 +218,22 @@ static BufferDesc *GetBufferFromRing(BufferAccessStrategy strategy,
 				  uint32 *buf_state);
 static void AddBufferToRing(BufferAccessStrategy strategy,
 				BufferDesc *buf);
+static BufferDesc *GetProbationBuffer(BufferStrategyNode *node,
+				   uint32 *buf_state);
+static int	ChooseSweepNode(void);
+static inline int GetMyBufferNode(void);
+static void GhostRemember(uint32 hashcode);
+static bool GhostRecall(uint32 hashcode);
+static inline BufferStrategyCounters *MyStrategyCounters(void);
 
 /*
  * ClockSweepTick - Helper routine for StrategyGetBuffer()
  *
- * Move the clock hand one buffer ahead of its current position and return the
- * id of the buffer now under the hand.
+ * Move the node's clock hand one buffer ahead of its current position and
+ * return the id of the buffer now under the hand.
  */
 static inline uint32
-ClockSweepTick(void)
+ClockSweepTick(BufferStrategyNode *node)
 {
 	uint32		victim;
 
@@ -120,14 +243,14 @@ ClockSweepTick(void)
 	 * apparent order.
 	 */
 	victim =
-		pg_atomic_fetch_add_u32(&StrategyControl->nextVictimBuffer, 1);
+		pg_atomic_fetch_add_u32(&node->nextVictimBuffer, 1);
 
-	if (victim >= NBuffers)
+	if (victim >= node->numBuffers)
 	{
 		uint32		originalVictim = victim;
 
 		/* always wrap what we look up in BufferDescriptors */
-		victim = victim % NBuffers;
+		victim = victim % node->numBuffers;
 
 		/*
 		 * If we're the one that just caused a wraparound, force
@@ -155,17 +278,83 @@ ClockSweepTick(void)
 				 */
 				SpinLockAcquire(&StrategyControl->buffer_strategy_lock);
 
-				wrapped = expected % NBuffers;
+				wrapped = expected % node->numBuffers;
 
-				success = pg_atomic_compare_exchange_u32(&StrategyControl->nextVictimBuffer,
+				success = pg_atomic_compare_exchange_u32(&node->nextVictimBuffer,
 														 &expected, wrapped);
 				if (success)
-					StrategyControl->completePasses++;
+					node->completePasses++;
 				SpinLockRelease(&StrategyControl->buffer_strategy_lock);
 			}
 		}
 	}
-	return victim;
+	return node->firstBuffer + victim;
+}
+
+/*
+ * ClockSweepPasses - number of complete passes of a node's clock hand
+ *
+ * Read without the lock, so the result may be a little out of date.
+ */
+static inline uint32
+ClockSweepPasses(BufferStrategyNode *node)
+{
+	return *((volatile uint32 *) &node->completePasses) +
+		pg_atomic_read_u32(&node->nextVictimBuffer) / node->numBuffers;
+}
+
+/*
+ * ChooseSweepNode - Helper routine for StrategyGetBuffer()
+ *
+ * Return the node whose clock hand should be advanced.  That's the node of
+ * this process, unless its hand has gotten more than a full pass ahead of
+ * some other node's.  Then the lagging node is swept instead: otherwise the
+ * buffers of nodes running few backends would hardly ever be reused, and if
+ * numa_nodes doesn't match the real topology, whole nodes' worth of buffers
+ * could sit idle.
+ */
+static int
+ChooseSweepNode(void)
+{
+	int			mynode;
+	uint32		mypasses;
+	int			i;
+
+	if (numa_nodes == 1)
+		return 0;
+
+	mynode = GetMyBufferNode();
+	mypasses = ClockSweepPasses(&StrategyControl->nodes[mynode].node);
+
+	for (i = 0; i < numa_nodes; i++)
+	{
+		if ((int32) (mypasses -
+			ClockSweepPasses(&StrategyControl->nodes[i].node)) > 1)
+			return i;
+	}
+
+	return mynode;
+}
+
+/*
+ * GetMyBufferNode - return the node this process prefers
+ *
+ * That's the node we're running on when first asked, or a node picked by
+ * process number if we can't tell.  The scheduler may move us later, but
+ * then there's a good chance that our memory moves along.
+ */
+static inline int
+GetMyBufferNode(void)
+{
+	if (MyBufferNode < 0)
+	{
+		int			node = PGSharedMemoryCurrentNode();
+
+		if (node < 0)
+			node = MyProc != NULL ? MyProc->pgprocno : MyProcPid;
+		MyBufferNode = node % numa_nodes;
+	}
+	return MyBufferNode;
 }
 
 /*
@@ -185,6 +374,9 @@ StrategyGetBuffer(BufferAccessStrategy strategy, uint32 *buf_state)
 {
 	BufferDesc *buf;
 	int			bgwprocno;
+	int			nodeno;
+	BufferStrategyNode *node;
+	int			nodes_left;
 	int			trycounter;
 	uint32		local_buf_state;	/* to avoid repeated (de-)referencing */
 
@@ -225,12 +417,16 @@ StrategyGetBuffer(BufferAccessStrategy strategy, uint32 *buf_state)
 		SetLatch(&ProcGlobal->allProcs[bgwprocno].procLatch);
 	}
 
+	/* Decide whose clock hand to advance, if it comes to that */
+	nodeno = ChooseSweepNode();
+	node = &StrategyControl->nodes[nodeno].node;
+
 	/*
 	 * We count buffer allocation requests so that the bgwriter can estimate
-	 * the rate of buffer consumption.  Note that buffers recycled by a
-	 * strategy object are intentionally not counted here.
+	 * the rate of buffer consumption of each node.  Note that buffers
+	 * recycled by a strategy object are intentionally not counted here.
 	 */
-	pg_atomic_fetch_add_u32(&StrategyControl->numBufferAllocs, 1);
+	pg_atomic_fetch_add_u32(&node->numBufferAllocs, 1);
 
 	/*
 	 * First check, without acquiring the lock, whether there's buffers in the
@@ -295,11 +491,29 @@ StrategyGetBuffer(BufferAccessStrategy strategy, uint32 *buf_state)
 		}
 	}
 
-	/* Nothing on the freelist, so run the "clock sweep" algorithm */
-	trycounter = NBuffers;
+	/*
+	 * Nothing on the freelist.  With the 2q policy, pages on probation are
+	 * evicted first as long as there are too many of them.
+	 */
+	if (buffer_replacement_policy == BUFFER_REPLACEMENT_2Q &&
+		pg_atomic_read_u32(&StrategyControl->numProbation) > PROBATION_TARGET)
+	{
+		buf = GetProbationBuffer(node, &local_buf_state);
+		if (buf != NULL)
+		{
+			if (strategy != NULL)
+				AddBufferToRing(strategy, buf);
+			*buf_state = local_buf_state;
+			return buf;
+		}
+	}
+
+	/* Otherwise run the "clock sweep" algorithm */
+	nodes_left = numa_nodes;
+	trycounter = node->numBuffers;
 	for (;;)
 	{
-		buf = GetBufferDescriptor(ClockSweepTick());
+		buf = GetBufferDescriptor(ClockSweepTick(node));
 
 		/*
 		 * If the buffer is pinned or has a nonzero usage_count, we cannot use
@@ -313,7 +527,7 @@ StrategyGetBuffer(BufferAccessStrategy strategy, uint32 *buf_state)
 			{
 				local_buf_state -= BUF_USAGECOUNT_ONE;
 
-				trycounter = NBuffers;
+				trycounter = node->numBuffers;
 			}
 			else
 			{
@@ -327,11 +541,23 @@ StrategyGetBuffer(BufferAccessStrategy strategy, uint32 *buf_state)
 		else if (--trycounter == 0)
 		{
 			/*
-			 * We've scanned all the buffers without making any state changes,
-			 * so all the buffers are pinned (or were when we looked at them).
-			 * We could hope that someone will free one eventually, but it's
-			 * probably better to fail than to risk getting stuck in an
-			 * infinite loop.
+			 * We've scanned all the buffers of the node without making any
+			 * state changes, so they're all pinned (or were when we looked at
+			 * them).  Try the next node, if we haven't yet.
+			 */
+			if (--nodes_left > 0)
+			{
+				UnlockBufHdr(buf, local_buf_state);
+				nodeno = (nodeno + 1) % numa_nodes;
+				node = &StrategyControl->nodes[nodeno].node;
+				trycounter = node->numBuffers;
+				continue;
+			}
+
+			/*
+			 * All the buffers are pinned.  We could hope that someone will
+			 * free one eventually, but it's probably better to fail than to
+			 * risk getting stuck in an infinite loop.
 			 */
 			UnlockBufHdr(buf, local_buf_state);
 			elog(ERROR, "no unpinned buffers available");
@@ -340,6 +566,237 @@ StrategyGetBuffer(BufferAccessStrategy strategy, uint32 *buf_state)
 	}
 }
 
+/*
+ * GetProbationBuffer -- helper routine for StrategyGetBuffer()
+ *
+ * Advance the node's clock hand to the next unpinned buffer in the
+ * probationary queue and return it with its header spinlock held, or return
+ * NULL if a full turn of the clock finds none.  Other buffers are passed over
+ * without decrementing their usage count.
+ */
+static BufferDesc *
+GetProbationBuffer(BufferStrategyNode *node, uint32 *buf_state)
+{
+	int			trycounter;
+
+	for (trycounter = node->numBuffers; trycounter > 0; trycounter--)
+	{
+		uint32		victim = ClockSweepTick(node);
+		BufferDesc *buf;
+		uint32		local_buf_state;
+
+		/* check the queue without the lock first, it's cheap */
+		if (BufferQueues[victim] != BUF_QUEUE_PROBATION)
+			continue;
+
+		buf = GetBufferDescriptor(victim);
+		local_buf_state = LockBufHdr(buf);
+		if (BufferQueues[victim] == BUF_QUEUE_PROBATION &&
+			BUF_STATE_GET_REFCOUNT(local_buf_state) == 0)
+		{
+			*buf_state = local_buf_state;
+			return buf;
+		}
+		UnlockBufHdr(buf, local_buf_state);
+	}
+
+	return NULL;
+}
+
+/*
+ * StrategyAdmitBuffer -- account for a buffer getting a new page
+ *
+ * Called by BufferAlloc() with the buffer header spinlock held, just before
+ * the buffer's tag is changed; buf->tag and buf_state still describe the old
+ * page, if any.  new_hash is the buffer mapping hash code of the new page.
+ *
+ * With the 2q policy this puts the buffer into the probationary or protected
+ * queue and remembers the old page in the ghost table if it was evicted from
+ * the probationary queue.
+ */
+void
+StrategyAdmitBuffer(BufferDesc *buf, uint32 buf_state, uint32 new_hash)
+{
+	BufferStrategyCounters *counters = MyStrategyCounters();
+	uint8	   *queue;
+
+	if (counters)
+	{
+		int			mynode = GetMyBufferNode();
+
+		counters->misses++;
+		if (GetBufferNode(buf->buf_id) == mynode)
+			counters->local_reads[mynode]++;
+		else
+			counters->remote_reads[mynode]++;
+		if (buf_state & BM_TAG_VALID)
+			counters->evictions++;
+	}
+
+	if (buffer_replacement_policy != BUFFER_REPLACEMENT_2Q)
+		return;
+
+	queue = &BufferQueues[buf->buf_id];
+
+	if (counters && (buf_state & BM_TAG_VALID) &&
+		*queue == BUF_QUEUE_PROBATION)
+		counters->probation_evictions++;
+
+	if (*queue == BUF_QUEUE_PROBATION)
+	{
+		pg_atomic_fetch_sub_u32(&StrategyControl->numProbation, 1);
+		if (buf_state & BM_TAG_VALID)
+			GhostRemember(BufTableHashCode(&buf->tag));
+	}
+
+	if (GhostRecall(new_hash))
+	{
+		*queue = BUF_QUEUE_PROTECTED;
+		if (counters)
+			counters->ghost_hits++;
+	}
+	else
+	{
+		*queue = BUF_QUEUE_PROBATION;
+		pg_atomic_fetch_add_u32(&StrategyControl->numProbation, 1);
+	}
+}
+
+/*
+ * StrategyForgetBuffer -- account for a buffer being invalidated
+ *
+ * Called by InvalidateBuffer() with the buffer header spinlock held.  The
+ * page is gone for good, so it is not remembered in the ghost table.
+ */
+void
+StrategyForgetBuffer(BufferDesc *buf)
+{
+	if (buffer_replacement_policy != BUFFER_REPLACEMENT_2Q)
+		return;
+
+	if (BufferQueues[buf->buf_id] == BUF_QUEUE_PROBATION)
+		pg_atomic_fetch_sub_u32(&StrategyControl->numProbation, 1);
+	BufferQueues[buf->buf_id] = BUF_QUEUE_NONE;
+}
+
+/*
+ * StrategyCountHit -- count a lookup that found its page in buffer buf
+ */
+void
+StrategyCountHit(BufferDesc *buf)
+{
+	BufferStrategyCounters *counters = MyStrategyCounters();
+
+	if (counters)
+	{
+		int			mynode = GetMyBufferNode();
+
+		counters->hits++;
+		if (GetBufferNode(buf->buf_id) == mynode)
+			counters->local_hits[mynode]++;
+		else
+			counters->remote_hits[mynode]++;
+	}
+}
+
+/*
+ * StrategyGetStats -- sum up the hit and miss counters of all processes
+ */
+void
+StrategyGetStats(BufferReplacementStats *stats)
+{
+	int			i;
+
+	memset(stats, 0, sizeof(BufferReplacementStats));
+
+	for (i = 0; i < NUM_STRATEGY_COUNTERS; i++)
+	{
+		volatile BufferStrategyCounters *counters = (BufferStrategyCounters *)
+		(StrategyCounters + i * STRATEGY_COUNTERS_STRIDE);
+
+		stats->hits += counters->hits;
+		stats->misses += counters->misses;
+		stats->ghost_hits += counters->ghost_hits;
+		stats->evictions += counters->evictions;
+		stats->probation_evictions += counters->probation_evictions;
+	}
+}
+
+/*
+ * StrategyGetNodeStats -- sum up the per-node counters of all processes
+ *
+ * stats must have room for numa_nodes entries.
+ */
+void
+StrategyGetNodeStats(BufferNodeStats *stats)
+{
+	int			i;
+	int			n;
+
+	memset(stats, 0, numa_nodes * sizeof(BufferNodeStats));
+
+	for (n = 0; n < numa_nodes; n++)
+		stats[n].buffers = StrategyControl->nodes[n].node.numBuffers;
+
+	for (i = 0; i < NUM_STRATEGY_COUNTERS; i++)
+	{
+		volatile BufferStrategyCounters *counters = (BufferStrategyCounters *)
+		(StrategyCounters + i * STRATEGY_COUNTERS_STRIDE);
+
+		for (n = 0; n < numa_nodes; n++)
+		{
+			stats[n].local_hits += counters->local_hits[n];
+			stats[n].remote_hits += counters->remote_hits[n];
+			stats[n].local_reads += counters->local_reads[n];
+			stats[n].remote_reads += counters->remote_reads[n];
+		}
+	}
+}
+
+/*
+ * MyStrategyCounters -- return the counter slot of this process, or NULL if
+ * it has none
+ */
+static inline BufferStrategyCounters *
+MyStrategyCounters(void)
+{
+	if (MyProc == NULL || MyProc->pgprocno >= NUM_STRATEGY_COUNTERS)
+		return NULL;
+	return (BufferStrategyCounters *)
+		(StrategyCounters + MyProc->pgprocno * STRATEGY_COUNTERS_STRIDE);
+}
+
+/*
+ * GhostRemember -- remember a page evicted from the probationary queue
+ *
+ * Zero marks an empty slot, so a page whose hash code is zero can't be
+ * remembered; that just means it is treated as never seen before.
+ */
+static void
+GhostRemember(uint32 hashcode)
+{
+	pg_atomic_write_u32(&GhostEntries[hashcode % NUM_GHOST_ENTRIES], hashcode);
+}
+
+/*
+ * GhostRecall -- was this page recently evicted from the probationary queue?
+ *
+ * A remembered page is forgotten when it is recalled, since it is then
+ * resident again.  Two different pages with the same hash code are
+ * indistinguishable here; the only harm is admitting a page to the wrong
+ * queue.
+ */
+static bool
+GhostRecall(uint32 hashcode)
+{
+	uint32		expected = hashcode;
+
+	if (hashcode == 0)
+		return false;
+	return pg_atomic_compare_exchange_u32(&GhostEntries[hashcode % NUM_GHOST_ENTRIES],
+										  &expected, 0);
+}
+
 /*
  * StrategyFreeBuffer: put a buffer on the freelist
  */
@@ -364,40 +821,45 @@ StrategyFreeBuffer(BufferDesc *buf)
 }
 
 /*
- * StrategySyncStart -- tell BufferSync where to start syncing
+ * StrategySyncStart -- tell BgBufferSync where to start syncing
  *
- * The result is the buffer index of the best buffer to sync first.
- * BufferSync() will proceed circularly around the buffer array from there.
+ * Each node has its own clock hand, sweeping the node's range of buffers
+ * (see GetNodeFirstBuffer).  The result is the buffer index of the best
+ * buffer of node 'nodeno' to sync first.  BgBufferSync() will proceed
+ * circularly around the node's range from there.
  *
- * In addition, we return the completed-pass count (which is effectively
- * the higher-order bits of nextVictimBuffer) and the count of recent buffer
- * allocs if non-NULL pointers are passed.  The alloc count is reset after
- * being read.
+ * In addition, we return the node's completed-pass count (which is
+ * effectively the higher-order bits of nextVictimBuffer) and its count of
+ * recent buffer allocs if non-NULL pointers are passed.  The alloc count is
+ * reset after being read.
  */
 int
-StrategySyncStart(uint32 *complete_passes, uint32 *num_buf_alloc)
+StrategySyncStart(int nodeno, uint32 *complete_passes, uint32 *num_buf_alloc)
 {
+	BufferStrategyNode *node = &StrategyControl->nodes[nodeno].node;
 	uint32		nextVictimBuffer;
 	int			result;
 
+	Assert(nodeno >= 0 && nodeno < numa_nodes);
+
 	SpinLockAcquire(&StrategyControl->buffer_strategy_lock);
-	nextVictimBuffer = pg_atomic_read_u32(&StrategyControl->nextVictimBuffer);
-	result = nextVictimBuffer % NBuffers;
+	nextVictimBuffer = pg_atomic_read_u32(&node->nextVictimBuffer);
+	result = node->firstBuffer + nextVictimBuffer % node->numBuffers;
 
 	if (complete_passes)
 	{
-		*complete_passes = StrategyControl->completePasses;
+		*complete_passes = node->completePasses;
 
 		/*
 		 * Additionally add the number of wraparounds that happened before
 		 * completePasses could be incremented. C.f. ClockSweepTick().
 		 */
-		*complete_passes += nextVictimBuffer / NBuffers;
+		*complete_passes += nextVictimBuffer / node->numBuffers;
 	}
 
 	if (num_buf_alloc)
 	{
-		*num_buf_alloc = pg_atomic_exchange_u32(&StrategyControl->numBufferAllocs, 0);
+		*num_buf_alloc = pg_atomic_exchange_u32(&node->numBufferAllocs, 0);
 	}
 	SpinLockRelease(&StrategyControl->buffer_strategy_lock);
 	return result;
@@ -444,6 +906,20 @@ StrategyShmemSize(void)
 	/* size of the shared replacement strategy control block */
 	size = add_size(size, MAXALIGN(sizeof(BufferStrategyControl)));
 
+	/* size of the hit and miss counters */
+	size = add_size(size, mul_size(NUM_STRATEGY_COUNTERS,
+								   STRATEGY_COUNTERS_STRIDE));
+	/* to allow aligning the counters */
+	size = add_size(size, PG_CACHE_LINE_SIZE);
+
+	/* size of the queue array and the ghost table, for the 2q policy */
+	if (buffer_replacement_policy == BUFFER_REPLACEMENT_2Q)
+	{
+		size = add_size(size, MAXALIGN(mul_size(NBuffers, sizeof(uint8))));
+		size = add_size(size, mul_size(NUM_GHOST_ENTRIES,
+									   sizeof(pg_atomic_uint32)));
+	}
+
 	return size;
 }
 
@@ -458,6 +934,7 @@ void
 StrategyInitialize(bool init)
 {
 	bool		found;
+	int			i;
 
 	/*
 	 * Initialize the shared buffer lookup hashtable.
@@ -495,18 +972,60 @@ StrategyInitialize(bool init)
 		StrategyControl->firstFreeBuffer = 0;
 		StrategyControl->lastFreeBuffer = NBuffers - 1;
 
-		/* Initialize the clock sweep pointer */
-		pg_atomic_init_u32(&StrategyControl->nextVictimBuffer, 0);
+		/* Initialize the clock sweep pointers and divide up the buffers */
+		for (i = 0; i < numa_nodes; i++)
+		{
+			BufferStrategyNode *node = &StrategyControl->nodes[i].node;
 
-		/* Clear statistics */
-		StrategyControl->completePasses = 0;
-		pg_atomic_init_u32(&StrategyControl->numBufferAllocs, 0);
+			pg_atomic_init_u32(&node->nextVictimBuffer, 0);
+			node->completePasses = 0;
+			pg_atomic_init_u32(&node->numBufferAllocs, 0);
+			node->firstBuffer = GetNodeFirstBuffer(i);
+			node->numBuffers = GetNodeFirstBuffer(i + 1) - node->firstBuffer;
+		}
 
 		/* No pending notification */
 		StrategyControl->bgwprocno = -1;
+
+		/* Nothing on probation yet */
+		pg_atomic_init_u32(&StrategyControl->numProbation, 0);
 	}
 	else
 		Assert(!init);
+
+	/*
+	 * Get or create the hit and miss counters, aligned to cache lines so
+	 * that processes don't share them.
+	 */
+	StrategyCounters = (char *)
+		CACHELINEALIGN(ShmemInitStruct("Buffer Strategy Counters",
+									   NUM_STRATEGY_COUNTERS *
+									   STRATEGY_COUNTERS_STRIDE +
+									   PG_CACHE_LINE_SIZE,
+									   &found));
+	if (!found)
+		MemSet(StrategyCounters, 0,
+			   NUM_STRATEGY_COUNTERS * STRATEGY_COUNTERS_STRIDE);
+
+	/* Get or create the queue array and the ghost table */
+	if (buffer_replacement_policy == BUFFER_REPLACEMENT_2Q)
+	{
+		BufferQueues = (uint8 *)
+			ShmemInitStruct("Buffer Strategy Queues",
+							NBuffers * sizeof(uint8), &found);
+		if (!found)
+			MemSet(BufferQueues, BUF_QUEUE_NONE, NBuffers * sizeof(uint8));
+
+		GhostEntries = (pg_atomic_uint32 *)
+			ShmemInitStruct("Buffer Strategy Ghost Entries",
+							NUM_GHOST_ENTRIES * sizeof(pg_atomic_uint32),
+							&found);
+		if (!found)
+		{
+			for (i = 0; i < NUM_GHOST_ENTRIES; i++)
+				pg_atomic_init_u32(&GhostEntries[i], 0);
+		}
+	}
 }
 
 
@@ -173,6 +173,8 @@ static void KnownAssignedXidsReset(void);
 static inline void ProcArrayEndTransactionInternal(PGPROC *proc,
 								PGXACT *pgxact, TransactionId latestXid);
 static void ProcArrayGroupClearXid(PGPROC *proc, TransactionId latestXid);
+static bool GetSnapshotDataReuse(Snapshot snapshot);
+static void GetSnapshotDataInitOldSnapshot(Snapshot snapshot);
 
 /*
  * Report shared-memory space needed by CreateSharedProcArray.
@@ -246,6 +248,9 @@ CreateSharedProcArray(void)
 		procArray->headKnownAssignedXids = 0;
 		SpinLockInit(&procArray->known_assigned_xids_lck);
 		procArray->lastOverflowedXid = InvalidTransactionId;
+
+		/* 0 is reserved to mark snapshots that mustn't be reused */
+		ShmemVariableCache->xactCompletionCount = 1;
 	}
 
 	allProcs = ProcGlobal->allProcs;
@@ -356,6 +361,9 @@ ProcArrayRemove(PGPROC *proc, TransactionId latestXid)
 		if (TransactionIdPrecedes(ShmemVariableCache->latestCompletedXid,
 								  latestXid))
 			ShmemVariableCache->latestCompletedXid = latestXid;
+
+		/* Invalidate snapshots that still show the gxact as running */
+		ShmemVariableCache->xactCompletionCount++;
 	}
 	else
 	{
@@ -471,6 +479,9 @@ ProcArrayEndTransactionInternal(PGPROC *proc, PGXACT *pgxact,
 	if (TransactionIdPrecedes(ShmemVariableCache->latestCompletedXid,
 							  latestXid))
 		ShmemVariableCache->latestCompletedXid = latestXid;
+
+	/* Snapshots taken before now are no longer valid for reuse */
+	ShmemVariableCache->xactCompletionCount++;
 }
 
 /*
@@ -610,11 +621,15 @@ ProcArrayClearTransaction(PGPROC *proc)
 	PGXACT	   *pgxact = &allPgXact[proc->pgprocno];
 
 	/*
-	 * We can skip locking ProcArrayLock here, because this action does not
-	 * actually change anyone's view of the set of running XIDs: our entry is
-	 * duplicate with the gxact that has already been inserted into the
-	 * ProcArray.
+	 * This action does not actually change other backends' view of the set
+	 * of running XIDs, since our entry is duplicate with the gxact that has
+	 * already been inserted into the ProcArray.  But our own snapshots leave
+	 * our XID out of xip, so a snapshot built before the PREPARE must not be
+	 * reused after it: it would treat the prepared transaction as aborted.
+	 * Advance xactCompletionCount, which requires ProcArrayLock.
 	 */
+	LWLockAcquire(ProcArrayLock, LW_EXCLUSIVE);
+
 	pgxact->xid = InvalidTransactionId;
 	proc->lxid = InvalidLocalTransactionId;
 	pgxact->xmin = InvalidTransactionId;
@@ -627,6 +642,11 @@ ProcArrayClearTransaction(PGPROC *proc)
 	/* Clear the subtransaction-XID cache too */
 	pgxact->nxids = 0;
 	pgxact->overflowed = false;
+
+	/* Snapshots taken before now must not be reused */
+	ShmemVariableCache->xactCompletionCount++;
+
+	LWLockRelease(ProcArrayLock);
 }
 
 /*
@@ -1471,6 +1491,88 @@ GetMaxSnapshotSubxidCount(void)
 	return TOTAL_MAX_CACHED_SUBXIDS;
 }
 
+/*
+ * GetSnapshotDataReuse -- try to reuse the snapshot's previous contents
+ *
+ * The set of running transactions, and therefore xmin, xmax and the XID
+ * arrays, only changes in a way that matters to MVCC visibility when an
+ * XID-bearing transaction completes; transactions that acquire XIDs later
+ * are all >= the old xmax and thus already treated as running.  So if
+ * ShmemVariableCache->xactCompletionCount hasn't moved since this snapshot
+ * was built, its contents are still correct and we can skip the scan of
+ * the proc array.
+ *
+ * Caller must hold ProcArrayLock in at least shared mode, so that no
+ * transaction can complete before we have advertised our xmin.  That xmin
+ * can't be older than the current global xmin: the transaction that
+ * determined it is still running, or, if there was none, latestCompletedXid
+ * hasn't advanced either.
+ *
+ * RecentGlobalXmin and RecentGlobalDataXmin keep their values from the last
+ * full computation, which is conservative but harmless.
+ */
+static bool
+GetSnapshotDataReuse(Snapshot snapshot)
+{
+	Assert(LWLockHeldByMe(ProcArrayLock));
+
+	if (snapshot->snapXactCompletionCount == 0 ||
+		snapshot->snapXactCompletionCount !=
+		ShmemVariableCache->xactCompletionCount)
+		return false;
+
+	/* recovery snapshots are never marked reusable, see GetSnapshotData */
+	Assert(!snapshot->takenDuringRecovery);
+
+	if (!TransactionIdIsValid(MyPgXact->xmin))
+		MyPgXact->xmin = TransactionXmin = snapshot->xmin;
+
+	RecentXmin = snapshot->xmin;
+	Assert(TransactionIdPrecedesOrEquals(TransactionXmin, RecentXmin));
+
+	snapshot->curcid = GetCurrentCommandId(false);
+
+	/*
+	 * This is a new snapshot as far as the caller is concerned, so reset the
+	 * refcounts and mark it as not copied in persistent memory.
+	 */
+	snapshot->active_count = 0;
+	snapshot->regd_count = 0;
+	snapshot->copied = false;
+
+	return true;
+}
+
+/*
+ * GetSnapshotDataInitOldSnapshot -- set the "snapshot too old" fields
+ *
+ * Called by GetSnapshotData once ProcArrayLock has been released.
+ */
+static void
+GetSnapshotDataInitOldSnapshot(Snapshot snapshot)
+{
+	if (old_snapshot_threshold < 0)
+	{
+		/*
+		 * If not using "snapshot too old" feature, fill related fields with
+		 * dummy values that don't require any locking.
+		 */
+		snapshot->lsn = InvalidXLogRecPtr;
+		snapshot->whenTaken = 0;
+	}
+	else
+	{
+		/*
+		 * Capture the current time and WAL stream location in case this
+		 * snapshot becomes old enough to need to fall back on the special
+		 * "old snapshot" logic.
+		 */
+		snapshot->lsn = GetXLogInsertRecPtr();
+		snapshot->whenTaken = GetSnapshotCurrentTimestamp();
+		MaintainOldSnapshotTimeMapping(snapshot->whenTaken, snapshot->xmin);
+	}
+}
+
 /*
  * GetSnapshotData -- returns information about running transactions.
  *
@@ -1503,6 +1605,10 @@ GetMaxSnapshotSubxidCount(void)
  *		RecentGlobalDataXmin: the global xmin for non-catalog tables
  *			>= RecentGlobalXmin
  *
+ * If no XID-bearing transaction has completed since the snapshot was last
+ * filled in, its previous contents are returned without rescanning the proc
+ * array; see GetSnapshotDataReuse().
+ *
  * Note: this function should probably not be called with an argument that's
  * not statically allocated (see xip allocation below).
  */
@@ -1560,6 +1666,13 @@ GetSnapshotData(Snapshot snapshot)
 	 */
 	LWLockAcquire(ProcArrayLock, LW_SHARED);
 
+	if (GetSnapshotDataReuse(snapshot))
+	{
+		LWLockRelease(ProcArrayLock);
+		GetSnapshotDataInitOldSnapshot(snapshot);
+		return snapshot;
+	}
+
 	/* xmax is always latestCompletedXid + 1 */
 	xmax = ShmemVariableCache->latestCompletedXid;
 	Assert(TransactionIdIsNormal(xmax));
@@ -1711,6 +1824,19 @@ GetSnapshotData(Snapshot snapshot)
 	if (!TransactionIdIsValid(MyPgXact->xmin))
 		MyPgXact->xmin = TransactionXmin = xmin;
 
+	/*
+	 * Remember the completion count, so that the next call can return this
+	 * snapshot unchanged if no transaction has completed meanwhile.  The
+	 * expiry of KnownAssignedXids doesn't maintain the count, and XIDs can
+	 * become known below xmax during recovery anyway, so recovery snapshots
+	 * are always rebuilt.
+	 */
+	if (snapshot->takenDuringRecovery)
+		snapshot->snapXactCompletionCount = 0;
+	else
+		snapshot->snapXactCompletionCount =
+			ShmemVariableCache->xactCompletionCount;
+
 	LWLockRelease(ProcArrayLock);
 
 	/*
@@ -1760,26 +1886,7 @@ GetSnapshotData(Snapshot snapshot)
 	snapshot->regd_count = 0;
 	snapshot->copied = false;
 
-	if (old_snapshot_threshold < 0)
-	{
-		/*
-		 * If not using "snapshot too old" feature, fill related fields with
-		 * dummy values that don't require any locking.
-		 */
-		snapshot->lsn = InvalidXLogRecPtr;
-		snapshot->whenTaken = 0;
-	}
-	else
-	{
-		/*
-		 * Capture the current time and WAL stream location in case this
-		 * snapshot becomes old enough to need to fall back on the special
-		 * "old snapshot" logic.
-		 */
-		snapshot->lsn = GetXLogInsertRecPtr();
-		snapshot->whenTaken = GetSnapshotCurrentTimestamp();
-		MaintainOldSnapshotTimeMapping(snapshot->whenTaken, xmin);
-	}
+	GetSnapshotDataInitOldSnapshot(snapshot);
 
 	return snapshot;
 }
@@ -3067,6 +3174,9 @@ XidCacheRemoveRunningXids(TransactionId xid,
 							  latestXid))
 		ShmemVariableCache->latestCompletedXid = latestXid;
 
+	/* As in ProcArrayEndTransactionInternal, snapshots must be rebuilt */
+	ShmemVariableCache->xactCompletionCount++;
+
 	LWLockRelease(ProcArrayLock);
 }
 
@@ -659,7 +659,14 @@ mdprefetch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum)
 	off_t		seekpos;
 	MdfdVec    *v;
 
-	v = _mdfd_getseg(reln, forknum, blocknum, false, EXTENSION_FAIL);
+	/*
+	 * There's nothing to read ahead if the block doesn't exist.  That's not
+	 * an error: during recovery, blocks can be prefetched before the WAL
+	 * record that creates them is replayed.
+	 */
+	v = _mdfd_getseg(reln, forknum, blocknum, false, EXTENSION_RETURN_NULL);
+	if (v == NULL)
+		return;
 
 	seekpos = (off_t) BLCKSZ *(blocknum % ((BlockNumber) RELSEG_SIZE));
 
@@ -28,11 +28,19 @@
 #include "utils/int8.h"
 #include "utils/jsonb.h"
 #include "utils/lsyscache.h"
+#include "utils/sortsupport.h"
 #include "utils/typcache.h"
 
 #define GRAPHID_FMTSTR			"%hu." UINT64_FORMAT
 #define GRAPHID_BUFLEN			32	/* "65535.281474976710655" */
 
+/*
+ * Maximum number of edges followed from a single vertex while traversing a
+ * graph (VLE and shortestpath). 0 means no limit.  The edges followed are
+ * the first ones the edge scan returns; the rest are not read at all.
+ */
+int			graph_traversal_max_degree = 0;
+
 typedef struct LabelOutData {
 	uint16		label_labid;
 	NameData	label;
@@ -50,6 +58,9 @@ typedef enum EdgeVertexKind {
 
 static void graphid_out_si(StringInfo si, Datum graphid);
 static int graphid_cmp(FunctionCallInfo fcinfo);
+#ifndef USE_FLOAT8_BYVAL
+static int graphid_fastcmp(Datum x, Datum y, SortSupport ssup);
+#endif
 static Jsonb *int_to_jsonb(int i);
 static LabelOutData *cache_label(FmgrInfo *flinfo, uint16 labid);
 static void elems_out_si(StringInfo si, AnyArrayType *elems, FmgrInfo *flinfo);
@@ -1320,6 +1331,37 @@ btgraphidcmp(PG_FUNCTION_ARGS)
 	PG_RETURN_INT32(graphid_cmp(fcinfo));
 }
 
+#ifndef USE_FLOAT8_BYVAL
+static int
+graphid_fastcmp(Datum x, Datum y, SortSupport ssup)
+{
+	Graphid		id1 = DatumGetGraphid(x);
+	Graphid		id2 = DatumGetGraphid(y);
+
+	if (id1 < id2)
+		return -1;
+	if (id1 > id2)
+		return 1;
+
+	return 0;
+}
+#endif
+
+/* BTSORTSUPPORT_PROC (2) */
+Datum
+btgraphidsortsupport(PG_FUNCTION_ARGS)
+{
+	SortSupport ssup = (SortSupport) PG_GETARG_POINTER(0);
+
+#ifdef USE_FLOAT8_BYVAL
+	/* graphid orders like its uint64 Datum, so tuplesort can radix sort it */
+	ssup->comparator = ssup_datum_unsigned_cmp;
+#else
+	ssup->comparator = graphid_fastcmp;
+#endif
+	PG_RETURN_VOID();
+}
+
 /*
  * Hash support functions
  */
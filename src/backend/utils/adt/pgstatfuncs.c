@@ -15,11 +15,13 @@
 #include "postgres.h"
 
 #include "access/htup_details.h"
+#include "access/xlogprefetch.h"
 #include "catalog/pg_type.h"
 #include "funcapi.h"
 #include "libpq/ip.h"
 #include "miscadmin.h"
 #include "pgstat.h"
+#include "storage/bufmgr.h"
 #include "storage/proc.h"
 #include "storage/procarray.h"
 #include "utils/acl.h"
@@ -96,6 +98,10 @@ extern Datum pg_stat_get_db_blk_write_time(PG_FUNCTION_ARGS);
 
 extern Datum pg_stat_get_archiver(PG_FUNCTION_ARGS);
 
+extern Datum pg_stat_get_buffer_replacement(PG_FUNCTION_ARGS);
+extern Datum pg_stat_get_buffer_nodes(PG_FUNCTION_ARGS);
+extern Datum pg_stat_get_recovery_prefetch(PG_FUNCTION_ARGS);
+
 extern Datum pg_stat_get_bgwriter_timed_checkpoints(PG_FUNCTION_ARGS);
 extern Datum pg_stat_get_bgwriter_requested_checkpoints(PG_FUNCTION_ARGS);
 extern Datum pg_stat_get_checkpoint_write_time(PG_FUNCTION_ARGS);
@@ -1931,3 +1937,167 @@ pg_stat_get_archiver(PG_FUNCTION_ARGS)
 	PG_RETURN_DATUM(HeapTupleGetDatum(
 								   heap_form_tuple(tupdesc, values, nulls)));
 }
+
+Datum
+pg_stat_get_buffer_replacement(PG_FUNCTION_ARGS)
+{
+	TupleDesc	tupdesc;
+	Datum		values[6];
+	bool		nulls[6];
+	BufferReplacementStats stats;
+
+	/* Initialise values and NULL flags arrays */
+	MemSet(values, 0, sizeof(values));
+	MemSet(nulls, 0, sizeof(nulls));
+
+	/* Initialise attributes information in the tuple descriptor */
+	tupdesc = CreateTemplateTupleDesc(6, false);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 1, "policy",
+					   TEXTOID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 2, "hits",
+					   INT8OID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 3, "misses",
+					   INT8OID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 4, "ghost_hits",
+					   INT8OID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 5, "evictions",
+					   INT8OID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 6, "probation_evictions",
+					   INT8OID, -1, 0);
+
+	BlessTupleDesc(tupdesc);
+
+	/* Get the counters of the buffer replacement strategy */
+	StrategyGetStats(&stats);
+
+	/* Fill values */
+	if (buffer_replacement_policy == BUFFER_REPLACEMENT_2Q)
+		values[0] = CStringGetTextDatum("2q");
+	else
+		values[0] = CStringGetTextDatum("clock");
+	values[1] = Int64GetDatum(stats.hits);
+	values[2] = Int64GetDatum(stats.misses);
+	values[3] = Int64GetDatum(stats.ghost_hits);
+	values[4] = Int64GetDatum(stats.evictions);
+	values[5] = Int64GetDatum(stats.probation_evictions);
+
+	/* Returns the record as Datum */
+	PG_RETURN_DATUM(HeapTupleGetDatum(
+								   heap_form_tuple(tupdesc, values, nulls)));
+}
+
+/*
+ * Returns the buffer counters of each NUMA node shared buffers are divided
+ * among.
+ */
+Datum
+pg_stat_get_buffer_nodes(PG_FUNCTION_ARGS)
+{
+#define PG_STAT_GET_BUFFER_NODES_COLS	6
+	TupleDesc	tupdesc;
+	Tuplestorestate *tupstore;
+	ReturnSetInfo *rsinfo = (ReturnSetInfo *) fcinfo->resultinfo;
+	MemoryContext per_query_ctx;
+	MemoryContext oldcontext;
+	BufferNodeStats *stats;
+	int			node;
+
+	/* check to see if caller supports us returning a tuplestore */
+	if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("set-valued function called in context that cannot accept a set")));
+	if (!(rsinfo->allowedModes & SFRM_Materialize))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("materialize mode required, but it is not " \
+						"allowed in this context")));
+
+	/* Build a tuple descriptor for our result type */
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	per_query_ctx = rsinfo->econtext->ecxt_per_query_memory;
+	oldcontext = MemoryContextSwitchTo(per_query_ctx);
+
+	tupstore = tuplestore_begin_heap(true, false, work_mem);
+	rsinfo->returnMode = SFRM_Materialize;
+	rsinfo->setResult = tupstore;
+	rsinfo->setDesc = tupdesc;
+	MemoryContextSwitchTo(oldcontext);
+
+	stats = (BufferNodeStats *) palloc(numa_nodes * sizeof(BufferNodeStats));
+	StrategyGetNodeStats(stats);
+
+	for (node = 0; node < numa_nodes; node++)
+	{
+		Datum		values[PG_STAT_GET_BUFFER_NODES_COLS];
+		bool		nulls[PG_STAT_GET_BUFFER_NODES_COLS];
+
+		MemSet(nulls, 0, sizeof(nulls));
+
+		values[0] = Int32GetDatum(node);
+		values[1] = Int32GetDatum(stats[node].buffers);
+		values[2] = Int64GetDatum(stats[node].local_hits);
+		values[3] = Int64GetDatum(stats[node].remote_hits);
+		values[4] = Int64GetDatum(stats[node].local_reads);
+		values[5] = Int64GetDatum(stats[node].remote_reads);
+
+		tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+	}
+
+	pfree(stats);
+
+	/* clean up and return the tuplestore */
+	tuplestore_donestoring(tupstore);
+
+	return (Datum) 0;
+}
+
+/*
+ * Returns the counters of the WAL prefetcher of the current (or last)
+ * recovery.
+ */
+Datum
+pg_stat_get_recovery_prefetch(PG_FUNCTION_ARGS)
+{
+	TupleDesc	tupdesc;
+	Datum		values[6];
+	bool		nulls[6];
+	XLogPrefetchStats stats;
+
+	/* Initialise values and NULL flags arrays */
+	MemSet(values, 0, sizeof(values));
+	MemSet(nulls, 0, sizeof(nulls));
+
+	/* Initialise attributes information in the tuple descriptor */
+	tupdesc = CreateTemplateTupleDesc(6, false);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 1, "prefetch",
+					   INT8OID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 2, "skip_hit",
+					   INT8OID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 3, "skip_new",
+					   INT8OID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 4, "skip_fpw",
+					   INT8OID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 5, "skip_rep",
+					   INT8OID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 6, "distance",
+					   INT8OID, -1, 0);
+
+	BlessTupleDesc(tupdesc);
+
+	XLogPrefetchGetStats(&stats);
+
+	/* Fill values */
+	values[0] = Int64GetDatum(stats.prefetch);
+	values[1] = Int64GetDatum(stats.skip_hit);
+	values[2] = Int64GetDatum(stats.skip_new);
+	values[3] = Int64GetDatum(stats.skip_fpw);
+	values[4] = Int64GetDatum(stats.skip_rep);
+	values[5] = Int64GetDatum(stats.distance);
+
+	/* Returns the record as Datum */
+	PG_RETURN_DATUM(HeapTupleGetDatum(
+								   heap_form_tuple(tupdesc, values, nulls)));
+}
@@ -4511,6 +4511,46 @@ pg_column_size(PG_FUNCTION_ARGS)
 	PG_RETURN_INT32(result);
 }
 
+/*
+ * Return the compression method of a datum, or NULL if it isn't compressed
+ *
+ * Works on any data type
+ */
+Datum
+pg_column_compression(PG_FUNCTION_ARGS)
+{
+	Datum		value = PG_GETARG_DATUM(0);
+	int			typlen;
+	int			cmethod;
+
+	/* On first call, get the input type's typlen, and save at *fn_extra */
+	if (fcinfo->flinfo->fn_extra == NULL)
+	{
+		/* Lookup the datatype of the supplied argument */
+		Oid			argtypeid = get_fn_expr_argtype(fcinfo->flinfo, 0);
+
+		typlen = get_typlen(argtypeid);
+		if (typlen == 0)		/* should not happen */
+			elog(ERROR, "cache lookup failed for type %u", argtypeid);
+
+		fcinfo->flinfo->fn_extra = MemoryContextAlloc(fcinfo->flinfo->fn_mcxt,
+													  sizeof(int));
+		*((int *) fcinfo->flinfo->fn_extra) = typlen;
+	}
+	else
+		typlen = *((int *) fcinfo->flinfo->fn_extra);
+
+	/* only varlena types can be compressed */
+	if (typlen != -1)
+		PG_RETURN_NULL();
+
+	cmethod = toast_get_compression_id((struct varlena *) DatumGetPointer(value));
+	if (cmethod == TOAST_INVALID_COMPRESSION_ID)
+		PG_RETURN_NULL();
+
+	PG_RETURN_TEXT_P(cstring_to_text(toast_compression_name(cmethod)));
+}
+
 /*
  * string_agg - Concatenates values and returns string.
  *
@@ -507,6 +507,24 @@ MemoryContextStatsDetail(MemoryContext context, int max_children)
 			grand_totals.totalspace - grand_totals.freespace);
 }
 
+/*
+ * MemoryContextMemConsumed
+ *		Add up the memory held by the named context and all its descendants.
+ *
+ * Unlike MemoryContextStats, nothing is printed; the counts are returned in
+ * *consumed.  This has to visit every block of every context, so callers
+ * that keep an eye on their memory usage shouldn't call it for each
+ * allocation.
+ */
+void
+MemoryContextMemConsumed(MemoryContext context,
+						 MemoryContextCounters *consumed)
+{
+	memset(consumed, 0, sizeof(*consumed));
+
+	MemoryContextStatsInternal(context, 0, false, PG_INT32_MAX, consumed);
+}
+
 /*
  * MemoryContextStatsInternal
  *		One recursion level for MemoryContextStats
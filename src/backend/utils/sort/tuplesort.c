@@ -568,6 +568,9 @@ static void dumpbatch(Tuplesortstate *state, bool alltuples);
 static void make_bounded_heap(Tuplesortstate *state);
 static void sort_bounded_heap(Tuplesortstate *state);
 static void tuplesort_sort_memtuples(Tuplesortstate *state);
+#if SIZEOF_DATUM >= 8
+static bool tuplesort_radix_sort(Tuplesortstate *state);
+#endif
 static void tuplesort_heap_insert(Tuplesortstate *state, SortTuple *tuple,
 					  int tupleindex, bool checkIndex);
 static void tuplesort_heap_siftup(Tuplesortstate *state, bool checkIndex);
@@ -620,6 +623,14 @@ static void free_sort_tuple(Tuplesortstate *state, SortTuple *stup);
  */
 #include "qsort_tuple.c"
 
+/*
+ * Below RADIX_SORT_MIN_TUPLES tuples, quicksort beats the fixed cost of the
+ * radix sort's counting pass and its 256-entry bucket tables.
+ */
+#define RADIX_SORT_MIN_TUPLES	1024
+#define RADIX_SORT_BITS			8
+#define RADIX_SORT_BUCKETS		(1 << RADIX_SORT_BITS)
+
 
 /*
  *		tuplesort_begin_xxx
@@ -3731,6 +3742,12 @@ tuplesort_sort_memtuples(Tuplesortstate *state)
 {
 	if (state->memtupcount > 1)
 	{
+#if SIZEOF_DATUM >= 8
+		/* Can we radix sort on datum1? */
+		if (tuplesort_radix_sort(state))
+			return;
+#endif
+
 		/* Can we use the single-key sort function? */
 		if (state->onlyKey != NULL)
 			qsort_ssup(state->memtuples, state->memtupcount,
@@ -3743,6 +3760,200 @@ tuplesort_sort_memtuples(Tuplesortstate *state)
 	}
 }
 
+#if SIZEOF_DATUM >= 8
+/*
+ * Sort all memtuples with an LSD radix sort on datum1, if possible.
+ *
+ * This applies when datum1 is the whole sort key and the key's comparator
+ * is one of the plain integer comparisons below: single-key MinimalTuple and
+ * Datum sorts, and B-tree index builds on one column that need not enforce
+ * uniqueness (they only break ties by heap TID to get a nicer physical order,
+ * which the stable radix sort mostly preserves anyway).
+ *
+ * Keys are mapped to unsigned integers that sort in the required order,
+ * then distributed 8 bits at a time, least significant byte first, between
+ * memtuples and a scratch array.  Passes over a byte that is the same in all
+ * keys are skipped, so keys drawn from a narrow range, such as the graphids
+ * of one label, only take a few passes.  NULLs are set aside up front.
+ *
+ * The scratch array must fit in the sort's remaining memory; if it doesn't,
+ * we return false and the caller quicksorts instead.
+ */
+static bool
+tuplesort_radix_sort(Tuplesortstate *state)
+{
+	SortSupport ssup = state->sortKeys;
+	SortTuple  *memtuples = state->memtuples;
+	int			n = state->memtupcount;
+	Size		scratchsize = (Size) n * sizeof(SortTuple);
+	SortTuple  *scratch;
+	SortTuple  *src;
+	SortTuple  *dst;
+	SortTuple  *keys;
+	uint64		xormask;
+	int			counts[sizeof(Datum)][RADIX_SORT_BUCKETS];
+	int			nkeys;
+	int			nnulls;
+	int			pass;
+	int			i;
+
+	if (n < RADIX_SORT_MIN_TUPLES || state->nKeys != 1)
+		return false;
+	if (state->onlyKey == NULL &&
+		(state->comparetup != comparetup_index_btree || state->enforceUnique))
+		return false;
+	/* hash index builds have no sort key at all */
+	if (ssup == NULL || ssup->abbrev_converter != NULL)
+		return false;
+
+	if (ssup->comparator == ssup_datum_unsigned_cmp)
+		xormask = 0;
+	else if (ssup->comparator == ssup_datum_signed_cmp)
+		xormask = UINT64CONST(1) << 63;	/* flip the sign bit */
+	else
+		return false;
+	if (ssup->ssup_reverse)
+		xormask = ~xormask;
+
+	if (state->availMem < (int64) scratchsize)
+		return false;
+	scratch = (SortTuple *) MemoryContextAllocHuge(state->sortcontext,
+												   scratchsize);
+	USEMEM(state, GetMemoryChunkSpace(scratch));
+
+	/* Count the values of every byte of the keys in one pass */
+	memset(counts, 0, sizeof(counts));
+	nkeys = 0;
+	for (i = 0; i < n; i++)
+	{
+		uint64		key;
+
+		if (memtuples[i].isnull1)
+			continue;
+		key = DatumGetUInt64(memtuples[i].datum1) ^ xormask;
+		for (pass = 0; pass < sizeof(Datum); pass++)
+			counts[pass][(key >> (pass * RADIX_SORT_BITS)) &
+						 (RADIX_SORT_BUCKETS - 1)]++;
+		nkeys++;
+	}
+	nnulls = n - nkeys;
+
+	/*
+	 * Move the non-null keys to the front of the scratch array and the NULLs
+	 * behind them, then put the NULLs where they belong in the output.  The
+	 * keys are sorted within their final stretch of memtuples.
+	 */
+	if (nnulls > 0)
+	{
+		int			nextkey = 0;
+		int			nextnull = nkeys;
+
+		for (i = 0; i < n; i++)
+		{
+			if (memtuples[i].isnull1)
+				scratch[nextnull++] = memtuples[i];
+			else
+				scratch[nextkey++] = memtuples[i];
+		}
+		if (ssup->ssup_nulls_first)
+		{
+			memcpy(memtuples, scratch + nkeys, nnulls * sizeof(SortTuple));
+			keys = memtuples + nnulls;
+		}
+		else
+		{
+			memcpy(memtuples + nkeys, scratch + nkeys,
+				   nnulls * sizeof(SortTuple));
+			keys = memtuples;
+		}
+		src = scratch;
+		dst = keys;
+	}
+	else
+	{
+		keys = memtuples;
+		src = memtuples;
+		dst = scratch;
+	}
+
+	for (pass = 0; pass < sizeof(Datum); pass++)
+	{
+		int			shift = pass * RADIX_SORT_BITS;
+		int			offsets[RADIX_SORT_BUCKETS];
+		int			offset = 0;
+		int			b;
+		SortTuple  *swap;
+
+		/* A byte that is equal in all keys leaves the order as it is */
+		if (counts[pass][(DatumGetUInt64(src[0].datum1) ^ xormask) >> shift &
+						 (RADIX_SORT_BUCKETS - 1)] == nkeys)
+			continue;
+
+		for (b = 0; b < RADIX_SORT_BUCKETS; b++)
+		{
+			offsets[b] = offset;
+			offset += counts[pass][b];
+		}
+
+		for (i = 0; i < nkeys; i++)
+		{
+			uint64		key = DatumGetUInt64(src[i].datum1) ^ xormask;
+
+			dst[offsets[(key >> shift) & (RADIX_SORT_BUCKETS - 1)]++] = src[i];
+		}
+
+		swap = src;
+		src = dst;
+		dst = swap;
+
+		CHECK_FOR_INTERRUPTS();
+	}
+
+	if (src != keys)
+		memcpy(keys, src, nkeys * sizeof(SortTuple));
+
+	FREEMEM(state, GetMemoryChunkSpace(scratch));
+	pfree(scratch);
+
+	return true;
+}
+#endif   /* SIZEOF_DATUM >= 8 */
+
+/*
+ * Datum comparators that tuplesort can radix sort on.  Datatypes whose
+ * pass-by-value representation orders like a plain integer should use one
+ * of these in their sortsupport routine.
+ */
+int
+ssup_datum_unsigned_cmp(Datum x, Datum y, SortSupport ssup)
+{
+	if (x < y)
+		return -1;
+	else if (x > y)
+		return 1;
+	else
+		return 0;
+}
+
+int
+ssup_datum_signed_cmp(Datum x, Datum y, SortSupport ssup)
+{
+#if SIZEOF_DATUM >= 8
+	int64		xx = (int64) x;
+	int64		yy = (int64) y;
+#else
+	int32		xx = (int32) x;
+	int32		yy = (int32) y;
+#endif
+
+	if (xx < yy)
+		return -1;
+	else if (xx > yy)
+		return 1;
+	else
+		return 0;
+}
+
 /*
  * Insert a new tuple into an empty or existing heap, maintaining the
  * heap invariant.  Caller is responsible for ensuring there's room.
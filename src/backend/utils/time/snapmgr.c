@@ -598,6 +598,9 @@ SetTransactionSnapshot(Snapshot sourcesnap, TransactionId sourcexid,
 	CurrentSnapshot->takenDuringRecovery = sourcesnap->takenDuringRecovery;
 	/* NB: curcid should NOT be copied, it's a local matter */
 
+	/* The next GetSnapshotData call must not reuse the imported contents */
+	CurrentSnapshot->snapXactCompletionCount = 0;
+
 	/*
 	 * Now we have to fix what GetSnapshotData did with MyPgXact->xmin and
 	 * TransactionXmin.  There is a race condition: to make sure we are not
@@ -2096,6 +2099,7 @@ RestoreSnapshot(char *start_address)
 	snapshot->curcid = serialized_snapshot->curcid;
 	snapshot->whenTaken = serialized_snapshot->whenTaken;
 	snapshot->lsn = serialized_snapshot->lsn;
+	snapshot->snapXactCompletionCount = 0;
 
 	/* Copy XIDs, if present. */
 	if (serialized_snapshot->xcnt > 0)
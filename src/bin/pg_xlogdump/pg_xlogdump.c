@@ -488,15 +488,26 @@ XLogDumpDisplayRecord(XLogDumpConfig *config, XLogReaderState *record)
 				   blk);
 			if (XLogRecHasBlockImage(record, block_id))
 			{
-				if (record->blocks[block_id].bimg_info &
-					BKPIMAGE_IS_COMPRESSED)
+				uint8		bimg_info = record->blocks[block_id].bimg_info;
+
+				if (BKPIMAGE_COMPRESSED(bimg_info))
 				{
-					printf(" (FPW); hole: offset: %u, length: %u, compression saved: %u\n",
+					const char *method;
+
+					if (bimg_info & BKPIMAGE_COMPRESS_PGLZ)
+						method = "pglz";
+					else if (bimg_info & BKPIMAGE_COMPRESS_LZ4)
+						method = "lz4";
+					else
+						method = "zstd";
+
+					printf(" (FPW); hole: offset: %u, length: %u, compression saved: %u, method: %s\n",
 						   record->blocks[block_id].hole_offset,
 						   record->blocks[block_id].hole_length,
 						   BLCKSZ -
 						   record->blocks[block_id].hole_length -
-						   record->blocks[block_id].bimg_len);
+						   record->blocks[block_id].bimg_len,
+						   method);
 				}
 				else
 				{
@@ -0,0 +1,42 @@
+/*-------------------------------------------------------------------------
+ *
+ * redoworker.h
+ *	  Parallel WAL replay using background worker processes
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * src/include/access/redoworker.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef REDOWORKER_H
+#define REDOWORKER_H
+
+#include "access/xlogreader.h"
+#include "storage/relfilenode.h"
+
+/* upper limit for recovery_workers */
+#define MAX_REDO_WORKERS	64
+
+/* GUC */
+extern int	recovery_workers;
+
+/* true in a redo worker process */
+extern bool IsRedoWorker;
+
+extern Size RedoWorkerShmemSize(void);
+extern void RedoWorkerShmemInit(void);
+
+/* functions called by the startup process */
+extern void StartRedoWorkers(void);
+extern bool DispatchRedoRecord(XLogReaderState *record);
+extern void WaitForRedoWorkers(void);
+extern void StopRedoWorkers(void);
+
+/* functions called by redo workers */
+extern void RedoWorkerMain(Datum main_arg);
+extern void RedoWorkerReportInvalidPage(RelFileNode node, ForkNumber forkno,
+							BlockNumber blkno, bool present);
+
+#endif   /* REDOWORKER_H */
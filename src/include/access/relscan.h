@@ -125,8 +125,28 @@ typedef struct IndexScanDescData
 
 	/* state data for traversing HOT chains in index_getnext */
 	bool		xs_continue_hot;	/* T if must keep walking HOT chain */
+
+	/* parallel index scan information, in shared memory */
+	ParallelIndexScanDesc parallel_scan;
+	bool		xs_temp_snap;	/* unregister snapshot at scan end? */
 }	IndexScanDescData;
 
+/*
+ * Shared state for parallel index scan.
+ *
+ * Like ParallelHeapScanDescData, this lives in the dynamic shared memory of
+ * the parallel query, and each participant's IndexScanDesc points to it.
+ * The index AM's own shared state follows it, at ps_offset bytes from the
+ * start of the struct.
+ */
+typedef struct ParallelIndexScanDescData
+{
+	Oid			ps_relid;		/* OID of heap relation to scan */
+	Oid			ps_indexid;		/* OID of index to scan */
+	Size		ps_offset;		/* offset of AM-specific shared state */
+	char		ps_snapshot_data[FLEXIBLE_ARRAY_MEMBER];
+}	ParallelIndexScanDescData;
+
 /* Struct for heap-or-index scans of system tables */
 typedef struct SysScanDescData
 {
@@ -134,6 +134,13 @@ typedef struct VariableCacheData
 	 */
 	TransactionId latestCompletedXid;	/* newest XID that has committed or
 										 * aborted */
+
+	/*
+	 * Number of top-level transactions with XIDs completed (committed or
+	 * aborted) since startup, also protected by ProcArrayLock.  Used to
+	 * check whether GetSnapshotData() can return a previous result.
+	 */
+	uint64		xactCompletionCount;
 } VariableCacheData;
 
 typedef VariableCacheData *VariableCache;
@@ -193,13 +193,52 @@ extern Datum toast_flatten_tuple_to_datum(HeapTupleHeader tup,
 							 uint32 tup_len,
 							 TupleDesc tupleDesc);
 
+/*
+ * Compression methods of compressed varlenas.  The id is kept in the two
+ * high bits of the raw size, see VARCOMPRESS_4B_C().
+ */
+#define TOAST_PGLZ_COMPRESSION_ID		0
+#define TOAST_LZ4_COMPRESSION_ID		1
+#define TOAST_ZSTD_COMPRESSION_ID		2
+
+#define TOAST_INVALID_COMPRESSION_ID	(-1)
+
+/* GUC */
+extern int	default_toast_compression;
+
 /* ----------
  * toast_compress_datum -
  *
- *	Create a compressed version of a varlena datum, if possible
+ *	Create a compressed version of a varlena datum, if possible, using
+ *	the given compression method
+ * ----------
+ */
+extern Datum toast_compress_datum(Datum value, int cmethod);
+
+/* ----------
+ * toast_get_compression_id -
+ *
+ *	Return the compression method of a varlena datum, or
+ *	TOAST_INVALID_COMPRESSION_ID if it isn't compressed
+ * ----------
+ */
+extern int	toast_get_compression_id(struct varlena * attr);
+
+/* ----------
+ * toast_compression_name -
+ *
+ *	Return the name of a compression method
+ * ----------
+ */
+extern const char *toast_compression_name(int cmethod);
+
+/* ----------
+ * toastValidateCompressionOption -
+ *
+ *	Check the value of the "compression" attribute option
  * ----------
  */
-extern Datum toast_compress_datum(Datum value);
+extern void toastValidateCompressionOption(char *value);
 
 /* ----------
  * toast_raw_datum_size -
@@ -103,7 +103,7 @@ extern char *XLogArchiveCommand;
 extern bool EnableHotStandby;
 extern bool fullPageWrites;
 extern bool wal_log_hints;
-extern bool wal_compression;
+extern int	wal_compression;
 extern bool log_checkpoints;
 
 extern int	CheckPointSegments;
@@ -117,6 +117,15 @@ typedef enum ArchiveMode
 } ArchiveMode;
 extern int	XLogArchiveMode;
 
+/* Compression methods of full-page images, for wal_compression */
+typedef enum WalCompression
+{
+	WAL_COMPRESSION_NONE = 0,
+	WAL_COMPRESSION_PGLZ,
+	WAL_COMPRESSION_LZ4,
+	WAL_COMPRESSION_ZSTD
+} WalCompression;
+
 /* WAL levels */
 typedef enum WalLevel
 {
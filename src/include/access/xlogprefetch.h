@@ -0,0 +1,47 @@
+/*-------------------------------------------------------------------------
+ *
+ * xlogprefetch.h
+ *	  Prefetching of blocks referenced by WAL records during recovery
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * src/include/access/xlogprefetch.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef XLOGPREFETCH_H
+#define XLOGPREFETCH_H
+
+#include "access/xlogreader.h"
+
+/* upper limit for recovery_prefetch_distance, in kB */
+#define MAX_RECOVERY_PREFETCH_DISTANCE	(1024 * 1024)
+
+/* GUC */
+extern int	recovery_prefetch_distance;
+
+typedef struct XLogPrefetcher XLogPrefetcher;
+
+/* counters shown by pg_stat_get_recovery_prefetch() */
+typedef struct XLogPrefetchStats
+{
+	uint64		prefetch;		/* blocks whose read was initiated */
+	uint64		skip_hit;		/* blocks already in shared buffers */
+	uint64		skip_new;		/* blocks that redo will initialize */
+	uint64		skip_fpw;		/* blocks that redo will restore from FPIs */
+	uint64		skip_rep;		/* blocks prefetched recently */
+	uint64		distance;		/* bytes of WAL decoded ahead of replay */
+} XLogPrefetchStats;
+
+extern Size XLogPrefetchShmemSize(void);
+extern void XLogPrefetchShmemInit(void);
+
+extern XLogPrefetcher *XLogPrefetcherAllocate(void);
+extern void XLogPrefetcherFree(XLogPrefetcher *prefetcher);
+extern void XLogPrefetcherReadAhead(XLogPrefetcher *prefetcher,
+						XLogReaderState *replay, TimeLineID tli);
+
+extern void XLogPrefetchGetStats(XLogPrefetchStats *stats);
+
+#endif   /* XLOGPREFETCH_H */
@@ -106,7 +106,8 @@ typedef struct XLogRecordBlockHeader
  * present is BLCKSZ - the length of "hole" bytes.
  *
  * When wal_compression is enabled, a full page image which "hole" was
- * removed is additionally compressed using PGLZ compression algorithm.
+ * removed is additionally compressed using the PGLZ, LZ4 or Zstandard
+ * compression algorithm, as chosen by wal_compression.
  * This can reduce the WAL volume, but at some extra cost of CPU spent
  * on the compression during WAL logging. In this case, since the "hole"
  * length cannot be calculated by subtracting the number of page image bytes
@@ -126,7 +127,7 @@ typedef struct XLogRecordBlockImageHeader
 	uint8		bimg_info;		/* flag bits, see below */
 
 	/*
-	 * If BKPIMAGE_HAS_HOLE and BKPIMAGE_IS_COMPRESSED, an
+	 * If BKPIMAGE_HAS_HOLE and BKPIMAGE_COMPRESSED(), an
 	 * XLogRecordBlockCompressHeader struct follows.
 	 */
 } XLogRecordBlockImageHeader;
@@ -136,7 +137,14 @@ typedef struct XLogRecordBlockImageHeader
 
 /* Information stored in bimg_info */
 #define BKPIMAGE_HAS_HOLE		0x01	/* page image has "hole" */
-#define BKPIMAGE_IS_COMPRESSED		0x02		/* page image is compressed */
+/* compression methods supported, at most one is set */
+#define BKPIMAGE_COMPRESS_PGLZ	0x02	/* page image is compressed with pglz */
+#define BKPIMAGE_COMPRESS_LZ4	0x04	/* page image is compressed with LZ4 */
+#define BKPIMAGE_COMPRESS_ZSTD	0x08	/* page image is compressed with zstd */
+
+#define BKPIMAGE_COMPRESSED(info) \
+	(((info) & (BKPIMAGE_COMPRESS_PGLZ | BKPIMAGE_COMPRESS_LZ4 | \
+				BKPIMAGE_COMPRESS_ZSTD)) != 0)
 
 /*
  * Extra header information used when page image has "hole" and
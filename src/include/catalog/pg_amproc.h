@@ -675,6 +675,7 @@ DATA(insert (	4104   603	 603  13  187 ));
  */
 /* BTree */
 DATA(insert ( 7093 7002 7002  1 7094 ));
+DATA(insert ( 7093 7002 7002  2 7095 ));
 /* Hash */
 DATA(insert ( 7096 7002 7002  1 7097 ));
 /* GIN (as BTree) */
@@ -2825,6 +2825,12 @@ DATA(insert OID = 2845 (  pg_stat_get_db_blk_write_time PGNSP PGUID 12 1 0 0 0 f
 DESCR("statistics: block write time, in msec");
 DATA(insert OID = 3195 (  pg_stat_get_archiver		PGNSP PGUID 12 1 0 0 0 f f f f f f s r 0 0 2249 "" "{20,25,1184,20,25,1184,1184}" "{o,o,o,o,o,o,o}" "{archived_count,last_archived_wal,last_archived_time,failed_count,last_failed_wal,last_failed_time,stats_reset}" _null_ _null_ pg_stat_get_archiver _null_ _null_ _null_ ));
 DESCR("statistics: information about WAL archiver");
+DATA(insert OID = 3344 (  pg_stat_get_buffer_replacement	PGNSP PGUID 12 1 0 0 0 f f f f f f v r 0 0 2249 "" "{25,20,20,20,20,20}" "{o,o,o,o,o,o}" "{policy,hits,misses,ghost_hits,evictions,probation_evictions}" _null_ _null_ pg_stat_get_buffer_replacement _null_ _null_ _null_ ));
+DESCR("statistics: shared buffer replacement");
+DATA(insert OID = 3345 (  pg_stat_get_buffer_nodes	PGNSP PGUID 12 1 16 0 0 f f f f f t v r 0 0 2249 "" "{23,23,20,20,20,20}" "{o,o,o,o,o,o}" "{node,buffers,local_hits,remote_hits,local_reads,remote_reads}" _null_ _null_ pg_stat_get_buffer_nodes _null_ _null_ _null_ ));
+DESCR("statistics: shared buffers of each NUMA node");
+DATA(insert OID = 3346 (  pg_stat_get_recovery_prefetch	PGNSP PGUID 12 1 0 0 0 f f f f f f v r 0 0 2249 "" "{20,20,20,20,20,20}" "{o,o,o,o,o,o}" "{prefetch,skip_hit,skip_new,skip_fpw,skip_rep,distance}" _null_ _null_ pg_stat_get_recovery_prefetch _null_ _null_ _null_ ));
+DESCR("statistics: WAL prefetching during recovery");
 DATA(insert OID = 2769 ( pg_stat_get_bgwriter_timed_checkpoints PGNSP PGUID 12 1 0 0 0 f f f f t f s r 0 0 20 "" _null_ _null_ _null_ _null_ _null_ pg_stat_get_bgwriter_timed_checkpoints _null_ _null_ _null_ ));
 DESCR("statistics: number of timed checkpoints started by the bgwriter");
 DATA(insert OID = 2770 ( pg_stat_get_bgwriter_requested_checkpoints PGNSP PGUID 12 1 0 0 0 f f f f t f s r 0 0 20 "" _null_ _null_ _null_ _null_ _null_ pg_stat_get_bgwriter_requested_checkpoints _null_ _null_ _null_ ));
@@ -3633,6 +3639,8 @@ DESCR("current user privilege on role by role oid");
 
 DATA(insert OID = 1269 (  pg_column_size		PGNSP PGUID 12 1 0 0 0 f f f f t f s s 1 0 23 "2276" _null_ _null_ _null_ _null_ _null_ pg_column_size _null_ _null_ _null_ ));
 DESCR("bytes required to store the value, perhaps with compression");
+DATA(insert OID = 3347 (  pg_column_compression	PGNSP PGUID 12 1 0 0 0 f f f f t f s s 1 0 25 "2276" _null_ _null_ _null_ _null_ _null_ pg_column_compression _null_ _null_ _null_ ));
+DESCR("compression method of the value, if compressed");
 DATA(insert OID = 2322 ( pg_tablespace_size		PGNSP PGUID 12 1 0 0 0 f f f f t f v s 1 0 20 "26" _null_ _null_ _null_ _null_ _null_ pg_tablespace_size_oid _null_ _null_ _null_ ));
 DESCR("total disk space usage for the specified tablespace");
 DATA(insert OID = 2323 ( pg_tablespace_size		PGNSP PGUID 12 1 0 0 0 f f f f t f v s 1 0 20 "19" _null_ _null_ _null_ _null_ _null_ pg_tablespace_size_name _null_ _null_ _null_ ));
@@ -5400,6 +5408,8 @@ DATA(insert OID = 7086 ( graphid_ge		PGNSP PGUID 12 1 0 0 0 f f f f t f i s 2 0
 /* BTree for graphid */
 DATA(insert OID = 7094 ( btgraphidcmp	PGNSP PGUID 12 1 0 0 0 f f f f t f i s 2 0 23 "7002 7002" _null_ _null_ _null_ _null_ _null_ btgraphidcmp _null_ _null_ _null_ ));
 DESCR("less-equal-greater");
+DATA(insert OID = 7095 ( btgraphidsortsupport	PGNSP PGUID 12 1 0 0 0 f f f f t f i s 1 0 2278 "2281" _null_ _null_ _null_ _null_ _null_ btgraphidsortsupport _null_ _null_ _null_ ));
+DESCR("sort support");
 /* Hash for graphid */
 DATA(insert OID = 7097 ( graphid_hash	PGNSP PGUID 12 1 0 0 0 f f f f t f i s 1 0 23 "7002" _null_ _null_ _null_ _null_ _null_ graphid_hash _null_ _null_ _null_ ));
 DESCR("hash");
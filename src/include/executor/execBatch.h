@@ -0,0 +1,100 @@
+/*-------------------------------------------------------------------------
+ *
+ * execBatch.h
+ *	  Batch-at-a-time tuple flow between executor nodes
+ *
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * src/include/executor/execBatch.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef EXECBATCH_H
+#define EXECBATCH_H
+
+#include "nodes/execnodes.h"
+
+/* maximum number of rows in a batch */
+#define TUPLE_BATCH_SIZE	1024
+
+/* comparison done by a vectorized qual */
+typedef enum BatchCompareOp
+{
+	BATCH_OP_EQ,
+	BATCH_OP_NE,
+	BATCH_OP_LT,
+	BATCH_OP_LE,
+	BATCH_OP_GT,
+	BATCH_OP_GE
+} BatchCompareOp;
+
+typedef struct TupleBatch TupleBatch;
+typedef struct BatchQual BatchQual;
+
+typedef void (*BatchQualFunc) (TupleBatch *batch, BatchQual *qual);
+
+/*
+ * A "column op constant" clause of the producing node's qual, evaluated for
+ * all the selected rows of a batch at once.
+ */
+struct BatchQual
+{
+	BatchQualFunc func;			/* kernel for the column's type */
+	int			col;			/* batch column to compare */
+	BatchCompareOp op;
+	Datum		constval;		/* never null */
+};
+
+/*
+ * TupleBatch
+ *
+ * Rows are stored by column: values[col][row] and isnull[col][row] for the
+ * heap attribute attnums[col].  Only pass-by-value columns have their values
+ * stored, since the rows of a batch come from several pages that are not kept
+ * pinned; for other columns only the null flags are valid.
+ *
+ * sel[0 .. nsel - 1] are the rows that passed the quals, in scan order.
+ */
+struct TupleBatch
+{
+	int			ncols;
+	AttrNumber *attnums;		/* heap attribute number of each column */
+	bool	   *byval;			/* is the column's value stored? */
+	AttrNumber	maxattnum;		/* highest attribute number to deform */
+
+	int			nquals;
+	BatchQual  *quals;
+
+	int			nrows;			/* rows loaded into the batch */
+	Datum	  **values;
+	bool	  **isnull;
+
+	int			nsel;			/* rows selected by the quals */
+	uint16	   *sel;
+
+	bool		done;			/* producer is exhausted */
+};
+
+/*
+ * Transition function of an aggregate applied to the selected rows of a
+ * batch.  The arguments mirror AggStatePerGroupData; the transition value of
+ * array-typed states is updated in place.
+ */
+typedef void (*BatchTransFunc) (TupleBatch *batch, int col,
+											Datum *transValue,
+											bool *transValueIsNull,
+											bool *noTransValue);
+
+/* GUC */
+extern bool enable_batch_execution;
+
+extern TupleBatch *ExecInitBatch(PlanState *node, int ncols,
+			  AttrNumber *outcols, int *colmap);
+extern bool ExecProcNodeBatch(PlanState *node, TupleBatch *batch);
+extern void ExecBatchQual(TupleBatch *batch);
+extern BatchTransFunc ExecBatchTransFunc(Oid transfn_oid, bool transtypeByVal,
+				   bool *needsvalue);
+
+#endif   /* EXECBATCH_H */
@@ -15,7 +15,10 @@
 #define HASHJOIN_H
 
 #include "nodes/execnodes.h"
+#include "port/atomics.h"
 #include "storage/buffile.h"
+#include "storage/dsm.h"
+#include "storage/spin.h"
 
 /* ----------------------------------------------------------------
  *				hash-join hash table structures
@@ -54,16 +57,42 @@
  * inner batch file.  Subsequently, while reading either inner or outer batch
  * files, we might find tuples that no longer belong to the current batch;
  * if so, we just dump them out to the correct batch file.
+ *
+ * A parallel-aware hashjoin builds a single table that all participants of
+ * the parallel query share.  Its buckets live in the parallel query's DSM
+ * segment, and each participant copies the inner tuples it reads into DSM
+ * segments of its own, which the others map once the table is complete.
+ * Since these are mapped at different addresses in each process, the links
+ * between shared tuples are HashJoinSharedPtrs rather than pointers.  Shared
+ * tables are never batched: the planner only chooses them when the whole
+ * inner relation is expected to fit into work_mem.
  * ----------------------------------------------------------------
  */
 
+/*
+ * Location of a tuple in a shared hash table: the number of the segment
+ * holding it plus one, and its offset within that segment.
+ */
+typedef uint64 HashJoinSharedPtr;
+
+#define InvalidHashJoinSharedPtr	((HashJoinSharedPtr) 0)
+#define HashJoinSharedPtrMake(segno, offset) \
+	((((HashJoinSharedPtr) (segno) + 1) << 32) | (HashJoinSharedPtr) (offset))
+#define HashJoinSharedPtrSegno(ptr)		((int) ((ptr) >> 32) - 1)
+#define HashJoinSharedPtrOffset(ptr)	((Size) ((ptr) & 0xFFFFFFFF))
+
 /* these are in nodes/execnodes.h: */
 /* typedef struct HashJoinTupleData *HashJoinTuple; */
 /* typedef struct HashJoinTableData *HashJoinTable; */
 
 typedef struct HashJoinTupleData
 {
-	struct HashJoinTupleData *next;		/* link to next tuple in same bucket */
+	/* link to next tuple in same bucket */
+	union
+	{
+		struct HashJoinTupleData *unshared;
+		HashJoinSharedPtr shared;	/* in a parallel-aware hashjoin */
+	}			next;
 	uint32		hashvalue;		/* tuple's hash code */
 	/* Tuple data, in MinimalTuple format, follows on a MAXALIGN boundary */
 }	HashJoinTupleData;
@@ -123,6 +152,55 @@ typedef struct HashMemoryChunkData *HashMemoryChunk;
 #define HASH_CHUNK_SIZE			(32 * 1024L)
 #define HASH_CHUNK_THRESHOLD	(HASH_CHUNK_SIZE / 4)
 
+/*
+ * State of a parallel-aware hashjoin, kept in the parallel query's DSM.
+ *
+ * Participants that arrive before the build is over insert the inner tuples
+ * they read, then wait until everybody that joined the build has done the
+ * same.  Participants that arrive later skip straight to probing.
+ *
+ * The DSM segments holding the tuples belong to the participants that
+ * created them, so they must stay mapped by somebody until everybody has
+ * mapped them: a participant keeps them mapped ("holds" them) until it is
+ * done with the join, and doesn't let go while another one is still mapping
+ * them.  When no participant holds them any more, every participant has
+ * finished probing, so there is no outer tuple left for latecomers to probe
+ * with.
+ *
+ * Participants record their pgprocno in the array following the buckets, so
+ * that whoever ends the build or finishes the last mapping can set their
+ * latches.  The segments may take up to work_mem in total, the bucket array
+ * included; a participant that would need more raises an error, since the
+ * table can't be batched.
+ */
+#define PHJ_SEGMENT_SIZE		(1024 * 1024L)	/* size of first segment */
+#define PHJ_MAX_SEGMENT_SIZE	(1024 * 1024 * 1024L)
+#define PHJ_MAX_SEGMENTS		256
+
+typedef struct ParallelHashJoinState
+{
+	slock_t		mutex;			/* protects all fields below but buckets */
+	int			nbuckets;		/* # buckets, fixed when the DSM is set up */
+	int			nparticipants;	/* # participants that joined the build */
+	int			nbuilt;			/* # of those that inserted their tuples */
+	bool		build_done;		/* have all of them done so? */
+	int			nholders;		/* # participants holding the segments */
+	int			nmapping;		/* # participants mapping them right now */
+	double		totalTuples;	/* # tuples in the table */
+	Size		spaceUsed;		/* space used by them */
+	Size		spaceAllowed;	/* work_mem, in bytes */
+	Size		spaceReserved;	/* space of the segments and buckets */
+	int			nsegments;		/* # segments holding the tuples */
+	dsm_handle	segments[PHJ_MAX_SEGMENTS];
+	int			maxprocs;		/* max # participants, in the procnos array */
+	int			nprocs;			/* # participants in the procnos array */
+	pg_atomic_uint64 buckets[FLEXIBLE_ARRAY_MEMBER];	/* HashJoinSharedPtrs */
+	/* followed by int procnos[maxprocs] */
+} ParallelHashJoinState;
+
+#define ParallelHashJoinProcnos(pstate) \
+	((int *) &(pstate)->buckets[(pstate)->nbuckets])
+
 typedef struct HashJoinTableData
 {
 	int			nbuckets;		/* # buckets in the in-memory hash table */
@@ -186,6 +264,16 @@ typedef struct HashJoinTableData
 
 	/* used for dense allocation of tuples (into linked chunks) */
 	HashMemoryChunk chunks;		/* one list for the whole batch */
+
+	/* used by parallel-aware hashjoins only */
+	ParallelHashJoinState *parallel_state;	/* NULL if private */
+	dsm_segment **segments;		/* segments mapped by us, by number */
+	char	  **segment_bases;	/* their addresses */
+	int			nsegments_created;	/* # segments created by us */
+	int			cur_segno;		/* segment we are filling, or -1 */
+	Size		cur_segment_used;	/* space used in it */
+	Size		cur_segment_size;	/* its size */
+	bool		holding;		/* are we holding the segments? */
 }	HashJoinTableData;
 
 #endif   /* HASHJOIN_H */
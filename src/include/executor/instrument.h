@@ -80,5 +80,6 @@ extern void InstrAggNode(Instrumentation *dst, Instrumentation *add);
 extern void InstrStartParallelQuery(void);
 extern void InstrEndParallelQuery(BufferUsage *result);
 extern void InstrAccumParallelQuery(BufferUsage *result);
+extern void InstrAccumTime(double *total, instr_time *starttime);
 
 #endif   /* INSTRUMENT_H */
@@ -9,6 +9,7 @@
 #ifndef NODEDIJKSTRA_H
 #define NODEDIJKSTRA_H
 
+#include "access/parallel.h"
 #include "nodes/execnodes.h"
 
 extern DijkstraState *ExecInitDijkstra(Dijkstra *node, EState *estate,
@@ -16,5 +17,17 @@ extern DijkstraState *ExecInitDijkstra(Dijkstra *node, EState *estate,
 extern TupleTableSlot *ExecDijkstra(DijkstraState *node);
 extern void ExecEndDijkstra(DijkstraState *node);
 extern void ExecReScanDijkstra(DijkstraState *node);
+extern void ExecShutdownDijkstra(DijkstraState *node);
+
+/* parallel instrumentation support */
+extern void ExecDijkstraEstimate(DijkstraState *node, ParallelContext *pcxt);
+extern void ExecDijkstraInitializeDSM(DijkstraState *node,
+									  ParallelContext *pcxt);
+extern void ExecDijkstraReInitializeDSM(DijkstraState *node,
+										ParallelContext *pcxt);
+extern void ExecDijkstraInitializeWorker(DijkstraState *node, shm_toc *toc);
+extern void ExecDijkstraRetrieveInstrumentation(DijkstraState *node);
+extern void ExecDijkstraAccumInstrumentation(DijkstraInstrumentation *dst,
+											 DijkstraInstrumentation *src);
 
 #endif
@@ -23,8 +23,9 @@ extern void ExecEndHash(HashState *node);
 extern void ExecReScanHash(HashState *node);
 
 extern HashJoinTable ExecHashTableCreate(Hash *node, List *hashOperators,
-					bool keepNulls);
+					bool keepNulls, struct ParallelHashJoinState *pstate);
 extern void ExecHashTableDestroy(HashJoinTable hashtable);
+extern void ExecHashTableDetach(HashJoinTable hashtable);
 extern void ExecHashTableInsert(HashJoinTable hashtable,
 					TupleTableSlot *slot,
 					uint32 hashvalue);
@@ -49,5 +50,9 @@ extern void ExecChooseHashTableSize(double ntuples, int tupwidth, bool useskew,
 						int *numbatches,
 						int *num_skew_mcvs);
 extern int	ExecHashGetSkewBucket(HashJoinTable hashtable, uint32 hashvalue);
+extern Size ExecParallelHashSize(double ntuples, int tupwidth, int maxprocs,
+					 int *nbuckets);
+extern void ExecParallelHashInitialize(struct ParallelHashJoinState *pstate,
+						   int nbuckets, int maxprocs);
 
 #endif   /* NODEHASH_H */
@@ -14,6 +14,7 @@
 #ifndef NODEHASHJOIN_H
 #define NODEHASHJOIN_H
 
+#include "access/parallel.h"
 #include "nodes/execnodes.h"
 #include "storage/buffile.h"
 
@@ -21,6 +22,10 @@ extern HashJoinState *ExecInitHashJoin(HashJoin *node, EState *estate, int eflag
 extern TupleTableSlot *ExecHashJoin(HashJoinState *node);
 extern void ExecEndHashJoin(HashJoinState *node);
 extern void ExecReScanHashJoin(HashJoinState *node);
+extern void ExecShutdownHashJoin(HashJoinState *node);
+extern void ExecHashJoinEstimate(HashJoinState *node, ParallelContext *pcxt);
+extern void ExecHashJoinInitializeDSM(HashJoinState *node, ParallelContext *pcxt);
+extern void ExecHashJoinInitializeWorker(HashJoinState *node, shm_toc *toc);
 
 extern void ExecHashJoinSaveTuple(MinimalTuple tuple, uint32 hashvalue,
 					  BufFile **fileptr);
@@ -14,6 +14,7 @@
 #ifndef NODEINDEXSCAN_H
 #define NODEINDEXSCAN_H
 
+#include "access/parallel.h"
 #include "nodes/execnodes.h"
 
 extern IndexScanState *ExecInitIndexScan(IndexScan *node, EState *estate, int eflags);
@@ -25,6 +26,12 @@ extern void ExecReScanIndexScan(IndexScanState *node);
 extern void ExecUpScanIndexScan(IndexScanState *node);
 extern void ExecDownScanIndexScan(IndexScanState *node);
 
+/* parallel scan support */
+extern void ExecIndexScanEstimate(IndexScanState *node, ParallelContext *pcxt);
+extern void ExecIndexScanInitializeDSM(IndexScanState *node, ParallelContext *pcxt);
+extern void ExecIndexScanReInitializeDSM(IndexScanState *node, ParallelContext *pcxt);
+extern void ExecIndexScanInitializeWorker(IndexScanState *node, shm_toc *toc);
+
 /*
  * These routines are exported to share code with nodeIndexonlyscan.c and
  * nodeBitmapIndexscan.c
@@ -9,6 +9,7 @@
 #ifndef NODENESTLOOPVLE_H
 #define NODENESTLOOPVLE_H
 
+#include "access/parallel.h"
 #include "nodes/execnodes.h"
 
 extern NestLoopVLEState *ExecInitNestLoopVLE(NestLoopVLE *node, EState *estate,
@@ -16,5 +17,20 @@ extern NestLoopVLEState *ExecInitNestLoopVLE(NestLoopVLE *node, EState *estate,
 extern TupleTableSlot *ExecNestLoopVLE(NestLoopVLEState *node);
 extern void ExecEndNestLoopVLE(NestLoopVLEState *node);
 extern void ExecReScanNestLoopVLE(NestLoopVLEState *node);
+extern void ExecShutdownNestLoopVLE(NestLoopVLEState *node);
+
+/* parallel instrumentation support */
+extern void ExecNestLoopVLEEstimate(NestLoopVLEState *node,
+									ParallelContext *pcxt);
+extern void ExecNestLoopVLEInitializeDSM(NestLoopVLEState *node,
+										 ParallelContext *pcxt);
+extern void ExecNestLoopVLEReInitializeDSM(NestLoopVLEState *node,
+										   ParallelContext *pcxt);
+extern void ExecNestLoopVLEInitializeWorker(NestLoopVLEState *node,
+											shm_toc *toc);
+extern void ExecNestLoopVLERetrieveInstrumentation(NestLoopVLEState *node);
+extern void ExecNestLoopVLEAccumInstrumentation(
+									NestLoopVLEInstrumentation *dst,
+									NestLoopVLEInstrumentation *src);
 
 #endif   /* NODENESTLOOPVLE_H */
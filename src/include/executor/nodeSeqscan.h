@@ -15,10 +15,12 @@
 #define NODESEQSCAN_H
 
 #include "access/parallel.h"
+#include "executor/execBatch.h"
 #include "nodes/execnodes.h"
 
 extern SeqScanState *ExecInitSeqScan(SeqScan *node, EState *estate, int eflags);
 extern TupleTableSlot *ExecSeqScan(SeqScanState *node);
+extern void ExecSeqScanBatch(SeqScanState *node, TupleBatch *batch);
 extern void ExecEndSeqScan(SeqScanState *node);
 extern void ExecReScanSeqScan(SeqScanState *node);
 extern void ExecUpScanSeqScan(SeqScanState *node);
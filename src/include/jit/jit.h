@@ -0,0 +1,69 @@
+/*-------------------------------------------------------------------------
+ *
+ * jit.h
+ *	  Provider independent JIT infrastructure.
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ *
+ * src/include/jit/jit.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef JIT_H
+#define JIT_H
+
+#include "nodes/plannodes.h"
+#include "portability/instr_time.h"
+
+
+/* Flags deciding what kind of JIT operations to perform. */
+#define PGJIT_NONE		0
+#define PGJIT_PERFORM	(1 << 0)
+#define PGJIT_OPT3		(1 << 1)
+#define PGJIT_EXPR		(1 << 2)
+#define PGJIT_DEFORM	(1 << 3)
+
+/*
+ * State of JIT compilation for one query.  It is created by the provider on
+ * first use and lives in the query's memory context; providers extend it
+ * with their own fields.
+ */
+typedef struct JitContext
+{
+	int			flags;			/* PGJIT_* flags */
+
+	size_t		created_functions;	/* # of emitted functions */
+	instr_time	generation_counter; /* time spent generating code */
+	instr_time	optimization_counter;	/* time spent optimizing */
+	instr_time	emission_counter;	/* time spent emitting machine code */
+} JitContext;
+
+struct ExprProgram;
+struct EState;
+
+typedef struct JitProviderCallbacks JitProviderCallbacks;
+
+typedef void (*JitProviderInit) (JitProviderCallbacks *cb);
+typedef bool (*JitProviderCompileExprCB) (struct ExprProgram *program,
+													  struct EState *estate);
+
+struct JitProviderCallbacks
+{
+	JitProviderCompileExprCB compile_expr;
+};
+
+
+/* GUCs */
+extern bool jit_enabled;
+extern char *jit_provider;
+extern double jit_above_cost;
+extern double jit_optimize_above_cost;
+extern bool jit_expressions;
+extern bool jit_tuple_deforming;
+
+
+extern int	jit_flags_for_plan(PlannedStmt *stmt);
+extern bool jit_compile_expr(struct ExprProgram *program,
+				 struct EState *estate);
+
+#endif   /* JIT_H */
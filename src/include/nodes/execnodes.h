@@ -413,6 +413,9 @@ typedef struct EState
 	int			es_instrument;	/* OR of InstrumentOption flags */
 	bool		es_finished;	/* true when ExecutorFinish is done */
 
+	int			es_jit_flags;	/* PGJIT_* flags for this query */
+	struct JitContext *es_jit;	/* JIT state, created on first use */
+
 	List	   *es_exprcontexts;	/* List of ExprContexts within EState */
 
 	List	   *es_subplanstates;		/* List of PlanState for SubPlans */
@@ -513,6 +516,10 @@ typedef struct ExecAuxRowMark
  * are set to point to the caller's function arrays while doing such a search.
  * During LookupTupleHashEntry(), they point to tab_hash_funcs and
  * tab_eq_funcs respectively.
+ *
+ * The table itself is generated from lib/simplehash.h.  Entries move around
+ * in it as others are added, so any per-group data of the caller is kept
+ * separately and pointed to by ->additional.
  * ----------------------------------------------------------------
  */
 typedef struct TupleHashEntryData *TupleHashEntry;
@@ -520,14 +527,23 @@ typedef struct TupleHashTableData *TupleHashTable;
 
 typedef struct TupleHashEntryData
 {
-	/* firstTuple must be the first field in this struct! */
 	MinimalTuple firstTuple;	/* copy of first tuple in this group */
-	/* there may be additional data beyond the end of this struct */
-} TupleHashEntryData;			/* VARIABLE LENGTH STRUCT */
+	void	   *additional;		/* user data */
+	uint32		status;			/* hash status */
+	uint32		hash;			/* hash value (cached) */
+} TupleHashEntryData;
+
+/* define parameters necessary to generate the tuple hash table interface */
+#define SH_PREFIX tuplehash
+#define SH_ELEMENT_TYPE TupleHashEntryData
+#define SH_KEY_TYPE MinimalTuple
+#define SH_SCOPE extern
+#define SH_DECLARE
+#include "lib/simplehash.h"
 
 typedef struct TupleHashTableData
 {
-	HTAB	   *hashtab;		/* underlying dynahash table */
+	tuplehash_hash *hashtab;	/* underlying hash table */
 	int			numCols;		/* number of columns in lookup key */
 	AttrNumber *keyColIdx;		/* attr numbers of key columns */
 	FmgrInfo   *tab_hash_funcs; /* hash functions for table datatype(s) */
@@ -542,7 +558,7 @@ typedef struct TupleHashTableData
 	FmgrInfo   *cur_eq_funcs;	/* equality functions for input vs. table */
 }	TupleHashTableData;
 
-typedef HASH_SEQ_STATUS TupleHashIterator;
+typedef tuplehash_iterator TupleHashIterator;
 
 /*
  * Use InitTupleHashIterator/TermTupleHashIterator for a read/write scan.
@@ -550,16 +566,13 @@ typedef HASH_SEQ_STATUS TupleHashIterator;
  * explicit scan termination is needed).
  */
 #define InitTupleHashIterator(htable, iter) \
-	hash_seq_init(iter, (htable)->hashtab)
+	tuplehash_start_iterate(htable->hashtab, iter)
 #define TermTupleHashIterator(iter) \
-	hash_seq_term(iter)
+	((void) 0)
 #define ResetTupleHashIterator(htable, iter) \
-	do { \
-		hash_freeze((htable)->hashtab); \
-		hash_seq_init(iter, (htable)->hashtab); \
-	} while (0)
-#define ScanTupleHashTable(iter) \
-	((TupleHashEntry) hash_seq_search(iter))
+	InitTupleHashIterator(htable, iter)
+#define ScanTupleHashTable(htable, iter) \
+	tuplehash_iterate(htable->hashtab, iter)
 
 
 /* ----------------------------------------------------------------
@@ -751,6 +764,13 @@ typedef struct FuncExprState
 	 * argument values between calls, when setArgsValid is true.
 	 */
 	FunctionCallInfoData fcinfo_data;
+
+	/*
+	 * If the expression has been flattened into a step program (see
+	 * execProgram.c), the program.  The argument states are not evaluated
+	 * by themselves then.
+	 */
+	struct ExprProgram *program;
 } FuncExprState;
 
 /* ----------------
@@ -1418,6 +1438,7 @@ typedef struct
  *		RuntimeContext	   expr context for evaling runtime Skeys
  *		RelationDesc	   index relation descriptor
  *		ScanDesc		   index scan descriptor
+ *		PscanLen		   size of parallel index scan descriptor
  *
  *		ReorderQueue	   tuples that need reordering due to re-check
  *		ReachedEnd		   have we fetched all tuples from index already?
@@ -1443,6 +1464,7 @@ typedef struct IndexScanState
 	ExprContext *iss_RuntimeContext;
 	Relation	iss_RelationDesc;
 	IndexScanDesc iss_ScanDesc;
+	Size		iss_PscanLen;
 	dlist_head  vle_ctxs;		/* list of IndexScanVLECtx */
 	dlist_node *cur_ctx;
 
@@ -1478,6 +1500,7 @@ typedef struct IndexScanVLECtx
  *		ScanDesc		   index scan descriptor
  *		VMBuffer		   buffer in use for visibility map testing, if any
  *		HeapFetches		   number of tuples we were forced to fetch from heap
+ *		PscanLen		   size of parallel index-only scan descriptor
  * ----------------
  */
 typedef struct IndexOnlyScanState
@@ -1496,6 +1519,7 @@ typedef struct IndexOnlyScanState
 	IndexScanDesc ioss_ScanDesc;
 	Buffer		ioss_VMBuffer;
 	long		ioss_HeapFetches;
+	Size		ioss_PscanLen;
 	dlist_head  vle_ctxs;		/* list of IndexScanVLECtx */
 	dlist_node *cur_ctx;
 } IndexOnlyScanState;
@@ -1545,8 +1569,13 @@ typedef struct BitmapIndexScanState
  *		prefetch_pages	   # pages prefetch iterator is ahead of current
  *		prefetch_target    current target prefetch distance
  *		prefetch_maximum   maximum value for prefetch_target
+ *		pstate			   shared state for parallel bitmap scan
  * ----------------
  */
+
+/* private to nodeBitmapHeapscan.c */
+typedef struct ParallelBitmapHeapState ParallelBitmapHeapState;
+
 typedef struct BitmapHeapScanState
 {
 	ScanState	ss;				/* its first field is NodeTag */
@@ -1560,6 +1589,7 @@ typedef struct BitmapHeapScanState
 	int			prefetch_pages;
 	int			prefetch_target;
 	int			prefetch_maximum;
+	ParallelBitmapHeapState *pstate;
 } BitmapHeapScanState;
 
 /* ----------------
@@ -1777,6 +1807,33 @@ typedef struct VLEArrayExpr
 	ExprContext *econtext;
 } VLEArrayExpr;
 
+/* ----------------
+ *	 Traversal statistics of NestLoopVLE for EXPLAIN ANALYZE
+ *
+ *		Rows of paths longer than VLE_INSTR_MAX_HOPS are counted in the last
+ *		element of hopRows.  Times are in seconds and are collected only if
+ *		the node is timed.
+ * ----------------
+ */
+#define VLE_INSTR_MAX_HOPS	16
+
+typedef struct NestLoopVLEInstrumentation
+{
+	uint64		hopRows[VLE_INSTR_MAX_HOPS + 1];	/* # of rows per hops */
+	uint64		nrescans;		/* # of rescans of the inner plan */
+	uint64		ncapped;		/* # of expansions cut by the degree cap */
+	int			maxDepth;		/* peak # of elements in rowids */
+	double		rescanTime;		/* time spent in rescanning the inner plan */
+	double		fetchTime;		/* time spent in fetching edges */
+} NestLoopVLEInstrumentation;
+
+/* shared memory container for per-worker NestLoopVLE statistics */
+typedef struct SharedNestLoopVLEInfo
+{
+	int			num_workers;
+	NestLoopVLEInstrumentation vinstrument[FLEXIBLE_ARRAY_MEMBER];
+} SharedNestLoopVLEInfo;
+
 typedef struct NestLoopVLEState
 {
 	NestLoopState nls;
@@ -1788,6 +1845,13 @@ typedef struct NestLoopVLEState
 	VLEArrayExpr path;
 	dlist_head	vleCtxs;		/* list of NestLoopVLECtx */
 	dlist_node *curCtx;
+	int64	   *degrees;		/* # of edges fetched at each depth */
+	int			maxdegrees;		/* allocated length of degrees */
+	Graphid		outerStart;		/* start vertex of the last outer row */
+	int64		outerDegree;	/* # of outer rows with that start vertex */
+	NestLoopVLEInstrumentation vinstrument;
+	SharedNestLoopVLEInfo *shared_info;	/* one entry per worker, in DSM */
+	SharedNestLoopVLEInfo *worker_info;	/* sum of shared_info of all runs */
 } NestLoopVLEState;
 
 typedef struct NestLoopVLECtx
@@ -1866,12 +1930,15 @@ typedef struct MergeJoinState
  *		hj_JoinState			current state of ExecHashJoin state machine
  *		hj_MatchedOuter			true if found a join match for current outer
  *		hj_OuterNotEmpty		true if outer relation known not empty
+ *		hj_ParallelState		shared hash table state, if parallel-aware
+ *		hj_ParallelNBuckets		number of buckets of the shared hash table
  * ----------------
  */
 
 /* these structs are defined in executor/hashjoin.h: */
 typedef struct HashJoinTupleData *HashJoinTuple;
 typedef struct HashJoinTableData *HashJoinTable;
+struct ParallelHashJoinState;
 
 typedef struct HashJoinState
 {
@@ -1893,6 +1960,8 @@ typedef struct HashJoinState
 	int			hj_JoinState;
 	bool		hj_MatchedOuter;
 	bool		hj_OuterNotEmpty;
+	struct ParallelHashJoinState *hj_ParallelState;
+	int			hj_ParallelNBuckets;
 } HashJoinState;
 
 
@@ -1934,6 +2003,33 @@ typedef struct SortState
 	void	   *tuplesortstate; /* private state of tuplesort.c */
 } SortState;
 
+/* ----------------
+ *	 IncrementalSortState information
+ *
+ *		The input arrives sorted on the first nPresortedCols sort keys.  It
+ *		is sorted in batches of at least INCREMENTAL_SORT_MIN_BATCH tuples,
+ *		each extended up to the end of the group of tuples with equal
+ *		presorted keys that it stops in.
+ * ----------------
+ */
+typedef struct IncrementalSortState
+{
+	ScanState	ss;				/* its first field is NodeTag */
+	bool		bounded;		/* is the result set bounded? */
+	int64		bound;			/* if bounded, how many tuples are needed */
+	int64		bound_Done;		/* number of tuples returned so far */
+	int			nPresortedCols; /* number of presorted columns */
+	FmgrInfo   *presortedEqfns; /* equality fns of the presorted columns */
+	bool		outerNodeDone;	/* outer plan exhausted? */
+	void	   *tuplesortstate; /* sort of the current batch, or NULL */
+	TupleTableSlot *group_pivot;	/* last tuple of the batch's minimum */
+	TupleTableSlot *transfer_tuple; /* first tuple of the next batch */
+	/* for EXPLAIN ANALYZE */
+	long		nbatches;		/* number of batches sorted */
+	long		maxSpaceUsed;	/* peak space used by a batch, in kB */
+	const char *maxSpaceType;	/* "Memory" or "Disk" */
+} IncrementalSortState;
+
 /* ---------------------
  *	GroupState information
  * -------------------------
@@ -1984,6 +2080,7 @@ typedef struct AggStatePerAggData *AggStatePerAgg;
 typedef struct AggStatePerTransData *AggStatePerTrans;
 typedef struct AggStatePerGroupData *AggStatePerGroup;
 typedef struct AggStatePerPhaseData *AggStatePerPhase;
+typedef struct HashAggSpillData *HashAggSpill;
 
 typedef struct AggState
 {
@@ -2017,12 +2114,24 @@ typedef struct AggState
 	/* these fields are used in AGG_PLAIN and AGG_SORTED modes: */
 	AggStatePerGroup pergroup;	/* per-Aggref-per-group working state */
 	HeapTuple	grp_firstTuple; /* copy of first tuple of current group */
+	struct TupleBatch *batch;	/* input batch, if the outer plan produces
+								 * batches (AGG_PLAIN only) */
 	/* these fields are used in AGG_HASHED mode: */
 	TupleHashTable hashtable;	/* hash table with one entry per group */
 	TupleTableSlot *hashslot;	/* slot for loading hash table */
 	List	   *hash_needed;	/* list of columns needed in hash table */
 	bool		table_filled;	/* hash table filled yet? */
 	TupleHashIterator hashiter; /* for iterating through hash table */
+	/* these fields bound the memory used by the hash table, see nodeAgg.c */
+	bool		hash_spill_mode;	/* writing new groups to disk? */
+	long		hash_ngroups_current;	/* # groups in the hash table */
+	long		hash_ngroups_limit; /* # groups at which to check memory */
+	HashAggSpill hash_spill;	/* partitions being written */
+	List	   *hash_batches;	/* spilled partitions yet to be processed */
+	int			hash_batches_used;	/* # batches processed, for EXPLAIN */
+	TupleTableSlot *hash_spill_slot;	/* slot for reading spilled tuples */
+	Size		hash_mem_peak;	/* peak hash table memory, for EXPLAIN */
+	uint64		hash_disk_used; /* bytes written to spill files */
 } AggState;
 
 /* ----------------
@@ -2128,6 +2237,42 @@ typedef struct GatherState
 	bool		need_to_scan_locally;
 } GatherState;
 
+/* ----------------
+ * GatherMergeState information
+ *
+ *		Gather merge nodes launch 1 or more parallel workers, run a
+ *		subplan which produces sorted output in each of them, and
+ *		merge the results into a single sorted stream.
+ *
+ *		gm_nkeys		number of sort key columns
+ *		gm_sortkeys		sort keys in SortSupport representation
+ *		gm_slots		current tuple of each participant; the last
+ *						one is the leader's own
+ *		gm_tuple_buffers	tuples read ahead from each worker
+ *		gm_heap			heap of participants with a current tuple
+ *		gm_initialized	true if the heap has been filled
+ * ----------------
+ */
+struct GMReaderTupleBuffer;		/* private in nodeGatherMerge.c */
+
+typedef struct GatherMergeState
+{
+	PlanState	ps;				/* its first field is NodeTag */
+	bool		initialized;
+	struct ParallelExecutorInfo *pei;
+	int			nreaders;
+	int			nworkers_launched;
+	struct TupleQueueReader **reader;
+	TupleDesc	tupDesc;
+	bool		need_to_scan_locally;
+	int			gm_nkeys;
+	SortSupport gm_sortkeys;	/* array of length gm_nkeys */
+	TupleTableSlot **gm_slots;	/* array of length nreaders + 1 */
+	struct GMReaderTupleBuffer *gm_tuple_buffers;	/* nreaders of them */
+	struct binaryheap *gm_heap; /* binary heap of slot indices */
+	bool		gm_initialized; /* are the slots filled? */
+} GatherMergeState;
+
 /* ----------------
  *	 HashState information
  * ----------------
@@ -2245,14 +2390,40 @@ typedef struct ModifyGraphState
 								   with `es_prop_map` */
 	List	   *exprs;			/* expression state list for DELETE */
 	List	   *sets;			/* list of GraphSetProp's for SET/REMOVE */
-	HTAB	   *propTable;
+	struct proptable_hash *propTable;	/* modified elements, by id */
 	Tuplestorestate *tuplestorestate;
 } ModifyGraphState;
 
+/* ----------------
+ *	 Traversal statistics of Dijkstra for EXPLAIN ANALYZE
+ *
+ *		Times are in seconds and are collected only if the node is timed.
+ * ----------------
+ */
+typedef struct DijkstraInstrumentation
+{
+	uint64		heapPushes;		/* # of entries added to the queue */
+	uint64		heapPops;		/* # of entries removed from the queue */
+	uint64		ncapped;		/* # of expansions cut by the degree cap */
+	long		maxVisited;		/* peak # of entries in visited_nodes */
+	Size		peakQueueSpace;	/* peak memory used by queue entries */
+	double		rescanTime;		/* time spent in rescanning the outer plan */
+	double		fetchTime;		/* time spent in fetching edges */
+} DijkstraInstrumentation;
+
+/* shared memory container for per-worker Dijkstra statistics */
+typedef struct SharedDijkstraInfo
+{
+	int			num_workers;
+	DijkstraInstrumentation dinstrument[FLEXIBLE_ARRAY_MEMBER];
+} SharedDijkstraInfo;
+
 typedef struct DijkstraState
 {
 	PlanState 		ps;
-	HTAB		   *visited_nodes;
+	/* use "struct" so we needn't generate the table type here */
+	struct visitedhash_hash *visited_nodes;
+	MemoryContext	visited_mcxt;	/* holds visited_nodes and its vnodes */
 	pairingheap	   *pq;
 	MemoryContext 	pq_mcxt;
 	ExprState  	   *source;
@@ -2263,6 +2434,10 @@ typedef struct DijkstraState
 	Graphid 		target_id;
 	bool			is_executed;
 	TupleTableSlot *selfTupleSlot;
+	Size			queueSpace;		/* memory used by queue entries */
+	DijkstraInstrumentation dinstrument;
+	SharedDijkstraInfo *shared_info;	/* one entry per worker, in DSM */
+	SharedDijkstraInfo *worker_info;	/* sum of shared_info of all runs */
 } DijkstraState;
 
 #endif   /* EXECNODES_H */
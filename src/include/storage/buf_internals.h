@@ -297,6 +297,16 @@ typedef struct CkptSortItem
 
 extern CkptSortItem *CkptBufferIds;
 
+/*
+ * With numa_nodes > 1, the buffers are divided into contiguous ranges, one
+ * per NUMA node.  GetNodeFirstBuffer(n) is the first buffer of node n, and
+ * GetBufferNode returns the node a buffer belongs to.
+ */
+#define GetNodeFirstBuffer(n) \
+	((int) (((int64) (n) * NBuffers + numa_nodes - 1) / numa_nodes))
+#define GetBufferNode(buf_id) \
+	((int) ((int64) (buf_id) * numa_nodes / NBuffers))
+
 /*
  * Internal buffer management routines
  */
@@ -311,8 +321,13 @@ extern BufferDesc *StrategyGetBuffer(BufferAccessStrategy strategy,
 extern void StrategyFreeBuffer(BufferDesc *buf);
 extern bool StrategyRejectBuffer(BufferAccessStrategy strategy,
 					 BufferDesc *buf);
+extern void StrategyAdmitBuffer(BufferDesc *buf, uint32 buf_state,
+					uint32 new_hash);
+extern void StrategyForgetBuffer(BufferDesc *buf);
+extern void StrategyCountHit(BufferDesc *buf);
 
-extern int	StrategySyncStart(uint32 *complete_passes, uint32 *num_buf_alloc);
+extern int	StrategySyncStart(int nodeno, uint32 *complete_passes,
+				  uint32 *num_buf_alloc);
 extern void StrategyNotifyBgWriter(int bgwprocno);
 
 extern Size StrategyShmemSize(void);
@@ -323,6 +338,8 @@ extern Size BufTableShmemSize(int size);
 extern void InitBufTable(int size);
 extern uint32 BufTableHashCode(BufferTag *tagPtr);
 extern int	BufTableLookup(BufferTag *tagPtr, uint32 hashcode);
+extern int	BufTableLookupHint(uint32 hashcode);
+extern void BufTableSetHint(uint32 hashcode, int buf_id);
 extern int	BufTableInsert(BufferTag *tagPtr, uint32 hashcode, int buf_id);
 extern void BufTableDelete(BufferTag *tagPtr, uint32 hashcode);
 
@@ -17,6 +17,7 @@
 #include "storage/block.h"
 #include "storage/buf.h"
 #include "storage/bufpage.h"
+#include "storage/itemptr.h"
 #include "storage/relfilenode.h"
 #include "utils/relcache.h"
 #include "utils/snapmgr.h"
@@ -47,6 +48,36 @@ typedef enum
 								 * replay; otherwise same as RBM_NORMAL */
 } ReadBufferMode;
 
+/* Possible values for buffer_replacement_policy */
+typedef enum
+{
+	BUFFER_REPLACEMENT_CLOCK,	/* clock sweep over all buffers */
+	BUFFER_REPLACEMENT_2Q		/* clock sweep with probationary queue */
+} BufferReplacementPolicy;
+
+/* maximum value of numa_nodes */
+#define NUMA_MAX_NODES		16
+
+/* Buffer replacement counters, summed over all processes */
+typedef struct BufferReplacementStats
+{
+	uint64		hits;
+	uint64		misses;
+	uint64		ghost_hits;
+	uint64		evictions;
+	uint64		probation_evictions;
+} BufferReplacementStats;
+
+/* Per-node buffer counters, summed over all processes on the node */
+typedef struct BufferNodeStats
+{
+	int			buffers;		/* number of buffers of the node */
+	uint64		local_hits;		/* hits on buffers of the node */
+	uint64		remote_hits;	/* hits on buffers of other nodes */
+	uint64		local_reads;	/* pages read into buffers of the node */
+	uint64		remote_reads;	/* pages read into buffers of other nodes */
+} BufferNodeStats;
+
 /* forward declared, to avoid having to expose buf_internals.h here */
 struct WritebackContext;
 
@@ -67,6 +98,10 @@ extern int	bgwriter_flush_after;
 /* in buf_init.c */
 extern PGDLLIMPORT char *BufferBlocks;
 
+/* in freelist.c */
+extern int	buffer_replacement_policy;
+extern int	numa_nodes;
+
 /* in guc.c */
 extern int	effective_io_concurrency;
 
@@ -165,6 +200,10 @@ extern PGDLLIMPORT int32 *LocalRefCount;
 extern bool ComputeIoConcurrency(int io_concurrency, double *target);
 extern void PrefetchBuffer(Relation reln, ForkNumber forkNum,
 			   BlockNumber blockNum);
+extern int PrefetchBufferTids(Relation reln, ItemPointer tids, int ntids,
+				   int max_blocks);
+extern bool PrefetchBufferWithoutRelcache(RelFileNode rnode,
+							  ForkNumber forkNum, BlockNumber blockNum);
 extern Buffer ReadBuffer(Relation reln, BlockNumber blockNum);
 extern Buffer ReadBufferExtended(Relation reln, ForkNumber forkNum,
 				   BlockNumber blockNum, ReadBufferMode mode,
@@ -230,6 +269,8 @@ extern void TestForOldSnapshot_impl(Snapshot snapshot, Relation relation);
 /* in freelist.c */
 extern BufferAccessStrategy GetAccessStrategy(BufferAccessStrategyType btype);
 extern void FreeAccessStrategy(BufferAccessStrategy strategy);
+extern void StrategyGetStats(BufferReplacementStats *stats);
+extern void StrategyGetNodeStats(BufferNodeStats *stats);
 
 
 /* inline functions */
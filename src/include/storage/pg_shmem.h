@@ -68,5 +68,7 @@ extern PGShmemHeader *PGSharedMemoryCreate(Size size, bool makePrivate,
 					 int port, PGShmemHeader **shim);
 extern bool PGSharedMemoryIsInUse(unsigned long id1, unsigned long id2);
 extern void PGSharedMemoryDetach(void);
+extern bool PGSharedMemoryBindToNode(void *addr, Size size, int node);
+extern int	PGSharedMemoryCurrentNode(void);
 
 #endif   /* PG_SHMEM_H */
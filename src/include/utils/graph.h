@@ -78,6 +78,9 @@ typedef struct {
 #define PG_GETARG_ROWID(n)	((Rowid *) DatumGetPointer(PG_GETARG_DATUM(n)))
 #define PG_RETURN_ROWID(x)	return RowidGetDatum(x)
 
+/* GUC variable */
+extern int	graph_traversal_max_degree;
+
 /* graphid */
 extern Datum graphid(PG_FUNCTION_ARGS);
 extern Datum graphid_in(PG_FUNCTION_ARGS);
@@ -172,6 +175,7 @@ extern Datum makeGraphEdgeDatum(Datum id, Datum start, Datum end,
 
 /* index support - BTree */
 extern Datum btgraphidcmp(PG_FUNCTION_ARGS);
+extern Datum btgraphidsortsupport(PG_FUNCTION_ARGS);
 /* index support - Hash */
 extern Datum graphid_hash(PG_FUNCTION_ARGS);
 /* index support - GIN (as BTree) */
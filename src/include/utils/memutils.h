@@ -105,6 +105,8 @@ extern MemoryContext MemoryContextGetParent(MemoryContext context);
 extern bool MemoryContextIsEmpty(MemoryContext context);
 extern void MemoryContextStats(MemoryContext context);
 extern void MemoryContextStatsDetail(MemoryContext context, int max_children);
+extern void MemoryContextMemConsumed(MemoryContext context,
+						 MemoryContextCounters *consumed);
 extern void MemoryContextAllowInCriticalSection(MemoryContext context,
 									bool allow);
 
@@ -109,6 +109,12 @@ typedef struct SnapshotData
 
 	int64		whenTaken;		/* timestamp when snapshot was taken */
 	XLogRecPtr	lsn;			/* position in the WAL stream when taken */
+
+	/*
+	 * The transaction completion count at the time GetSnapshotData() built
+	 * this snapshot, or 0 if its contents may not be reused.
+	 */
+	uint64		snapXactCompletionCount;
 } SnapshotData;
 
 /*
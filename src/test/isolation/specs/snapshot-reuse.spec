@@ -0,0 +1,28 @@
+# Snapshot reuse test
+#
+# A READ COMMITTED session reuses its previous snapshot as long as no
+# transaction has completed since.  Check that starting a transaction or
+# assigning it an XID doesn't make the reused snapshot stale, and that its
+# commit or abort does.
+
+setup
+{
+ CREATE TABLE sr (id int);
+}
+
+teardown
+{
+ DROP TABLE sr;
+}
+
+session "s1"
+step "s1r" { SELECT count(*) FROM sr; }
+
+session "s2"
+step "s2b" { BEGIN; }
+step "s2i" { INSERT INTO sr VALUES (1); }
+step "s2c" { COMMIT; }
+step "s2a" { ROLLBACK; }
+
+permutation "s1r" "s2b" "s2i" "s1r" "s2c" "s1r"
+permutation "s1r" "s2b" "s2i" "s1r" "s2a" "s1r"
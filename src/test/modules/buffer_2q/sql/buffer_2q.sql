@@ -0,0 +1,19 @@
+--
+-- Test the 2q buffer replacement policy
+--
+SELECT policy FROM pg_stat_get_buffer_replacement();
+
+-- Load a table bigger than the probationary queue's target of a quarter of
+-- shared_buffers, but smaller than shared_buffers.  Its pages must come off
+-- the freelist, without evicting anything.
+CREATE TABLE test_2q (a int);
+INSERT INTO test_2q SELECT g FROM generate_series(1, 150000) g;
+SELECT pg_relation_size('test_2q') / current_setting('block_size')::int
+  > 16 * 1024 * 1024 / 4 / current_setting('block_size')::int AS big_enough;
+SELECT evictions, probation_evictions FROM pg_stat_get_buffer_replacement();
+
+-- Reading it again hits in shared buffers
+SELECT count(*) FROM test_2q;
+SELECT hits > 0 AS hits, evictions FROM pg_stat_get_buffer_replacement();
+
+DROP TABLE test_2q;
@@ -0,0 +1,88 @@
+# Test WAL replay with redo workers, on a standby and in crash recovery.
+use strict;
+use warnings;
+
+use PostgresNode;
+use TestLib;
+use Test::More tests => 7;
+
+my $node_master = get_new_node('master');
+$node_master->init(allows_streaming => 1);
+$node_master->append_conf('postgresql.conf', qq{
+recovery_workers = 2
+max_worker_processes = 4
+autovacuum = off
+});
+$node_master->start;
+
+$node_master->backup('master_backup');
+my $node_standby = get_new_node('standby');
+$node_standby->init_from_backup($node_master, 'master_backup',
+	has_streaming => 1);
+$node_standby->start;
+
+# A mix of single-block records that are handed to the workers, and records
+# that make the startup process wait for them.
+$node_master->safe_psql('postgres', qq{
+create table testtab (a int primary key, b text);
+insert into testtab select g, 'foo' from generate_series(1, 10000) g;
+update testtab set b = 'bar' where a % 3 = 0;
+delete from testtab where a % 7 = 0;
+checkpoint;
+update testtab set b = 'baz' where a % 5 = 0;
+create index testtab_b on testtab (b);
+insert into testtab select g, 'qux' from generate_series(10001, 20000) g;
+});
+
+my $applname = $node_standby->name;
+my $caughtup_query =
+"SELECT pg_current_xlog_location() <= replay_location FROM pg_stat_replication WHERE application_name = '$applname';";
+$node_master->poll_query_until('postgres', $caughtup_query)
+  or die "Timed out while waiting for standby to catch up";
+
+my $check_query =
+  "select count(*), sum(a), string_agg(distinct b, ',' order by b) from testtab";
+my $expected = $node_master->safe_psql('postgres', $check_query);
+
+like(slurp_file($node_standby->logfile),
+	qr/using 2 redo workers/, 'standby uses redo workers');
+is($node_standby->safe_psql('postgres', $check_query),
+	$expected, 'standby replayed all changes');
+is($node_standby->safe_psql('postgres',
+		"set enable_seqscan = off; select count(*) from testtab where b = 'baz'"),
+	$node_master->safe_psql('postgres',
+		"select count(*) from testtab where b = 'baz'"),
+	'standby index matches');
+
+# Crash the master and check that crash recovery replays the same data.
+# Crash recovery never reaches consistency before the end of WAL, so the
+# workers must also handle changes to a table that is dropped later, which
+# reference pages that are gone by the time they are replayed.
+$node_master->safe_psql('postgres', qq{
+update testtab set b = 'quux' where a % 11 = 0;
+create table droptab (a int);
+insert into droptab select g from generate_series(1, 10000) g;
+});
+$node_master->safe_psql('postgres', qq{
+update droptab set a = a + 1;
+drop table droptab;
+insert into testtab select g, 'corge' from generate_series(20001, 25000) g;
+});
+$expected = $node_master->safe_psql('postgres', $check_query);
+my $logstart = -s $node_master->logfile;
+$node_master->stop('immediate');
+$node_master->start;
+
+is($node_master->safe_psql('postgres', $check_query),
+	$expected, 'crash recovery replayed all changes');
+like(substr(slurp_file($node_master->logfile), $logstart),
+	qr/redo workers replayed [1-9][0-9]* records/,
+	'crash recovery used redo workers');
+is($node_master->safe_psql('postgres',
+		"select count(*) from pg_class where relname = 'droptab'"),
+	'0', 'dropped table stays dropped');
+is($node_master->safe_psql('postgres',
+		"set enable_seqscan = off; select count(*) from testtab where b = 'quux'"),
+	$node_master->safe_psql('postgres',
+		"set enable_seqscan = on; select count(*) from testtab where b = 'quux'"),
+	'index matches after crash recovery');
@@ -0,0 +1,43 @@
+# Test WAL replay with prefetching of referenced blocks, in crash recovery.
+use strict;
+use warnings;
+
+use PostgresNode;
+use TestLib;
+use Test::More tests => 3;
+
+my $node = get_new_node('master');
+$node->init;
+$node->append_conf('postgresql.conf', qq{
+recovery_prefetch_distance = 256kB
+full_page_writes = off
+autovacuum = off
+});
+$node->start;
+
+$node->safe_psql('postgres', qq{
+create table testtab (a int primary key, b text);
+insert into testtab select g, 'foo' from generate_series(1, 10000) g;
+checkpoint;
+update testtab set b = 'bar' where a % 3 = 0;
+delete from testtab where a % 7 = 0;
+insert into testtab select g, 'baz' from generate_series(10001, 20000) g;
+});
+
+my $check_query =
+  "select count(*), sum(a), string_agg(distinct b, ',' order by b) from testtab";
+my $expected = $node->safe_psql('postgres', $check_query);
+
+$node->stop('immediate');
+$node->start;
+
+is($node->safe_psql('postgres', $check_query),
+	$expected, 'crash recovery replayed all changes');
+is($node->safe_psql('postgres',
+		"set enable_seqscan = off; select count(*) from testtab where b = 'bar'"),
+	$node->safe_psql('postgres',
+		"set enable_seqscan = on; select count(*) from testtab where b = 'bar'"),
+	'index matches after crash recovery');
+is($node->safe_psql('postgres',
+		"select prefetch + skip_hit + skip_new + skip_rep > 0 from pg_stat_get_recovery_prefetch()"),
+	't', 'blocks were considered for prefetching');
@@ -0,0 +1,54 @@
+# Test replay of full-page images compressed with each method built in.
+use strict;
+use warnings;
+
+use PostgresNode;
+use TestLib;
+use Test::More tests => 4;
+
+my $node = get_new_node('master');
+$node->init;
+$node->append_conf('postgresql.conf', qq{
+autovacuum = off
+});
+$node->start;
+
+$node->safe_psql('postgres',
+	"create table testtab (a int primary key, b text)");
+
+# Methods that aren't built in are rejected by the GUC machinery.
+my $enum_vals = $node->safe_psql('postgres',
+	"select array_to_string(enumvals, ',') from pg_settings where name = 'wal_compression'");
+my %methods = map { $_ => 1 } split(/,/, $enum_vals);
+
+foreach my $method ('pglz', 'lz4', 'zstd', 'off')
+{
+  SKIP:
+	{
+		skip "$method is not supported by this build", 1
+		  unless $methods{$method};
+
+		$node->safe_psql('postgres', qq{
+alter system set wal_compression = '$method';
+select pg_reload_conf();
+});
+		# Every page touched after the checkpoint gets a full-page image.
+		$node->safe_psql('postgres', qq{
+checkpoint;
+insert into testtab select g, repeat('$method', 20)
+  from generate_series((select coalesce(max(a), 0) + 1 from testtab),
+                       (select coalesce(max(a), 0) + 5000 from testtab)) g;
+checkpoint;
+update testtab set b = b || 'x' where a % 10 = 0;
+});
+
+		my $check_query = "select count(*), sum(length(b)) from testtab";
+		my $expected = $node->safe_psql('postgres', $check_query);
+
+		$node->stop('immediate');
+		$node->start;
+
+		is($node->safe_psql('postgres', $check_query),
+			$expected, "crash recovery with wal_compression = $method");
+	}
+}
@@ -824,3 +824,33 @@ create aggregate my_half_sum(int4)
 select my_sum(one),my_half_sum(one) from (values(1),(2),(3),(4)) t(one);
 
 rollback;
+
+-- Hash aggregation must stay within work_mem by spilling to disk when the
+-- planner underestimates the number of groups
+set work_mem = '64kB';
+set enable_sort = off;
+explain (costs off)
+  select count(*), sum(c), min(c), max(c)
+  from (select g % 10000 as k, count(*) as c
+        from generate_series(1, 20000) g group by k) s;
+select count(*), sum(c), min(c), max(c)
+  from (select g % 10000 as k, count(*) as c
+        from generate_series(1, 20000) g group by k) s;
+-- with transition states that have memory contexts of their own
+select count(*), sum(n)
+  from (select g % 5000 as k, array_length(array_agg(g), 1) as n
+        from generate_series(1, 20000) g group by k) s;
+reset enable_sort;
+reset work_mem;
+
+-- Plain aggregation reading a sequential scan in batches
+create temp table batch_agg as
+  select g::int4 as a, g::int8 as b, g::float8 as c
+  from generate_series(1, 5000) g;
+insert into batch_agg values (null, null, null), (7, null, 7.5);
+set enable_batch_execution = on;
+select count(*), count(a), sum(a), min(b), max(b), sum(c), avg(c)
+  from batch_agg where b > 100 and 4000.5 >= c;
+select count(*), count(b), sum(a), round(avg(a), 2), min(c), max(a)
+  from batch_agg;
+reset enable_batch_execution;
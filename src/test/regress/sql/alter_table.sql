@@ -1897,3 +1897,12 @@ ALTER TABLE test_add_column
 	ADD COLUMN c4 integer;
 \d test_add_column
 DROP TABLE test_add_column;
+
+-- column compression method
+CREATE TABLE compress_test (f1 text);
+ALTER TABLE compress_test ALTER COLUMN f1 SET (compression = pglz);
+ALTER TABLE compress_test ALTER COLUMN f1 SET (compression = foo); -- fail
+INSERT INTO compress_test VALUES (repeat('1234567890', 1000));
+SELECT pg_column_compression(f1), length(f1) FROM compress_test;
+SELECT pg_column_compression('short'::text);
+DROP TABLE compress_test;
@@ -0,0 +1,52 @@
+--
+-- TOAST compression with zstd
+--
+-- compression_zstd_1.out is the output of a server built without zstd, where
+-- choosing the method fails and every value is compressed with pglz.
+--
+CREATE TABLE cmdata_zstd (id int, f1 text);
+ALTER TABLE cmdata_zstd ALTER COLUMN f1 SET (compression = zstd);
+
+-- compressed inline, and compressed then moved to the TOAST table
+INSERT INTO cmdata_zstd VALUES (1, repeat('1234567890', 1000));
+INSERT INTO cmdata_zstd VALUES (2, repeat('1234567890', 1000000));
+SELECT id, pg_column_compression(f1), length(f1),
+       f1 = repeat('1234567890', length(f1) / 10) AS round_trip
+  FROM cmdata_zstd ORDER BY id;
+SELECT id, substr(f1, 9991, 10) FROM cmdata_zstd ORDER BY id;
+
+-- an update that leaves the value alone keeps it as it is
+UPDATE cmdata_zstd SET id = id + 10;
+SELECT id, pg_column_compression(f1),
+       f1 = repeat('1234567890', length(f1) / 10) AS round_trip
+  FROM cmdata_zstd ORDER BY id;
+
+-- changing the method only affects values compressed afterwards
+ALTER TABLE cmdata_zstd ALTER COLUMN f1 SET (compression = pglz);
+INSERT INTO cmdata_zstd VALUES (3, repeat('1234567890', 1000));
+SELECT id, pg_column_compression(f1),
+       f1 = repeat('1234567890', length(f1) / 10) AS round_trip
+  FROM cmdata_zstd ORDER BY id;
+DROP TABLE cmdata_zstd;
+
+-- default method for columns without the option
+SET default_toast_compression = zstd;
+CREATE TABLE cmdata_zstd_default (f1 text);
+INSERT INTO cmdata_zstd_default VALUES (repeat('1234567890', 1000));
+SELECT pg_column_compression(f1),
+       f1 = repeat('1234567890', 1000) AS round_trip
+  FROM cmdata_zstd_default;
+DROP TABLE cmdata_zstd_default;
+RESET default_toast_compression;
+
+-- graph properties
+CREATE GRAPH cmgraph_zstd;
+SET graph_path = cmgraph_zstd;
+CREATE VLABEL doc;
+ALTER VLABEL doc SET COMPRESSION zstd;
+CREATE (:doc {body: (SELECT repeat('1234567890', 1000))});
+MATCH (d:doc)
+RETURN length(d.body),
+       d.body = (SELECT to_jsonb(repeat('1234567890', 1000))) AS round_trip;
+SELECT pg_column_compression(properties) FROM cmgraph_zstd.doc;
+DROP GRAPH cmgraph_zstd CASCADE;
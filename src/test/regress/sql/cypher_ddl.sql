@@ -134,6 +134,11 @@ COMMENT ON VLABEL v1 IS 'multiple inheritance test';
 ALTER VLABEL v0 SET STORAGE external;
 \d+ g.v0
 
+ALTER VLABEL v0 SET COMPRESSION pglz;
+SELECT attoptions FROM pg_attribute
+  WHERE attrelid = 'g.v0'::regclass AND attname = 'properties';
+ALTER VLABEL v0 SET COMPRESSION foo;	--should fail
+
 ALTER VLABEL v0 RENAME TO vv;
 \dGv
 ALTER VLABEL vv RENAME TO v0;
@@ -635,6 +635,60 @@ MATCH (v1:v {id: 0}), (v2:v {id: 3}),
 	  (path, x)=dijkstra((v1)-[e:e]->(v2), e.weight, LIMIT 10)
 return nodes(path), x;
 
+-- graph_traversal_max_degree
+
+CREATE FUNCTION explain_traversal(query text) RETURNS SETOF text AS $$
+DECLARE
+  ln text;
+BEGIN
+  FOR ln IN EXECUTE 'EXPLAIN (analyze, costs off, timing off) ' || query LOOP
+    IF ln ~ 'Heap Pushes|Inner Rescans|Rescan Time' THEN
+      RETURN NEXT regexp_replace(btrim(ln), 'Memory: \d+kB', 'Memory: NkB');
+    END IF;
+  END LOOP;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE (:v {id: 10});
+CREATE (:v {id: 14});
+MATCH (v1:v {id: 10})
+CREATE (v1)-[:e {weight: 1}]->(:v {id: 11});
+MATCH (v1:v {id: 10})
+CREATE (v1)-[:e {weight: 1}]->(:v {id: 12});
+MATCH (v1:v {id: 10})
+CREATE (v1)-[:e {weight: 1}]->(:v {id: 13});
+
+SET graph_traversal_max_degree = 2;
+
+MATCH (:v {id: 10})-[:e*1..2]->(x) RETURN count(x);
+
+SELECT explain_traversal($$
+  MATCH (:v {id: 10})-[:e*1..2]->(x) RETURN count(x)
+$$);
+
+SELECT explain_traversal($$
+  MATCH (v1:v {id: 10}), (v2:v {id: 14})
+  RETURN dijkstra((v1)-[e:e]->(v2), e.weight)
+$$);
+
+SET graph_traversal_max_degree = 3;
+
+MATCH (:v {id: 10})-[:e*1..2]->(x) RETURN count(x);
+
+SELECT explain_traversal($$
+  MATCH (v1:v {id: 10}), (v2:v {id: 14})
+  RETURN dijkstra((v1)-[e:e]->(v2), e.weight)
+$$);
+
+RESET graph_traversal_max_degree;
+
+SELECT explain_traversal($$
+  MATCH (v1:v {id: 10}), (v2:v {id: 14})
+  RETURN dijkstra((v1)-[e:e]->(v2), e.weight)
+$$);
+
+DROP FUNCTION explain_traversal(text);
+
 SET graph_path = agens;
 
 --
@@ -36,3 +36,25 @@ SELECT g.* FROM GRAPHID_TBL g WHERE g.f1 <= '12345.123'::graphid;
 SET enable_seqscan = on;
 
 DROP TABLE GRAPHID_TBL;
+
+-- Sort
+
+CREATE TABLE GRAPHID_SORT_TBL AS
+  SELECT graphid((i % 3) + 1, ((i * 7919) % 5003)::int8) AS f1
+  FROM generate_series(1, 5000) i;
+INSERT INTO GRAPHID_SORT_TBL VALUES (NULL);
+
+-- sorting by f1 must agree with sorting by its label ID and local ID
+SELECT count(*) FROM
+  (SELECT row_number() OVER (ORDER BY f1) AS r1,
+          row_number() OVER (ORDER BY graphid_labid(f1), graphid_locid(f1)) AS r2
+   FROM GRAPHID_SORT_TBL) s
+WHERE r1 <> r2;
+SELECT count(*) FROM
+  (SELECT row_number() OVER (ORDER BY f1 DESC NULLS LAST) AS r1,
+          row_number() OVER (ORDER BY graphid_labid(f1) DESC NULLS LAST,
+                                      graphid_locid(f1) DESC NULLS LAST) AS r2
+   FROM GRAPHID_SORT_TBL) s
+WHERE r1 <> r2;
+
+DROP TABLE GRAPHID_SORT_TBL;
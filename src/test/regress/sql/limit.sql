@@ -99,3 +99,13 @@ select sum(tenthous) as s1, sum(tenthous) + random()*0 as s2
 
 select sum(tenthous) as s1, sum(tenthous) + random()*0 as s2
   from tenk1 group by thousand order by thousand limit 3;
+
+-- incremental sort: input ordered by thousand only needs each group sorted
+explain (costs off)
+select thousand, unique1 from tenk1 order by thousand, unique1 limit 5;
+
+select thousand, unique1 from tenk1 order by thousand, unique1 limit 5;
+
+-- results spanning several groups
+select thousand, unique1 from tenk1
+  order by thousand, unique1 desc limit 3 offset 38;
@@ -154,7 +154,19 @@ SELECT * FROM pxtest3;
 -- There should be no prepared transactions
 SELECT gid FROM pg_prepared_xacts;
 
+-- A prepared transaction must still be seen as running by the session that
+-- prepared it, even if that session could reuse its previous snapshot
+CREATE TABLE pxtest5 (a int);
+BEGIN;
+INSERT INTO pxtest5 VALUES (1);
+SELECT * FROM pxtest5;
+PREPARE TRANSACTION 'regress-five';
+SELECT * FROM pxtest5;
+COMMIT PREPARED 'regress-five';
+SELECT * FROM pxtest5;
+
 -- Clean up
 DROP TABLE pxtest2;
 DROP TABLE pxtest3;  -- will still be there if prepared xacts are disabled
 DROP TABLE pxtest4;
+DROP TABLE pxtest5;
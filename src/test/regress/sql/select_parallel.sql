@@ -39,6 +39,51 @@ explain (costs off)
 	select  sum(parallel_restricted(unique1)) from tenk1
 	group by(parallel_restricted(unique1));
 
+-- test a hash join whose inner relation is scanned in parallel too, so that
+-- the workers build a single hash table together
+set enable_mergejoin to off;
+set enable_nestloop to off;
+explain (costs off)
+  select count(*) from tenk1 t1 join tenk2 t2 on t1.unique1 = t2.unique1;
+select count(*) from tenk1 t1 join tenk2 t2 on t1.unique1 = t2.unique1;
+set enable_parallel_hash to off;
+select count(*) from tenk1 t1 join tenk2 t2 on t1.unique1 = t2.unique1;
+reset enable_parallel_hash;
+reset enable_mergejoin;
+reset enable_nestloop;
+
+-- test gather merge
+explain (costs off)
+  select fivethous from tenk1 order by fivethous limit 4;
+select fivethous from tenk1 order by fivethous limit 4;
+
+set enable_hashagg to off;
+explain (costs off)
+  select count(*) from tenk1 group by twenty;
+select count(*) from tenk1 group by twenty;
+reset enable_hashagg;
+
+-- test parallel index scans
+set enable_seqscan to off;
+set enable_bitmapscan to off;
+explain (costs off)
+  select count((unique1)) from tenk1 where hundred > 1;
+select count((unique1)) from tenk1 where hundred > 1;
+
+-- test parallel index-only scans
+explain (costs off)
+  select count(*) from tenk1 where thousand > 95;
+select count(*) from tenk1 where thousand > 95;
+reset enable_bitmapscan;
+
+-- test parallel bitmap heap scans
+set enable_indexscan to off;
+explain (costs off)
+  select count((unique1)) from tenk1 where hundred > 1;
+select count((unique1)) from tenk1 where hundred > 1;
+reset enable_indexscan;
+reset enable_seqscan;
+
 set force_parallel_mode=1;
 
 explain (costs off)
@@ -164,5 +164,13 @@ SELECT st.heap_blks_read + st.heap_blks_hit >= pr.heap_blks + cl.relpages,
 SELECT pr.snap_ts < pg_stat_get_snapshot_timestamp() as snapshot_newer
 FROM prevstats AS pr;
 
+SELECT policy, hits > 0 AS hits, misses >= evictions AS misses
+  FROM pg_stat_get_buffer_replacement();
+
+SELECT node, local_hits > 0 AS local_hits, remote_hits
+  FROM pg_stat_get_buffer_nodes();
+
+SELECT prefetch, skip_hit, distance FROM pg_stat_get_recovery_prefetch();
+
 DROP TABLE trunc_stats_test, trunc_stats_test1, trunc_stats_test2, trunc_stats_test3, trunc_stats_test4;
 -- End of Stats Test
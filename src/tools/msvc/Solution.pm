@@ -223,6 +223,16 @@ s{PG_VERSION_STR "[^"]+"}{__STRINGIFY(x) #x\n#define __STRINGIFY2(z) __STRINGIFY
 			print O "#define HAVE_LIBXSLT\n";
 			print O "#define USE_LIBXSLT\n";
 		}
+		if ($self->{options}->{lz4})
+		{
+			print O "#define HAVE_LIBLZ4 1\n";
+			print O "#define USE_LZ4 1\n";
+		}
+		if ($self->{options}->{zstd})
+		{
+			print O "#define HAVE_LIBZSTD 1\n";
+			print O "#define USE_ZSTD 1\n";
+		}
 		if ($self->{options}->{gss})
 		{
 			print O "#define ENABLE_GSS 1\n";
@@ -563,6 +573,16 @@ sub AddProject
 		$proj->AddIncludeDir($self->{options}->{xslt} . '\include');
 		$proj->AddLibrary($self->{options}->{xslt} . '\lib\libxslt.lib');
 	}
+	if ($self->{options}->{lz4})
+	{
+		$proj->AddIncludeDir($self->{options}->{lz4} . '\include');
+		$proj->AddLibrary($self->{options}->{lz4} . '\lib\liblz4.lib');
+	}
+	if ($self->{options}->{zstd})
+	{
+		$proj->AddIncludeDir($self->{options}->{zstd} . '\include');
+		$proj->AddLibrary($self->{options}->{zstd} . '\lib\libzstd.lib');
+	}
 	return $proj;
 }
 
@@ -670,6 +690,8 @@ sub GetFakeConfigure
 	$cfg .= ' --with-ossp-uuid'     if ($self->{options}->{uuid});
 	$cfg .= ' --with-libxml'        if ($self->{options}->{xml});
 	$cfg .= ' --with-libxslt'       if ($self->{options}->{xslt});
+	$cfg .= ' --with-lz4'           if ($self->{options}->{lz4});
+	$cfg .= ' --with-zstd'          if ($self->{options}->{zstd});
 	$cfg .= ' --with-gssapi'        if ($self->{options}->{gss});
 	$cfg .= ' --with-tcl'           if ($self->{options}->{tcl});
 	$cfg .= ' --with-perl'          if ($self->{options}->{perl});
@@ -26,7 +26,9 @@ our $config = {
 	xml       => undef,    # --with-libxml=<path>
 	xslt      => undef,    # --with-libxslt=<path>
 	iconv     => undef,    # (not in configure, path to iconv)
-	zlib      => undef     # --with-zlib=<path>
+	lz4       => undef,    # --with-lz4=<path>
+	zlib      => undef,    # --with-zlib=<path>
+	zstd      => undef     # --with-zstd=<path>
 };
 
 1;
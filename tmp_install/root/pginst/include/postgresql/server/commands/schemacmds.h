@@ -0,0 +1,30 @@
+/*-------------------------------------------------------------------------
+ *
+ * schemacmds.h
+ *	  prototypes for schemacmds.c.
+ *
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * src/include/commands/schemacmds.h
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#ifndef SCHEMACMDS_H
+#define SCHEMACMDS_H
+
+#include "catalog/objectaddress.h"
+#include "nodes/parsenodes.h"
+
+extern Oid CreateSchemaCommand(CreateSchemaStmt *parsetree,
+					const char *queryString);
+
+extern void RemoveSchemaById(Oid schemaOid);
+
+extern ObjectAddress RenameSchema(const char *oldname, const char *newname);
+extern ObjectAddress AlterSchemaOwner(const char *name, Oid newOwnerId);
+extern void AlterSchemaOwner_oid(Oid schemaOid, Oid newOwnerId);
+
+#endif   /* SCHEMACMDS_H */
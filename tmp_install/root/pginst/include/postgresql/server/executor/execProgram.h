@@ -0,0 +1,168 @@
+/*-------------------------------------------------------------------------
+ *
+ * execProgram.h
+ *	  Flat step programs for evaluation of scalar expressions
+ *
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * src/include/executor/execProgram.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef EXECPROGRAM_H
+#define EXECPROGRAM_H
+
+#include "nodes/execnodes.h"
+
+/*
+ * Slots a Var step can read from.  These index the array of slots that the
+ * interpreter loads from the ExprContext once per evaluation.
+ */
+#define EEP_SCAN_SLOT	0
+#define EEP_INNER_SLOT	1
+#define EEP_OUTER_SLOT	2
+#define EEP_NUM_SLOTS	3
+
+typedef enum ExprProgramOpcode
+{
+	/* end of the program */
+	EEOP_DONE,
+
+	/* load a (user) attribute of a slot */
+	EEOP_VAR,
+
+	/* load a constant */
+	EEOP_CONST,
+
+	/* call a function whose arguments have been evaluated by earlier steps */
+	EEOP_FUNCEXPR,
+	EEOP_FUNCEXPR_STRICT,
+	EEOP_FUNCEXPR_FUSAGE,
+
+	/*
+	 * call a strict function whose arguments are all Vars or non-null
+	 * Consts; the Vars are fetched and null-checked by this step itself
+	 */
+	EEOP_FUNCEXPR_STRICT_VARS,
+
+	/* AND and OR evaluate their argument into the result, then check it */
+	EEOP_BOOL_AND_STEP_FIRST,
+	EEOP_BOOL_AND_STEP,
+	EEOP_BOOL_AND_STEP_LAST,
+	EEOP_BOOL_OR_STEP_FIRST,
+	EEOP_BOOL_OR_STEP,
+	EEOP_BOOL_OR_STEP_LAST,
+	EEOP_BOOL_NOT,
+
+	/* evaluate a subexpression the program does not know through its tree */
+	EEOP_EXPRSTATE,
+
+	EEOP_LAST
+} ExprProgramOpcode;
+
+/* a Var passed directly to a function by EEOP_FUNCEXPR_STRICT_VARS */
+typedef struct ExprProgramVarArg
+{
+	int			slot;			/* EEP_*_SLOT */
+	int			attnum;			/* zero-based attribute number */
+	int			argno;			/* position in the argument list */
+} ExprProgramVarArg;
+
+typedef struct ExprProgramStep
+{
+	/*
+	 * ExprProgramOpcode while the program is being built.  If the interpreter
+	 * uses direct threading, this is replaced by the address of the code
+	 * that implements the step when the program is finished.
+	 */
+	intptr_t	opcode;
+
+	/* where to store the result of this step */
+	Datum	   *resvalue;
+	bool	   *resnull;
+
+	union
+	{
+		/* for EEOP_VAR */
+		struct
+		{
+			int			slot;
+			int			attnum;		/* zero-based attribute number */
+		}			var;
+
+		/* for EEOP_CONST */
+		struct
+		{
+			Datum		value;
+			bool		isnull;
+		}			constval;
+
+		/* for EEOP_FUNCEXPR* */
+		struct
+		{
+			FmgrInfo   *finfo;
+			FunctionCallInfo fcinfo;
+			int			nargs;
+			int			nvars;		/* EEOP_FUNCEXPR_STRICT_VARS only */
+			ExprProgramVarArg *vars;
+		}			func;
+
+		/* for EEOP_BOOL_*_STEP* */
+		struct
+		{
+			bool	   *anynull;	/* track if any input was NULL */
+			int			jumpdone;	/* step to jump to when result is known */
+		}			boolexpr;
+
+		/* for EEOP_EXPRSTATE */
+		struct
+		{
+			ExprState  *state;
+		}			exprstate;
+	}			d;
+} ExprProgramStep;
+
+typedef struct ExprProgram ExprProgram;
+
+typedef Datum (*ExprProgramEvalFunc) (ExprProgram *program,
+												  ExprContext *econtext,
+												  bool *isNull);
+
+struct ExprProgram
+{
+	/*
+	 * Function that runs the program; the interpreter, or native code
+	 * emitted by a JIT provider.
+	 */
+	ExprProgramEvalFunc evalfunc;
+
+	ExprProgramStep *steps;
+	int			nsteps;
+
+	/* result of the whole program */
+	Datum		resvalue;
+	bool		resnull;
+
+	/*
+	 * Highest attribute referenced in each slot.  All of them are deformed
+	 * with a single slot_getsomeattrs() call before the first step runs.
+	 */
+	int			last_attnum[EEP_NUM_SLOTS];
+
+	/*
+	 * Descriptors of the slots when the program was built, so that a JIT
+	 * provider can generate deforming code for them.
+	 */
+	TupleDesc	last_desc[EEP_NUM_SLOTS];
+};
+
+extern ExprProgram *ExecBuildExprProgram(ExprState *state,
+					 ExprContext *econtext);
+extern Datum ExecEvalExprProgram(FuncExprState *fcache,
+					ExprContext *econtext,
+					bool *isNull,
+					ExprDoneCond *isDone);
+
+#endif   /* EXECPROGRAM_H */
@@ -0,0 +1,279 @@
+/*-------------------------------------------------------------------------
+ *
+ * hashjoin.h
+ *	  internal structures for hash joins
+ *
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * src/include/executor/hashjoin.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef HASHJOIN_H
+#define HASHJOIN_H
+
+#include "nodes/execnodes.h"
+#include "port/atomics.h"
+#include "storage/buffile.h"
+#include "storage/dsm.h"
+#include "storage/spin.h"
+
+/* ----------------------------------------------------------------
+ *				hash-join hash table structures
+ *
+ * Each active hashjoin has a HashJoinTable control block, which is
+ * palloc'd in the executor's per-query context.  All other storage needed
+ * for the hashjoin is kept in private memory contexts, two for each hashjoin.
+ * This makes it easy and fast to release the storage when we don't need it
+ * anymore.  (Exception: data associated with the temp files lives in the
+ * per-query context too, since we always call buffile.c in that context.)
+ *
+ * The hashtable contexts are made children of the per-query context, ensuring
+ * that they will be discarded at end of statement even if the join is
+ * aborted early by an error.  (Likewise, any temporary files we make will
+ * be cleaned up by the virtual file manager in event of an error.)
+ *
+ * Storage that should live through the entire join is allocated from the
+ * "hashCxt", while storage that is only wanted for the current batch is
+ * allocated in the "batchCxt".  By resetting the batchCxt at the end of
+ * each batch, we free all the per-batch storage reliably and without tedium.
+ *
+ * During first scan of inner relation, we get its tuples from executor.
+ * If nbatch > 1 then tuples that don't belong in first batch get saved
+ * into inner-batch temp files. The same statements apply for the
+ * first scan of the outer relation, except we write tuples to outer-batch
+ * temp files.  After finishing the first scan, we do the following for
+ * each remaining batch:
+ *	1. Read tuples from inner batch file, load into hash buckets.
+ *	2. Read tuples from outer batch file, match to hash buckets and output.
+ *
+ * It is possible to increase nbatch on the fly if the in-memory hash table
+ * gets too big.  The hash-value-to-batch computation is arranged so that this
+ * can only cause a tuple to go into a later batch than previously thought,
+ * never into an earlier batch.  When we increase nbatch, we rescan the hash
+ * table and dump out any tuples that are now of a later batch to the correct
+ * inner batch file.  Subsequently, while reading either inner or outer batch
+ * files, we might find tuples that no longer belong to the current batch;
+ * if so, we just dump them out to the correct batch file.
+ *
+ * A parallel-aware hashjoin builds a single table that all participants of
+ * the parallel query share.  Its buckets live in the parallel query's DSM
+ * segment, and each participant copies the inner tuples it reads into DSM
+ * segments of its own, which the others map once the table is complete.
+ * Since these are mapped at different addresses in each process, the links
+ * between shared tuples are HashJoinSharedPtrs rather than pointers.  Shared
+ * tables are never batched: the planner only chooses them when the whole
+ * inner relation is expected to fit into work_mem.
+ * ----------------------------------------------------------------
+ */
+
+/*
+ * Location of a tuple in a shared hash table: the number of the segment
+ * holding it plus one, and its offset within that segment.
+ */
+typedef uint64 HashJoinSharedPtr;
+
+#define InvalidHashJoinSharedPtr	((HashJoinSharedPtr) 0)
+#define HashJoinSharedPtrMake(segno, offset) \
+	((((HashJoinSharedPtr) (segno) + 1) << 32) | (HashJoinSharedPtr) (offset))
+#define HashJoinSharedPtrSegno(ptr)		((int) ((ptr) >> 32) - 1)
+#define HashJoinSharedPtrOffset(ptr)	((Size) ((ptr) & 0xFFFFFFFF))
+
+/* these are in nodes/execnodes.h: */
+/* typedef struct HashJoinTupleData *HashJoinTuple; */
+/* typedef struct HashJoinTableData *HashJoinTable; */
+
+typedef struct HashJoinTupleData
+{
+	/* link to next tuple in same bucket */
+	union
+	{
+		struct HashJoinTupleData *unshared;
+		HashJoinSharedPtr shared;	/* in a parallel-aware hashjoin */
+	}			next;
+	uint32		hashvalue;		/* tuple's hash code */
+	/* Tuple data, in MinimalTuple format, follows on a MAXALIGN boundary */
+}	HashJoinTupleData;
+
+#define HJTUPLE_OVERHEAD  MAXALIGN(sizeof(HashJoinTupleData))
+#define HJTUPLE_MINTUPLE(hjtup)  \
+	((MinimalTuple) ((char *) (hjtup) + HJTUPLE_OVERHEAD))
+
+/*
+ * If the outer relation's distribution is sufficiently nonuniform, we attempt
+ * to optimize the join by treating the hash values corresponding to the outer
+ * relation's MCVs specially.  Inner relation tuples matching these hash
+ * values go into the "skew" hashtable instead of the main hashtable, and
+ * outer relation tuples with these hash values are matched against that
+ * table instead of the main one.  Thus, tuples with these hash values are
+ * effectively handled as part of the first batch and will never go to disk.
+ * The skew hashtable is limited to SKEW_WORK_MEM_PERCENT of the total memory
+ * allowed for the join; while building the hashtables, we decrease the number
+ * of MCVs being specially treated if needed to stay under this limit.
+ *
+ * Note: you might wonder why we look at the outer relation stats for this,
+ * rather than the inner.  One reason is that the outer relation is typically
+ * bigger, so we get more I/O savings by optimizing for its most common values.
+ * Also, for similarly-sized relations, the planner prefers to put the more
+ * uniformly distributed relation on the inside, so we're more likely to find
+ * interesting skew in the outer relation.
+ */
+typedef struct HashSkewBucket
+{
+	uint32		hashvalue;		/* common hash value */
+	HashJoinTuple tuples;		/* linked list of inner-relation tuples */
+} HashSkewBucket;
+
+#define SKEW_BUCKET_OVERHEAD  MAXALIGN(sizeof(HashSkewBucket))
+#define INVALID_SKEW_BUCKET_NO	(-1)
+#define SKEW_WORK_MEM_PERCENT  2
+#define SKEW_MIN_OUTER_FRACTION  0.01
+
+/*
+ * To reduce palloc overhead, the HashJoinTuples for the current batch are
+ * packed in 32kB buffers instead of pallocing each tuple individually.
+ */
+typedef struct HashMemoryChunkData
+{
+	int			ntuples;		/* number of tuples stored in this chunk */
+	size_t		maxlen;			/* size of the buffer holding the tuples */
+	size_t		used;			/* number of buffer bytes already used */
+
+	struct HashMemoryChunkData *next;	/* pointer to the next chunk (linked
+										 * list) */
+
+	char		data[FLEXIBLE_ARRAY_MEMBER];	/* buffer allocated at the end */
+}	HashMemoryChunkData;
+
+typedef struct HashMemoryChunkData *HashMemoryChunk;
+
+#define HASH_CHUNK_SIZE			(32 * 1024L)
+#define HASH_CHUNK_THRESHOLD	(HASH_CHUNK_SIZE / 4)
+
+/*
+ * State of a parallel-aware hashjoin, kept in the parallel query's DSM.
+ *
+ * Participants that arrive before the build is over insert the inner tuples
+ * they read, then wait until everybody that joined the build has done the
+ * same.  Participants that arrive later skip straight to probing.
+ *
+ * The DSM segments holding the tuples belong to the participants that
+ * created them, so they must stay mapped by somebody until everybody has
+ * mapped them: a participant keeps them mapped ("holds" them) until it is
+ * done with the join, and doesn't let go while another one is still mapping
+ * them.  When no participant holds them any more, every participant has
+ * finished probing, so there is no outer tuple left for latecomers to probe
+ * with.
+ *
+ * Participants record their pgprocno in the array following the buckets, so
+ * that whoever ends the build or finishes the last mapping can set their
+ * latches.  The segments may take up to work_mem in total, the bucket array
+ * included; a participant that would need more raises an error, since the
+ * table can't be batched.
+ */
+#define PHJ_SEGMENT_SIZE		(1024 * 1024L)	/* size of first segment */
+#define PHJ_MAX_SEGMENT_SIZE	(1024 * 1024 * 1024L)
+#define PHJ_MAX_SEGMENTS		256
+
+typedef struct ParallelHashJoinState
+{
+	slock_t		mutex;			/* protects all fields below but buckets */
+	int			nbuckets;		/* # buckets, fixed when the DSM is set up */
+	int			nparticipants;	/* # participants that joined the build */
+	int			nbuilt;			/* # of those that inserted their tuples */
+	bool		build_done;		/* have all of them done so? */
+	int			nholders;		/* # participants holding the segments */
+	int			nmapping;		/* # participants mapping them right now */
+	double		totalTuples;	/* # tuples in the table */
+	Size		spaceUsed;		/* space used by them */
+	Size		spaceAllowed;	/* work_mem, in bytes */
+	Size		spaceReserved;	/* space of the segments and buckets */
+	int			nsegments;		/* # segments holding the tuples */
+	dsm_handle	segments[PHJ_MAX_SEGMENTS];
+	int			maxprocs;		/* max # participants, in the procnos array */
+	int			nprocs;			/* # participants in the procnos array */
+	pg_atomic_uint64 buckets[FLEXIBLE_ARRAY_MEMBER];	/* HashJoinSharedPtrs */
+	/* followed by int procnos[maxprocs] */
+} ParallelHashJoinState;
+
+#define ParallelHashJoinProcnos(pstate) \
+	((int *) &(pstate)->buckets[(pstate)->nbuckets])
+
+typedef struct HashJoinTableData
+{
+	int			nbuckets;		/* # buckets in the in-memory hash table */
+	int			log2_nbuckets;	/* its log2 (nbuckets must be a power of 2) */
+
+	int			nbuckets_original;		/* # buckets when starting the first
+										 * hash */
+	int			nbuckets_optimal;		/* optimal # buckets (per batch) */
+	int			log2_nbuckets_optimal;	/* log2(nbuckets_optimal) */
+
+	/* buckets[i] is head of list of tuples in i'th in-memory bucket */
+	struct HashJoinTupleData **buckets;
+	/* buckets array is per-batch storage, as are all the tuples */
+
+	bool		keepNulls;		/* true to store unmatchable NULL tuples */
+
+	bool		skewEnabled;	/* are we using skew optimization? */
+	HashSkewBucket **skewBucket;	/* hashtable of skew buckets */
+	int			skewBucketLen;	/* size of skewBucket array (a power of 2!) */
+	int			nSkewBuckets;	/* number of active skew buckets */
+	int		   *skewBucketNums; /* array indexes of active skew buckets */
+
+	int			nbatch;			/* number of batches */
+	int			curbatch;		/* current batch #; 0 during 1st pass */
+
+	int			nbatch_original;	/* nbatch when we started inner scan */
+	int			nbatch_outstart;	/* nbatch when we started outer scan */
+
+	bool		growEnabled;	/* flag to shut off nbatch increases */
+
+	double		totalTuples;	/* # tuples obtained from inner plan */
+	double		skewTuples;		/* # tuples inserted into skew tuples */
+
+	/*
+	 * These arrays are allocated for the life of the hash join, but only if
+	 * nbatch > 1.  A file is opened only when we first write a tuple into it
+	 * (otherwise its pointer remains NULL).  Note that the zero'th array
+	 * elements never get used, since we will process rather than dump out any
+	 * tuples of batch zero.
+	 */
+	BufFile   **innerBatchFile; /* buffered virtual temp file per batch */
+	BufFile   **outerBatchFile; /* buffered virtual temp file per batch */
+
+	/*
+	 * Info about the datatype-specific hash functions for the datatypes being
+	 * hashed. These are arrays of the same length as the number of hash join
+	 * clauses (hash keys).
+	 */
+	FmgrInfo   *outer_hashfunctions;	/* lookup data for hash functions */
+	FmgrInfo   *inner_hashfunctions;	/* lookup data for hash functions */
+	bool	   *hashStrict;		/* is each hash join operator strict? */
+
+	Size		spaceUsed;		/* memory space currently used by tuples */
+	Size		spaceAllowed;	/* upper limit for space used */
+	Size		spacePeak;		/* peak space used */
+	Size		spaceUsedSkew;	/* skew hash table's current space usage */
+	Size		spaceAllowedSkew;		/* upper limit for skew hashtable */
+
+	MemoryContext hashCxt;		/* context for whole-hash-join storage */
+	MemoryContext batchCxt;		/* context for this-batch-only storage */
+
+	/* used for dense allocation of tuples (into linked chunks) */
+	HashMemoryChunk chunks;		/* one list for the whole batch */
+
+	/* used by parallel-aware hashjoins only */
+	ParallelHashJoinState *parallel_state;	/* NULL if private */
+	dsm_segment **segments;		/* segments mapped by us, by number */
+	char	  **segment_bases;	/* their addresses */
+	int			nsegments_created;	/* # segments created by us */
+	int			cur_segno;		/* segment we are filling, or -1 */
+	Size		cur_segment_used;	/* space used in it */
+	Size		cur_segment_size;	/* its size */
+	bool		holding;		/* are we holding the segments? */
+}	HashJoinTableData;
+
+#endif   /* HASHJOIN_H */
@@ -0,0 +1,28 @@
+/*-------------------------------------------------------------------------
+ *
+ * nodeAgg.h
+ *	  prototypes for nodeAgg.c
+ *
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * src/include/executor/nodeAgg.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef NODEAGG_H
+#define NODEAGG_H
+
+#include "nodes/execnodes.h"
+
+extern AggState *ExecInitAgg(Agg *node, EState *estate, int eflags);
+extern TupleTableSlot *ExecAgg(AggState *node);
+extern void ExecEndAgg(AggState *node);
+extern void ExecReScanAgg(AggState *node);
+
+extern Size hash_agg_entry_size(int numAggs);
+
+extern Datum aggregate_dummy(PG_FUNCTION_ARGS);
+
+#endif   /* NODEAGG_H */
@@ -0,0 +1,33 @@
+/*
+ * nodeDijkstra.h
+ *
+ * Copyright (c) 2017 by Bitnine Global, Inc.
+ *
+ * src/include/executor/nodeDijkstra.h
+ */
+
+#ifndef NODEDIJKSTRA_H
+#define NODEDIJKSTRA_H
+
+#include "access/parallel.h"
+#include "nodes/execnodes.h"
+
+extern DijkstraState *ExecInitDijkstra(Dijkstra *node, EState *estate,
+									   int eflags);
+extern TupleTableSlot *ExecDijkstra(DijkstraState *node);
+extern void ExecEndDijkstra(DijkstraState *node);
+extern void ExecReScanDijkstra(DijkstraState *node);
+extern void ExecShutdownDijkstra(DijkstraState *node);
+
+/* parallel instrumentation support */
+extern void ExecDijkstraEstimate(DijkstraState *node, ParallelContext *pcxt);
+extern void ExecDijkstraInitializeDSM(DijkstraState *node,
+									  ParallelContext *pcxt);
+extern void ExecDijkstraReInitializeDSM(DijkstraState *node,
+										ParallelContext *pcxt);
+extern void ExecDijkstraInitializeWorker(DijkstraState *node, shm_toc *toc);
+extern void ExecDijkstraRetrieveInstrumentation(DijkstraState *node);
+extern void ExecDijkstraAccumInstrumentation(DijkstraInstrumentation *dst,
+											 DijkstraInstrumentation *src);
+
+#endif
@@ -0,0 +1,98 @@
+/*-------------------------------------------------------------------------
+ *
+ * replnodes.h
+ *	  definitions for replication grammar parse nodes
+ *
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * src/include/nodes/replnodes.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef REPLNODES_H
+#define REPLNODES_H
+
+#include "access/xlogdefs.h"
+#include "nodes/pg_list.h"
+
+typedef enum ReplicationKind
+{
+	REPLICATION_KIND_PHYSICAL,
+	REPLICATION_KIND_LOGICAL
+} ReplicationKind;
+
+
+/* ----------------------
+ *		IDENTIFY_SYSTEM command
+ * ----------------------
+ */
+typedef struct IdentifySystemCmd
+{
+	NodeTag		type;
+} IdentifySystemCmd;
+
+
+/* ----------------------
+ *		BASE_BACKUP command
+ * ----------------------
+ */
+typedef struct BaseBackupCmd
+{
+	NodeTag		type;
+	List	   *options;
+} BaseBackupCmd;
+
+
+/* ----------------------
+ *		CREATE_REPLICATION_SLOT command
+ * ----------------------
+ */
+typedef struct CreateReplicationSlotCmd
+{
+	NodeTag		type;
+	char	   *slotname;
+	ReplicationKind kind;
+	char	   *plugin;
+	bool		reserve_wal;
+} CreateReplicationSlotCmd;
+
+
+/* ----------------------
+ *		DROP_REPLICATION_SLOT command
+ * ----------------------
+ */
+typedef struct DropReplicationSlotCmd
+{
+	NodeTag		type;
+	char	   *slotname;
+} DropReplicationSlotCmd;
+
+
+/* ----------------------
+ *		START_REPLICATION command
+ * ----------------------
+ */
+typedef struct StartReplicationCmd
+{
+	NodeTag		type;
+	ReplicationKind kind;
+	char	   *slotname;
+	TimeLineID	timeline;
+	XLogRecPtr	startpoint;
+	List	   *options;
+} StartReplicationCmd;
+
+
+/* ----------------------
+ *		TIMELINE_HISTORY command
+ * ----------------------
+ */
+typedef struct TimeLineHistoryCmd
+{
+	NodeTag		type;
+	TimeLineID	timeline;
+} TimeLineHistoryCmd;
+
+#endif   /* REPLNODES_H */
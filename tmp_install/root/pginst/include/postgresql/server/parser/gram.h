@@ -0,0 +1,589 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_BASE_YY_GRAM_H_INCLUDED
+# define YY_BASE_YY_GRAM_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int base_yydebug;
+#endif
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    IDENT = 258,                   /* IDENT  */
+    FCONST = 259,                  /* FCONST  */
+    SCONST = 260,                  /* SCONST  */
+    BCONST = 261,                  /* BCONST  */
+    XCONST = 262,                  /* XCONST  */
+    Op = 263,                      /* Op  */
+    ICONST = 264,                  /* ICONST  */
+    PARAM = 265,                   /* PARAM  */
+    TYPECAST = 266,                /* TYPECAST  */
+    DOT_DOT = 267,                 /* DOT_DOT  */
+    COLON_EQUALS = 268,            /* COLON_EQUALS  */
+    EQUALS_GREATER = 269,          /* EQUALS_GREATER  */
+    LESS_EQUALS = 270,             /* LESS_EQUALS  */
+    GREATER_EQUALS = 271,          /* GREATER_EQUALS  */
+    NOT_EQUALS = 272,              /* NOT_EQUALS  */
+    ADD_EQUALS = 273,              /* ADD_EQUALS  */
+    ABORT_P = 274,                 /* ABORT_P  */
+    ABSOLUTE_P = 275,              /* ABSOLUTE_P  */
+    ACCESS = 276,                  /* ACCESS  */
+    ACTION = 277,                  /* ACTION  */
+    ADD_P = 278,                   /* ADD_P  */
+    ADMIN = 279,                   /* ADMIN  */
+    AFTER = 280,                   /* AFTER  */
+    AGGREGATE = 281,               /* AGGREGATE  */
+    ALL = 282,                     /* ALL  */
+    ALLSHORTESTPATHS = 283,        /* ALLSHORTESTPATHS  */
+    ALSO = 284,                    /* ALSO  */
+    ALTER = 285,                   /* ALTER  */
+    ALWAYS = 286,                  /* ALWAYS  */
+    ANALYSE = 287,                 /* ANALYSE  */
+    ANALYZE = 288,                 /* ANALYZE  */
+    AND = 289,                     /* AND  */
+    ANY = 290,                     /* ANY  */
+    ARRAY = 291,                   /* ARRAY  */
+    AS = 292,                      /* AS  */
+    ASC = 293,                     /* ASC  */
+    ASSERT = 294,                  /* ASSERT  */
+    ASSERTION = 295,               /* ASSERTION  */
+    ASSIGNMENT = 296,              /* ASSIGNMENT  */
+    ASYMMETRIC = 297,              /* ASYMMETRIC  */
+    AT = 298,                      /* AT  */
+    ATTRIBUTE = 299,               /* ATTRIBUTE  */
+    AUTHORIZATION = 300,           /* AUTHORIZATION  */
+    BACKWARD = 301,                /* BACKWARD  */
+    BEFORE = 302,                  /* BEFORE  */
+    BEGIN_P = 303,                 /* BEGIN_P  */
+    BETWEEN = 304,                 /* BETWEEN  */
+    BIGINT = 305,                  /* BIGINT  */
+    BINARY = 306,                  /* BINARY  */
+    BIT = 307,                     /* BIT  */
+    BOOLEAN_P = 308,               /* BOOLEAN_P  */
+    BOTH = 309,                    /* BOTH  */
+    BY = 310,                      /* BY  */
+    CACHE = 311,                   /* CACHE  */
+    CALLED = 312,                  /* CALLED  */
+    CASCADE = 313,                 /* CASCADE  */
+    CASCADED = 314,                /* CASCADED  */
+    CASE = 315,                    /* CASE  */
+    CAST = 316,                    /* CAST  */
+    CATALOG_P = 317,               /* CATALOG_P  */
+    CHAIN = 318,                   /* CHAIN  */
+    CHAR_P = 319,                  /* CHAR_P  */
+    CHARACTER = 320,               /* CHARACTER  */
+    CHARACTERISTICS = 321,         /* CHARACTERISTICS  */
+    CHECK = 322,                   /* CHECK  */
+    CHECKPOINT = 323,              /* CHECKPOINT  */
+    CLASS = 324,                   /* CLASS  */
+    CLOSE = 325,                   /* CLOSE  */
+    CLUSTER = 326,                 /* CLUSTER  */
+    COALESCE = 327,                /* COALESCE  */
+    COLLATE = 328,                 /* COLLATE  */
+    COLLATION = 329,               /* COLLATION  */
+    COLUMN = 330,                  /* COLUMN  */
+    COMMENT = 331,                 /* COMMENT  */
+    COMMENTS = 332,                /* COMMENTS  */
+    COMMIT = 333,                  /* COMMIT  */
+    COMMITTED = 334,               /* COMMITTED  */
+    COMPRESSION = 335,             /* COMPRESSION  */
+    CONCURRENTLY = 336,            /* CONCURRENTLY  */
+    CONFIGURATION = 337,           /* CONFIGURATION  */
+    CONFLICT = 338,                /* CONFLICT  */
+    CONNECTION = 339,              /* CONNECTION  */
+    CONSTRAINT = 340,              /* CONSTRAINT  */
+    CONSTRAINTS = 341,             /* CONSTRAINTS  */
+    CONTENT_P = 342,               /* CONTENT_P  */
+    CONTINUE_P = 343,              /* CONTINUE_P  */
+    CONVERSION_P = 344,            /* CONVERSION_P  */
+    COPY = 345,                    /* COPY  */
+    COST = 346,                    /* COST  */
+    CREATE = 347,                  /* CREATE  */
+    CROSS = 348,                   /* CROSS  */
+    CSV = 349,                     /* CSV  */
+    CUBE = 350,                    /* CUBE  */
+    CURRENT_P = 351,               /* CURRENT_P  */
+    CURRENT_CATALOG = 352,         /* CURRENT_CATALOG  */
+    CURRENT_DATE = 353,            /* CURRENT_DATE  */
+    CURRENT_ROLE = 354,            /* CURRENT_ROLE  */
+    CURRENT_SCHEMA = 355,          /* CURRENT_SCHEMA  */
+    CURRENT_TIME = 356,            /* CURRENT_TIME  */
+    CURRENT_TIMESTAMP = 357,       /* CURRENT_TIMESTAMP  */
+    CURRENT_USER = 358,            /* CURRENT_USER  */
+    CURSOR = 359,                  /* CURSOR  */
+    CYCLE = 360,                   /* CYCLE  */
+    DATA_P = 361,                  /* DATA_P  */
+    DATABASE = 362,                /* DATABASE  */
+    DAY_P = 363,                   /* DAY_P  */
+    DEALLOCATE = 364,              /* DEALLOCATE  */
+    DEC = 365,                     /* DEC  */
+    DECIMAL_P = 366,               /* DECIMAL_P  */
+    DECLARE = 367,                 /* DECLARE  */
+    DEFAULT = 368,                 /* DEFAULT  */
+    DEFAULTS = 369,                /* DEFAULTS  */
+    DEFERRABLE = 370,              /* DEFERRABLE  */
+    DEFERRED = 371,                /* DEFERRED  */
+    DEFINER = 372,                 /* DEFINER  */
+    DELETE_P = 373,                /* DELETE_P  */
+    DELIMITER = 374,               /* DELIMITER  */
+    DELIMITERS = 375,              /* DELIMITERS  */
+    DEPENDS = 376,                 /* DEPENDS  */
+    DESC = 377,                    /* DESC  */
+    DETACH = 378,                  /* DETACH  */
+    DICTIONARY = 379,              /* DICTIONARY  */
+    DIJKSTRA = 380,                /* DIJKSTRA  */
+    DISABLE_P = 381,               /* DISABLE_P  */
+    DISCARD = 382,                 /* DISCARD  */
+    DISTINCT = 383,                /* DISTINCT  */
+    DO = 384,                      /* DO  */
+    DOCUMENT_P = 385,              /* DOCUMENT_P  */
+    DOMAIN_P = 386,                /* DOMAIN_P  */
+    DOUBLE_P = 387,                /* DOUBLE_P  */
+    DROP = 388,                    /* DROP  */
+    EACH = 389,                    /* EACH  */
+    ELABEL = 390,                  /* ELABEL  */
+    ELSE = 391,                    /* ELSE  */
+    ENABLE_P = 392,                /* ENABLE_P  */
+    ENCODING = 393,                /* ENCODING  */
+    ENCRYPTED = 394,               /* ENCRYPTED  */
+    END_P = 395,                   /* END_P  */
+    ENUM_P = 396,                  /* ENUM_P  */
+    ESCAPE = 397,                  /* ESCAPE  */
+    EVENT = 398,                   /* EVENT  */
+    EXCEPT = 399,                  /* EXCEPT  */
+    EXCLUDE = 400,                 /* EXCLUDE  */
+    EXCLUDING = 401,               /* EXCLUDING  */
+    EXCLUSIVE = 402,               /* EXCLUSIVE  */
+    EXECUTE = 403,                 /* EXECUTE  */
+    EXISTS = 404,                  /* EXISTS  */
+    EXPLAIN = 405,                 /* EXPLAIN  */
+    EXTENSION = 406,               /* EXTENSION  */
+    EXTERNAL = 407,                /* EXTERNAL  */
+    EXTRACT = 408,                 /* EXTRACT  */
+    FALSE_P = 409,                 /* FALSE_P  */
+    FAMILY = 410,                  /* FAMILY  */
+    FETCH = 411,                   /* FETCH  */
+    FILTER = 412,                  /* FILTER  */
+    FIRST_P = 413,                 /* FIRST_P  */
+    FLOAT_P = 414,                 /* FLOAT_P  */
+    FOLLOWING = 415,               /* FOLLOWING  */
+    FOR = 416,                     /* FOR  */
+    FORCE = 417,                   /* FORCE  */
+    FOREIGN = 418,                 /* FOREIGN  */
+    FORWARD = 419,                 /* FORWARD  */
+    FREEZE = 420,                  /* FREEZE  */
+    FROM = 421,                    /* FROM  */
+    FULL = 422,                    /* FULL  */
+    FUNCTION = 423,                /* FUNCTION  */
+    FUNCTIONS = 424,               /* FUNCTIONS  */
+    GLOBAL = 425,                  /* GLOBAL  */
+    GRANT = 426,                   /* GRANT  */
+    GRANTED = 427,                 /* GRANTED  */
+    GRAPH = 428,                   /* GRAPH  */
+    GREATEST = 429,                /* GREATEST  */
+    GROUP_P = 430,                 /* GROUP_P  */
+    GROUPING = 431,                /* GROUPING  */
+    HANDLER = 432,                 /* HANDLER  */
+    HAVING = 433,                  /* HAVING  */
+    HEADER_P = 434,                /* HEADER_P  */
+    HOLD = 435,                    /* HOLD  */
+    HOUR_P = 436,                  /* HOUR_P  */
+    IDENTITY_P = 437,              /* IDENTITY_P  */
+    IF_P = 438,                    /* IF_P  */
+    ILIKE = 439,                   /* ILIKE  */
+    IMMEDIATE = 440,               /* IMMEDIATE  */
+    IMMUTABLE = 441,               /* IMMUTABLE  */
+    IMPLICIT_P = 442,              /* IMPLICIT_P  */
+    IMPORT_P = 443,                /* IMPORT_P  */
+    IN_P = 444,                    /* IN_P  */
+    INCLUDING = 445,               /* INCLUDING  */
+    INCREMENT = 446,               /* INCREMENT  */
+    INDEX = 447,                   /* INDEX  */
+    INDEXES = 448,                 /* INDEXES  */
+    INHERIT = 449,                 /* INHERIT  */
+    INHERITS = 450,                /* INHERITS  */
+    INITIALLY = 451,               /* INITIALLY  */
+    INLINE_P = 452,                /* INLINE_P  */
+    INNER_P = 453,                 /* INNER_P  */
+    INOUT = 454,                   /* INOUT  */
+    INPUT_P = 455,                 /* INPUT_P  */
+    INSENSITIVE = 456,             /* INSENSITIVE  */
+    INSERT = 457,                  /* INSERT  */
+    INSTEAD = 458,                 /* INSTEAD  */
+    INT_P = 459,                   /* INT_P  */
+    INTEGER = 460,                 /* INTEGER  */
+    INTERSECT = 461,               /* INTERSECT  */
+    INTERVAL = 462,                /* INTERVAL  */
+    INTO = 463,                    /* INTO  */
+    INVOKER = 464,                 /* INVOKER  */
+    IS = 465,                      /* IS  */
+    ISNULL = 466,                  /* ISNULL  */
+    ISOLATION = 467,               /* ISOLATION  */
+    JOIN = 468,                    /* JOIN  */
+    KEY = 469,                     /* KEY  */
+    LABEL = 470,                   /* LABEL  */
+    LANGUAGE = 471,                /* LANGUAGE  */
+    LARGE_P = 472,                 /* LARGE_P  */
+    LAST_P = 473,                  /* LAST_P  */
+    LATERAL_P = 474,               /* LATERAL_P  */
+    LEADING = 475,                 /* LEADING  */
+    LEAKPROOF = 476,               /* LEAKPROOF  */
+    LEAST = 477,                   /* LEAST  */
+    LEFT = 478,                    /* LEFT  */
+    LEVEL = 479,                   /* LEVEL  */
+    LIKE = 480,                    /* LIKE  */
+    LIMIT = 481,                   /* LIMIT  */
+    LISTEN = 482,                  /* LISTEN  */
+    LOAD = 483,                    /* LOAD  */
+    LOCAL = 484,                   /* LOCAL  */
+    LOCALTIME = 485,               /* LOCALTIME  */
+    LOCALTIMESTAMP = 486,          /* LOCALTIMESTAMP  */
+    LOCATION = 487,                /* LOCATION  */
+    LOCK_P = 488,                  /* LOCK_P  */
+    LOCKED = 489,                  /* LOCKED  */
+    LOGGED = 490,                  /* LOGGED  */
+    MAPPING = 491,                 /* MAPPING  */
+    MATCH = 492,                   /* MATCH  */
+    MATERIALIZED = 493,            /* MATERIALIZED  */
+    MAXVALUE = 494,                /* MAXVALUE  */
+    MERGE = 495,                   /* MERGE  */
+    METHOD = 496,                  /* METHOD  */
+    MINUTE_P = 497,                /* MINUTE_P  */
+    MINVALUE = 498,                /* MINVALUE  */
+    MODE = 499,                    /* MODE  */
+    MONTH_P = 500,                 /* MONTH_P  */
+    MOVE = 501,                    /* MOVE  */
+    NAME_P = 502,                  /* NAME_P  */
+    NAMES = 503,                   /* NAMES  */
+    NATIONAL = 504,                /* NATIONAL  */
+    NATURAL = 505,                 /* NATURAL  */
+    NCHAR = 506,                   /* NCHAR  */
+    NEXT = 507,                    /* NEXT  */
+    NO = 508,                      /* NO  */
+    NONE = 509,                    /* NONE  */
+    NOT = 510,                     /* NOT  */
+    NOTHING = 511,                 /* NOTHING  */
+    NOTIFY = 512,                  /* NOTIFY  */
+    NOTNULL = 513,                 /* NOTNULL  */
+    NOWAIT = 514,                  /* NOWAIT  */
+    NULL_P = 515,                  /* NULL_P  */
+    NULLIF = 516,                  /* NULLIF  */
+    NULLS_P = 517,                 /* NULLS_P  */
+    NUMERIC = 518,                 /* NUMERIC  */
+    OBJECT_P = 519,                /* OBJECT_P  */
+    OF = 520,                      /* OF  */
+    OFF = 521,                     /* OFF  */
+    OFFSET = 522,                  /* OFFSET  */
+    OIDS = 523,                    /* OIDS  */
+    ON = 524,                      /* ON  */
+    ONLY = 525,                    /* ONLY  */
+    OPERATOR = 526,                /* OPERATOR  */
+    OPTION = 527,                  /* OPTION  */
+    OPTIONAL_P = 528,              /* OPTIONAL_P  */
+    OPTIONS = 529,                 /* OPTIONS  */
+    OR = 530,                      /* OR  */
+    ORDER = 531,                   /* ORDER  */
+    ORDINALITY = 532,              /* ORDINALITY  */
+    OUT_P = 533,                   /* OUT_P  */
+    OUTER_P = 534,                 /* OUTER_P  */
+    OVER = 535,                    /* OVER  */
+    OVERLAPS = 536,                /* OVERLAPS  */
+    OVERLAY = 537,                 /* OVERLAY  */
+    OWNED = 538,                   /* OWNED  */
+    OWNER = 539,                   /* OWNER  */
+    PARALLEL = 540,                /* PARALLEL  */
+    PARSER = 541,                  /* PARSER  */
+    PARTIAL = 542,                 /* PARTIAL  */
+    PARTITION = 543,               /* PARTITION  */
+    PASSING = 544,                 /* PASSING  */
+    PASSWORD = 545,                /* PASSWORD  */
+    PLACING = 546,                 /* PLACING  */
+    PLANS = 547,                   /* PLANS  */
+    POLICY = 548,                  /* POLICY  */
+    POSITION = 549,                /* POSITION  */
+    PRECEDING = 550,               /* PRECEDING  */
+    PRECISION = 551,               /* PRECISION  */
+    PRESERVE = 552,                /* PRESERVE  */
+    PREPARE = 553,                 /* PREPARE  */
+    PREPARED = 554,                /* PREPARED  */
+    PRIMARY = 555,                 /* PRIMARY  */
+    PRIOR = 556,                   /* PRIOR  */
+    PRIVILEGES = 557,              /* PRIVILEGES  */
+    PROCEDURAL = 558,              /* PROCEDURAL  */
+    PROCEDURE = 559,               /* PROCEDURE  */
+    PROGRAM = 560,                 /* PROGRAM  */
+    PROPERTY = 561,                /* PROPERTY  */
+    QUOTE = 562,                   /* QUOTE  */
+    RANGE = 563,                   /* RANGE  */
+    READ = 564,                    /* READ  */
+    REAL = 565,                    /* REAL  */
+    REASSIGN = 566,                /* REASSIGN  */
+    RECHECK = 567,                 /* RECHECK  */
+    RECURSIVE = 568,               /* RECURSIVE  */
+    REF = 569,                     /* REF  */
+    REFERENCES = 570,              /* REFERENCES  */
+    REFRESH = 571,                 /* REFRESH  */
+    REINDEX = 572,                 /* REINDEX  */
+    RELATIVE_P = 573,              /* RELATIVE_P  */
+    RELEASE = 574,                 /* RELEASE  */
+    REMOVE = 575,                  /* REMOVE  */
+    RENAME = 576,                  /* RENAME  */
+    REPEATABLE = 577,              /* REPEATABLE  */
+    REPLACE = 578,                 /* REPLACE  */
+    REPLICA = 579,                 /* REPLICA  */
+    RESET = 580,                   /* RESET  */
+    RESTART = 581,                 /* RESTART  */
+    RESTRICT = 582,                /* RESTRICT  */
+    RETURN = 583,                  /* RETURN  */
+    RETURNING = 584,               /* RETURNING  */
+    RETURNS = 585,                 /* RETURNS  */
+    REVOKE = 586,                  /* REVOKE  */
+    RIGHT = 587,                   /* RIGHT  */
+    ROLE = 588,                    /* ROLE  */
+    ROLLBACK = 589,                /* ROLLBACK  */
+    ROLLUP = 590,                  /* ROLLUP  */
+    ROW = 591,                     /* ROW  */
+    ROWS = 592,                    /* ROWS  */
+    RULE = 593,                    /* RULE  */
+    SAVEPOINT = 594,               /* SAVEPOINT  */
+    SCHEMA = 595,                  /* SCHEMA  */
+    SCROLL = 596,                  /* SCROLL  */
+    SEARCH = 597,                  /* SEARCH  */
+    SECOND_P = 598,                /* SECOND_P  */
+    SECURITY = 599,                /* SECURITY  */
+    SELECT = 600,                  /* SELECT  */
+    SEQUENCE = 601,                /* SEQUENCE  */
+    SEQUENCES = 602,               /* SEQUENCES  */
+    SERIALIZABLE = 603,            /* SERIALIZABLE  */
+    SERVER = 604,                  /* SERVER  */
+    SESSION = 605,                 /* SESSION  */
+    SESSION_USER = 606,            /* SESSION_USER  */
+    SET = 607,                     /* SET  */
+    SETS = 608,                    /* SETS  */
+    SETOF = 609,                   /* SETOF  */
+    SHARE = 610,                   /* SHARE  */
+    SHORTESTPATH = 611,            /* SHORTESTPATH  */
+    SHOW = 612,                    /* SHOW  */
+    SIMILAR = 613,                 /* SIMILAR  */
+    SIMPLE = 614,                  /* SIMPLE  */
+    SINGLE = 615,                  /* SINGLE  */
+    SIZE_P = 616,                  /* SIZE_P  */
+    SKIP = 617,                    /* SKIP  */
+    SMALLINT = 618,                /* SMALLINT  */
+    SNAPSHOT = 619,                /* SNAPSHOT  */
+    SOME = 620,                    /* SOME  */
+    SQL_P = 621,                   /* SQL_P  */
+    STABLE = 622,                  /* STABLE  */
+    STANDALONE_P = 623,            /* STANDALONE_P  */
+    START = 624,                   /* START  */
+    STATEMENT = 625,               /* STATEMENT  */
+    STATISTICS = 626,              /* STATISTICS  */
+    STDIN = 627,                   /* STDIN  */
+    STDOUT = 628,                  /* STDOUT  */
+    STORAGE = 629,                 /* STORAGE  */
+    STRICT_P = 630,                /* STRICT_P  */
+    STRIP_P = 631,                 /* STRIP_P  */
+    SUBSTRING = 632,               /* SUBSTRING  */
+    SYMMETRIC = 633,               /* SYMMETRIC  */
+    SYSID = 634,                   /* SYSID  */
+    SYSTEM_P = 635,                /* SYSTEM_P  */
+    TABLE = 636,                   /* TABLE  */
+    TABLES = 637,                  /* TABLES  */
+    TABLESAMPLE = 638,             /* TABLESAMPLE  */
+    TABLESPACE = 639,              /* TABLESPACE  */
+    TEMP = 640,                    /* TEMP  */
+    TEMPLATE = 641,                /* TEMPLATE  */
+    TEMPORARY = 642,               /* TEMPORARY  */
+    TEXT_P = 643,                  /* TEXT_P  */
+    THEN = 644,                    /* THEN  */
+    TIME = 645,                    /* TIME  */
+    TIMESTAMP = 646,               /* TIMESTAMP  */
+    TO = 647,                      /* TO  */
+    TRAILING = 648,                /* TRAILING  */
+    TRANSACTION = 649,             /* TRANSACTION  */
+    TRANSFORM = 650,               /* TRANSFORM  */
+    TREAT = 651,                   /* TREAT  */
+    TRIGGER = 652,                 /* TRIGGER  */
+    TRIM = 653,                    /* TRIM  */
+    TRUE_P = 654,                  /* TRUE_P  */
+    TRUNCATE = 655,                /* TRUNCATE  */
+    TRUSTED = 656,                 /* TRUSTED  */
+    TYPE_P = 657,                  /* TYPE_P  */
+    TYPES_P = 658,                 /* TYPES_P  */
+    UNBOUNDED = 659,               /* UNBOUNDED  */
+    UNCOMMITTED = 660,             /* UNCOMMITTED  */
+    UNENCRYPTED = 661,             /* UNENCRYPTED  */
+    UNION = 662,                   /* UNION  */
+    UNIQUE = 663,                  /* UNIQUE  */
+    UNKNOWN = 664,                 /* UNKNOWN  */
+    UNLISTEN = 665,                /* UNLISTEN  */
+    UNLOGGED = 666,                /* UNLOGGED  */
+    UNTIL = 667,                   /* UNTIL  */
+    UPDATE = 668,                  /* UPDATE  */
+    USER = 669,                    /* USER  */
+    USING = 670,                   /* USING  */
+    VACUUM = 671,                  /* VACUUM  */
+    VALID = 672,                   /* VALID  */
+    VALIDATE = 673,                /* VALIDATE  */
+    VALIDATOR = 674,               /* VALIDATOR  */
+    VALUE_P = 675,                 /* VALUE_P  */
+    VALUES = 676,                  /* VALUES  */
+    VARCHAR = 677,                 /* VARCHAR  */
+    VARIADIC = 678,                /* VARIADIC  */
+    VARYING = 679,                 /* VARYING  */
+    VERBOSE = 680,                 /* VERBOSE  */
+    VERSION_P = 681,               /* VERSION_P  */
+    VIEW = 682,                    /* VIEW  */
+    VIEWS = 683,                   /* VIEWS  */
+    VLABEL = 684,                  /* VLABEL  */
+    VOLATILE = 685,                /* VOLATILE  */
+    WHEN = 686,                    /* WHEN  */
+    WHERE = 687,                   /* WHERE  */
+    WHITESPACE_P = 688,            /* WHITESPACE_P  */
+    WINDOW = 689,                  /* WINDOW  */
+    WITH = 690,                    /* WITH  */
+    WITHIN = 691,                  /* WITHIN  */
+    WITHOUT = 692,                 /* WITHOUT  */
+    WORK = 693,                    /* WORK  */
+    WRAPPER = 694,                 /* WRAPPER  */
+    WRITE = 695,                   /* WRITE  */
+    XML_P = 696,                   /* XML_P  */
+    XMLATTRIBUTES = 697,           /* XMLATTRIBUTES  */
+    XMLCONCAT = 698,               /* XMLCONCAT  */
+    XMLELEMENT = 699,              /* XMLELEMENT  */
+    XMLEXISTS = 700,               /* XMLEXISTS  */
+    XMLFOREST = 701,               /* XMLFOREST  */
+    XMLPARSE = 702,                /* XMLPARSE  */
+    XMLPI = 703,                   /* XMLPI  */
+    XMLROOT = 704,                 /* XMLROOT  */
+    XMLSERIALIZE = 705,            /* XMLSERIALIZE  */
+    YEAR_P = 706,                  /* YEAR_P  */
+    YES_P = 707,                   /* YES_P  */
+    ZONE = 708,                    /* ZONE  */
+    NOT_LA = 709,                  /* NOT_LA  */
+    NULLS_LA = 710,                /* NULLS_LA  */
+    WITH_LA = 711,                 /* WITH_LA  */
+    POSTFIXOP = 712,               /* POSTFIXOP  */
+    UMINUS = 713                   /* UMINUS  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 204 "gram.y"
+
+	core_YYSTYPE		core_yystype;
+	/* these fields must match core_YYSTYPE: */
+	int					ival;
+	char				*str;
+	const char			*keyword;
+
+	char				chr;
+	bool				boolean;
+	JoinType			jtype;
+	DropBehavior		dbehavior;
+	OnCommitAction		oncommit;
+	List				*list;
+	Node				*node;
+	Value				*value;
+	ObjectType			objtype;
+	TypeName			*typnam;
+	FunctionParameter   *fun_param;
+	FunctionParameterMode fun_param_mode;
+	FuncWithArgs		*funwithargs;
+	DefElem				*defelt;
+	SortBy				*sortby;
+	WindowDef			*windef;
+	JoinExpr			*jexpr;
+	IndexElem			*ielem;
+	Alias				*alias;
+	RangeVar			*range;
+	IntoClause			*into;
+	WithClause			*with;
+	InferClause			*infer;
+	OnConflictClause	*onconflict;
+	A_Indices			*aind;
+	ResTarget			*target;
+	struct PrivTarget	*privtarget;
+	AccessPriv			*accesspriv;
+	struct ImportQual	*importqual;
+	InsertStmt			*istmt;
+	VariableSetStmt		*vsetstmt;
+
+#line 562 "gram.h"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+/* Location type.  */
+#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
+typedef struct YYLTYPE YYLTYPE;
+struct YYLTYPE
+{
+  int first_line;
+  int first_column;
+  int last_line;
+  int last_column;
+};
+# define YYLTYPE_IS_DECLARED 1
+# define YYLTYPE_IS_TRIVIAL 1
+#endif
+
+
+
+
+int base_yyparse (core_yyscan_t yyscanner);
+
+
+#endif /* !YY_BASE_YY_GRAM_H_INCLUDED  */
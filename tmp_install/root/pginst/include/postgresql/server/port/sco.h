@@ -0,0 +1,7 @@
+/*
+ * src/include/port/sco.h
+ *
+ * see src/backend/libpq/pqcomm.c */
+#define SCO_ACCEPT_BUG
+
+#define USE_UNIVEL_CC
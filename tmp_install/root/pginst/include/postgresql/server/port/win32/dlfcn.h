@@ -0,0 +1 @@
+/* src/include/port/win32/dlfcn.h */
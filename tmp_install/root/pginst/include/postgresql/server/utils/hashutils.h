@@ -0,0 +1,33 @@
+/*
+ * hashutils.h
+ *	  Inline hash functions for simple keys.
+ *
+ * Portions Copyright (c) 1996-2016, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * src/include/utils/hashutils.h
+ */
+#ifndef HASHUTILS_H
+#define HASHUTILS_H
+
+/*
+ * Simple inline murmur hash implementation hashing a 64 bit integer, for
+ * performance.  It's the finalizer of MurmurHash3, which mixes all the bits
+ * of the input into all the bits of the result, so the low bits of the result
+ * can be used directly to select a bucket of a hash table.
+ */
+static inline uint64
+murmurhash64(uint64 data)
+{
+	uint64		h = data;
+
+	h ^= h >> 33;
+	h *= UINT64CONST(0xff51afd7ed558ccd);
+	h ^= h >> 33;
+	h *= UINT64CONST(0xc4ceb9fe1a85ec53);
+	h ^= h >> 33;
+
+	return h;
+}
+
+#endif   /* HASHUTILS_H */